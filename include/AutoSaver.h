@@ -0,0 +1,92 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AUTOSAVER_H
+#define AUTOSAVER_H
+
+#include <SaveGameHeader.h>
+
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+inline constexpr auto AUTOSAVE_SLOTS = 3; ///< number of autosave files that are used in turn
+
+/**
+    Writes autosaves on a worker thread. The game thread only serializes the game into memory
+    (see Game::createSaveGameData()); compressing and writing the file happens in the background.
+    The autosaves rotate through the files autosave1.dls, autosave2.dls, ... Every file is written under a temporary
+    name first and then renamed, so a crash while saving never destroys an older autosave.
+*/
+class AutoSaver final {
+public:
+    /**
+        Constructor. The slot that is overwritten first is the one with the oldest autosave.
+        \param  directory   the directory for the autosaves
+        \param  numSlots    the number of autosave files
+    */
+    explicit AutoSaver(std::filesystem::path directory, int numSlots = AUTOSAVE_SLOTS);
+
+    AutoSaver(const AutoSaver&)            = delete;
+    AutoSaver(AutoSaver&&)                 = delete;
+    AutoSaver& operator=(const AutoSaver&) = delete;
+    AutoSaver& operator=(AutoSaver&&)      = delete;
+
+    /// waits until the current autosave is written
+    ~AutoSaver();
+
+    /**
+        Hands a savegame over to the worker thread. If the previous autosave is still being written the new one is
+        dropped, so a slow disk never delays the game.
+        \param  saveGameData    the savegame to write
+        \return true if the savegame will be written, false if it was dropped
+    */
+    bool save(SaveGameData&& saveGameData);
+
+    /// is an autosave currently waiting or being written?
+    [[nodiscard]] bool isBusy() const;
+
+    /// waits until the current autosave is written
+    void wait() const;
+
+    /**
+        Returns the file name of an autosave slot.
+        \param  slot    the slot (0 to numSlots - 1)
+        \return the file name
+    */
+    [[nodiscard]] std::filesystem::path getSlotFilename(int slot) const;
+
+private:
+    void run();
+    void write(const SaveGameData& saveGameData);
+
+    const std::filesystem::path directory_;
+    const int numSlots_;
+    int nextSlot_ = 0; ///< only accessed by the worker thread after construction
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable condition_;
+    std::optional<SaveGameData> pending_; ///< the savegame waiting for the worker
+    bool bWriting_ = false;               ///< the worker is writing a savegame
+    bool bQuit_    = false;
+
+    std::thread thread_;
+};
+
+#endif // AUTOSAVER_H
@@ -114,6 +114,12 @@ public:
     */
     [[nodiscard]] CMDTYPE getCommandID() const noexcept { return commandID; }
 
+    /**
+        Gets the parameters of this command.
+        \return the parameters of this command
+    */
+    [[nodiscard]] const std::vector<uint32_t>& getParameters() const noexcept { return parameter; }
+
     /**
         Executes this command. This takes the appropriate actions to run this command.
     */
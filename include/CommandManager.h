@@ -19,6 +19,7 @@
 #define COMMANDMANAGER_H
 
 #include <Command.h>
+#include <Definitions.h>
 
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
@@ -85,6 +86,16 @@ public:
     */
     void load(InputStream& stream);
 
+    /**
+        Calculates how many cycles in advance commands are given, so that they reach the other players before they
+        are executed.
+        \param  roundTripTime   the maximum round trip time to the other players in milliseconds
+        \return the number of cycles
+    */
+    static uint32_t calcNetworkCycleBuffer(int roundTripTime) noexcept {
+        return static_cast<uint32_t>(MILLI2CYCLES(roundTripTime)) + 5;
+    }
+
     [[nodiscard]] uint32_t getNetworkCycleBuffer() const noexcept { return networkCycleBuffer; }
 
     void setNetworkCycleBuffer(uint32_t newNetworkCycleBuffer) noexcept { networkCycleBuffer = newNetworkCycleBuffer; }
@@ -128,6 +139,10 @@ private:
     std::unique_ptr<OutputStream> pStream;      ///< a stream all added commands will be written to. May be nullptr
     bool bReadOnly{};              ///< true = addCommand() is a NO-OP, false = addCommand() has normal behaviour
     uint32_t networkCycleBuffer{}; ///< the number of frames a command is given in advance
+
+    bool bCommandsChanged = true;          ///< commands were added since the last command list was sent
+    uint32_t lastSentCycle{};              ///< the game cycle the last command list was sent in
+    uint32_t lastSentNetworkCycleBuffer{}; ///< the network cycle buffer used for the last command list
 };
 
 #endif // COMMANDMANAGER_H
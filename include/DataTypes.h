@@ -230,6 +230,7 @@ public:
         std::string language;   ///< Language code: "en" = English, "fr" = French, "de" = German
         int scrollSpeed;        ///< Scroll speed in pixels
         bool showTutorialHints; ///< If true, tutorial hints are shown during the game
+        int autosaveInterval;   ///< Minutes of game time between two autosaves; 0 disables autosaving
     } general;
 
     class VideoClass {
@@ -245,6 +246,7 @@ public:
         bool rotateUnitGraphics;
         std::string renderer;
         std::string typeface;
+        bool dirtyRegions;
     } video;
 
     class AudioClass {
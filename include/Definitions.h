@@ -34,7 +34,13 @@ inline constexpr auto DEFAULT_PORT       = 28747;
 inline constexpr auto DEFAULT_METASERVER = "http://dunelegacy.sourceforge.net/metaserver/metaserver.php";
 
 inline constexpr auto SAVEMAGIC       = 8675309;
-inline constexpr auto SAVEGAMEVERSION = 9704;
+inline constexpr auto SAVEGAMEVERSION = 9706;
+
+/// the last savegame version that stores the map tiles one after another instead of in chunks
+inline constexpr auto SAVEGAMEVERSION_SEQUENTIAL_MAP = 9705;
+
+/// the last savegame version without header and compressed sections; such savegames can still be loaded
+inline constexpr auto SAVEGAMEVERSION_UNCOMPRESSED = 9704;
 
 inline constexpr auto MAX_PLAYERNAMELENGTH = 24;
 
@@ -92,6 +98,7 @@ inline constexpr auto NUM_TEAMS = 7;
 
 inline constexpr auto DEVIATIONTIME     = MILLI2CYCLES(120 * 1000);
 inline constexpr auto TRACKSTIME        = MILLI2CYCLES((1 << 16));
+inline constexpr auto FOGTIME           = MILLI2CYCLES(10 * 1000);
 inline constexpr auto HARVESTERMAXSPICE = 700;
 #define HARVESTSPEED      (0.1344_fix)
 #define BADLYDAMAGEDRATIO (0.5_fix) // if health/getMaxHealth() < this, damage will become bad - smoke and shit
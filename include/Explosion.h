@@ -40,6 +40,9 @@ public:
 
     bool update();
 
+    /// \return the center of this explosion in world coordinates
+    const Coord& getPosition() const noexcept { return position; }
+
 private:
     uint32_t explosionID;
     Coord position;
@@ -18,33 +18,28 @@
 #ifndef DECODE_H
 #define DECODE_H
 
-/// A variant of memcpy that can handle overlapping memory areas.
-/**
-    Copies memory areas that may overlap byte by byte from small memory
-    addresses to big memory addresses. Thus, already copied bytes can be
-    copied again.
-    \param  dst destination
-    \param  src source
-    \param  cnt length in bytes
-*/
-inline void memcpy_overlap(unsigned char* dst, const unsigned char* src, unsigned cnt);
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
 /// Decompresses format40 compressed images/data.
-/** Decompresses format40 compressed images/data specified by image_in to image_out.
-    \param  image_in    format80 compressed data
-    \param  image_out   pointer to output uncompressed data
-    \return written bytes to image_out
+/** Decompresses format40 compressed images/data specified by input into output. Format40 stores the difference to the
+    previous frame, so the decoded bytes are XORed into output.
+    \param  input   format40 compressed data
+    \param  output  the previous frame, which is changed into the new one
+    \return the position in output after the last command
+    \throw  std::invalid_argument if the data ends without an end command or does not fit into output
  */
-int decode40(const unsigned char* image_in, unsigned char* image_out);
+size_t decode40(std::span<const uint8_t> input, std::span<uint8_t> output);
 
 /// Decompresses format80 compressed images/data.
-/** Decompresses format80 compressed images/data specified by image_in to image_out. The checksum is also calculated and
-    compared with the parameter checksum.
-    \param  image_in    format80 compressed data
-    \param  image_out   pointer to output uncompressed data
-    \param  checksum    checksum for this file
-    \return 0 if checksum is correct<br> -1 if checksum is incorrect
+/** Decompresses format80 compressed images/data specified by input into output.
+    \param  input   format80 compressed data
+    \param  output  buffer for the uncompressed data
+    \return the number of bytes written to output; some file formats store it as a checksum
+    \throw  std::invalid_argument if the data ends without an end command, refers to data outside of output or does
+            not fit into output
  */
-int decode80(const unsigned char* image_in, unsigned char* image_out, unsigned checksum);
+size_t decode80(std::span<const uint8_t> input, std::span<uint8_t> output);
 
 #endif // DECODE_H
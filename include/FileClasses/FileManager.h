@@ -26,6 +26,8 @@
 #include <optional>
 #include <span>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -35,6 +37,9 @@ public:
 
     [[nodiscard]] std::optional<std::filesystem::path> find(const std::u8string& filename) const;
 
+    /// \return the paths of all cached files, sorted
+    [[nodiscard]] std::vector<std::filesystem::path> files() const;
+
     void refresh(std::span<const std::filesystem::path> paths);
 
 private:
@@ -61,9 +66,50 @@ public:
     getMissingFiles(const CaseInsensitiveFilesystemCache& cache);
 };
 
+/**
+    The MD5 digests of the PAK-Files are logged at startup. They are cached together with the size and the modification
+    time of every PAK-File, so unchanged PAK-Files are not read again on every start.
+*/
+class PakDigestCache final {
+public:
+    /**
+        Loads the cache. A missing or broken cache file results in an empty cache.
+        \param  cacheFilename   the file the cache is stored in
+    */
+    explicit PakDigestCache(std::filesystem::path cacheFilename);
+
+    /**
+        Returns the cached digest of a file.
+        \param  filename    the file
+        \return the digest or nothing if the file is not cached or has changed since
+    */
+    [[nodiscard]] std::optional<std::string> find(const std::filesystem::path& filename) const;
+
+    void insert(const std::filesystem::path& filename, std::string digest);
+
+    /// writes the cache back to the cache file
+    void save() const;
+
+private:
+    struct Entry final {
+        uint64_t size;
+        int64_t modificationTime;
+        std::string digest;
+    };
+
+    std::filesystem::path cacheFilename_;
+    std::unordered_map<std::u8string, Entry> entries_;
+};
+
 class PakFileManager final {
 public:
     explicit PakFileManager(const CaseInsensitiveFilesystemCache& cache, std::span<const std::string> files);
+    ~PakFileManager();
+
+    PakFileManager(const PakFileManager&)            = delete;
+    PakFileManager(PakFileManager&&)                 = delete;
+    PakFileManager& operator=(const PakFileManager&) = delete;
+    PakFileManager& operator=(PakFileManager&&)      = delete;
 
     [[nodiscard]] std::tuple<const Pakfile*, int> find(const std::string& filename) const;
 
@@ -79,8 +125,12 @@ private:
 
     [[nodiscard]] pak_directory_type createPakDirectory() const;
 
+    void logDigests();
+
     const std::vector<std::unique_ptr<Pakfile>> pakFiles_;
     const pak_directory_type pak_directory_;
+
+    std::thread digestThread_; ///< hashes the PAK-Files that are not in the PakDigestCache
 };
 
 /// A class for loading all the PAK-Files.
@@ -116,6 +166,13 @@ public:
 
     [[nodiscard]] bool exists(std::filesystem::path filename) const;
 
+    /**
+        Describes the content of all files in the search paths (including the PAK-Files) by their names, sizes and
+        modification times. Caches of data derived from these files must be discarded when the stamp changes.
+        \return a hash over the names, sizes and modification times
+    */
+    [[nodiscard]] std::string getContentStamp() const;
+
 private:
     CaseInsensitiveFilesystemCache filesystem_cache_;
     PakFileManager pak_files_;
@@ -22,6 +22,7 @@
 
 #include "SurfaceLoader.h"
 #include <Renderer/DuneTextures.h>
+#include <Renderer/TextureAtlasCache.h>
 
 #include "Animation.h"
 #include "misc/Random.h"
@@ -33,6 +34,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 class GFXManager final {
 public:
@@ -51,6 +53,13 @@ public:
     }
     zoomable_texture getObjPic(ObjPic_enum id, HOUSETYPE house = HOUSETYPE::HOUSE_HARKONNEN) const;
 
+    /**
+        Generates the house colored object pictures that were requested through getObjPic() but do not exist yet
+        for this zoom level. Call it before drawing a frame.
+        \param  z   the zoom level that is about to be drawn
+    */
+    void prepareZoomlevel(int z) const;
+
     [[nodiscard]] const DuneTexture* getSmallDetailPic(SmallDetailPics_Enum id) const;
     [[nodiscard]] const DuneTexture* getTinyPicture(TinyPicture_Enum id) const;
     [[nodiscard]] const DuneTexture*
@@ -62,22 +71,22 @@ public:
     [[nodiscard]] SDL_Cursor* getDefaultCursor() const { return default_cursor_.get(); }
 
     SDL_Surface* getZoomedObjSurface(ObjPic_enum id, HOUSETYPE house, unsigned int z) {
-        return surfaceLoader.getZoomedObjSurface(id, house, z);
+        return getSurfaceLoader().getZoomedObjSurface(id, house, z);
     }
     SDL_Surface* getZoomedObjSurface(ObjPic_enum id, unsigned int z) {
-        return surfaceLoader.getZoomedObjSurface(id, z);
+        return getSurfaceLoader().getZoomedObjSurface(id, z);
     }
 
     SDL_Surface* getUIGraphicSurface(UIGraphics_Enum id, HOUSETYPE house = HOUSETYPE::HOUSE_HARKONNEN) {
-        return surfaceLoader.getUIGraphicSurface(id, house);
+        return getSurfaceLoader().getUIGraphicSurface(id, house);
     }
     SDL_Surface* getMapChoicePieceSurface(UIGraphics_Enum num, HOUSETYPE house) {
-        return surfaceLoader.getMapChoicePieceSurface(num, house);
+        return getSurfaceLoader().getMapChoicePieceSurface(num, house);
     }
 
-    Animation* getAnimation(unsigned int id) { return surfaceLoader.getAnimation(id); }
+    Animation* getAnimation(unsigned int id) { return getSurfaceLoader().getAnimation(id); }
 
-    [[nodiscard]] SDL_Surface* getBackgroundSurface() const { return surfaceLoader.getBackgroundSurface(); }
+    [[nodiscard]] SDL_Surface* getBackgroundSurface() const { return getSurfaceLoader().getBackgroundSurface(); }
 
     [[nodiscard]] SDL_Texture* getTempStreamingTexture(SDL_Renderer* renderer, int width, int height);
 
@@ -94,20 +103,21 @@ public:
 private:
     Random random_; ///< This random number generator is for use by the UI so that the game RNGs will not be disrupted.
 
-    [[nodiscard]] sdl2::texture_ptr extractSmallDetailPicTex(const std::string& filename) const;
-
     void initialize_cursors();
 
-    SurfaceLoader surfaceLoader;
-    DuneTextures duneTextures;
+    /// Returns the surfaces of the cursors; they are cached, so the SurfaceLoader is not needed on a cache hit
+    [[nodiscard]] std::vector<sdl2::surface_ptr> loadCursorSurfaces() const;
 
-    // Textures
-    std::array<std::array<std::array<sdl2::texture_ptr, NUM_ZOOMLEVEL>, NUM_HOUSES>, NUM_OBJPICS> objPicTex;
-    std::array<sdl2::texture_ptr, NUM_SMALLDETAILPICS> smallDetailPicTex;
-    std::array<sdl2::texture_ptr, NUM_TINYPICTURE> tinyPictureTex;
+    /// Returns the SurfaceLoader and creates it on first use
+    SurfaceLoader& getSurfaceLoader() const;
 
-    std::array<std::array<sdl2::texture_ptr, NUM_HOUSES>, NUM_UIGRAPHICS> uiGraphicTex;
-    std::array<std::array<sdl2::texture_ptr, NUM_HOUSES>, NUM_MAPCHOICEPIECES> mapChoicePiecesTex;
+    const int width_;
+    const int height_;
+
+    mutable std::unique_ptr<SurfaceLoader> surfaceLoader_; ///< only created if the caches do not fit
+    std::unique_ptr<TextureAtlasCache> atlasCache_;        ///< keeps the atlases of duneTextures between starts
+    std::unique_ptr<TextureAtlasCache> cursorCache_;       ///< keeps the cursor surfaces between starts
+    DuneTextures duneTextures;
 
     sdl2::cursor_ptr default_cursor_;
     std::unordered_map<UIGraphics_Enum, sdl2::cursor_ptr> cursors_;
@@ -18,6 +18,7 @@
 #ifndef ICNFILE_H
 #define ICNFILE_H
 
+#include <misc/RWopsData.h>
 #include <misc/SDL2pp.h>
 
 #include <cstdint>
@@ -65,7 +66,7 @@ public:
     [[nodiscard]] auto getNumTilesets() const noexcept { return tilesets.size(); }
 
 private:
-    std::unique_ptr<uint8_t[]> pIcnFiledata;
+    RWopsData pIcnFiledata; ///< a view of the mapped PAK-File or a copy of the icn-File
     uint32_t numFiles;
 
     std::vector<MapfileEntry> tilesets;
@@ -18,9 +18,12 @@
 #ifndef PAKFILE_H
 #define PAKFILE_H
 
+#include <misc/MappedFile.h>
 #include <misc/SDL2pp.h>
 
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -43,13 +46,9 @@ public:
 
     [[nodiscard]] bool exists(const std::string& filename) const;
 
+    [[nodiscard]] const std::filesystem::path& getPakfilename() const noexcept { return filename_; }
+
 protected:
-    /// Internal structure used by opened SDL_RWop
-    struct RWopData {
-        const BasePakfile* curPakfile;
-        unsigned int fileIndex;
-        size_t fileOffset;
-    };
     /// Internal structure for representing one file in this PAK-File
     struct PakFileEntry final {
         uint32_t startOffset;
@@ -57,14 +56,6 @@ protected:
         std::string filename;
     };
 
-    static int64_t SizeFile(SDL_RWops* pRWop);
-    static int64_t SeekFile(SDL_RWops* pRWop, int64_t offset, int whence);
-    static size_t WriteFile(SDL_RWops* pRWop, const void* ptr, size_t size, size_t n);
-    static int CloseFile(SDL_RWops* pRWop);
-
-    void readIndex();
-
-    sdl2::RWops_ptr fPakFile;
     std::filesystem::path filename_;
 
     std::vector<PakFileEntry> fileEntries;
@@ -73,7 +64,8 @@ protected:
 /// A class for reading PAK-Files.
 /**
     This class can be used to read PAK-Files. PAK-Files are archive files used by Dune2.
-    The files inside the PAK-File can an be read through SDL_RWops.
+    The PAK-File is mapped into memory. The files inside can be accessed as views of the mapped data or
+    read through SDL_RWops; RWopsData views the files opened as SDL_RWops in place, too.
 */
 class Pakfile final : public BasePakfile {
 public:
@@ -83,8 +75,34 @@ public:
     sdl2::RWops_ptr openFile(const std::string& filename) const;
     sdl2::RWops_ptr openFile(int index) const;
 
+    /**
+        Returns the content of a file in this PAK-File. The view is valid as long as this Pakfile exists.
+        \param  filename    the name of the file
+        \return the content of the file
+    */
+    [[nodiscard]] std::span<const uint8_t> getFileData(const std::string& filename) const;
+
+    /**
+        Returns the content of a file in this PAK-File. The view is valid as long as this Pakfile exists.
+        \param  index   the index of the file
+        \return the content of the file
+    */
+    [[nodiscard]] std::span<const uint8_t> getFileData(int index) const;
+
+    /**
+        Returns the rest of a file opened by openFile() from its current position on and moves the position to the end
+        of the file. The view is valid as long as the Pakfile exists, even after the SDL_RWops is closed.
+        \param  rwop    any SDL_RWops
+        \return the content of the file or nothing if rwop was not opened by a Pakfile
+    */
+    [[nodiscard]] static std::optional<std::span<const uint8_t>> readFileData(SDL_RWops* rwop);
+
 private:
-    static size_t ReadFile(SDL_RWops* pRWop, void* ptr, size_t size, size_t n);
+    void readIndex();
+
+    [[nodiscard]] int findFile(const std::string& filename) const;
+
+    MappedFile mappedFile_;
 };
 
 /**
@@ -98,6 +116,8 @@ public:
     void addFile(SDL_RWops* rwop, const std::string& filename);
 
 private:
+    sdl2::RWops_ptr fPakFile;
+
     char* writeOutData{};
     size_t numWriteOutData{};
 };
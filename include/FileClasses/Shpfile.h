@@ -19,6 +19,7 @@
 #define SHPFILE_H
 
 #include "Animation.h"
+#include <misc/RWopsData.h>
 #include <misc/SDL2pp.h>
 
 #include <algorithm>
@@ -100,11 +101,13 @@ private:
     sdl2::surface_ptr
     getPictureArrayImpl(unsigned int tilesX, unsigned int tilesY, std::span<const int> tile_index) const;
     void readIndex();
-    static void shpCorrectLF(const unsigned char* in, unsigned char* out, int size);
+    void decodePicture(const ShpfileEntry& entry, std::span<unsigned char> image,
+                       std::vector<unsigned char>& buffer) const;
+    static void shpCorrectLF(std::span<const unsigned char> in, std::span<unsigned char> out);
     static void applyPalOffsets(const unsigned char* offsets, unsigned char* data, unsigned int length);
 
     std::vector<ShpfileEntry> shpfileEntries;
-    std::unique_ptr<unsigned char[]> pFiledata;
+    RWopsData pFiledata; ///< a view of the mapped PAK-File or a copy of the shp-File
     size_t shpFilesize;
 };
 
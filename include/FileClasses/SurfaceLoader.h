@@ -48,6 +48,15 @@ public:
         return getZoomedObjSurface(id, HOUSETYPE::HOUSE_HARKONNEN, z);
     }
 
+    /**
+        Returns the 8-bit Harkonnen picture the other houses are colored from. It is remapped with
+        mapSurfaceColorRange(); the windtrap then still has to be animated with generateWindtrapSurface().
+        \param  id  the object picture id
+        \param  z   the zoom level
+        \return the picture or nullptr if it looks the same for every house
+    */
+    [[nodiscard]] SDL_Surface* getRemapSource(unsigned int id, unsigned int z) const;
+
     SDL_Surface* getSmallDetailSurface(unsigned int id);
     SDL_Surface* getTinyPictureSurface(unsigned int id);
 
@@ -56,7 +65,22 @@ public:
 
     Animation* getAnimation(unsigned int id);
 
-    sdl2::surface_ptr generateWindtrapAnimationFrames(SDL_Surface* windtrapPic) const;
+    static sdl2::surface_ptr generateWindtrapAnimationFrames(SDL_Surface* windtrapPic);
+
+    /**
+        Generates the animated windtrap of a house from the 8-bit windtrap picture.
+        \param  house   the house to color the windtrap for
+        \param  zoom    the zoom level
+        \return the windtrap animation frames in display format
+    */
+    [[nodiscard]] sdl2::surface_ptr generateWindtrapSurface(HOUSETYPE house, int zoom) const;
+
+    /**
+        Generates the animated windtrap from an 8-bit windtrap picture that is already colored for its house.
+        \param  windtrap    the remapped windtrap picture (see getRemapSource())
+        \return the windtrap animation frames in display format
+    */
+    static sdl2::surface_ptr generateWindtrapSurface(SDL_Surface* windtrap);
     static sdl2::surface_ptr
     generateMapChoiceArrowFrames(SDL_Surface* arrowPic, HOUSETYPE house = HOUSETYPE::HOUSE_HARKONNEN);
     [[nodiscard]] sdl2::surface_ptr extractSmallDetailPic(const std::string& filename) const;
@@ -92,8 +116,10 @@ private:
     [[nodiscard]] sdl2::surface_ptr generateDoubledObjPic(unsigned int id, int h) const;
     [[nodiscard]] sdl2::surface_ptr generateTripledObjPic(unsigned int id, int h) const;
 
-    // 8-bit surfaces kept in main memory for processing as needed, e.g. color remapping
+    // 8-bit surfaces kept in main memory for processing as needed, e.g. color remapping. Only the Harkonnen
+    // pictures are created up front; the other houses are remapped on first use by getZoomedObjSurface().
     std::array<std::array<std::array<sdl2::surface_ptr, NUM_ZOOMLEVEL>, NUM_HOUSES>, NUM_OBJPICS> objPic;
+    std::array<sdl2::surface_ptr, NUM_ZOOMLEVEL> windtrapBase_; ///< the 8-bit windtraps before animating them
     std::array<std::array<sdl2::surface_ptr, NUM_HOUSES>, NUM_UIGRAPHICS> uiGraphic;
     std::array<std::array<sdl2::surface_ptr, NUM_HOUSES>, NUM_MAPCHOICEPIECES> mapChoicePieces;
     std::array<std::unique_ptr<Animation>, NUM_ANIMATION> animation{};
@@ -19,11 +19,13 @@
 #define WSAFILE_H
 
 #include "Animation.h"
+#include <misc/RWopsData.h>
 #include <misc/SDL2pp.h>
 
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <span>
 #include <tuple>
 
 /// A class for loading a *.WSA-File.
@@ -80,9 +82,9 @@ public:
     [[nodiscard]] bool isAnimationLooped() const noexcept { return looped; }
 
 private:
-    void decodeFrames(const unsigned char* pFiledata, uint32_t* index, int numberOfFrames,
+    void decodeFrames(std::span<const unsigned char> filedata, const unsigned char* index, int numberOfFrames,
                       unsigned char* pDecodedFrames, int x, int y) const;
-    std::tuple<std::unique_ptr<unsigned char[]>, size_t> readfile(SDL_RWops* rwop) const;
+    RWopsData readfile(SDL_RWops* rwop) const;
     void readdata(const std::initializer_list<SDL_RWops*>& rwops);
 
     std::vector<unsigned char> decodedFrames;
@@ -55,6 +55,9 @@ public:
 
     void addHintMessage(std::string_view message, const DuneTexture* pTexture);
 
+    /// \return true if no message is shown
+    [[nodiscard]] bool empty() const noexcept { return chatMessages.empty(); }
+
     /**
         Draws this widget to screen. This method is called before drawOverlay().
         \param  position    Position to draw the widget to
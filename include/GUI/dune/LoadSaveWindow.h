@@ -21,12 +21,16 @@
 #include <GUI/HBox.h>
 #include <GUI/Label.h>
 #include <GUI/ListBox.h>
+#include <GUI/PictureLabel.h>
 #include <GUI/TextBox.h>
 #include <GUI/TextButton.h>
 #include <GUI/VBox.h>
 #include <GUI/Window.h>
 
+#include <SaveGameHeader.h>
+
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -106,6 +110,14 @@ private:
 
     void onSelectionChange(bool bInteractive);
 
+    /**
+        Shows the header of the selected savegame (see SaveGameHeader). The headers are read by updateEntries().
+    */
+    void updateSaveGameInfo();
+
+    /// the file name (without extension) of a list entry
+    [[nodiscard]] const std::string& getEntryFileName(ListBox::index_type index) const;
+
     HBox mainHBox;
     VBox mainVBox;
 
@@ -121,7 +133,12 @@ private:
     TextButton cancelButton;
     TextBox saveName;
 
+    VBox thumbnailVBox;
+    PictureLabel thumbnail;
+    Label saveGameInfoLabel;
+
     bool bSaveWindow_;
+    bool bShowSaveGameInfo_; ///< show details about the selected savegame (only when loading savegames)
     std::filesystem::path filename_;
     std::vector<std::filesystem::path> directories_;
     std::vector<std::string> directoryTitles_;
@@ -129,6 +146,9 @@ private:
     int currentDirectoryIndex_;
     std::string preselectedFile_;
     uint32_t color_;
+
+    std::vector<std::string> fileNames_; ///< file names without extension, indexed by the int data of the entries
+    std::vector<std::optional<SaveGameHeader>> headers_; ///< the headers of fileNames_ (only if bShowSaveGameInfo_)
 };
 
 #endif // LOADSAVEWINDOW_H
@@ -22,9 +22,12 @@
 #include <GameInitSettings.h>
 #include <GameInterface.h>
 #include <INIMap/INIMapLoader.h>
+#include <MapChunkCache.h>
 #include <ObjectData.h>
 #include <ObjectManager.h>
+#include <Renderer/DuneSpriteBatch.h>
 #include <Trigger/TriggerManager.h>
+#include <misc/DirtyRegion.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <misc/Random.h>
@@ -39,6 +42,7 @@
 #include <algorithm>
 #include <array>
 #include <filesystem>
+#include <optional>
 #include <ranges>
 #include <unordered_set>
 #include <utility>
@@ -51,6 +55,10 @@ class WaitingForOtherPlayers;
 class ObjectManager;
 class House;
 class Explosion;
+class ReplaySnapshots;
+class AutoSaver;
+class SaveGameData;
+class SaveGameHeader;
 
 inline constexpr auto END_WAIT_TIME = dune::as_dune_clock_duration(6 * 1000);
 
@@ -89,8 +97,31 @@ public:
     /**
         Initializes a replay from the specified filename
         \param  filename    the file containing the replay
+        \param  startCycle  start the replay at this game cycle; the nearest earlier snapshot (see
+                            setReplaySnapshots()) is restored and the remaining game cycles are skipped
     */
-    void initReplay(const std::filesystem::path& filename);
+    void initReplay(const std::filesystem::path& filename, uint32_t startCycle = 0);
+
+    /**
+        Sets the snapshots for seeking in a replay. The snapshots are not owned by the game, so they can be passed
+        to the game that is created for the next seek.
+        \param  pReplaySnapshots    the snapshots to use and to add to
+    */
+    void setReplaySnapshots(ReplaySnapshots* pReplaySnapshots) noexcept { pReplaySnapshots_ = pReplaySnapshots; }
+
+    /**
+        Seeks to a game cycle in a replay. Seeking forward just skips game cycles; seeking backwards or past a
+        snapshot quits this game and getReplaySeekCycle() returns the requested game cycle. The caller should then
+        create a new game and call initReplay() with it.
+        \param  gameCycle   the game cycle to seek to
+    */
+    void seekReplay(uint32_t gameCycle);
+
+    /**
+        Returns the game cycle a new replay game should start at after runMainLoop() returned.
+        \return the requested game cycle or nothing if the replay was quit
+    */
+    [[nodiscard]] std::optional<uint32_t> getReplaySeekCycle() const noexcept { return replaySeekCycle_; }
 
     friend class INIMapLoader; // loading INI Maps is done with a INIMapLoader helper object
 
@@ -102,8 +133,10 @@ private:
 
     /**
         This method draws a complete frame.
+        \param  interfaceClip   the part of the screen the side bar and top bar are drawn to while only the changed
+                                parts of the screen are redrawn or nullptr to draw them like the rest of the screen
     */
-    void drawScreen();
+    void drawScreen(const SDL_Rect* interfaceClip = nullptr);
 
     /**
         This method processes all the user input.
@@ -227,6 +260,27 @@ private:
     */
     bool loadSaveGame(InputStream& stream);
 
+    /**
+        Loads the game state from the sections of a savegame. Savegames of version SAVEGAMEVERSION_UNCOMPRESSED
+        have no sections and pass the same stream for all of them.
+        \param  savegameVersion the version of the savegame
+        \param  state       the settings, houses and players
+        \param  map         the map
+        \param  objects     the units and structures
+        \param  bullets     the bullets, explosions, selection, screen position and triggers
+        \param  commands    the commands
+        \param  pHeader     the header of the savegame or nullptr for SAVEGAMEVERSION_UNCOMPRESSED
+        \return true on success, false on failure
+    */
+    bool loadSaveGameSections(uint32_t savegameVersion, InputStream& state, InputStream& map, InputStream& objects,
+                              InputStream& bullets, InputStream& commands, const SaveGameHeader* pHeader);
+
+    /**
+        Creates the header of a savegame of the current game.
+        \return the header including a thumbnail of the map as the local player sees it
+    */
+    [[nodiscard]] SaveGameHeader createSaveGameHeader() const;
+
 public:
     /**
         This method saves the current running game.
@@ -235,6 +289,19 @@ public:
     */
     bool saveGame(const std::filesystem::path& filename);
 
+    /**
+        This method saves the current running game.
+        \param stream the stream to save to
+    */
+    void saveGame(OutputStream& stream);
+
+    /**
+        Serializes the current game into memory without compressing it. This is much faster than saveGame() and the
+        result can be written on another thread.
+        \return the savegame
+    */
+    [[nodiscard]] SaveGameData createSaveGameData();
+
     /**
         This method starts the game. Will return when the game is finished or aborted.
     */
@@ -492,6 +559,32 @@ private:
     */
     void saveScreenshot();
 
+    /**
+        Starts or stops writing the render statistics of every frame to renderstats.csv in the user directory
+    */
+    void toggleRenderStatsDump();
+
+    /**
+        Collects the parts of the screen that have to be redrawn in this frame if only the changed parts of the screen
+        are redrawn. Scrolling, zooming, the overlays and input to the interface redraw the whole screen. A new game
+        cycle redraws the side bar and the part of the map view where objects and animations were and are now.
+    */
+    void collectScreenChanges();
+
+    /**
+        Collects the visible tiles that changed since the last game cycle or may change in the next one: tiles with
+        objects, dead units, fading tracks, bullets, explosions or the action indicator and the invalidated tiles.
+        \return the bounding rectangle of these tiles (in map coordinates) including a margin for sprites reaching
+                into the neighbouring tiles
+    */
+    SDL_Rect collectChangedTiles();
+
+    /**
+        Adds the part of the map view that shows the given tiles to the changed part of the screen.
+        \param  tiles   the tiles in map coordinates
+    */
+    void addChangedTiles(const SDL_Rect& tiles);
+
     /**
         Checks whether the cursor is on the radar view
         \param  mouseX  x-coordinate of cursor
@@ -578,10 +671,22 @@ private:
     void removeFromQuickSelectionLists(uint32_t objectID);
 
     void serviceNetwork(bool& bWaitForNetwork);
+
+    /// \return true if the commands of another player for the current game cycle have not arrived yet
+    [[nodiscard]] bool isWaitingForNetwork() const;
     void updateGame(const GameContext& context);
+    void updateReplaySnapshots();
+    void updateAutoSave();
+    void skipGameTime(uint32_t milliseconds);
 
     void doEventsUntil(const GameContext& context, dune::dune_clock::time_point until);
 
+    /**
+        Handles the events while the game is paused until the next frame has to be drawn (see dune::RedrawScheduler)
+        but at most for a second
+    */
+    void waitForRedraw(const GameContext& context);
+
 public:
     enum {
         CursorMode_Normal,
@@ -640,6 +745,12 @@ private:
 
     uint32_t skipToGameCycle_ = 0; ///< skip to this game cycle
 
+    ReplaySnapshots* pReplaySnapshots_ = nullptr; ///< snapshots for seeking in a replay (not owned)
+    std::optional<uint32_t> replaySeekCycle_;     ///< restart the replay at this game cycle after quitting
+
+    std::unique_ptr<AutoSaver> pAutoSaver_; ///< writes the autosaves in the background (nullptr if autosaving is off)
+    uint32_t autosaveInterval_ = 0;         ///< game cycles between two autosaves
+
     bool takePeriodicScreenshots_ = false; ///< take a screenshot every 10 seconds
     bool pendingScreenshot_       = false;
 
@@ -698,6 +809,18 @@ private:
     dune::selected_set_type
         selectedByOtherPlayerList_; ///< This is only used in multiplayer games where two players control one house
     std::vector<std::unique_ptr<Explosion>> explosionList_; ///< A list containing all the explosions that must be drawn
+    dune::SpriteBatch spriteBatch_;                         ///< Collects the sprites of the map view between draw calls
+    MapChunkCache terrainCache_{SDL_BLENDMODE_NONE};        ///< The terrain of the map view
+    MapChunkCache fogCache_{SDL_BLENDMODE_BLEND};           ///< The shroud and fog of war of the map view
+    const House* fogCacheHouse_ = nullptr;                  ///< The local house fogCache_ was drawn for
+
+    dune::DirtyRegion dirtyRegion_;                ///< The part of the screen to redraw when only changes are redrawn
+    dune::DirtyRegion dirtyInterface_;             ///< The part of the side bar and top bar to redraw
+    dune::dune_clock::time_point lastInputTime_{}; ///< When the last event changing the interface was handled
+    Coord drawnTopLeft_      = Coord::Invalid();   ///< The top left corner of the map view in the last drawn frame
+    int drawnZoomlevel_      = -1;                 ///< The zoom level of the last drawn frame
+    uint32_t drawnGameCycle_ = 0;                  ///< The game cycle of the last drawn frame
+    SDL_Rect drawnChangedTiles_{};                 ///< The changed tiles (see collectChangedTiles()) of that game cycle
 
     std::string localPlayerName_; ///< the name of the local player
     std::unordered_multimap<std::string, Player*>
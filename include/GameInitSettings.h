@@ -155,7 +155,12 @@ public:
 
     ~GameInitSettings();
 
-    void save(OutputStream& stream) const;
+    /**
+        Saves these settings to a stream.
+        \param  stream          the stream to write to
+        \param  bWithFiledata   false = write an empty filedata (e.g. if it is transferred separately)
+    */
+    void save(OutputStream& stream, bool bWithFiledata = true) const;
 
     [[nodiscard]] GameType getGameType() const noexcept { return gameType; }
     [[nodiscard]] HOUSETYPE getHouseID() const noexcept { return houseID; }
@@ -164,9 +169,11 @@ public:
     [[nodiscard]] uint32_t getAlreadyShownTutorialHints() const noexcept { return alreadyShownTutorialHints; }
     [[nodiscard]] const std::filesystem::path& getFilename() const noexcept { return filename; }
     [[nodiscard]] const std::string& getFiledata() const noexcept { return filedata; }
+    void setFiledata(std::string&& newFiledata) noexcept { filedata = std::move(newFiledata); }
     [[nodiscard]] const std::string& getServername() const noexcept { return servername; }
 
     [[nodiscard]] const std::vector<uint8_t>& getRandomSeed() noexcept;
+    void createRandomSeed();
 
     [[nodiscard]] bool isMultiplePlayersPerHouse() const noexcept { return multiplePlayersPerHouse; }
     void setMultiplePlayersPerHouse(bool multiplePlayersPerHouse) noexcept {
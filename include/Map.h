@@ -22,11 +22,13 @@
 #include "misc/Random.h"
 #include <AStarSearch.h>
 #include <Tile.h>
+#include <misc/DirtyTiles.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <misc/exceptions.h>
 
 #include <queue>
+#include <vector>
 
 class Map final {
 public:
@@ -41,7 +43,12 @@ public:
     Map& operator=(const Map&) = delete;
     Map& operator=(Map&&)      = delete;
 
-    void load(InputStream& stream);
+    /**
+        Loads the map. The tiles of current savegames are stored in chunks that are decoded in parallel.
+        \param  stream          the stream to read from
+        \param  savegameVersion the version of the savegame
+    */
+    void load(InputStream& stream, uint32_t savegameVersion);
     void save(OutputStream& stream, uint32_t gameCycleCount) const;
 
     void createSandRegions();
@@ -57,6 +64,60 @@ public:
         viewMap(houseID, Coord(x, y), maxViewRange);
     }
 
+    /**
+        Marks a tile as changed for the radar, e.g. because its terrain changed or an object entered or left it.
+        \param  location    the location of the tile
+    */
+    void invalidateRadar(const Coord& location) { radarChanges_.mark(location.x, location.y); }
+
+    /**
+        Returns the tiles whose radar color may have changed since the radar was updated the last time. This includes
+        the tiles that may have become fogged until gameCycleCount. The radar clears the set after updating.
+        \param  gameCycleCount  the current game cycle
+        \return the changed tiles
+    */
+    dune::DirtyTiles& collectRadarChanges(uint32_t gameCycleCount) {
+        expireFog(gameCycleCount);
+        return radarChanges_;
+    }
+
+    /**
+        Marks a tile as changed for the terrain cache of the map view, e.g. because its type changed or it was damaged.
+        \param  location    the location of the tile
+    */
+    void invalidateTerrain(const Coord& location) { terrainChanges_.mark(location.x, location.y); }
+
+    /**
+        Returns the tiles whose terrain may look different since the terrain cache was updated the last time. The
+        cache clears the set after updating.
+        \return the changed tiles
+    */
+    dune::DirtyTiles& collectTerrainChanges() noexcept { return terrainChanges_; }
+
+    /**
+        Marks a tile as changed for the map view while its cached terrain stays valid, e.g. because it was damaged.
+        \param  location    the location of the tile
+    */
+    void invalidateGround(const Coord& location) { groundChanges_.mark(location.x, location.y); }
+
+    /**
+        Returns the tiles that were damaged or cleared since the changed parts of the screen were collected the last
+        time. Only the partial redraw of the screen uses the set and clears it afterwards.
+        \return the changed tiles
+    */
+    dune::DirtyTiles& collectGroundChanges() noexcept { return groundChanges_; }
+
+    /**
+        Returns the tiles that may have been explored, become visible again or become fogged since the fog overlay of
+        the map view was updated the last time. The overlay clears the set after updating.
+        \param  gameCycleCount  the current game cycle
+        \return the changed tiles
+    */
+    dune::DirtyTiles& collectFogChanges(uint32_t gameCycleCount) {
+        expireFog(gameCycleCount);
+        return fogChanges_;
+    }
+
     bool findSpice(Coord& destination, const Coord& origin);
     bool okayToPlaceStructure(int x, int y, int buildingSizeX, int buildingSizeY, bool tilesRequired,
                               const House* pHouse, bool bIgnoreUnits = false) const;
@@ -609,6 +670,15 @@ private:
     std::unique_ptr<BoxOffsets> offsets_3x3_;
 
     void init_box_sets();
+
+    void expireFog(uint32_t gameCycleCount);
+
+    dune::DirtyTiles radarChanges_;             ///< the tiles whose radar color may have changed
+    dune::DirtyTiles terrainChanges_;           ///< the tiles whose terrain may have changed
+    dune::DirtyTiles groundChanges_;            ///< the tiles whose damage may have changed
+    dune::DirtyTiles fogChanges_;               ///< the tiles whose explored or fogged state may have changed
+    std::vector<std::vector<int>> fogExpiry_;   ///< per time slot the tiles seen; they may be fogged FOGTIME later
+    uint32_t fogExpirySlot_{INVALID_GAMECYCLE}; ///< the first time slot in fogExpiry_ that was not checked yet
 };
 
 #endif // MAP_H
@@ -0,0 +1,152 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPCHUNKCACHE_H
+#define MAPCHUNKCACHE_H
+
+#include <DataTypes.h>
+
+#include <Renderer/DuneSpriteBatch.h>
+#include <misc/DirtyTiles.h>
+#include <misc/SDL2pp.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+class ScreenBorder;
+
+/**
+    Caches a layer of the map view that rarely changes (e.g. the terrain) in textures of chunk_size x chunk_size tiles.
+    A chunk is only rendered again when one of its tiles (or one of their neighbors) was invalidated or the zoom level
+    changed; otherwise drawing the layer costs one copy per visible chunk. Only the chunks of the current zoom level
+    are kept and chunks that were not visible for a while are released when the cache grows too large.
+*/
+class MapChunkCache final {
+public:
+    static constexpr int chunk_size = 16; ///< the width and height of a chunk in tiles
+
+    /**
+        Constructor
+        \param  blendMode   the blend mode used for drawing the chunks to the screen
+    */
+    explicit MapChunkCache(SDL_BlendMode blendMode);
+    ~MapChunkCache();
+
+    MapChunkCache(const MapChunkCache&)            = delete;
+    MapChunkCache(MapChunkCache&&)                 = delete;
+    MapChunkCache& operator=(const MapChunkCache&) = delete;
+    MapChunkCache& operator=(MapChunkCache&&)      = delete;
+
+    /**
+        Marks the chunks that show one of the changed tiles or one of their neighbors for rendering and clears changes.
+        If the size of changes does not match the cache, the cache is reset to the new map size.
+        \param  changes the changed tiles
+    */
+    void invalidate(dune::DirtyTiles& changes);
+
+    /// Marks every chunk for rendering
+    void invalidateAll();
+
+    /// Releases all textures, e.g. after the render device was reset
+    void release();
+
+    /**
+        Draws the chunks that show the tiles between topLeftTile and bottomRightTile (inclusive). Chunks that are not up
+        to date are rendered first by calling renderChunk(tiles) with the render target set to the chunk texture; a
+        tile at (x, y) has to be drawn at ((x - tiles.x) * zoomedTileSize, (y - tiles.y) * zoomedTileSize). If
+        renderChunk returns a bool, false means that nothing was drawn and the chunk is skipped until it changes.
+        \param  renderer        the renderer
+        \param  screenborder    the current view onto the map
+        \param  topLeftTile     the top left tile that is visible
+        \param  bottomRightTile the bottom right tile that is visible
+        \param  renderChunk     renders the tiles of a chunk, is called with the chunk rectangle in tiles
+    */
+    template<typename RenderChunk>
+    void draw(SDL_Renderer* renderer, const ScreenBorder& screenborder, const Coord& topLeftTile,
+              const Coord& bottomRightTile, RenderChunk&& renderChunk) {
+        if (chunksX_ == 0 || chunksY_ == 0)
+            return;
+
+        beginFrame();
+
+        const auto cx1 = std::max(0, topLeftTile.x / chunk_size);
+        const auto cy1 = std::max(0, topLeftTile.y / chunk_size);
+        const auto cx2 = std::min(chunksX_ - 1, bottomRightTile.x / chunk_size);
+        const auto cy2 = std::min(chunksY_ - 1, bottomRightTile.y / chunk_size);
+
+        for (auto cy = cy1; cy <= cy2; ++cy) {
+            for (auto cx = cx1; cx <= cx2; ++cx) {
+                auto& chunk = chunks_[cy * chunksX_ + cx];
+
+                if (chunk.dirty || !chunk.texture) {
+                    const auto tiles = chunkTiles(cx, cy);
+
+                    if (!beginChunk(renderer, chunk, tiles))
+                        continue;
+
+                    if constexpr (std::is_same_v<std::invoke_result_t<RenderChunk, const SDL_Rect&>, bool>) {
+                        chunk.empty = !renderChunk(tiles);
+                    } else {
+                        renderChunk(tiles);
+                    }
+
+                    endChunk(renderer, chunk);
+                }
+
+                drawChunk(renderer, screenborder, chunk, cx, cy);
+            }
+        }
+
+        endFrame((cx2 - cx1 + 1) * (cy2 - cy1 + 1));
+    }
+
+private:
+    struct Chunk {
+        sdl2::texture_ptr texture;
+        bool dirty        = true;
+        bool empty        = false; ///< nothing was drawn to the texture
+        uint32_t lastUsed = 0;     ///< the frame the chunk was drawn the last time
+    };
+
+    [[nodiscard]] SDL_Rect chunkTiles(int cx, int cy) const noexcept;
+
+    void beginFrame();
+    void endFrame(int visibleChunks);
+
+    bool beginChunk(SDL_Renderer* renderer, Chunk& chunk, const SDL_Rect& tiles);
+    void endChunk(SDL_Renderer* renderer, Chunk& chunk);
+    void drawChunk(SDL_Renderer* renderer, const ScreenBorder& screenborder, Chunk& chunk, int cx, int cy);
+
+    SDL_BlendMode blendMode_;
+
+    int sizeX_   = 0; ///< the width of the map in tiles
+    int sizeY_   = 0; ///< the height of the map in tiles
+    int chunksX_ = 0;
+    int chunksY_ = 0;
+
+    int zoom_       = -1; ///< the zoom level the textures were rendered for
+    uint32_t frame_ = 0;
+
+    std::vector<Chunk> chunks_;
+
+    SDL_Texture* previousTarget_{}; ///< the render target before beginChunk()
+    dune::SpriteBatch batch_;       ///< batches the sprites of a chunk
+};
+
+#endif // MAPCHUNKCACHE_H
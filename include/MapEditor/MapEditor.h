@@ -137,6 +137,9 @@ public:
 
     [[nodiscard]] bool hasChangeSinceLastSave() const { return bChangedSinceLastSave_; }
 
+    /// \return a number that changes whenever the map, its items, units or structures are changed
+    [[nodiscard]] uint32_t getRevision() const noexcept { return revision_; }
+
     [[nodiscard]] std::string generateMapname();
 
     std::vector<Player>& getPlayers() { return players_; }
@@ -216,6 +219,7 @@ public:
     void addUndoOperation(std::unique_ptr<MapEditorOperation> op) {
         undoOperationStack_.push(std::move(op));
         bChangedSinceLastSave_ = true;
+        ++revision_;
     }
 
     void undoLastOperation();
@@ -256,6 +260,7 @@ private:
     bool shift_ = false;
 
     bool bChangedSinceLastSave_ = false;
+    uint32_t revision_          = 0; ///< incremented on every change
 
     EditorMode currentEditorMode_;
 
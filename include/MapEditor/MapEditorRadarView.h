@@ -20,8 +20,12 @@
 
 #include <RadarViewBase.h>
 
+#include <misc/DirtyTiles.h>
 #include <misc/SDL2pp.h>
 
+#include <cstdint>
+#include <vector>
+
 class MapEditor;
 class MapData;
 
@@ -57,12 +61,30 @@ public:
     void draw(Point position) override;
 
 private:
+    /**
+        Redraws the tiles whose color changed since the map editor's last change and uploads them to the radar texture.
+        \param  map     the map to show
+        \param  scale   the size of a tile on the radar in pixels
+        \param  offsetX the offset of the map on the radar in x direction
+        \param  offsetY the offset of the map on the radar in y direction
+    */
     void updateRadarSurface(const MapData& map, int scale, int offsetX, int offsetY);
 
+    /**
+        Calculates the color of every tile including spice fields, blooms, units and structures.
+        \param  map     the map to show
+        \return the colors (row by row)
+    */
+    [[nodiscard]] std::vector<uint32_t> calculateTileColors(const MapData& map) const;
+
     MapEditor* pMapEditor;
 
     sdl2::surface_ptr radarSurface;
     sdl2::texture_ptr radarTexture;
+
+    std::vector<uint32_t> tileColors_; ///< the color of every tile as shown on radarSurface (row by row)
+    dune::DirtyTiles changes_;         ///< the tiles that have to be redrawn
+    uint32_t drawnRevision_ = 0;       ///< the revision of the map editor radarSurface shows
 };
 
 #endif // RADARVIEW_H
@@ -62,6 +62,7 @@ private:
 
     void onReceiveChatMessage(const std::string& name, const std::string& message);
     void onPeerDisconnected(const std::string& playername, bool bHost, int cause);
+    void onSendGameDataProgress(const std::string& playername, uint32_t sentBytes, uint32_t totalBytes);
 
     void extractMapInfo(INIFile* pMap);
 
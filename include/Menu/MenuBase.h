@@ -63,6 +63,12 @@ public:
 protected:
     bool doEventsUntil(dune::dune_clock::time_point until);
 
+    /**
+        Handles the events until the next frame has to be drawn (see dune::RedrawScheduler) but at most for a second
+        \return false if the menu is quitting
+    */
+    bool waitForRedraw();
+
     virtual int showMenuImpl();
     virtual void doInputImpl(const SDL_Event& event);
 
@@ -44,6 +44,7 @@ private:
     static void onQuit();
 
     void onPeerDisconnected(const std::string& playername, bool bHost, int cause);
+    void onGameDataProgress(uint32_t receivedBytes, uint32_t totalBytes);
 
     void onGameTypeChange(int buttonID);
     void onGameListSelectionChange(bool bInteractive);
@@ -19,60 +19,105 @@
 #define ENETPACKETOSTREAM_H
 
 #include <misc/OutputStream.h>
+#include <misc/exceptions.h>
 
 #include <enet/enet.h>
 
 #include <gsl/gsl>
 
+#include <cstring>
+#include <memory>
+#include <span>
 #include <string>
+#include <vector>
+
+/**
+    A pool of buffers for outgoing ENet packets. Packets created by ENetPacketOStream::getPacket() do not copy the
+    serialized data but point into a pooled buffer (ENET_PACKET_FLAG_NO_ALLOCATE); the buffer is handed back to the
+    pool when ENet destroys the packet.
+*/
+class ENetPacketBufferPool final {
+public:
+    using buffer_type = std::vector<uint8_t>;
+
+    /**
+        Gets a buffer with at least minSize bytes from the pool or allocates a new one.
+        \param  minSize the minimum size of the buffer
+        \return the buffer
+    */
+    static std::unique_ptr<buffer_type> acquire(size_t minSize);
+
+    /**
+        Returns a buffer to the pool. Buffers that are very large or exceed the pool size are freed.
+        \param  buffer  the buffer to return
+    */
+    static void release(std::unique_ptr<buffer_type> buffer);
+
+    /**
+        Creates an ENet packet that points to buffer. The packet owns the buffer and returns it to the pool when it
+        is destroyed.
+        \param  buffer  the buffer containing the packet data
+        \param  size    the number of used bytes in buffer
+        \param  flags   the ENet packet flags
+        \return the new packet
+    */
+    static ENetPacket* createPacket(std::unique_ptr<buffer_type> buffer, size_t size, enet_uint32 flags);
+
+private:
+    static void ENET_CALLBACK onPacketDestroyed(ENetPacket* packet);
+};
 
 class ENetPacketOStream final : public OutputStream {
 public:
-    explicit ENetPacketOStream(enet_uint32 flags) : currentPos(0), packet(enet_packet_create(nullptr, 16, flags)) {
+    /**
+        Creates a new packet stream.
+        \param  flags       the ENet packet flags (e.g. ENET_PACKET_FLAG_RELIABLE)
+        \param  sizeHint    the expected size of the packet; the buffer grows if more data is written
+    */
+    explicit ENetPacketOStream(enet_uint32 flags, size_t sizeHint = 0)
+        : flags(flags), currentPos(0), buffer(ENetPacketBufferPool::acquire(sizeHint)) { }
 
-        if (packet == nullptr) {
-            THROW(OutputStream::error, "ENetPacketOStream: enet_packet_create() failed!");
-        }
-    }
-
-    ENetPacketOStream(const ENetPacketOStream& p) : currentPos(0), packet(nullptr) { *this = p; }
+    ENetPacketOStream(const ENetPacketOStream& p) : flags(p.flags), currentPos(0) { *this = p; }
 
     ~ENetPacketOStream() override {
-        if (packet != nullptr) {
-            enet_packet_destroy(packet);
+        if (buffer != nullptr) {
+            ENetPacketBufferPool::release(std::move(buffer));
         }
     }
 
     ENetPacketOStream& operator=(const ENetPacketOStream& p) {
         if (this != &p) {
-            ENetPacket* packetCopy = enet_packet_create(p.packet->data, p.packet->dataLength, p.packet->flags);
-            if (packetCopy == nullptr) {
-                THROW(InputStream::error, "ENetPacketOStream::operator=(): enet_packet_create() failed!");
-            }
+            auto bufferCopy = ENetPacketBufferPool::acquire(p.currentPos);
+            std::copy_n(p.buffer->data(), p.currentPos, bufferCopy->data());
 
-            if (packet != nullptr) {
-                enet_packet_destroy(packet);
+            if (buffer != nullptr) {
+                ENetPacketBufferPool::release(std::move(buffer));
             }
 
-            packet     = packetCopy;
+            buffer     = std::move(bufferCopy);
+            flags      = p.flags;
             currentPos = p.currentPos;
         }
 
         return *this;
     }
 
+    /**
+        Creates the ENet packet from the data written so far. The packet does not copy the data but takes over the
+        buffer of this stream, so nothing more can be written afterwards.
+        \return the packet; it must be passed to enet_peer_send() or destroyed with enet_packet_destroy()
+    */
     ENetPacket* getPacket() {
-        if (enet_packet_resize(packet, currentPos) < 0) {
-            THROW(OutputStream::error, "ENetPacketOStream::getPacket(): enet_packet_resize() failed!");
+        if (buffer == nullptr) {
+            THROW(OutputStream::error, "ENetPacketOStream::getPacket(): Packet was already taken!");
         }
 
-        ENetPacket* pPacket = packet;
-
-        packet = nullptr;
-
-        return pPacket;
+        return ENetPacketBufferPool::createPacket(std::move(buffer), currentPos, flags);
     }
 
+    /// the number of bytes written so far
+    [[nodiscard]] size_t size() const noexcept { return currentPos; }
+
     void flush() override { }
 
     // write operations
@@ -83,32 +128,35 @@ public:
         writeUint32(gsl::narrow<uint32_t>(str.length()));
 
         if (!str.empty()) {
-            memcpy(packet->data + currentPos, str.data(), str.length());
+            memcpy(buffer->data() + currentPos, str.data(), str.length());
             currentPos += str.length();
         }
     }
 
     void writeUint8(uint8_t x) override {
         ensureBufferSize(currentPos + sizeof(uint8_t));
-        packet->data[currentPos] = x;
+        (*buffer)[currentPos] = x;
         currentPos += sizeof(uint8_t);
     }
 
     void writeUint16(uint16_t x) override {
         ensureBufferSize(currentPos + sizeof(uint16_t));
-        *reinterpret_cast<uint16_t*>(packet->data + currentPos) = SDL_SwapLE16(x);
+        const uint16_t tmp = SDL_SwapLE16(x);
+        memcpy(buffer->data() + currentPos, &tmp, sizeof(uint16_t));
         currentPos += sizeof(uint16_t);
     }
 
     void writeUint32(uint32_t x) override {
         ensureBufferSize(currentPos + sizeof(uint32_t));
-        *reinterpret_cast<uint32_t*>(packet->data + currentPos) = SDL_SwapLE32(x);
+        const uint32_t tmp = SDL_SwapLE32(x);
+        memcpy(buffer->data() + currentPos, &tmp, sizeof(uint32_t));
         currentPos += sizeof(uint32_t);
     }
 
     void writeUint64(uint64_t x) override {
         ensureBufferSize(currentPos + sizeof(uint64_t));
-        *reinterpret_cast<uint64_t*>(packet->data + currentPos) = SDL_SwapLE64(x);
+        const uint64_t tmp = SDL_SwapLE64(x);
+        memcpy(buffer->data() + currentPos, &tmp, sizeof(uint64_t));
         currentPos += sizeof(uint64_t);
     }
 
@@ -120,24 +168,28 @@ public:
         writeUint32(tmp);
     }
 
-    void ensureBufferSize(size_t minBufferSize) const {
-        if (minBufferSize < packet->dataLength) {
+    void writeBytes(std::span<const uint8_t> data) override {
+        if (data.empty()) {
             return;
         }
 
-        size_t newBufferSize = packet->dataLength * 3 / 2;
-        if (newBufferSize < minBufferSize) {
-            newBufferSize = minBufferSize;
-        }
+        ensureBufferSize(currentPos + data.size());
+        memcpy(buffer->data() + currentPos, data.data(), data.size());
+        currentPos += data.size();
+    }
 
-        if (enet_packet_resize(packet, newBufferSize) < 0) {
-            THROW(OutputStream::error, "ENetPacketOStream::ensureBufferSize(): enet_packet_resize() failed!");
+    void ensureBufferSize(size_t minBufferSize) {
+        if (minBufferSize <= buffer->size()) {
+            return;
         }
+
+        buffer->resize(std::max(buffer->size() * 3 / 2, minBufferSize));
     }
 
 private:
+    enet_uint32 flags;
     size_t currentPos;
-    ENetPacket* packet;
+    std::unique_ptr<ENetPacketBufferPool::buffer_type> buffer;
 };
 
 #endif // ENETPACKETOSTREAM_H
@@ -0,0 +1,158 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAMEDATATRANSFER_H
+#define GAMEDATATRANSFER_H
+
+#include <GameInitSettings.h>
+#include <Network/ChangeEventList.h>
+
+#include <misc/InputStream.h>
+#include <misc/OutputStream.h>
+#include <misc/SDL2pp.h>
+
+#include <array>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <vector>
+
+inline constexpr uint32_t GAMEDATA_CHUNK_SIZE   = 16 * 1024;        ///< bytes of game data per chunk
+inline constexpr uint32_t GAMEDATA_MAX_REQUESTS = 4;                ///< number of chunks requested ahead
+inline constexpr uint32_t GAMEDATA_MAX_SIZE     = 64 * 1024 * 1024; ///< larger game data is rejected by the receiver
+
+/// the md5 sum of the uncompressed game data
+using GameDataHash = std::array<uint8_t, 16>;
+
+/**
+    The game data (the map or savegame in GameInitSettings::getFiledata()) prepared for sending it to joining players.
+    The data is prepared once and then sent in chunks of GAMEDATA_CHUNK_SIZE bytes on request
+    (NETWORKPACKET_GAMEDATAREQUEST/NETWORKPACKET_GAMEDATACHUNK), so it never blocks the lobby for long.
+*/
+class GameDataUpload final {
+public:
+    /**
+        Starts preparing the game data on its own thread. Maps are compressed; savegames are sent as they are,
+        because their sections are already compressed. The other methods wait for this to finish.
+        \param  filedata    the game data
+    */
+    explicit GameDataUpload(std::string filedata);
+
+    /**
+        Writes the content of a NETWORKPACKET_SENDGAMEINFO packet. The game data itself is only included if it fits
+        into a single chunk.
+        \param  stream              the stream to write to
+        \param  gameInitSettings    the settings of the game (the filedata is not written)
+        \param  changeEventList     the current lobby state for the new player
+    */
+    void writeGameInfo(OutputStream& stream, const GameInitSettings& gameInitSettings,
+                       const ChangeEventList& changeEventList) const;
+
+    /**
+        Writes the content of a NETWORKPACKET_GAMEDATACHUNK packet.
+        \param  stream  the stream to write to
+        \param  offset  the offset of the requested chunk in the compressed data
+        \return false if offset is not a valid chunk offset
+    */
+    bool writeChunk(OutputStream& stream, uint32_t offset) const;
+
+    /// the number of bytes that are sent in chunks
+    [[nodiscard]] uint32_t getTransferSize() const { return static_cast<uint32_t>(prepared_.get().data.size()); }
+
+private:
+    struct PreparedData {
+        GameDataHash hash{};
+        uint32_t size    = 0;     ///< the size of the game data
+        bool bCompressed = false; ///< data is zlib compressed
+        std::vector<uint8_t> data;
+    };
+
+    std::shared_future<PreparedData> prepared_;
+};
+
+/**
+    The receiving side of GameDataUpload. Clients that already have the game data (in the download cache or as a map or
+    savegame with the same content) do not need to download it. Partial downloads are kept in the download cache and
+    resumed when joining the same game again.
+*/
+class GameDataDownload final {
+public:
+    /**
+        Reads the content of a NETWORKPACKET_SENDGAMEINFO packet and looks for a local copy of the game data.
+        \param  stream  the packet to read from
+    */
+    explicit GameDataDownload(InputStream& stream);
+
+    GameDataDownload(const GameDataDownload&)            = delete;
+    GameDataDownload(GameDataDownload&&)                 = delete;
+    GameDataDownload& operator=(const GameDataDownload&) = delete;
+    GameDataDownload& operator=(GameDataDownload&&)      = delete;
+
+    ~GameDataDownload();
+
+    [[nodiscard]] bool isComplete() const noexcept { return bComplete_; }
+
+    /**
+        Returns the offset of the next chunk to request or nothing if GAMEDATA_MAX_REQUESTS chunks are already
+        requested or everything is requested.
+        \return the offset to put into the next NETWORKPACKET_GAMEDATAREQUEST
+    */
+    [[nodiscard]] std::optional<uint32_t> getNextRequest();
+
+    /**
+        Adds the content of a NETWORKPACKET_GAMEDATACHUNK packet. An exception is thrown if the chunk was not expected
+        or the complete data does not match the announced md5 sum.
+        \param  stream  the packet to read from
+    */
+    void addChunk(InputStream& stream);
+
+    /**
+        Change events received while downloading are collected and passed on together with the game info.
+        \param  changeEventList the received change events
+    */
+    void addChangeEventList(const ChangeEventList& changeEventList);
+
+    [[nodiscard]] uint32_t getReceivedBytes() const noexcept {
+        return bComplete_ ? compressedSize_ : static_cast<uint32_t>(compressedData_.size());
+    }
+    [[nodiscard]] uint32_t getTotalBytes() const noexcept { return compressedSize_; }
+
+    [[nodiscard]] const GameInitSettings& getGameInitSettings() const noexcept { return gameInitSettings_; }
+    [[nodiscard]] const ChangeEventList& getChangeEventList() const noexcept { return changeEventList_; }
+
+private:
+    [[nodiscard]] bool findLocalCopy();
+    void openPartFile();
+    void complete();
+
+    GameInitSettings gameInitSettings_;
+    ChangeEventList changeEventList_;
+
+    GameDataHash hash_{};
+    uint32_t size_           = 0;
+    uint32_t compressedSize_ = 0;     ///< the number of bytes sent in chunks
+    bool bCompressed_        = false; ///< the received data has to be decompressed (it is not a savegame)
+
+    std::vector<uint8_t> compressedData_; ///< the chunks received so far
+    uint32_t nextRequestOffset_ = 0;
+    bool bComplete_             = false;
+
+    std::filesystem::path cacheDirectory_; ///< empty if there is no download cache
+    sdl2::RWops_ptr partFile_;             ///< the received chunks are appended to this file for resuming
+};
+
+#endif // GAMEDATATRANSFER_H
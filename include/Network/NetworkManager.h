@@ -22,6 +22,7 @@
 #include <Network/CommandList.h>
 #include <Network/ENetPacketIStream.h>
 #include <Network/ENetPacketOStream.h>
+#include <Network/GameDataTransfer.h>
 
 #include <Network/LANGameFinderAndAnnouncer.h>
 #include <Network/MetaServerClient.h>
@@ -34,30 +35,59 @@
 
 #include <functional>
 #include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
 #include <string>
 #include <utility>
+#include <vector>
 
 inline constexpr auto NETWORKDISCONNECT_QUIT          = 1;
 inline constexpr auto NETWORKDISCONNECT_TIMEOUT       = 2;
 inline constexpr auto NETWORKDISCONNECT_PLAYER_EXISTS = 3;
 inline constexpr auto NETWORKDISCONNECT_GAME_FULL     = 4;
 
-inline constexpr auto NETWORKPACKET_UNKNOWN         = 0;
-inline constexpr auto NETWORKPACKET_CONNECT         = 1;
-inline constexpr auto NETWORKPACKET_DISCONNECT      = 2;
-inline constexpr auto NETWORKPACKET_PEER_CONNECTED  = 3;
-inline constexpr auto NETWORKPACKET_SENDGAMEINFO    = 4;
-inline constexpr auto NETWORKPACKET_SENDNAME        = 5;
-inline constexpr auto NETWORKPACKET_CHATMESSAGE     = 6;
-inline constexpr auto NETWORKPACKET_CHANGEEVENTLIST = 7;
-inline constexpr auto NETWORKPACKET_STARTGAME       = 8;
-inline constexpr auto NETWORKPACKET_COMMANDLIST     = 9;
-inline constexpr auto NETWORKPACKET_SELECTIONLIST   = 10;
+inline constexpr auto NETWORKPACKET_UNKNOWN            = 0;
+inline constexpr auto NETWORKPACKET_CONNECT            = 1;
+inline constexpr auto NETWORKPACKET_DISCONNECT         = 2;
+inline constexpr auto NETWORKPACKET_PEER_CONNECTED     = 3;
+inline constexpr auto NETWORKPACKET_SENDGAMEINFO       = 4;
+inline constexpr auto NETWORKPACKET_SENDNAME           = 5;
+inline constexpr auto NETWORKPACKET_CHATMESSAGE        = 6;
+inline constexpr auto NETWORKPACKET_CHANGEEVENTLIST    = 7;
+inline constexpr auto NETWORKPACKET_STARTGAME          = 8;
+inline constexpr auto NETWORKPACKET_COMMANDLIST        = 9;
+inline constexpr auto NETWORKPACKET_SELECTIONLIST      = 10;
+inline constexpr auto NETWORKPACKET_RELAYED            = 11;
+inline constexpr auto NETWORKPACKET_RELAYPEERS         = 12;
+inline constexpr auto NETWORKPACKET_SELECTIONLISTDELTA = 13;
+inline constexpr auto NETWORKPACKET_GAMEDATAREQUEST    = 14;
+inline constexpr auto NETWORKPACKET_GAMEDATACHUNK      = 15;
+inline constexpr auto NETWORKPACKET_GAMEDATACOMPLETE   = 16;
 
 inline constexpr auto AWAITING_CONNECTION_TIMEOUT = dune::as_dune_clock_duration(5000);
 
 class GameInitSettings;
 
+/**
+    Artificial network conditions that are applied to all outgoing packets of a NetworkManager. This is meant for
+    testing and benchmarking the lockstep behaviour on a single machine and is disabled by default.
+*/
+struct SimulatedNetworkConditions {
+    dune::dune_clock::duration latency{}; ///< one-way delay added to every outgoing packet
+    dune::dune_clock::duration jitter{};  ///< maximum random delay added on top of latency
+    float packetLoss = 0.0f;              ///< probability (0 to 1) that an outgoing packet is lost
+    uint32_t seed    = 0;                 ///< seed for the random loss and jitter
+
+    /// the time the delays are measured in (e.g. a simulated clock of a test); dune_clock::now() if empty
+    std::function<dune::dune_clock::time_point()> clock;
+
+    [[nodiscard]] bool isActive() const noexcept {
+        return latency.count() > 0 || jitter.count() > 0 || packetLoss > 0.0f;
+    }
+};
+
 class NetworkManager {
 public:
     NetworkManager(uint16_t port, std::string metaserver);
@@ -70,6 +100,8 @@ public:
 
     [[nodiscard]] bool isServer() const noexcept { return bIsServer_; }
 
+    [[nodiscard]] bool isRelayed() const noexcept { return bRelayed_; }
+
     void startServer(bool bLANServer, std::string serverName, std::string playerName,
                      GameInitSettings* pGameInitSettings, int numPlayers, int maxPlayers);
     void updateServer(int numPlayers);
@@ -90,12 +122,42 @@ public:
 
     void sendCommandList(const CommandList& commandList);
 
+    /**
+        Sends the packet created by the last call to sendCommandList() again. This saves building and serializing
+        the command list if it did not change.
+        \return true if the command list was sent, false if there is no previous command list
+    */
+    bool resendCommandList();
+
+    /**
+        Sends the current selection (groupListIndex = -1) or a group assignment to all peers. Only the changes
+        since the last call with the same groupListIndex are sent unless the complete list is smaller.
+        \param  selectedList    the selected objects
+        \param  groupListIndex  the group index or -1 for the current selection
+    */
     void sendSelectedList(const dune::selected_set_type& selectedList, int groupListIndex = -1);
 
     [[nodiscard]] std::vector<std::string> getConnectedPeers() const;
 
     [[nodiscard]] int getMaxPeerRoundTripTime() const;
 
+    /// the UDP port this network manager is bound to (useful if it was created with port 0)
+    [[nodiscard]] uint16_t getPort() const noexcept { return host_->address.port; }
+
+    /// number of bytes sent over the wire so far (after compression, including ENet protocol overhead)
+    [[nodiscard]] uint32_t getTotalSentBytes() const noexcept { return host_->totalSentData; }
+
+    /// number of bytes received over the wire so far (after compression, including ENet protocol overhead)
+    [[nodiscard]] uint32_t getTotalReceivedBytes() const noexcept { return host_->totalReceivedData; }
+
+    /**
+        Simulate a bad network connection for all packets sent from now on. Unreliable packets are dropped with
+        probability packetLoss; reliable packets are never dropped but delayed by an additional round trip, like
+        a retransmit would do.
+        \param  conditions  the conditions to simulate; pass a default constructed object to disable the simulation
+    */
+    void setSimulatedNetworkConditions(const SimulatedNetworkConditions& conditions);
+
     LANGameFinderAndAnnouncer* getLANGameFinderAndAnnouncer() const { return pLANGameFinderAndAnnouncer_.get(); }
 
     MetaServerClient* getMetaServerClient() const { return pMetaServerClient_.get(); }
@@ -116,6 +178,25 @@ public:
         this->pOnReceiveGameInfo_ = std::move(pOnReceiveGameInfo);
     }
 
+    /**
+        Sets the function that should be called while the game data (map or savegame) is downloaded after connecting
+        to the server. The game info is passed to the function set by setOnReceiveGameInfo() when the download is
+        complete.
+        \param  pOnGameDataProgress function to call with the received and the total number of bytes
+    */
+    void setOnGameDataProgress(std::function<void(uint32_t, uint32_t)> pOnGameDataProgress) {
+        this->pOnGameDataProgress_ = std::move(pOnGameDataProgress);
+    }
+
+    /**
+        Sets the function that should be called when a chunk of the game data was sent to a joining player.
+        \param  pOnSendGameDataProgress function to call with the player name, the sent and the total number of bytes
+    */
+    void setOnSendGameDataProgress(
+        std::function<void(const std::string&, uint32_t, uint32_t)> pOnSendGameDataProgress) {
+        this->pOnSendGameDataProgress_ = std::move(pOnSendGameDataProgress);
+    }
+
     /**
         Sets the function that should be called when a change event is received.
         \param  pOnReceiveChangeEventList   function to call on receive
@@ -174,12 +255,30 @@ private:
 
     void sendPacketToHost(ENetPacketOStream& packetStream, int channel = 0);
 
-    static void sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetStream, int channel = 0);
+    void sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetStream, int channel = 0);
 
     void sendPacketToAllConnectedPeers(ENetPacketOStream& packetStream, int channel = 0);
 
+    void sendPacketToAllConnectedPeers(ENetPacket* enetPacket, int channel = 0);
+
+    void sendPacket(ENetPeer* peer, enet_uint8 channel, ENetPacket* enetPacket);
+
+    void sendDelayedPackets();
+
     void handlePacket(ENetPeer* peer, ENetPacketIStream& packetStream);
 
+    void handleRelayedPacket(const std::string& originName, InputStream& packetStream);
+
+    void updateRelayPeers(std::vector<std::string> relayPeerNames);
+
+    void handleSelectionList(const std::string& name, InputStream& packetStream, bool bDelta);
+
+    void sendGameInfo(ENetPeer* peer, const ChangeEventList& changeEventList);
+
+    void requestGameData();
+
+    void finishGameDataDownload();
+
     class PeerData {
     public:
         enum class PeerState {
@@ -216,8 +315,26 @@ private:
 
     std::list<ENetPeer*> awaitingConnectionList_;
 
+    /// the selection lists last sent to all peers, by group index
+    std::map<int, dune::selected_set_type> sentSelectionLists_;
+    bool bResendSelectionLists_ = false; ///< a peer (re)connected, so the next lists must be sent in full
+    /// the selection lists last received, by player name and group index
+    std::map<std::pair<std::string, int>, dune::selected_set_type> receivedSelectionLists_;
+
+    ENetPacket* pLastCommandListPacket_ = nullptr; ///< the last sent command list; we hold one reference on it
+
+    std::unique_ptr<GameDataUpload> pGameDataUpload_;     ///< created when starting the server
+    std::unique_ptr<GameDataDownload> pGameDataDownload_; ///< the game data we are currently receiving
+    /// a start game message received while downloading the game data
+    std::optional<dune::dune_clock::time_point> pendingStartGameTime_;
+
+    bool bRelayed_ = false;                     ///< connected to a dedicated relay server instead of a player host
+    std::vector<std::string> relayPeerNames_{}; ///< all players in the game as last reported by the relay server
+
     std::function<void(const std::string&, const std::string&)> pOnReceiveChatMessage_;
     std::function<void(const GameInitSettings&, const ChangeEventList&)> pOnReceiveGameInfo_;
+    std::function<void(uint32_t, uint32_t)> pOnGameDataProgress_;
+    std::function<void(const std::string&, uint32_t, uint32_t)> pOnSendGameDataProgress_;
     std::function<void(const ChangeEventList&)> pOnReceiveChangeEventList_;
     std::function<void(const std::string&, bool, uint32_t)> pOnPeerDisconnected_;
     std::function<ChangeEventList(const std::string&)> pGetChangeEventListForNewPlayerCallback_;
@@ -225,6 +342,23 @@ private:
     std::function<void(const std::string&, const CommandList&)> pOnReceiveCommandList_;
     std::function<void(const std::string&, const dune::selected_set_type&, int)> pOnReceiveSelectionList_;
 
+    /// \return the current time of the simulated network conditions
+    [[nodiscard]] dune::dune_clock::time_point simulatedNow() const {
+        return simulatedConditions_.clock ? simulatedConditions_.clock() : dune::dune_clock::now();
+    }
+
+    struct DelayedPacket {
+        dune::dune_clock::time_point sendTime;
+        enet_uint16 peerID;    ///< the index of the peer in host_->peers
+        enet_uint32 connectID; ///< identifies the connection, as the peer slot is reused after a disconnect
+        enet_uint8 channel;
+        ENetPacket* pPacket; ///< we hold one reference on this packet
+    };
+
+    SimulatedNetworkConditions simulatedConditions_{};
+    std::minstd_rand simulatedConditionsRandom_{};
+    std::vector<DelayedPacket> delayedPackets_{}; ///< packets held back by the simulated latency, ordered by sendTime
+
     std::unique_ptr<LANGameFinderAndAnnouncer> pLANGameFinderAndAnnouncer_ = nullptr;
     std::unique_ptr<MetaServerClient> pMetaServerClient_                   = nullptr;
 };
@@ -0,0 +1,143 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RELAYSERVER_H
+#define RELAYSERVER_H
+
+#include <GameInitSettings.h>
+#include <Network/ChangeEventList.h>
+#include <Network/ENetPacketOStream.h>
+#include <Network/GameDataTransfer.h>
+
+#include <misc/dune_clock.h>
+
+#include <enet/enet.h>
+
+#include <string>
+#include <vector>
+
+/**
+    A headless game host that never simulates or renders anything. Players connect to it with the normal
+    NetworkManager::connect(). Instead of building a full mesh between all players the relay server keeps the
+    lobby state, hands out GameInitSettings and ChangeEventLists and forwards chat messages, command lists
+    and selection lists between the connected players (see NETWORKPACKET_RELAYED).
+*/
+class RelayServer final {
+public:
+    /// The houses a match can be played with and whether each of them can be controlled by two players
+    struct PlayerSlots {
+        int numHouses                = 0;
+        bool multiplePlayersPerHouse = false;
+
+        /// \return the number of players that can join a match
+        [[nodiscard]] int getMaxPlayers() const noexcept { return multiplePlayersPerHouse ? 2 * numHouses : numHouses; }
+    };
+
+    /**
+        Reads the houses of the map or multiplayer savegame a match is played with, like the lobby does.
+        \param  gameInitSettings    the settings of the match
+        \return the houses of the match
+    */
+    static PlayerSlots readPlayerSlots(const GameInitSettings& gameInitSettings);
+
+    /**
+        Creates a relay server listening on the given port.
+        \param  port                the UDP port to listen on
+        \param  gameInitSettings    the settings (map or savegame) every match on this server is played with
+        \param  maxPlayers          the number of human players; the match is started as soon as all of them
+                                    joined and received the game data. It must not exceed the player slots of the
+                                    map (see readPlayerSlots()).
+    */
+    RelayServer(uint16_t port, GameInitSettings gameInitSettings, int maxPlayers);
+    RelayServer(const RelayServer&) = delete;
+    RelayServer(RelayServer&&)      = delete;
+    ~RelayServer();
+
+    RelayServer& operator=(const RelayServer&) = delete;
+    RelayServer& operator=(RelayServer&&)      = delete;
+
+    /**
+        Handles all pending network events. This method never blocks.
+    */
+    void update();
+
+    [[nodiscard]] ENetSocket getSocket() const noexcept { return host_->socket; }
+    [[nodiscard]] uint16_t getPort() const noexcept { return host_->address.port; }
+
+    [[nodiscard]] int getNumPlayers() const noexcept;
+    [[nodiscard]] bool isGameStarted() const noexcept { return bGameStarted_; }
+
+private:
+    template<typename... Args>
+    void debugNetwork(fmt::format_string<Args...> format, Args&&... args) {
+        sdl2::log_info(format, std::forward<Args>(args)...);
+    }
+
+    class ClientData {
+    public:
+        enum class ClientState { WaitingForName, Connected };
+
+        explicit ClientData(ENetPeer* pPeer) : pPeer_(pPeer) { }
+
+        ENetPeer* pPeer_;
+
+        ClientState clientState_ = ClientState::WaitingForName;
+        dune::dune_clock::time_point timeout_{};
+
+        std::string name_;
+        int slot_          = -1;
+        bool bHasGameData_ = false; ///< the player has confirmed receiving the game data
+    };
+
+    void resetLobby();
+
+    void onConnect(ENetPeer* peer);
+    void onDisconnect(ENetPeer* peer, uint32_t cause);
+    void onReceive(ENetPeer* peer, ENetPacket* packet, enet_uint8 channel);
+
+    void onReceiveName(ClientData& clientData, std::string name);
+    void onReceiveChangeEventList(const ClientData& clientData, ChangeEventList changeEventList);
+
+    void relayPacket(const ClientData& clientData, const ENetPacket* packet, enet_uint8 channel);
+
+    void addLobbyEvent(const ChangeEventList::ChangeEvent& changeEvent);
+
+    [[nodiscard]] int findFreeSlot() const;
+    [[nodiscard]] bool isValidSlot(const ChangeEventList::ChangeEvent& changeEvent) const noexcept;
+
+    void sendPeerList();
+    void startGameIfReady();
+    void sendStartGame();
+
+    static void sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetStream, enet_uint8 channel = 0);
+    void sendPacketToAllClients(ENetPacketOStream& packetStream, enet_uint8 channel = 0,
+                                const ENetPeer* pExcept = nullptr);
+
+    ENetHost* host_ = nullptr;
+
+    const GameInitSettings templateGameInitSettings_; ///< settings without random seed; copied for every match
+    const GameDataUpload gameDataUpload_;             ///< the compressed game data, sent to players on request
+    GameInitSettings gameInitSettings_;               ///< settings for the current match
+    const PlayerSlots playerSlots_;                   ///< the houses on the map of every match
+    const int maxPlayers_;
+
+    std::vector<ENetPeer*> clients_;                              ///< all peers in state ClientState::Connected
+    std::vector<ChangeEventList::ChangeEvent> lobbyEvents_;       ///< accumulated lobby state
+    bool bGameStarted_ = false;
+};
+
+#endif // RELAYSERVER_H
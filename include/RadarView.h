@@ -24,6 +24,9 @@
 
 #include <misc/SDL2pp.h>
 
+class House;
+class Map;
+
 /// This class manages the mini map at the top right corner of the screen
 class RadarView final : public RadarViewBase {
 public:
@@ -85,7 +88,13 @@ public:
 private:
     enum class RadarMode { RadarOff, RadarOn, AnimationRadarOff, AnimationRadarOn };
 
-    void updateRadarSurface(int scale, int offsetX, int offsetY) const;
+    /**
+        Redraws the tiles whose radar color changed since the last call and uploads them to the radar texture.
+        \param  scale       the size of a tile on the radar in pixels
+        \param  offsetX     the offset of the map on the radar in x direction
+        \param  offsetY     the offset of the map on the radar in y direction
+    */
+    void updateRadarSurface(int scale, int offsetX, int offsetY);
 
     RadarMode currentRadarMode; ///< the current mode of the radar
 
@@ -96,6 +105,11 @@ private:
     sdl2::surface_ptr radarSurface;          ///< contains the image to be drawn when the radar is active
     sdl2::texture_ptr radarTexture;          ///< streaming texture to be used when the radar is active
     const DuneTexture* radarStaticAnimation; ///< holds the animation graphic for radar static
+
+    const Map* drawnMap_     = nullptr; ///< the map radarSurface shows
+    const House* drawnHouse_ = nullptr; ///< the house whose view radarSurface shows
+    bool drawnRadarOn_       = false;   ///< was the radar on when radarSurface was drawn?
+    bool drawnDebug_         = false;   ///< was debug mode on when radarSurface was drawn?
 };
 
 #endif // RADARVIEW_H
@@ -22,6 +22,10 @@
 
 #include <DataTypes.h>
 
+#include <misc/DirtyTiles.h>
+#include <misc/SDL2pp.h>
+
+#include <cstddef>
 #include <functional>
 
 inline constexpr auto NUM_STATIC_FRAMES     = 21;
@@ -132,6 +136,62 @@ public:
     void setOnRadarClick(std::function<bool(Coord, bool, bool)> pOnRadarClick) { this->pOnRadarClick = std::move(pOnRadarClick); }
 
 protected:
+    /**
+        Redraws the changed tiles on the radar surface and uploads the changed parts of the surface to the radar
+        texture.
+        \param  surface     the radar surface (32 bit per pixel)
+        \param  texture     the streaming texture the radar surface is shown with
+        \param  changes     the tiles to redraw
+        \param  scale       the size of a tile on the radar in pixels
+        \param  offsetX     the offset of the map on the radar in x direction
+        \param  offsetY     the offset of the map on the radar in y direction
+        \param  getColor    returns the color (in the format of surface) of the tile at (x, y)
+    */
+    template<typename GetColor>
+    static void updateRadarTiles(SDL_Surface* surface, SDL_Texture* texture, const dune::DirtyTiles& changes,
+                                 int scale, int offsetX, int offsetY, GetColor&& getColor) {
+        if (changes.empty())
+            return;
+
+        {
+            sdl2::surface_lock lock{surface};
+
+            const auto pitch   = static_cast<ptrdiff_t>(surface->pitch);
+            auto* const pixels = static_cast<uint8_t*>(surface->pixels) + offsetY * pitch;
+
+            changes.for_each([&](int x, int y) {
+                const uint32_t color = getColor(x, y);
+
+                auto* const RESTRICT out = pixels + pitch * scale * y;
+
+                const auto offset = offsetX + scale * x;
+
+                for (auto j = 0; j < scale; j++) {
+                    auto* p = reinterpret_cast<uint32_t*>(out + j * pitch) + offset;
+
+                    for (auto i = 0; i < scale; ++i, ++p) {
+                        // Do not use putPixel here to avoid overhead
+                        *p = color;
+                    }
+                }
+            });
+        }
+
+        uploadRadarChanges(surface, texture, changes, scale, offsetX, offsetY);
+    }
+
+    /**
+        Uploads the bounding rectangles of the changed tiles from the radar surface to the radar texture.
+        \param  surface     the radar surface
+        \param  texture     the streaming texture the radar surface is shown with
+        \param  changes     the changed tiles
+        \param  scale       the size of a tile on the radar in pixels
+        \param  offsetX     the offset of the map on the radar in x direction
+        \param  offsetY     the offset of the map on the radar in y direction
+    */
+    static void uploadRadarChanges(SDL_Surface* surface, SDL_Texture* texture, const dune::DirtyTiles& changes,
+                                   int scale, int offsetX, int offsetY);
+
     std::function<bool(Coord, bool, bool)>
         pOnRadarClick; ///< this function is called when the user clicks on the radar (1st parameter is world
                        ///< coordinate; 2nd parameter is whether the right mouse button was pressed; 3rd parameter is
@@ -0,0 +1,161 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DUNERENDERSTATS_H
+#define DUNERENDERSTATS_H
+
+#include "DuneSpriteBatch.h"
+
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace dune {
+
+/// The parts of the screen the render statistics are collected for
+enum class RenderLayer { Ground, Structures, Units, Bullets, Fog, GUI, Count };
+
+inline constexpr auto NUM_RENDER_LAYERS = static_cast<size_t>(RenderLayer::Count);
+
+/// \return the name of layer
+std::string_view to_string(RenderLayer layer) noexcept;
+
+/// What was drawn to one layer during a frame
+struct RenderLayerStats {
+    int copies           = 0; ///< the number of textured rectangles drawn
+    int draw_calls       = 0; ///< the number of calls submitted to SDL (a sprite batch is a single call)
+    int texture_switches = 0; ///< how often a copy used a different texture than the copy before
+    int state_changes    = 0; ///< the number of blend mode and alpha modulation changes
+    int64_t pixels       = 0; ///< the number of pixels covered, counting overdraw
+};
+
+using RenderFrameStats = std::array<RenderLayerStats, NUM_RENDER_LAYERS>;
+
+/**
+    Counts what is drawn per frame and layer. The counters are only updated while the statistics are enabled (e.g.
+    while the FPS overlay is shown), so the Dune_Render* functions cost a single branch otherwise. The statistics of a
+    frame become available when Dune_RenderPresent() is called and can be appended to a CSV file, one line per layer
+    and frame.
+*/
+class RenderStats final {
+public:
+    RenderStats() = delete;
+
+    [[nodiscard]] static bool enabled() noexcept { return enabled_; }
+
+    /**
+        Starts or stops collecting statistics. The statistics of the last frame are cleared.
+        \param  enable  true to collect statistics
+    */
+    static void enable(bool enable);
+
+    [[nodiscard]] static RenderLayer layer() noexcept { return layer_; }
+    static void setLayer(RenderLayer layer) noexcept { layer_ = layer; }
+
+    /**
+        Counts a textured rectangle.
+        \param  renderer    the renderer (used if dest is nullptr)
+        \param  texture     the texture that is drawn
+        \param  dest        the destination rectangle or nullptr for the whole render target
+        \param  batched     true if the copy is submitted later as part of a sprite batch
+    */
+    static void countCopy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_FRect* dest, bool batched = false) {
+        if (enabled_)
+            countCopyImpl(renderer, texture, dest, batched);
+    }
+
+    /**
+        Counts a call to SDL that draws something, e.g. lines or a sprite batch.
+        \param  pixels  the number of pixels covered if they are known
+    */
+    static void countDrawCall(int64_t pixels = 0) noexcept {
+        if (!enabled_)
+            return;
+
+        auto& stats = current_[static_cast<size_t>(layer_)];
+        ++stats.draw_calls;
+        stats.pixels += pixels;
+    }
+
+    /// Counts a change of a blend mode or of the alpha modulation of a texture
+    static void countStateChange() noexcept {
+        if (enabled_)
+            ++current_[static_cast<size_t>(layer_)].state_changes;
+    }
+
+    /// Finishes the current frame; called by Dune_RenderPresent()
+    static void endFrame();
+
+    /// \return the statistics of the last completed frame
+    [[nodiscard]] static const RenderFrameStats& lastFrame() noexcept { return last_; }
+
+    /**
+        Appends the statistics of every following frame to a CSV file. Enables the statistics.
+        \param  path    the file to write to; it is truncated
+        \return true on success
+    */
+    static bool startDump(const std::filesystem::path& path);
+
+    /// Stops writing the statistics to a file
+    static void stopDump();
+
+    [[nodiscard]] static bool dumping() noexcept;
+
+private:
+    static void countCopyImpl(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_FRect* dest, bool batched);
+
+    static inline bool enabled_         = false;
+    static inline RenderLayer layer_    = RenderLayer::GUI;
+    static inline SDL_Texture* texture_ = nullptr; ///< the texture of the last copy
+    static inline RenderFrameStats current_{};
+    static inline RenderFrameStats last_{};
+};
+
+/**
+    Attributes everything drawn during the lifetime of this object to a layer. The sprites queued in a sprite batch are
+    drawn whenever the layer changes, so that they are counted for the right layer.
+*/
+class RenderLayerScope final {
+public:
+    explicit RenderLayerScope(RenderLayer layer) : previous_{RenderStats::layer()} { change(layer); }
+    ~RenderLayerScope() { change(previous_); }
+
+    RenderLayerScope(const RenderLayerScope&)            = delete;
+    RenderLayerScope(RenderLayerScope&&)                 = delete;
+    RenderLayerScope& operator=(const RenderLayerScope&) = delete;
+    RenderLayerScope& operator=(RenderLayerScope&&)      = delete;
+
+    /**
+        Attributes everything drawn from now on to another layer.
+        \param  layer   the new layer
+    */
+    void change(RenderLayer layer) {
+        flush_sprites();
+        RenderStats::setLayer(layer);
+    }
+
+private:
+    RenderLayer previous_;
+};
+
+} // namespace dune
+
+#endif // DUNERENDERSTATS_H
@@ -2,6 +2,8 @@
 #define DUNERENDERER_H
 
 #include "Colors.h"
+#include "DuneRenderStats.h"
+#include "DuneSpriteBatch.h"
 #include "DuneTexture.h"
 
 #include <SDL2/SDL.h>
@@ -22,21 +24,56 @@ extern int render_presents;
 extern bool render_dump;
 extern std::map<SDL_Texture*, int> render_textures;
 
-void countRenderCopy(SDL_Texture* texture);
+void countRenderTexture(SDL_Texture* texture);
 } // namespace DuneRendererImplementation
 
 void Dune_RenderDump();
-#else // DEBUG
-namespace DuneRendererImplementation {
-inline void countRenderCopy(SDL_Texture* texture) { }
-} // namespace DuneRendererImplementation
+#endif // _DEBUG
 
+namespace DuneRendererImplementation {
+/**
+    Counts a copy of texture to dstrect for the render statistics.
+    \param  batched true if the copy is part of a sprite batch and not submitted on its own
+*/
+inline void
+countRenderCopy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_FRect* dstrect, bool batched = false) {
+#if _DEBUG
+    countRenderTexture(texture);
 #endif // _DEBUG
 
+    dune::RenderStats::countCopy(renderer, texture, dstrect, batched);
+}
+
+inline void
+countRenderCopy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* dstrect, bool batched = false) {
+    if (!dune::RenderStats::enabled() || !dstrect) {
+        countRenderCopy(renderer, texture, static_cast<const SDL_FRect*>(nullptr), batched);
+        return;
+    }
+
+    const SDL_FRect dest{static_cast<float>(dstrect->x), static_cast<float>(dstrect->y),
+                         static_cast<float>(dstrect->w), static_cast<float>(dstrect->h)};
+    countRenderCopy(renderer, texture, &dest, batched);
+}
+/// \return the number of pixels covered by rects if the render statistics are enabled
+template<typename Rects>
+int64_t coveredPixels(const Rects& rects) noexcept {
+    if (!dune::RenderStats::enabled())
+        return 0;
+
+    auto pixels = 0.f;
+    for (const auto& rect : rects)
+        pixels += rect.w * rect.h;
+
+    return static_cast<int64_t>(pixels);
+}
+} // namespace DuneRendererImplementation
+
 inline int
 Dune_RenderCopyEx(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* srcrect, const SDL_Rect* dstrect,
                   const double angle, const SDL_Point* center, const SDL_RendererFlip flip) {
-    DuneRendererImplementation::countRenderCopy(texture);
+    dune::flush_sprites();
+    DuneRendererImplementation::countRenderCopy(renderer, texture, dstrect);
 
     return SDL_RenderCopyEx(renderer, texture, srcrect, dstrect, angle, center, flip);
 }
@@ -44,7 +81,8 @@ Dune_RenderCopyEx(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect*
 inline int
 Dune_RenderCopyExF(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* srcrect, const SDL_FRect* dstrect,
                    const double angle, const SDL_FPoint* center, const SDL_RendererFlip flip) {
-    DuneRendererImplementation::countRenderCopy(texture);
+    dune::flush_sprites();
+    DuneRendererImplementation::countRenderCopy(renderer, texture, dstrect);
 
     return SDL_RenderCopyExF(renderer, texture, srcrect, dstrect, angle, center, flip);
 }
@@ -62,26 +100,39 @@ void Dune_RenderCopy(SDL_Renderer* renderer, const DuneTexture* texture, const S
 void Dune_RenderCopyF(SDL_Renderer* renderer, const DuneTexture* texture, const SDL_Rect* srcrect,
                       const SDL_FRect* dstrect);
 
+/**
+    Draws texture translucently. Inside a dune::SpriteBatch the alpha value is passed with the vertices, otherwise the
+    alpha modulation of the texture is changed temporarily.
+*/
+void Dune_RenderCopyF(SDL_Renderer* renderer, const DuneTexture* texture, const SDL_Rect* srcrect,
+                      const SDL_FRect* dstrect, uint8_t alpha);
+
 void Dune_RenderCopy(SDL_Renderer* renderer, SDL_Texture* texture, int x, int y);
 
 inline void
 Dune_RenderCopy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* srcrect, const SDL_Rect* dstrect) {
-    DuneRendererImplementation::countRenderCopy(texture);
+    dune::flush_sprites();
+    DuneRendererImplementation::countRenderCopy(renderer, texture, dstrect);
 
     SDL_RenderCopy(renderer, texture, srcrect, dstrect);
 }
 
 inline void
 Dune_RenderCopyF(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* srcrect, const SDL_FRect* dstrect) {
-    DuneRendererImplementation::countRenderCopy(texture);
+    dune::flush_sprites();
+    DuneRendererImplementation::countRenderCopy(renderer, texture, dstrect);
 
     SDL_RenderCopyF(renderer, texture, srcrect, dstrect);
 }
 
-inline void Dune_RenderPresent(SDL_Renderer* renderer) {
-#if _DEBUG
-    using namespace DuneRendererImplementation;
+namespace DuneRendererImplementation {
+/// Submits the queued sprites and finishes the statistics of the frame before it is presented
+inline void endFrame() {
+    dune::flush_sprites();
 
+    dune::RenderStats::endFrame();
+
+#if _DEBUG
     if (render_dump)
         Dune_RenderDump();
 
@@ -92,12 +143,66 @@ inline void Dune_RenderPresent(SDL_Renderer* renderer) {
 
     render_texture = nullptr;
 #endif // _DEBUG
+}
+} // namespace DuneRendererImplementation
+
+inline void Dune_RenderPresent(SDL_Renderer* renderer) {
+    DuneRendererImplementation::endFrame();
 
     SDL_RenderPresent(renderer);
 
     dune::destroy_textures();
 }
 
+/**
+    Presents only the parts rects of the screen, the rest of the window keeps what was presented before. This only works
+    with the software renderer, which draws directly to the window surface; other renderers present the whole screen.
+    \param  renderer    the renderer to present
+    \param  rects       the changed parts of the screen in render coordinates, empty rectangles are ignored
+*/
+void Dune_RenderPresentRects(SDL_Renderer* renderer, std::span<const SDL_Rect> rects);
+
+/// \return true if renderer is SDL's software renderer
+bool Dune_RenderIsSoftware(SDL_Renderer* renderer);
+
+/**
+    Sets the clip rectangle of renderer. While a frame clip is set (see dune::setFrameClip()) and renderer draws to the
+    screen, rect is intersected with the frame clip and nullptr selects the frame clip.
+*/
+int Dune_RenderSetClipRect(SDL_Renderer* renderer, const SDL_Rect* rect);
+
+/// Changes the alpha modulation of texture after drawing the queued sprites
+inline int Dune_SetTextureAlphaMod(SDL_Texture* texture, uint8_t alpha) {
+    dune::flush_sprites();
+    dune::RenderStats::countStateChange();
+
+    return SDL_SetTextureAlphaMod(texture, alpha);
+}
+
+/// Changes the blend mode of texture after drawing the queued sprites
+inline int Dune_SetTextureBlendMode(SDL_Texture* texture, SDL_BlendMode blendMode) {
+    dune::flush_sprites();
+    dune::RenderStats::countStateChange();
+
+    return SDL_SetTextureBlendMode(texture, blendMode);
+}
+
+/// Changes the blend mode for drawing lines and rectangles after drawing the queued sprites
+inline int Dune_SetRenderDrawBlendMode(SDL_Renderer* renderer, SDL_BlendMode blendMode) {
+    dune::flush_sprites();
+    dune::RenderStats::countStateChange();
+
+    return SDL_SetRenderDrawBlendMode(renderer, blendMode);
+}
+
+/// Changes the color for drawing lines and rectangles and for clearing after drawing the queued sprites
+inline int Dune_SetRenderDrawColor(SDL_Renderer* renderer, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    dune::flush_sprites();
+    dune::RenderStats::countStateChange();
+
+    return SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
 void DuneDrawSelectionBox(SDL_Renderer* renderer, float x, float y, float w, float h, Uint32 color = COLOR_WHITE);
 
 inline void DuneDrawSelectionBox(SDL_Renderer* renderer, const SDL_Rect& rect, Uint32 color = COLOR_WHITE) {
@@ -109,31 +214,57 @@ inline void DuneDrawSelectionBox(SDL_Renderer* renderer, const SDL_FRect& rect,
 }
 
 inline int DuneDrawLines(SDL_Renderer* renderer, std::span<SDL_FPoint> points) {
+    dune::flush_sprites();
+    dune::RenderStats::countDrawCall();
+
     return SDL_RenderDrawLinesF(renderer, points.data(), points.size());
 }
 
 inline int DuneDrawLines(SDL_Renderer* renderer, std::initializer_list<const SDL_FPoint> points) {
+    dune::flush_sprites();
+    dune::RenderStats::countDrawCall();
+
     return SDL_RenderDrawLinesF(renderer, std::data(points), points.size());
 }
 
 inline int DuneDrawRects(SDL_Renderer* renderer, std::span<SDL_FRect> rects) {
+    dune::flush_sprites();
+    dune::RenderStats::countDrawCall();
+
     return SDL_RenderDrawRectsF(renderer, rects.data(), rects.size());
 }
 
 inline int DuneDrawRects(SDL_Renderer* renderer, std::initializer_list<const SDL_FRect> rects) {
+    dune::flush_sprites();
+    dune::RenderStats::countDrawCall();
+
     return SDL_RenderDrawRectsF(renderer, std::data(rects), rects.size());
 }
 
 inline int DuneFillRects(SDL_Renderer* renderer, std::span<SDL_FRect> rects) {
+    dune::flush_sprites();
+    dune::RenderStats::countDrawCall(DuneRendererImplementation::coveredPixels(rects));
+
     return SDL_RenderFillRectsF(renderer, rects.data(), rects.size());
 }
 
 inline int DuneFillRects(SDL_Renderer* renderer, std::initializer_list<const SDL_FRect> rects) {
+    dune::flush_sprites();
+    dune::RenderStats::countDrawCall(DuneRendererImplementation::coveredPixels(rects));
+
     return SDL_RenderFillRectsF(renderer, std::data(rects), rects.size());
 }
 
 namespace dune {
 
+/**
+    Restricts everything drawn to the screen to clip until it is reset with nullptr. This is used to only redraw the
+    changed part of the screen.
+    \param  renderer    the renderer to clip
+    \param  clip        the part of the screen to draw to or nullptr to draw to the whole screen again
+*/
+void setFrameClip(SDL_Renderer* renderer, const SDL_Rect* clip);
+
 class RenderClip final {
 public:
     RenderClip(SDL_Renderer* renderer, const SDL_Rect& clip);
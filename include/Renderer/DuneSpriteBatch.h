@@ -0,0 +1,95 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DUNESPRITEBATCH_H
+#define DUNESPRITEBATCH_H
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace dune {
+
+/**
+    Collects textured quads and submits every run of quads with the same texture with a single SDL_RenderGeometry()
+    call instead of one SDL_RenderCopyF() per sprite. The alpha value of a quad is carried in its vertex colors, so no
+    SDL_SetTextureAlphaMod() calls are necessary.
+
+    Between begin() and end() Dune_RenderCopy() and Dune_RenderCopyF() of a DuneTexture add quads to the batch. All
+    other functions that draw or change the state of the renderer or of a texture must call flush_sprites() first,
+    otherwise the drawing order would change. The Dune_* and render* helpers do this already.
+*/
+class SpriteBatch final {
+public:
+    SpriteBatch();
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&)            = delete;
+    SpriteBatch(SpriteBatch&&)                 = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(SpriteBatch&&)      = delete;
+
+    /**
+        Starts collecting the sprites drawn to renderer.
+        \param  renderer    the renderer to draw to
+    */
+    void begin(SDL_Renderer* renderer);
+
+    /// Submits the remaining sprites and stops collecting
+    void end();
+
+    /**
+        Adds a sprite.
+        \param  texture the texture
+        \param  source  the part of the texture to draw (in texture coordinates)
+        \param  dest    the position on the screen
+        \param  alpha   the alpha value to draw the sprite with
+    */
+    void add(SDL_Texture* texture, const SDL_Rect& source, const SDL_FRect& dest, uint8_t alpha = 255);
+
+    /// Submits all collected sprites
+    void flush();
+
+    [[nodiscard]] SDL_Renderer* renderer() const noexcept { return renderer_; }
+
+    /// \return the batch sprites are currently added to or nullptr
+    static SpriteBatch* active() noexcept { return active_; }
+
+private:
+    SDL_Renderer* renderer_{};
+    SpriteBatch* previous_{}; ///< the batch that was active before begin()
+
+    SDL_Texture* texture_{}; ///< the texture of the collected sprites
+    float scaleX_{};         ///< 1 / width of texture_
+    float scaleY_{};         ///< 1 / height of texture_
+
+    std::vector<SDL_Vertex> vertices_; ///< four vertices per sprite
+    std::vector<int> indices_;         ///< two triangles per sprite; only grows
+
+    static inline SpriteBatch* active_ = nullptr;
+};
+
+/// Submits the sprites of the active batch (if any) before drawing something else
+inline void flush_sprites() {
+    if (auto* const batch = SpriteBatch::active())
+        batch->flush();
+}
+
+} // namespace dune
+
+#endif // DUNESPRITEBATCH_H
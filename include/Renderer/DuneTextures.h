@@ -6,17 +6,62 @@
 #include "DataTypes.h"
 #include "DuneTexture.h"
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <vector>
+
 class SurfaceLoader;
+class StreamingAtlas;
+class TextureAtlasCache;
 
 class DuneTextures final {
 public:
     ~DuneTextures();
 
-    static DuneTextures create(SDL_Renderer* renderer, SurfaceLoader* manager);
-
-    [[nodiscard]] const DuneTexture& get_object_picture(unsigned int id, HOUSETYPE house, int zoom) const {
-        return object_pictures_.at(zoom).at(id).at(static_cast<int>(house));
-    }
+    /// Returns the SurfaceLoader; it is only called when surfaces are needed, so the loader can be created lazily
+    using surface_loader_type = std::function<SurfaceLoader*()>;
+
+    /**
+        Creates the texture atlases from the surfaces of the SurfaceLoader. If a cache is given, the atlases are
+        loaded from it instead and the SurfaceLoader is not needed; a missing cache is written afterwards. Only the
+        Harkonnen object pictures are packed up front, the other houses are colored on first use from 8-bit copies of
+        the Harkonnen pictures, which are part of the cache as well.
+        \param  renderer    the renderer to create the textures for
+        \param  manager     returns the surfaces to pack
+        \param  cache       the atlas cache or nullptr
+        \return the textures
+    */
+    static DuneTextures create(SDL_Renderer* renderer, surface_loader_type manager, TextureAtlasCache* cache = nullptr);
+
+    /**
+        Returns an object picture. Pictures of houses other than Harkonnen are generated on first use and added to a
+        streaming atlas.
+        \param  id      the object picture id
+        \param  house   the house
+        \param  zoom    the zoom level
+        \return the texture; it is empty if there is no such picture
+    */
+    [[nodiscard]] const DuneTexture& get_object_picture(unsigned int id, HOUSETYPE house, int zoom) const;
+
+    /**
+        Returns an object picture for all zoom levels but only generates it for the current one. The picture is
+        remembered, so prepare_zoom_level() generates it as soon as another zoom level is selected.
+        \param  id      the object picture id
+        \param  house   the house
+        \param  zoom    the current zoom level
+        \return the textures of all zoom levels
+    */
+    [[nodiscard]] zoomable_texture get_object_pictures(unsigned int id, HOUSETYPE house, int zoom) const;
+
+    /**
+        Generates all object pictures requested by get_object_pictures() for a zoom level. This is cheap if
+        nothing new was requested since the last call.
+        \param  zoom    the zoom level that is about to be drawn
+    */
+    void prepare_zoom_level(int zoom) const;
 
     [[nodiscard]] const DuneTexture& get_small_object(unsigned int id) const { return small_details_.at(id); }
     [[nodiscard]] const DuneTexture& get_tiny_picture(unsigned int id) const { return tiny_pictures_.at(id); }
@@ -64,15 +109,28 @@ public:
     using generated_type         = std::array<DuneTexture, NUM_GENERATEDPICTURES>;
     using decoration_border_type = DecorationBorderType;
     using border_style_type      = std::array<BorderStyle, NUM_DECORATIONFRAMES>;
+    using remap_sources_type     = std::array<std::array<sdl2::surface_ptr, NUM_OBJPICS>, NUM_ZOOMLEVEL>;
 
 private:
     DuneTextures();
     DuneTextures(std::vector<sdl2::texture_ptr>&& textures, object_pictures_type&& object_pictures,
                  small_details_type&& small_details, tiny_pictures_type&& tiny_pictures, ui_graphics_type&& ui_graphics,
                  map_choice_type&& map_choice_, generated_type&& generated_pictures,
-                 decoration_border_type&& decoration_border, border_style_type&& border_style);
+                 decoration_border_type&& decoration_border, border_style_type&& border_style,
+                 remap_sources_type&& remap_sources, std::unique_ptr<StreamingAtlas>&& streaming_atlas);
+
+    /// Colors object picture id of a zoom level for all the given houses in one pass over its Harkonnen version
+    void create_object_pictures(unsigned int id, std::span<const HOUSETYPE> houses, int zoom) const;
+
+    remap_sources_type remap_sources_; ///< the 8-bit Harkonnen object pictures (see SurfaceLoader::getRemapSource())
+
+    // The object pictures are completed lazily, so they are mutable caches
+    mutable object_pictures_type object_pictures_{};
+    mutable std::unique_ptr<StreamingAtlas> streaming_atlas_;
+    mutable std::vector<std::tuple<unsigned int, HOUSETYPE>> requested_; ///< non-Harkonnen pictures in use
+    mutable std::array<size_t, NUM_ZOOMLEVEL> prepared_{};               ///< prefix of requested_ done per zoom
+    mutable std::array<std::array<bool, NUM_HOUSES>, NUM_OBJPICS> is_requested_{};
 
-    const object_pictures_type object_pictures_{};
     const small_details_type small_details_{};
     const tiny_pictures_type tiny_pictures_{};
     const ui_graphics_type ui_graphics_{};
@@ -0,0 +1,88 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXTUREATLASCACHE_H
+#define TEXTUREATLASCACHE_H
+
+#include "DuneTexture.h"
+
+#include <misc/SDL2pp.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+    Keeps the packed texture atlases of DuneTextures on disk, so later starts can upload them directly instead of
+    recoloring, scaling and packing every sprite again. A cache is only used if it was written with the same key; the
+    key has to change whenever the content of the atlases could change (game data, scaler, screen size, ...).
+*/
+class TextureAtlasCache final {
+public:
+    /// The location of one texture: the index of its atlas (-1 if there is no texture) and its rectangle in the atlas
+    struct Slot final {
+        int32_t atlas = -1;
+        DuneTextureRect rect;
+    };
+
+    struct Contents final {
+        std::vector<sdl2::surface_ptr> atlases;     ///< the pixels of the atlases
+        std::vector<Slot> slots;                    ///< the locations of all textures
+        std::vector<std::vector<SDL_Color>> colors; ///< color strips that are drawn without textures
+        std::vector<sdl2::surface_ptr> pictures;    ///< 8-bit pictures kept in main memory (nullptr for none)
+    };
+
+    /**
+        Constructor.
+        \param  filename    the file the cache is stored in
+        \param  key         describes everything the atlases depend on
+    */
+    TextureAtlasCache(std::filesystem::path filename, std::string key);
+
+    TextureAtlasCache(const TextureAtlasCache&)            = delete;
+    TextureAtlasCache(TextureAtlasCache&&)                 = delete;
+    TextureAtlasCache& operator=(const TextureAtlasCache&) = delete;
+    TextureAtlasCache& operator=(TextureAtlasCache&&)      = delete;
+
+    /// waits until a cache passed to store() is written
+    ~TextureAtlasCache();
+
+    /**
+        Loads the cache.
+        \return the cached atlases or nothing if the cache is missing, broken or was written with another key
+    */
+    [[nodiscard]] std::optional<Contents> load() const;
+
+    /**
+        Writes the cache on a background thread.
+        \param  contents    the atlases to store
+    */
+    void store(Contents&& contents);
+
+private:
+    void write(const Contents& contents) const;
+
+    std::filesystem::path filename_;
+    std::string key_;
+
+    std::thread thread_;
+};
+
+#endif // TEXTUREATLASCACHE_H
@@ -0,0 +1,97 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAYSNAPSHOTS_H
+#define REPLAYSNAPSHOTS_H
+
+#include <Definitions.h>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+inline constexpr auto REPLAY_SNAPSHOT_INTERVAL   = MILLI2CYCLES(30 * 1000); ///< take a snapshot every 30s game time
+inline constexpr size_t REPLAY_SNAPSHOT_MAX_BYTES = 64 * 1024 * 1024;       ///< memory for all snapshots
+
+/**
+    Savegames of a running replay, taken every few game cycles and kept in memory. The savegames are stored as they
+    are, as their sections are already compressed. Seeking in a replay restores the nearest earlier snapshot and only
+    simulates the remaining game cycles. If the snapshots need more memory than allowed every other snapshot is
+    dropped and the interval is doubled.
+*/
+class ReplaySnapshots final {
+public:
+    explicit ReplaySnapshots(uint32_t interval = REPLAY_SNAPSHOT_INTERVAL, size_t maxBytes = REPLAY_SNAPSHOT_MAX_BYTES);
+    ReplaySnapshots(const ReplaySnapshots&) = delete;
+    ReplaySnapshots(ReplaySnapshots&&)      = delete;
+    ~ReplaySnapshots();
+
+    ReplaySnapshots& operator=(const ReplaySnapshots&) = delete;
+    ReplaySnapshots& operator=(ReplaySnapshots&&)      = delete;
+
+    /**
+        Checks if a snapshot should be taken at the beginning of this game cycle.
+        \param  gameCycle   the current game cycle
+        \return true if gameCycle is a multiple of the interval and there is no snapshot for it yet
+    */
+    [[nodiscard]] bool isSnapshotDue(uint32_t gameCycle) const;
+
+    /**
+        Adds a snapshot.
+        \param  gameCycle   the game cycle the savegame was taken at
+        \param  savegame    the savegame as written by Game::saveGame()
+    */
+    void addSnapshot(uint32_t gameCycle, std::span<const uint8_t> savegame);
+
+    /**
+        Finds the latest snapshot that was taken at or before gameCycle.
+        \param  gameCycle   the game cycle to seek to
+        \return the game cycle of the snapshot or nothing if there is none
+    */
+    [[nodiscard]] std::optional<uint32_t> findSnapshot(uint32_t gameCycle) const;
+
+    /**
+        Finds the snapshot to restore for seeking from currentCycle to targetCycle. Seeking forward only restores a
+        snapshot that is ahead of currentCycle; otherwise simulating from currentCycle is faster.
+        \param  currentCycle    the current game cycle of the replay
+        \param  targetCycle     the game cycle to seek to
+        \return the game cycle of the snapshot to restore or nothing if the replay should just skip ahead
+    */
+    [[nodiscard]] std::optional<uint32_t> findRestorePoint(uint32_t currentCycle, uint32_t targetCycle) const;
+
+    /**
+        Returns the savegame of a snapshot.
+        \param  gameCycle   the game cycle as returned by findSnapshot()
+        \return the savegame as passed to addSnapshot()
+    */
+    [[nodiscard]] std::vector<uint8_t> getSnapshot(uint32_t gameCycle) const;
+
+    /// the number of bytes used by all snapshots
+    [[nodiscard]] size_t getMemoryUsage() const noexcept { return memoryUsage_; }
+
+private:
+    void thinOut();
+
+    uint32_t interval_;
+    size_t maxBytes_;
+    size_t memoryUsage_ = 0;
+    std::map<uint32_t, std::vector<uint8_t>> snapshots_; ///< the savegames by game cycle
+};
+
+#endif // REPLAYSNAPSHOTS_H
@@ -0,0 +1,122 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SAVEGAMEHEADER_H
+#define SAVEGAMEHEADER_H
+
+#include <DataTypes.h>
+#include <GameInitSettings.h>
+
+#include <misc/InputStream.h>
+#include <misc/OutputStream.h>
+#include <misc/SDL2pp.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+inline constexpr auto SAVEGAME_THUMBNAIL_SIZE = 64; ///< maximum width and height of the thumbnail in pixels
+
+/**
+    The uncompressed block at the beginning of a savegame (right after the magic number, the savegame version and the
+    version string). It contains everything the load/save window shows about a savegame, so listing savegames does
+    not need to decompress and parse the whole game state. It is followed by the compressed sections
+    (see writeSaveGameSection()).
+*/
+class SaveGameHeader final {
+public:
+    SaveGameHeader();
+
+    /**
+        Reads the header.
+        \param  stream  the stream to read from (positioned right after the version string)
+    */
+    explicit SaveGameHeader(InputStream& stream);
+
+    SaveGameHeader(const SaveGameHeader&);
+    SaveGameHeader(SaveGameHeader&&) noexcept;
+    SaveGameHeader& operator=(const SaveGameHeader&);
+    SaveGameHeader& operator=(SaveGameHeader&&) noexcept;
+
+    ~SaveGameHeader();
+
+    void save(OutputStream& stream) const;
+
+    /**
+        Reads the header of a savegame file without reading the rest of it.
+        \param  savegame    the savegame to read
+        \return the header or nothing if the file cannot be read or was saved in a format without header
+    */
+    static std::optional<SaveGameHeader> read(const std::filesystem::path& savegame);
+
+    /// creates a surface showing the thumbnail or nullptr if there is none
+    [[nodiscard]] sdl2::surface_ptr createThumbnailSurface() const;
+
+    std::string mapName;                           ///< the name of the map file without extension
+    GameType gameType       = GameType::Campaign;  ///< the type of the game
+    HOUSETYPE houseID       = HOUSETYPE::HOUSE_INVALID; ///< the house of the local player
+    int mission             = 0;                   ///< the mission number (campaign and skirmish only)
+    uint32_t gameCycleCount = 0;                   ///< the game cycle the game was saved at
+    GameInitSettings::HouseInfoList houseInfoList; ///< the house setup chosen at the beginning of the game
+
+    uint16_t thumbnailWidth  = 0;
+    uint16_t thumbnailHeight = 0;
+    std::vector<uint8_t> thumbnail; ///< RGB pixels, thumbnailWidth * thumbnailHeight * 3 bytes
+};
+
+/**
+    A complete savegame with the sections not yet compressed. Creating it (see Game::createSaveGameData()) only
+    serializes the game state into memory; write() does the compression and the I/O and may run on another thread.
+*/
+class SaveGameData final {
+public:
+    SaveGameData();
+    SaveGameData(const SaveGameData&) = delete;
+    SaveGameData(SaveGameData&&) noexcept;
+    ~SaveGameData();
+
+    SaveGameData& operator=(const SaveGameData&) = delete;
+    SaveGameData& operator=(SaveGameData&&) noexcept;
+
+    /**
+        Writes the savegame including the magic number and the savegame version.
+        \param  stream  the stream to write to
+    */
+    void write(OutputStream& stream) const;
+
+    SaveGameHeader header;
+    std::vector<std::vector<uint8_t>> sections; ///< uncompressed; state, map, objects, bullets and commands
+};
+
+/**
+    Writes a compressed section of a savegame.
+    \param  stream  the stream to write to
+    \param  data    the uncompressed section
+*/
+void writeSaveGameSection(OutputStream& stream, std::span<const uint8_t> data);
+
+/**
+    Reads a section written by writeSaveGameSection(). An exception is thrown if the section is corrupt.
+    \param  stream  the stream to read from
+    \return the uncompressed section
+*/
+std::vector<uint8_t> readSaveGameSection(InputStream& stream);
+
+#endif // SAVEGAMEHEADER_H
@@ -224,10 +224,20 @@ public:
     void assignUndergroundUnit(uint32_t newObjectID);
 
     /**
-        This method draws the terrain of this tile
+        This method draws the terrain of this tile including destroyed structures. The result is cached by the map
+        view, so nothing that changes without invalidating the terrain of the map may be drawn here.
+        \param renderer the renderer
+        \param x        the x-coordinate of the top left corner of the tile
+        \param y        the y-coordinate of the top left corner of the tile
+    */
+    void blitTerrain(SDL_Renderer* renderer, float x, float y) const;
+
+    /**
+        This method draws what changes on the ground of this tile over time (the tracks) and the damage. Both are
+        drawn every frame as they must stay hidden under the fog of war.
         \param game     the game
     */
-    void blitGround(Game* game);
+    void blitGround(Game* game) const;
 
     /**
         This method draws the structures.
@@ -380,9 +390,7 @@ public:
 
     void setOwner(HOUSETYPE newOwner) noexcept { owner_ = newOwner; }
     void setSandRegion(uint32_t newSandRegion) noexcept { sandRegion_ = newSandRegion; }
-    void setDestroyedStructureTile(int newDestroyedStructureTile) noexcept {
-        destroyedStructureTile_ = newDestroyedStructureTile;
-    }
+    void setDestroyedStructureTile(int newDestroyedStructureTile);
 
     bool hasAGroundObject() const noexcept { return (hasInfantry() || hasANonInfantryGroundObject()); }
     bool hasAnAirUnit() const noexcept { return !assignedAirUnitList_.empty(); }
@@ -393,11 +401,22 @@ public:
     bool hasAnObject() const noexcept { return (hasAGroundObject() || hasAnAirUnit() || hasAnUndergroundUnit()); }
 
     bool hasSpice() const noexcept { return (spice_ > 0); }
+
+    /**
+        Checks if this tile may look different in the next game cycle without being invalidated, because objects on it
+        move or are animated, dead units burn down or tracks fade away.
+        \param  gameCycleCount  the current game cycle
+        \return true if this tile may change in every game cycle
+    */
+    bool isAnimated(uint32_t gameCycleCount) const noexcept;
+
     bool infantryNotFull() const noexcept { return (assignedInfantryList_.size() < NUM_INFANTRY_PER_TILE); }
     bool isConcrete() const noexcept { return (type_ == TERRAINTYPE::Terrain_Slab); }
     bool isExploredByHouse(HOUSETYPE houseID) const { return explored_[static_cast<int>(houseID)]; }
     bool isExploredByTeam(const Game* game, int teamID) const;
 
+    uint32_t getLastAccess(HOUSETYPE houseID) const { return lastAccess_[static_cast<int>(houseID)]; }
+
     bool isFoggedByHouse(bool fogOfWarEnabled, uint32_t gameCycleCount, HOUSETYPE houseID) const noexcept;
     bool isFoggedByTeam(const Game* game, int teamID) const;
     bool isMountain() const noexcept { return (type_ == TERRAINTYPE::Terrain_Mountain); }
@@ -0,0 +1,110 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIRTYREGION_H
+#define DIRTYREGION_H
+
+#include <SDL2/SDL_rect.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace dune {
+
+/**
+    Remembers which part of the screen changed since it was drawn the last time. The changed part is kept as a single
+    bounding rectangle, as the screen is redrawn in one pass clipped to this rectangle anyway.
+*/
+class DirtyRegion final {
+public:
+    /**
+        Adds a changed rectangle. Empty rectangles are ignored.
+        \param  rect    the changed rectangle in screen coordinates
+    */
+    void add(const SDL_Rect& rect) noexcept {
+        if (all_ || rect.w <= 0 || rect.h <= 0)
+            return;
+
+        if (bounds_.w <= 0) {
+            bounds_ = rect;
+            return;
+        }
+
+        const auto x1 = std::min(bounds_.x, rect.x);
+        const auto y1 = std::min(bounds_.y, rect.y);
+        const auto x2 = std::max(bounds_.x + bounds_.w, rect.x + rect.w);
+        const auto y2 = std::max(bounds_.y + bounds_.h, rect.y + rect.h);
+
+        bounds_ = {x1, y1, x2 - x1, y2 - y1};
+    }
+
+    /**
+        Adds a changed rectangle. The rectangle is extended to whole pixels.
+        \param  rect    the changed rectangle in screen coordinates
+    */
+    void add(const SDL_FRect& rect) noexcept {
+        const auto x1 = static_cast<int>(std::floor(rect.x));
+        const auto y1 = static_cast<int>(std::floor(rect.y));
+        const auto x2 = static_cast<int>(std::ceil(rect.x + rect.w));
+        const auto y2 = static_cast<int>(std::ceil(rect.y + rect.h));
+
+        add(SDL_Rect{x1, y1, x2 - x1, y2 - y1});
+    }
+
+    /// Marks the whole screen as changed
+    void markAll() noexcept { all_ = true; }
+
+    /// Marks the whole screen as unchanged again
+    void clear() noexcept {
+        all_    = false;
+        bounds_ = {};
+    }
+
+    /// \return true if the whole screen changed
+    [[nodiscard]] bool isAll() const noexcept { return all_; }
+
+    /// \return true if nothing changed
+    [[nodiscard]] bool empty() const noexcept { return !all_ && bounds_.w <= 0; }
+
+    /**
+        Returns the bounding rectangle of the changed part of the screen.
+        \param  screen  the rectangle covered by the screen
+        \return the changed part of screen (screen itself if isAll() is true)
+    */
+    [[nodiscard]] SDL_Rect bounds(const SDL_Rect& screen) const noexcept {
+        if (all_)
+            return screen;
+
+        const auto x1 = std::max(bounds_.x, screen.x);
+        const auto y1 = std::max(bounds_.y, screen.y);
+        const auto x2 = std::min(bounds_.x + bounds_.w, screen.x + screen.w);
+        const auto y2 = std::min(bounds_.y + bounds_.h, screen.y + screen.h);
+
+        if (x2 <= x1 || y2 <= y1)
+            return {};
+
+        return {x1, y1, x2 - x1, y2 - y1};
+    }
+
+private:
+    bool all_ = false;
+    SDL_Rect bounds_{}; ///< the bounding rectangle of the changed rectangles (w == 0 if nothing changed)
+};
+
+} // namespace dune
+
+#endif // DIRTYREGION_H
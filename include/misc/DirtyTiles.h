@@ -0,0 +1,160 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIRTYTILES_H
+#define DIRTYTILES_H
+
+#include <SDL2/SDL_rect.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace dune {
+
+/**
+    Remembers which tiles of a map changed since the last time a cached picture of the map (e.g. the radar) was
+    updated. Every tile is only recorded once, so the cost of updating the picture is proportional to the number of
+    changed tiles and not to the size of the map. For uploading the changes the map is divided into horizontal bands
+    of band_height rows and the bounding rectangle of the changed tiles is kept for every band.
+*/
+class DirtyTiles final {
+public:
+    static constexpr int band_height = 8;
+
+    DirtyTiles() = default;
+
+    /**
+        Creates a tracker for a map of the given size. Initially every tile is dirty.
+        \param  sizeX   the width of the map in tiles
+        \param  sizeY   the height of the map in tiles
+    */
+    DirtyTiles(int sizeX, int sizeY);
+
+    /**
+        Changes the size of the map. Afterwards every tile is dirty.
+        \param  sizeX   the width of the map in tiles
+        \param  sizeY   the height of the map in tiles
+    */
+    void reset(int sizeX, int sizeY);
+
+    /**
+        Marks a tile as dirty. Tiles outside the map are ignored.
+        \param  x   the x-coordinate of the tile
+        \param  y   the y-coordinate of the tile
+    */
+    void mark(int x, int y) {
+        if (all_ || x < 0 || x >= sizeX_ || y < 0 || y >= sizeY_)
+            return;
+
+        const auto index = y * sizeX_ + x;
+        if (flags_[index])
+            return;
+
+        flags_[index] = 1;
+        tiles_.push_back(index);
+
+        auto& band = bands_[y / band_height];
+        if (band.w == 0) {
+            band = {x, y, 1, 1};
+            return;
+        }
+
+        if (x < band.x) {
+            band.w += band.x - x;
+            band.x = x;
+        } else if (x >= band.x + band.w) {
+            band.w = x - band.x + 1;
+        }
+
+        if (y < band.y) {
+            band.h += band.y - y;
+            band.y = y;
+        } else if (y >= band.y + band.h) {
+            band.h = y - band.y + 1;
+        }
+    }
+
+    /// Marks the whole map as dirty
+    void markAll() noexcept { all_ = true; }
+
+    /// Marks every tile as clean again
+    void clear();
+
+    [[nodiscard]] int getSizeX() const noexcept { return sizeX_; }
+    [[nodiscard]] int getSizeY() const noexcept { return sizeY_; }
+
+    /// \return true if the whole map is dirty
+    [[nodiscard]] bool isAll() const noexcept { return all_; }
+
+    /// \return true if no tile is dirty
+    [[nodiscard]] bool empty() const noexcept { return !all_ && tiles_.empty(); }
+
+    /// \return the number of dirty tiles
+    [[nodiscard]] int count() const noexcept {
+        return all_ ? sizeX_ * sizeY_ : static_cast<int>(tiles_.size());
+    }
+
+    /**
+        Calls f(x, y) for every dirty tile.
+        \param  f   the function to call
+    */
+    template<typename F>
+    void for_each(F&& f) const {
+        if (all_) {
+            for (auto y = 0; y < sizeY_; ++y) {
+                for (auto x = 0; x < sizeX_; ++x)
+                    f(x, y);
+            }
+            return;
+        }
+
+        for (const auto index : tiles_)
+            f(index % sizeX_, index / sizeX_);
+    }
+
+    /**
+        Calls f(rect) with the bounding rectangle (in tiles) of the dirty tiles of every band that has dirty tiles.
+        The rectangles do not overlap.
+        \param  f   the function to call
+    */
+    template<typename F>
+    void for_each_rect(F&& f) const {
+        if (all_) {
+            if (sizeX_ > 0 && sizeY_ > 0)
+                f(SDL_Rect{0, 0, sizeX_, sizeY_});
+            return;
+        }
+
+        for (const auto& band : bands_) {
+            if (band.w > 0)
+                f(band);
+        }
+    }
+
+private:
+    int sizeX_ = 0;
+    int sizeY_ = 0;
+    bool all_  = false;
+
+    std::vector<uint8_t> flags_;  ///< one entry per tile, set if the tile is in tiles_
+    std::vector<int> tiles_;      ///< the indices (y * sizeX + x) of the dirty tiles
+    std::vector<SDL_Rect> bands_; ///< the bounding rectangle of the dirty tiles per band (w == 0 if clean)
+};
+
+} // namespace dune
+
+#endif // DIRTYTILES_H
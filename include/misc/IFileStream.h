@@ -20,7 +20,9 @@
 
 #include "InputStream.h"
 
+#include <cstring>
 #include <filesystem>
+#include <memory>
 #include <string>
 
 class IFileStream final : public InputStream {
@@ -39,13 +41,37 @@ public:
     uint64_t readUint64() override;
     bool readBool() override;
     float readFloat() override;
+    void readBytes(std::span<uint8_t> data) override;
 
     size_t bytesLeft() const override { return sizeBytes_ - bytePos_; }
 
 private:
+    /// The file is read in blocks, so loading a game does not call fread() for every value
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    template<typename T>
+    T get(const char* caller) {
+        T x;
+        if (bufferEnd_ - bufferPos_ >= sizeof(T)) {
+            std::memcpy(&x, buffer_.get() + bufferPos_, sizeof(T));
+            bufferPos_ += sizeof(T);
+            bytePos_ += sizeof(T);
+        } else {
+            read(reinterpret_cast<uint8_t*>(&x), sizeof(T), caller);
+        }
+        return x;
+    }
+
+    void read(uint8_t* data, size_t size, const char* caller);
+    void fillBuffer(const char* caller);
+
     FILE* fp;
     long sizeBytes_;
     long bytePos_;
+
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t bufferPos_ = 0;
+    size_t bufferEnd_ = 0;
 };
 
 #endif // IFILESTREAM_H
@@ -52,6 +52,8 @@ public:
 
     float readFloat() override;
 
+    void readBytes(std::span<uint8_t> data) override;
+
     size_t bytesLeft() const override { return bufferSize - currentPos; }
 
 private:
@@ -24,6 +24,7 @@
 #include <misc/SDL2pp.h>
 
 #include <exception>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -48,6 +49,25 @@ public:
     virtual bool readBool()       = 0;
     virtual float readFloat()     = 0;
 
+    /**
+        Reads in a block of raw bytes. The default implementation reads byte by byte; derived streams
+        override it with a bulk copy.
+        \param data    the buffer to fill
+    */
+    virtual void readBytes(std::span<uint8_t> data);
+
+    /**
+        Reads in an array of Uint32 values written by OutputStream::writeUint32s().
+        \param data    the buffer to fill
+    */
+    void readUint32s(std::span<uint32_t> data);
+
+    /**
+        Reads in an array of Sint32 values written by OutputStream::writeSint32s().
+        \param data    the buffer to fill
+    */
+    void readSint32s(std::span<int32_t> data);
+
     // Returns the number of bytes available in the stream before EOF.
     // Attempting to read more than this many bytes will throw an EOF exception.
     [[nodiscard]] virtual size_t bytesLeft() const = 0;
@@ -123,6 +143,9 @@ public:
     void readUint32Vector(std::vector<T>& vec) {
         vec.clear();
         const auto size = readUint32();
+        if (size > bytesLeft() / sizeof(uint32_t)) {
+            throw InputStream::eof("InputStream::readUint32Vector(): End-of-File reached!");
+        }
         vec.reserve(size);
         for (unsigned int i = 0; i < size; i++) {
             vec.push_back(static_cast<T>(readUint32()));
@@ -0,0 +1,57 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+/**
+    A read-only view of a whole file mapped into memory. The mapping stays valid until the object is destroyed.
+*/
+class MappedFile final {
+public:
+    /**
+        Maps a file into memory.
+        \param  filename    the file to map
+        \throw  io_error if the file cannot be opened or mapped
+    */
+    explicit MappedFile(const std::filesystem::path& filename);
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile(MappedFile&&)                 = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&)      = delete;
+
+    ~MappedFile();
+
+    [[nodiscard]] std::span<const uint8_t> data() const noexcept { return {pData_, size_}; }
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+private:
+    const uint8_t* pData_ = nullptr;
+    size_t size_          = 0;
+
+#ifdef _WIN32
+    void* hMapping_ = nullptr;
+#endif
+};
+
+#endif // MAPPEDFILE_H
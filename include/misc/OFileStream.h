@@ -20,7 +20,9 @@
 
 #include "OutputStream.h"
 
+#include <cstring>
 #include <filesystem>
+#include <memory>
 #include <string_view>
 
 class OFileStream final : public OutputStream {
@@ -29,6 +31,11 @@ public:
     ~OFileStream() override;
 
     bool open(const std::filesystem::path& filename);
+
+    /**
+        Writes out the buffered data and closes the file.
+        \throw OutputStream::error if the buffered data cannot be written
+    */
     void close();
 
     void flush() override;
@@ -43,9 +50,27 @@ public:
     void writeUint64(uint64_t x) override;
     void writeBool(bool x) override;
     void writeFloat(float x) override;
+    void writeBytes(std::span<const uint8_t> data) override;
 
 private:
+    /// The writes are collected in a buffer, so saving a game does not call fwrite() for every value
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    template<typename T>
+    void put(T x) {
+        if (bufferUsed_ + sizeof(T) > BUFFER_SIZE) {
+            flushBuffer();
+        }
+
+        std::memcpy(buffer_.get() + bufferUsed_, &x, sizeof(T));
+        bufferUsed_ += sizeof(T);
+    }
+
+    void flushBuffer();
+
     FILE* fp{};
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t bufferUsed_ = 0;
 };
 
 #endif // OFILESTREAM_H
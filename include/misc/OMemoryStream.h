@@ -20,7 +20,11 @@
 
 #include "OutputStream.h"
 
-#include <string>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 class OMemoryStream final : public OutputStream {
 public:
@@ -28,34 +32,45 @@ public:
 
     ~OMemoryStream() override;
 
+    /**
+        Discards all data written so far. The allocated memory is kept for reuse.
+    */
     void open();
 
-    [[nodiscard]] const char* getData() const { return pBuffer; }
+    [[nodiscard]] const char* getData() const { return reinterpret_cast<const char*>(buffer.data()); }
 
-    [[nodiscard]] size_t getDataLength() const { return (bReadOnly == true) ? bufferSize : currentPos; }
+    [[nodiscard]] size_t getDataLength() const { return buffer.size(); }
+
+    [[nodiscard]] std::span<const uint8_t> getBytes() const { return buffer; }
+
+    /**
+        Moves the data written so far out of this stream. The stream is empty afterwards.
+        \return the data
+    */
+    [[nodiscard]] std::vector<uint8_t> releaseBytes() { return std::exchange(buffer, {}); }
 
     void flush() override;
 
-    void writeString(const std::string& str) override;
+    void writeString(std::string_view str) override;
 
-    void writeUint8(Uint8 x) override;
+    void writeUint8(uint8_t x) override;
 
-    void writeUint16(Uint16 x) override;
+    void writeUint16(uint16_t x) override;
 
-    void writeUint32(Uint32 x) override;
+    void writeUint32(uint32_t x) override;
 
-    void writeUint64(Uint64 x) override;
+    void writeUint64(uint64_t x) override;
 
     void writeBool(bool x) override;
 
     void writeFloat(float x) override;
 
+    void writeBytes(std::span<const uint8_t> data) override;
+
     void ensureBufferSize(size_t minBufferSize);
 
 private:
-    size_t currentPos{};
-    size_t bufferSize{};
-    char* pBuffer{};
+    std::vector<uint8_t> buffer;
 };
 
 #endif // OMEMORYSTREAM_H
@@ -26,6 +26,7 @@
 
 #include <exception>
 #include <list>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -50,6 +51,26 @@ public:
     virtual void writeBool(bool x)       = 0;
     virtual void writeFloat(float x)     = 0;
 
+    /**
+        Writes out a block of raw bytes. The default implementation writes byte by byte; derived streams
+        override it with a bulk copy.
+        \param data    the bytes to write
+    */
+    virtual void writeBytes(std::span<const uint8_t> data);
+
+    /**
+        Writes out an array of Uint32 values without a size prefix. The result is the same as calling
+        writeUint32() for every element but needs only one virtual call per block.
+        \param data    the values to write
+    */
+    void writeUint32s(std::span<const uint32_t> data);
+
+    /**
+        Writes out an array of Sint32 values without a size prefix (see writeUint32s()).
+        \param data    the values to write
+    */
+    void writeSint32s(std::span<const int32_t> data);
+
     /**
         Writes out a Sint8 value.
         \param x    the value to write out
@@ -0,0 +1,68 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RWOPSDATA_H
+#define RWOPSDATA_H
+
+#include <misc/SDL2pp.h>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+/**
+    The remaining content of a SDL_RWops. The files opened by Pakfile::openFile() are viewed in the mapped PAK-File
+    without copying; the data of all other RWops is read into a buffer. A view is valid as long as the Pakfile exists,
+    so as long as the FileManager exists.
+*/
+class RWopsData final {
+public:
+    RWopsData() = default;
+
+    /**
+        Reads or views all data from the current position of rwop to its end. rwop is at its end afterwards.
+        \param  rwop    the RWops to read (can be readonly but must support seeking)
+        \throw  std::runtime_error if the data cannot be read
+    */
+    explicit RWopsData(SDL_RWops* rwop);
+
+    RWopsData(const RWopsData&) = delete;
+    RWopsData(RWopsData&& o) noexcept : buffer_{std::move(o.buffer_)}, data_{std::exchange(o.data_, {})} { }
+    ~RWopsData() = default;
+
+    RWopsData& operator=(const RWopsData&) = delete;
+    RWopsData& operator=(RWopsData&& o) noexcept {
+        buffer_ = std::move(o.buffer_);
+        data_   = std::exchange(o.data_, {});
+        return *this;
+    }
+
+    [[nodiscard]] std::span<const uint8_t> data() const noexcept { return data_; }
+
+    [[nodiscard]] const uint8_t* get() const noexcept { return data_.data(); }
+
+    [[nodiscard]] size_t size() const noexcept { return data_.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+
+private:
+    std::unique_ptr<uint8_t[]> buffer_;
+    std::span<const uint8_t> data_;
+};
+
+#endif // RWOPSDATA_H
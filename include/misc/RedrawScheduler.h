@@ -0,0 +1,66 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REDRAWSCHEDULER_H
+#define REDRAWSCHEDULER_H
+
+#include "misc/dune_clock.h"
+
+#include <algorithm>
+
+namespace dune {
+
+/**
+    Decides when the screen has to be drawn again by loops that can sleep while nothing changes, e.g. the menus and
+    the paused game. Input and widgets that changed request a new frame with invalidate(), animations request the frame
+    that shows their next step with wakeAt(). Until then the loop can block in Dune_WaitEvent().
+*/
+class RedrawScheduler final {
+public:
+    RedrawScheduler() = delete;
+
+    /// Requests drawing the screen as soon as possible
+    static void invalidate() noexcept { wakeTime_ = dune_clock::time_point::min(); }
+
+    /**
+        Requests drawing the screen at time. The earliest requested time is kept.
+        \param  time    the time the screen has to be drawn again
+    */
+    static void wakeAt(dune_clock::time_point time) noexcept { wakeTime_ = std::min(wakeTime_, time); }
+
+    /**
+        Requests drawing the screen after delay.
+        \param  delay   the time from now until the screen has to be drawn again
+    */
+    static void wakeAfter(dune_clock::duration delay) noexcept { wakeAt(dune_clock::now() + delay); }
+
+    /// \return true if drawing the screen was requested for now or earlier
+    [[nodiscard]] static bool due(dune_clock::time_point now = dune_clock::now()) noexcept { return wakeTime_ <= now; }
+
+    /// \return the time the screen has to be drawn again (time_point::max() if nothing was requested)
+    [[nodiscard]] static dune_clock::time_point nextWake() noexcept { return wakeTime_; }
+
+    /// Forgets all requests before a frame is drawn. The animations request their next step while being drawn.
+    static void startFrame() noexcept { wakeTime_ = dune_clock::time_point::max(); }
+
+private:
+    static inline dune_clock::time_point wakeTime_ = dune_clock::time_point::min();
+};
+
+} // namespace dune
+
+#endif // REDRAWSCHEDULER_H
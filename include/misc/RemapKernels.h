@@ -0,0 +1,107 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REMAPKERNELS_H
+#define REMAPKERNELS_H
+
+#include <misc/ScalerKernels.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+    Palette remapping of 8-bit images in memory, e.g. for house colors. Like the kernels of the Scaler there is portable
+    scalar code and vectorized versions with the exact same output.
+*/
+namespace dune::remap {
+
+using scaler::InstructionSet;
+
+/// A lookup table from every palette index to its replacement.
+class ColorMap final {
+public:
+    /// The identity map
+    ColorMap();
+    explicit ColorMap(const uint8_t map[256]);
+
+    /**
+        The map used by mapSurfaceColorRange(): [srcColor;srcColor+7) is mapped to [destColor;destColor+7).
+        \param  src_color   first color of the range to change
+        \param  dest_color  first color of the range to change to
+        \return the map
+    */
+    static ColorMap range(int src_color, int dest_color);
+
+    /// Maps from to to; all other colors stay as they are.
+    ColorMap& set(uint8_t from, uint8_t to);
+
+    [[nodiscard]] uint8_t operator[](uint8_t color) const { return map_[color]; }
+
+    [[nodiscard]] const std::array<uint8_t, 256>& table() const noexcept { return map_; }
+
+    /// The colors which are not mapped to themselves, in ascending order
+    [[nodiscard]] std::span<const uint8_t> changed() const noexcept { return {changed_.data(), num_changed_}; }
+
+private:
+    void update_changed();
+
+    std::array<uint8_t, 256> map_{};
+    std::array<uint8_t, 256> changed_{};
+    size_t num_changed_ = 0;
+};
+
+/// One output of remap()
+struct Target {
+    const ColorMap* map;
+    uint8_t* pixels;
+    int pitch;
+};
+
+/**
+    Remaps an image into several targets in one pass over the source, e.g. to create all house variants of a picture.
+    \param  set         the instruction set to use; it must be supported
+    \param  src         the source pixels
+    \param  src_pitch   the distance between two source rows in bytes
+    \param  width       the width of the image in bytes
+    \param  height      the height of the image
+    \param  targets     the maps and the destinations with room for width x height pixels each. A destination may only
+                        be the source itself if it is the only target.
+*/
+void remap(InstructionSet set, const uint8_t* src, int src_pitch, int width, int height,
+           std::span<const Target> targets);
+
+inline void remap(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+                  int height, const ColorMap& map) {
+    const Target target{&map, dst, dst_pitch};
+
+    remap(set, src, src_pitch, width, height, {&target, 1});
+}
+
+inline void remap(const uint8_t* src, int src_pitch, int width, int height, std::span<const Target> targets) {
+    remap(scaler::best_instruction_set(), src, src_pitch, width, height, targets);
+}
+
+inline void
+remap(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height, const ColorMap& map) {
+    remap(scaler::best_instruction_set(), src, src_pitch, dst, dst_pitch, width, height, map);
+}
+
+} // namespace dune::remap
+
+#endif // REMAPKERNELS_H
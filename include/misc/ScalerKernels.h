@@ -0,0 +1,86 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCALERKERNELS_H
+#define SCALERKERNELS_H
+
+#include <cstdint>
+
+/**
+    The pixel loops of the Scaler. They work on 8-bit palettized images in memory, so they can be tested without SDL.
+    Every kernel exists as portable scalar code and, where the CPU allows, in vectorized versions that produce the
+    exact same output.
+*/
+namespace dune::scaler {
+
+enum class InstructionSet { Scalar, SSE2, AVX2, NEON };
+
+/// The fastest instruction set supported by this CPU; it is used by the kernels without an explicit instruction set.
+[[nodiscard]] InstructionSet best_instruction_set();
+
+[[nodiscard]] bool is_supported(InstructionSet set);
+
+[[nodiscard]] const char* instruction_set_name(InstructionSet set);
+
+/**
+    Scales an image of tile_width x tile_height sized tiles with the Scale2x algorithm. Every tile is scaled on its own.
+    \param  set         the instruction set to use; it must be supported
+    \param  src         the source pixels
+    \param  src_pitch   the distance between two source rows in bytes
+    \param  dst         the destination pixels for 2 * width x 2 * height pixels
+    \param  dst_pitch   the distance between two destination rows in bytes
+    \param  width       the width of the source; a multiple of tile_width
+    \param  height      the height of the source; a multiple of tile_height
+    \param  tile_width  the width of a tile
+    \param  tile_height the height of a tile
+*/
+void scale2x(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height,
+             int tile_width, int tile_height);
+
+/// Like scale2x() but with the Scale3x algorithm and a destination of 3 * width x 3 * height pixels.
+void scale3x(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height,
+             int tile_width, int tile_height);
+
+/// Doubles an image by making 4 same-colored pixels out of one.
+void double_nn(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+               int height);
+
+/// Triples an image by making 9 same-colored pixels out of one.
+void triple_nn(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+               int height);
+
+inline void scale2x(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height,
+                    int tile_width, int tile_height) {
+    scale2x(best_instruction_set(), src, src_pitch, dst, dst_pitch, width, height, tile_width, tile_height);
+}
+
+inline void scale3x(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height,
+                    int tile_width, int tile_height) {
+    scale3x(best_instruction_set(), src, src_pitch, dst, dst_pitch, width, height, tile_width, tile_height);
+}
+
+inline void double_nn(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height) {
+    double_nn(best_instruction_set(), src, src_pitch, dst, dst_pitch, width, height);
+}
+
+inline void triple_nn(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height) {
+    triple_nn(best_instruction_set(), src, src_pitch, dst, dst_pitch, width, height);
+}
+
+} // namespace dune::scaler
+
+#endif // SCALERKERNELS_H
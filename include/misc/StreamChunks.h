@@ -0,0 +1,100 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STREAMCHUNKS_H
+#define STREAMCHUNKS_H
+
+#include <misc/IMemoryStream.h>
+#include <misc/InputStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/OutputStream.h>
+#include <misc/ThreadPool.h>
+#include <misc/exceptions.h>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace dune {
+
+/**
+    Writes items in chunks of itemsPerChunk items. Every chunk is prefixed with its size, so readChunks() can decode
+    the chunks in parallel. The last chunk holds the remaining items and may be smaller.
+    \param  stream          the stream to write to
+    \param  items           the items to write
+    \param  itemsPerChunk   the number of items per chunk (at least one)
+    \param  save            called as save(OutputStream&, const T&) for every item
+*/
+template<typename T, typename SaveFunction>
+void writeChunks(OutputStream& stream, std::span<const T> items, size_t itemsPerChunk, SaveFunction&& save) {
+    const auto numChunks = (items.size() + itemsPerChunk - 1) / itemsPerChunk;
+
+    stream.writeUint32(gsl::narrow<uint32_t>(itemsPerChunk));
+    stream.writeUint32(gsl::narrow<uint32_t>(numChunks));
+
+    OMemoryStream chunk;
+    for (size_t begin = 0; begin < items.size(); begin += itemsPerChunk) {
+        chunk.open();
+
+        const auto end = std::min(begin + itemsPerChunk, items.size());
+        for (auto i = begin; i < end; i++)
+            save(chunk, items[i]);
+
+        stream.writeUint8Vector(chunk.getBytes());
+    }
+}
+
+/**
+    Reads items written by writeChunks(). The chunks are read first and then decoded on ThreadPool::shared(), so
+    an item must only depend on its own record. An exception is thrown if the chunks do not match the number of items
+    or a chunk is not used up completely.
+    \param  stream  the stream to read from
+    \param  items   the items to read; the number of items has to be the same as when writing
+    \param  load    called as load(InputStream&, T&) for every item
+*/
+template<typename T, typename LoadFunction>
+void readChunks(InputStream& stream, std::span<T> items, LoadFunction&& load) {
+    const auto itemsPerChunk = stream.readUint32();
+    const auto numChunks     = stream.readUint32();
+
+    if (itemsPerChunk == 0 || numChunks != (items.size() + itemsPerChunk - 1) / itemsPerChunk)
+        THROW(std::runtime_error, "Invalid chunks: {} chunks of {} items for {} items", numChunks, itemsPerChunk,
+              items.size());
+
+    std::vector<std::vector<uint8_t>> chunks(numChunks);
+    for (auto& chunk : chunks)
+        stream.readUint8Vector(chunk);
+
+    ThreadPool::shared().parallel_for(chunks.size(), [&](size_t i) {
+        const auto& chunk = chunks[i];
+        IMemoryStream chunkStream{reinterpret_cast<const char*>(chunk.data()), chunk.size()};
+
+        const auto begin = i * itemsPerChunk;
+        const auto end   = std::min<size_t>(begin + itemsPerChunk, items.size());
+        for (auto j = begin; j < end; j++)
+            load(chunkStream, items[j]);
+
+        if (chunkStream.bytesLeft() != 0)
+            THROW(std::runtime_error, "Chunk {} has {} unused bytes", i, chunkStream.bytesLeft());
+    });
+}
+
+} // namespace dune
+
+#endif // STREAMCHUNKS_H
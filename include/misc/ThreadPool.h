@@ -0,0 +1,147 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+    A fixed set of worker threads executing submitted tasks in FIFO order. Tasks must not wait for other tasks of the
+    same pool; dependent work is expressed by waiting for the returned futures on the submitting thread.
+*/
+class ThreadPool final {
+public:
+    /**
+        Starts the worker threads.
+        \param  numThreads  the number of worker threads (at least one is started)
+    */
+    explicit ThreadPool(unsigned int numThreads = defaultNumThreads());
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool(ThreadPool&&)                 = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&)      = delete;
+
+    /**
+        Finishes all queued tasks and joins the worker threads.
+    */
+    ~ThreadPool();
+
+    /**
+        Queues a task for execution on one of the worker threads.
+        \param  f   the task
+        \return a future for the result of the task; exceptions thrown by the task are rethrown by get()
+    */
+    template<typename F>
+    auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+
+        auto task   = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        auto future = task->get_future();
+
+        enqueue([task = std::move(task)] { (*task)(); });
+
+        return future;
+    }
+
+    /**
+        Calls f(i) for every i in [0, count) on the worker threads and the calling thread. Returns when all calls
+        have finished; the first exception thrown by f is rethrown afterwards.
+        \param  count   the number of calls
+        \param  f       the function to call
+    */
+    template<typename F>
+    void parallel_for(size_t count, F&& f) {
+        std::atomic<size_t> next{0};
+
+        const auto worker = [&] {
+            try {
+                for (auto i = next++; i < count; i = next++)
+                    f(i);
+            } catch (...) {
+                next = count;
+                throw;
+            }
+        };
+
+        std::vector<std::future<void>> helpers;
+        const auto numHelpers = std::min(count, threads_.size() + 1) - (count > 0 ? 1 : 0);
+        helpers.reserve(numHelpers);
+        for (size_t i = 0; i < numHelpers; i++)
+            helpers.push_back(submit(worker));
+
+        std::exception_ptr exception;
+        try {
+            worker();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        for (auto& helper : helpers) {
+            try {
+                helper.get();
+            } catch (...) {
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return threads_.size(); }
+
+    /**
+        The pool for work that is split up between threads while the calling thread waits, like loading the
+        map or the game graphics. It is created on first use. Tasks of this pool must not use it themselves.
+        \return the shared pool
+    */
+    static ThreadPool& shared();
+
+    /**
+        The number of worker threads to use when the submitting thread also does work.
+        \return one less than the number of hardware threads, but at least one
+    */
+    static unsigned int defaultNumThreads() noexcept;
+
+private:
+    void enqueue(std::function<void()> task);
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::function<void()>> tasks_;
+    bool stop_ = false;
+
+    std::vector<std::thread> threads_;
+};
+
+#endif // THREADPOOL_H
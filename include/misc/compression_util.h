@@ -0,0 +1,47 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPRESSION_UTIL_H
+#define COMPRESSION_UTIL_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dune {
+
+/**
+    Compresses data into the zlib format. We use the deflate implementation of lodepng, so no additional library is
+    needed.
+    \param  data    the data to compress
+    \return the compressed data
+*/
+std::vector<uint8_t> zlib_compress(std::span<const uint8_t> data);
+
+/**
+    Decompresses zlib compressed data. An exception is thrown if the data is corrupt or does not decompress to
+    exactly expectedSize bytes. Nothing is allocated up front, but callers should still limit expectedSize if it
+    comes from a file or the network.
+    \param  data            the compressed data
+    \param  expectedSize    the size of the uncompressed data
+    \return the uncompressed data
+*/
+std::vector<uint8_t> zlib_decompress(std::span<const uint8_t> data, size_t expectedSize);
+
+} // namespace dune
+
+#endif // COMPRESSION_UTIL_H
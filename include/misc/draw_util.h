@@ -23,6 +23,9 @@
 
 #include <Renderer/DuneRenderer.h>
 
+#include <span>
+#include <vector>
+
 /**
     Return the pixel value at (x, y) in surface
     NOTE: The surface must be locked before calling this!
@@ -44,8 +47,10 @@ void drawRectNoLock(SDL_Surface* surface, int x1, int y1, int x2, int y2, uint32
 void drawRect(SDL_Surface* surface, int x1, int y1, int x2, int y2, uint32_t color);
 
 inline void setRenderDrawColor(SDL_Renderer* renderer, uint32_t color) {
+    dune::flush_sprites();
+
     if (((color & AMASK) >> ASHIFT) != 255) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        Dune_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     }
     SDL_SetRenderDrawColor(renderer, (color & RMASK) >> RSHIFT, (color & GMASK) >> GSHIFT, (color & BMASK) >> BSHIFT,
                            (color & AMASK) >> ASHIFT);
@@ -53,11 +58,13 @@ inline void setRenderDrawColor(SDL_Renderer* renderer, uint32_t color) {
 
 inline void renderDrawLineF(SDL_Renderer* renderer, float x1, float y1, float x2, float y2, uint32_t color) {
     setRenderDrawColor(renderer, color);
+    dune::RenderStats::countDrawCall();
     SDL_RenderDrawLineF(renderer, x1, y1, x2, y2);
 }
 
 inline void renderDrawLine(SDL_Renderer* renderer, int x1, int y1, int x2, int y2, uint32_t color) {
     setRenderDrawColor(renderer, color);
+    dune::RenderStats::countDrawCall();
     SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
 }
 
@@ -79,11 +86,13 @@ inline void renderDrawVLine(SDL_Renderer* renderer, float x, float y1, float y2,
 
 inline void renderDrawRect(SDL_Renderer* renderer, const SDL_Rect* rect, uint32_t color) {
     setRenderDrawColor(renderer, color);
+    dune::RenderStats::countDrawCall();
     SDL_RenderDrawRect(renderer, rect);
 }
 
 inline void renderDrawRectF(SDL_Renderer* renderer, const SDL_FRect* rect, uint32_t color) {
     setRenderDrawColor(renderer, color);
+    dune::RenderStats::countDrawCall();
     SDL_RenderDrawRectF(renderer, rect);
 }
 
@@ -100,11 +109,13 @@ inline void renderDrawRectF(SDL_Renderer* renderer, float x1, float y1, float x2
 
 inline void renderFillRect(SDL_Renderer* renderer, const SDL_Rect* rect, uint32_t color) {
     setRenderDrawColor(renderer, color);
+    dune::RenderStats::countDrawCall(rect ? static_cast<int64_t>(rect->w) * rect->h : 0);
     SDL_RenderFillRect(renderer, rect);
 }
 
 inline void renderFillRectF(SDL_Renderer* renderer, const SDL_FRect* rect, uint32_t color) {
     setRenderDrawColor(renderer, color);
+    dune::RenderStats::countDrawCall(rect ? static_cast<int64_t>(rect->w * rect->h) : 0);
     SDL_RenderFillRectF(renderer, rect);
 }
 
@@ -158,6 +169,17 @@ sdl2::surface_ptr createShadowSurface(SDL_Surface* source);
 */
 sdl2::surface_ptr mapSurfaceColorRange(SDL_Surface* source, int srcColor, int destColor);
 
+/**
+    Like mapSurfaceColorRange() for several destination ranges at once, e.g. for all house colors. The source is only
+    read once.
+    \param  source      The source image
+    \param  srcColor    Color range to change = [srcColor;srcColor+7]
+    \param  destColors  The first colors of the ranges to change to
+    \return One mapped surface per destination range
+*/
+std::vector<sdl2::surface_ptr>
+mapSurfaceColorRange(SDL_Surface* source, int srcColor, std::span<const int> destColors);
+
 /**
     This function create a new blank surface with the same format and other attributes as the model surface.
     \param  model      The model surface
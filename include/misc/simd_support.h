@@ -0,0 +1,45 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMD_SUPPORT_H
+#define SIMD_SUPPORT_H
+
+// Instruction set detection for the translation units with vectorized kernels (see ScalerKernels.h). Only include
+// this from source files; the intrinsics headers are not meant to leak into the rest of the game.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DUNE_HAVE_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+// The AVX2 kernels are compiled for AVX2 on their own and are only called after checking the CPU at runtime.
+#if defined(DUNE_HAVE_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#    define DUNE_HAVE_AVX2 1
+#    include <immintrin.h>
+#    if defined(__GNUC__)
+#        define DUNE_TARGET_AVX2 __attribute__((target("avx2")))
+#    else
+#        define DUNE_TARGET_AVX2
+#    endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#    define DUNE_HAVE_NEON 1
+#    include <arm_neon.h>
+#endif
+
+#endif // SIMD_SUPPORT_H
@@ -1,6 +1,7 @@
 add_sources(HEADERS
 	AITeamInfo.h
 	AStarSearch.h
+	AutoSaver.h
 	Bullet.h
 	Choam.h
 	Colors.h
@@ -140,6 +141,7 @@ add_sources(HEADERS
 	INIMap/INIMapLoader.h
 	INIMap/INIMapPreviewCreator.h
 	Map.h
+	MapChunkCache.h
 	MapEditor/ChoamWindow.h
 	MapEditor/LoadMapWindow.h
 	MapEditor/MapData.h
@@ -176,6 +178,9 @@ add_sources(HEADERS
 	Menu/SinglePlayerSkirmishMenu.h
 	misc/BlendBlitter.h
 	misc/BufferedReader.h
+	misc/compression_util.h
+	misc/DirtyRegion.h
+	misc/DirtyTiles.h
 	misc/DrawingRectHelper.h
 	misc/draw_util.h
 	misc/dune_clock.h
@@ -192,6 +197,7 @@ add_sources(HEADERS
 	misc/IMemoryStream.h
 	misc/InputStream.h
 	misc/lemire_uniform_uint32_distribution.h
+	misc/MappedFile.h
 	misc/md5.h
 	misc/OFileStream.h
 	misc/OMemoryStream.h
@@ -201,14 +207,21 @@ add_sources(HEADERS
 	misc/random_xoroshiro128plus.h
 	misc/random_xorshift1024star.h
 	misc/random_xoshiro256starstar.h
+	misc/RedrawScheduler.h
+	misc/RemapKernels.h
 	misc/reverse.h
 	misc/RobustList.h
+	misc/RWopsData.h
 	misc/Scaler.h
+	misc/ScalerKernels.h
 	misc/SDL2pp.h
 	misc/sdl_support.h
+	misc/simd_support.h
 	misc/sound_util.h
+	misc/StreamChunks.h
 	misc/string_error.h
 	misc/string_util.h
+	misc/ThreadPool.h
 	misc/unique_or_nonowning_ptr.h
 	mmath.h
 	Network/ChangeEventList.h
@@ -217,11 +230,13 @@ add_sources(HEADERS
 	Network/ENetHttp.h
 	Network/ENetPacketIStream.h
 	Network/ENetPacketOStream.h
+	Network/GameDataTransfer.h
 	Network/GameServerInfo.h
 	Network/LANGameFinderAndAnnouncer.h
 	Network/MetaServerClient.h
 	Network/MetaServerCommands.h
 	Network/NetworkManager.h
+	Network/RelayServer.h
 	ObjectBase.h
 	ObjectData.h
 	ObjectManager.h
@@ -235,13 +250,18 @@ add_sources(HEADERS
 	players/SmartBot.h
 	RadarView.h
 	RadarViewBase.h
+	Renderer/DuneRenderStats.h
 	Renderer/DuneRenderer.h
 	Renderer/DuneRotateTexture.h
+	Renderer/DuneSpriteBatch.h
 	Renderer/DuneSurface.h
 	Renderer/DuneTexture.h
 	Renderer/DuneTextures.h
 	Renderer/DuneTileTexture.h
+	Renderer/TextureAtlasCache.h
+	ReplaySnapshots.h
 	sand.h
+	SaveGameHeader.h
 	ScreenBorder.h
 	SoundPlayer.h
 	structures/Barracks.h
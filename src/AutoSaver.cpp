@@ -0,0 +1,155 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <AutoSaver.h>
+
+#include <misc/OFileStream.h>
+#include <misc/SDL2pp.h>
+#include <misc/string_error.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <utility>
+
+AutoSaver::AutoSaver(std::filesystem::path directory, int numSlots)
+    : directory_(std::move(directory)), numSlots_(std::max(numSlots, 1)) {
+
+    // continue with the slot of the oldest (or a missing) autosave
+    std::optional<std::filesystem::file_time_type> oldest;
+    for (auto slot = 0; slot < numSlots_; slot++) {
+        std::error_code ec;
+        const auto time = std::filesystem::last_write_time(getSlotFilename(slot), ec);
+        if (ec) {
+            nextSlot_ = slot;
+            break;
+        }
+
+        if (!oldest || time < *oldest) {
+            oldest    = time;
+            nextSlot_ = slot;
+        }
+    }
+
+    thread_ = std::thread{[this] { run(); }};
+}
+
+AutoSaver::~AutoSaver() {
+    {
+        std::lock_guard lock{mutex_};
+        bQuit_ = true;
+    }
+    condition_.notify_all();
+
+    thread_.join();
+}
+
+bool AutoSaver::save(SaveGameData&& saveGameData) {
+    {
+        std::lock_guard lock{mutex_};
+
+        if (pending_ || bWriting_) {
+            return false;
+        }
+
+        pending_ = std::move(saveGameData);
+    }
+    condition_.notify_all();
+
+    return true;
+}
+
+bool AutoSaver::isBusy() const {
+    std::lock_guard lock{mutex_};
+
+    return pending_ || bWriting_;
+}
+
+void AutoSaver::wait() const {
+    std::unique_lock lock{mutex_};
+
+    condition_.wait(lock, [this] { return !pending_ && !bWriting_; });
+}
+
+std::filesystem::path AutoSaver::getSlotFilename(int slot) const {
+    return directory_ / fmt::format("autosave{}.dls", slot + 1);
+}
+
+void AutoSaver::run() {
+    std::unique_lock lock{mutex_};
+
+    while (true) {
+        // a pending autosave is still written when quitting
+        condition_.wait(lock, [this] { return pending_ || bQuit_; });
+
+        if (!pending_) {
+            return;
+        }
+
+        const auto saveGameData = std::move(*pending_);
+        pending_.reset();
+        bWriting_ = true;
+
+        lock.unlock();
+        write(saveGameData);
+        lock.lock();
+
+        bWriting_ = false;
+        condition_.notify_all();
+    }
+}
+
+void AutoSaver::write(const SaveGameData& saveGameData) {
+    const auto filename = getSlotFilename(nextSlot_);
+
+    auto tmpFilename = filename;
+    tmpFilename += ".tmp";
+
+    try {
+        OFileStream fs;
+
+        if (!fs.open(tmpFilename)) {
+            sdl2::log_info("AutoSaver: Cannot open '{}': {}",
+                           reinterpret_cast<const char*>(tmpFilename.u8string().c_str()), dune::string_error(errno));
+            return;
+        }
+
+        saveGameData.write(fs);
+
+        fs.close();
+    } catch (std::exception& e) {
+        sdl2::log_info("AutoSaver: Writing '{}' failed: {}",
+                       reinterpret_cast<const char*>(tmpFilename.u8string().c_str()), e.what());
+
+        std::error_code ec;
+        std::filesystem::remove(tmpFilename, ec);
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpFilename, filename, ec);
+    if (ec) {
+        sdl2::log_info("AutoSaver: Cannot rename '{}': {}",
+                       reinterpret_cast<const char*>(tmpFilename.u8string().c_str()), ec.message());
+        return;
+    }
+
+    sdl2::log_info("Autosaved game cycle {} to '{}'", saveGameData.header.gameCycleCount,
+                   reinterpret_cast<const char*>(filename.u8string().c_str()));
+
+    nextSlot_ = (nextSlot_ + 1) % numSlots_;
+}
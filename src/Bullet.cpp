@@ -287,6 +287,9 @@ void Bullet::blitToScreen(uint32_t cycleCount) const {
         const auto shimmerOffsetIndex = ((cycleCount + getBulletID()) % 24) / 3;
         sx += shimmerOffset[shimmerOffsetIndex % 8] * 2;
 
+        // The pixels read back below have to include everything queued so far
+        dune::flush_sprites();
+
         uint32_t format = 0;
         int access = 0, w = 0, h = 0;
         SDL_QueryTexture(shimmerTex, &format, &access, &w, &h);
@@ -343,24 +346,24 @@ void Bullet::blitToScreen(uint32_t cycleCount) const {
         // copy complete mask
         // contains solid black (0,0,0,255) for pixels to take from screen
         // and transparent (0,0,0,0) for pixels that should not be copied over
-        SDL_SetTextureBlendMode(shimmerMaskTex, SDL_BLENDMODE_NONE);
+        Dune_SetTextureBlendMode(shimmerMaskTex, SDL_BLENDMODE_NONE);
         Dune_RenderCopy(renderer, shimmerMaskTex, nullptr, nullptr);
-        SDL_SetTextureBlendMode(shimmerMaskTex, SDL_BLENDMODE_BLEND);
+        Dune_SetTextureBlendMode(shimmerMaskTex, SDL_BLENDMODE_BLEND);
 
         // now copy r,g,b colors from screen but don't change alpha values in mask
-        SDL_SetTextureBlendMode(screenTexture, SDL_BLENDMODE_ADD);
+        Dune_SetTextureBlendMode(screenTexture, SDL_BLENDMODE_ADD);
         auto source = dest;
         const auto shimmerOffsetIndex = ((cycleCount + getBulletID()) % 24)/3;
         source.x += shimmerOffset[shimmerOffsetIndex%8]*2;
         Dune_RenderCopy(renderer, screenTexture, &source, nullptr);
-        SDL_SetTextureBlendMode(screenTexture, SDL_BLENDMODE_NONE);
+        Dune_SetTextureBlendMode(screenTexture, SDL_BLENDMODE_NONE);
 
         // switch back to old rendering target (from texture 'shimmerTex')
         SDL_SetRenderTarget(renderer, oldRenderTarget);
 #endif // 0
 
         // now blend shimmerTex to screen (= make use of alpha values in mask)
-        SDL_SetTextureBlendMode(shimmerTex, SDL_BLENDMODE_BLEND);
+        Dune_SetTextureBlendMode(shimmerTex, SDL_BLENDMODE_BLEND);
         Dune_RenderCopyF(renderer, shimmerTex, nullptr, &dest);
     } else {
         const auto source = calcSpriteSourceRect(graphic_[zoom], (numFrames_ > 1) ? drawnAngle_ : 0, numFrames_);
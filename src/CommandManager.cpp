@@ -75,10 +75,20 @@ void CommandManager::update() {
     if (network_manager == nullptr)
         return;
 
+    const auto gameCycleCount = game->getGameCycleCount();
+
+    // While the game waits for other players or several frames are drawn per game cycle the command list does not
+    // change. The already serialized packet is sent again then.
+    if (!bCommandsChanged && gameCycleCount == lastSentCycle && networkCycleBuffer == lastSentNetworkCycleBuffer
+        && network_manager->resendCommandList()) {
+        return;
+    }
+
     CommandList commandList;
+    commandList.commandList.reserve(MILLI2CYCLES(2500) + networkCycleBuffer);
 
-    for (uint32_t i = std::max(static_cast<int>(game->getGameCycleCount()) - MILLI2CYCLES(2500), 0);
-         i < game->getGameCycleCount() + networkCycleBuffer; i++) {
+    for (uint32_t i = std::max(static_cast<int>(gameCycleCount) - MILLI2CYCLES(2500), 0);
+         i < gameCycleCount + networkCycleBuffer; i++) {
 
         std::vector<Command> commands;
 
@@ -94,6 +104,10 @@ void CommandManager::update() {
     }
 
     network_manager->sendCommandList(commandList);
+
+    bCommandsChanged           = false;
+    lastSentCycle              = gameCycleCount;
+    lastSentNetworkCycleBuffer = networkCycleBuffer;
 }
 
 void CommandManager::addCommandList(const std::string& playername, const CommandList& commandList) {
@@ -127,6 +141,8 @@ void CommandManager::addCommand(const Command& cmd, uint32_t CycleNumber) {
         timeslot.resize(CycleNumber + 1);
     }
 
+    bCommandsChanged = true;
+
     timeslot[CycleNumber].push_back(cmd);
     std::ranges::stable_sort(timeslot[CycleNumber], [](const Command& cmd1, const Command& cmd2) {
         return (cmd1.getPlayerID() < cmd2.getPlayerID());
@@ -146,6 +162,8 @@ void CommandManager::addCommand(Command&& cmd, uint32_t CycleNumber) {
         timeslot.resize(CycleNumber + 1);
     }
 
+    bCommandsChanged = true;
+
     if (pStream != nullptr) {
         pStream->writeUint32(CycleNumber);
         cmd.save(*pStream);
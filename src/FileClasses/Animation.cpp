@@ -17,6 +17,7 @@
 
 #include <FileClasses/Animation.h>
 
+#include <misc/RedrawScheduler.h>
 #include <misc/Scaler.h>
 #include <misc/draw_util.h>
 
@@ -47,6 +48,10 @@ unsigned int Animation::getCurrentFrameNumber() {
         }
     }
 
+    // the next frame has to be shown after frameDurationTime unless the animation stopped
+    if (frames.size() > 1 && loopsLeft != 0)
+        dune::RedrawScheduler::wakeAt(curFrameStartTime + frameDurationTime);
+
     return (curFrameOverride != INVALID_FRAME) ? curFrameOverride : curFrame;
 }
 
@@ -20,6 +20,8 @@
 #include <FileClasses/Decode.h>
 #include <FileClasses/Palette.h>
 
+#include <misc/RWopsData.h>
+#include <misc/dune_endian.h>
 #include <misc/exceptions.h>
 
 #include "globals.h"
@@ -40,39 +42,38 @@ sdl2::surface_ptr LoadCPS_RW(SDL_RWops* RWop) {
         return nullptr;
     }
 
-    const int64_t endOffset = SDL_RWsize(RWop);
-    if (endOffset <= 0) {
-        THROW(std::runtime_error, "LoadCPS_RW(): Cannot determine size of this *.cps-File!");
-    }
+    // files in PAK-Files are decoded straight from the mapped PAK-File
+    const RWopsData filedata{RWop};
+    const auto* const pFiledata = filedata.get();
 
-    const auto cpsFilesize = static_cast<size_t>(endOffset);
-    const auto pFiledata   = std::make_unique<uint8_t[]>(cpsFilesize);
-
-    if (SDL_RWread(RWop, pFiledata.get(), cpsFilesize, 1) != 1) {
-        THROW(std::runtime_error, "LoadCPS_RW(): Reading this *.cps-File failed!");
+    if (filedata.size() < 10) {
+        THROW(std::runtime_error, "LoadCPS_RW(): Cannot determine size of this *.cps-File!");
     }
 
-    const uint16_t format = SDL_SwapLE16(*reinterpret_cast<uint16_t*>(pFiledata.get() + 2));
+    const uint16_t format = dune::read_le_uint16(pFiledata + 2);
 
     if (format != 0x0004) {
         THROW(std::runtime_error, "LoadCPS_RW(): Only Format80 encoded *.cps-Files are supported!");
     }
 
-    unsigned int SizeXTimeSizeY = SDL_SwapLE16(*reinterpret_cast<uint16_t*>(pFiledata.get() + 4));
-    SizeXTimeSizeY += SDL_SwapLE16(*reinterpret_cast<uint16_t*>(pFiledata.get() + 6));
+    unsigned int SizeXTimeSizeY = dune::read_le_uint16(pFiledata + 4);
+    SizeXTimeSizeY += dune::read_le_uint16(pFiledata + 6);
 
     if (SizeXTimeSizeY != SIZE_X * SIZE_Y) {
         THROW(std::runtime_error, "LoadCPS_RW(): Images must be 320x200 pixels big!");
     }
 
-    const uint16_t PaletteSize = SDL_SwapLE16(*reinterpret_cast<uint16_t*>(pFiledata.get() + 8));
+    const uint16_t PaletteSize = dune::read_le_uint16(pFiledata + 8);
+
+    if (filedata.size() < 10U + PaletteSize) {
+        THROW(std::runtime_error, "LoadCPS_RW(): This *.cps-File is too short!");
+    }
 
     const auto pImageOut = std::make_unique<uint8_t[]>(static_cast<size_t>(SIZE_X) * SIZE_Y);
     memset(pImageOut.get(), 0, static_cast<size_t>(SIZE_X) * SIZE_Y);
 
-    if (decode80(pFiledata.get() + 10 + PaletteSize, pImageOut.get(), 0) == -2) {
-        THROW(std::runtime_error, "LoadCPS_RW(): Decoding this *.cps-File failed!");
-    }
+    decode80({pFiledata + 10 + PaletteSize, filedata.size() - 10 - PaletteSize},
+             {pImageOut.get(), static_cast<size_t>(SIZE_X) * SIZE_Y});
 
     // create new picture surface
     auto pic = sdl2::surface_ptr{SDL_CreateRGBSurface(0, SIZE_X, SIZE_Y, 8, 0, 0, 0, 0)};
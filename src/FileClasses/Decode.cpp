@@ -17,26 +17,124 @@
 
 #include <FileClasses/Decode.h>
 
-#include <misc/SDL2pp.h>
 #include <misc/dune_endian.h>
 #include <misc/exceptions.h>
 
-void memcpy_overlap(unsigned char* dst, const unsigned char* src, unsigned cnt) {
-    /* Copies memory areas that may overlap byte by byte from small memory
-     * addresses to big memory addresses. Thus, already copied bytes can be
-     * copied again. */
-    if (dst + cnt < src || src + cnt < dst) {
-        memcpy(dst, src, cnt);
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/// The read position in the compressed data; every read is checked against the end of the data.
+class Reader final {
+public:
+    Reader(std::span<const uint8_t> input, const char* decoder) : input_{input}, decoder_{decoder} { }
+
+    /// Makes sure that count more bytes can be read.
+    void require(size_t count) const {
+        if (input_.size() - pos_ < count)
+            THROW(std::invalid_argument, "{}: Compressed data ends unexpectedly!", decoder_);
+    }
+
+    uint8_t byte() {
+        require(1);
+        return input_[pos_++];
+    }
+
+    uint16_t word() {
+        require(2);
+        const auto value = dune::read_le_uint16(input_.data() + pos_);
+        pos_ += 2;
+        return value;
+    }
+
+    /// Returns the next count bytes.
+    const uint8_t* bytes(size_t count) {
+        require(count);
+        const auto* const p = input_.data() + pos_;
+        pos_ += count;
+        return p;
+    }
+
+private:
+    std::span<const uint8_t> input_;
+    size_t pos_ = 0;
+    const char* decoder_;
+};
+
+/// Makes sure that count bytes can be written at position pos of output.
+void require_space(std::span<const uint8_t> output, size_t pos, size_t count, const char* decoder) {
+    if (output.size() - pos < count)
+        THROW(std::invalid_argument, "{}: Decompressed data does not fit into {} bytes!", decoder, output.size());
+}
+
+/**
+    Copies count bytes from src to dst like a byte by byte copy from small to big addresses. If the source is before
+    the destination and the areas overlap, the copied bytes are copied again, so the source pattern is repeated.
+*/
+void copy_forward(uint8_t* dst, const uint8_t* src, size_t count) {
+    if (src >= dst) {
+        // Reading ahead of the writes is the same as memmove
+        memmove(dst, src, count);
+        return;
+    }
+
+    const auto distance = static_cast<size_t>(dst - src);
+
+    if (distance >= count) {
+        memcpy(dst, src, count);
+        return;
+    }
+
+    if (distance == 1) {
+        memset(dst, *src, count);
         return;
     }
-    while (cnt--) {
-        *dst = *src;
-        dst++;
-        src++;
+
+    // The output is periodic with period distance, so every copy can take twice as much as the previous one
+    auto done = std::min(distance, count);
+    memcpy(dst, src, done);
+
+    while (done < count) {
+        const auto step = done / distance * distance;
+        const auto n    = std::min(count - done, step);
+
+        memcpy(dst + done, dst + done - step, n);
+        done += n;
+    }
+}
+
+void xor_fill(uint8_t* dst, uint8_t value, size_t count) {
+    const auto pattern = uint64_t{0x0101010101010101} * value;
+
+    for (; count >= sizeof(uint64_t); count -= sizeof(uint64_t), dst += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, dst, sizeof(word));
+        word ^= pattern;
+        memcpy(dst, &word, sizeof(word));
     }
+
+    for (; count; --count)
+        *dst++ ^= value;
 }
 
-int decode40(const unsigned char* image_in, unsigned char* image_out) {
+void xor_copy(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (; count >= sizeof(uint64_t); count -= sizeof(uint64_t), dst += sizeof(uint64_t), src += sizeof(uint64_t)) {
+        uint64_t word;
+        uint64_t other;
+        memcpy(&word, dst, sizeof(word));
+        memcpy(&other, src, sizeof(other));
+        word ^= other;
+        memcpy(dst, &word, sizeof(word));
+    }
+
+    for (; count; --count)
+        *dst++ ^= *src++;
+}
+
+} // namespace
+
+size_t decode40(std::span<const uint8_t> input, std::span<uint8_t> output) {
     /*
     0 fill 00000000 c v
     1 copy 0ccccccc
@@ -46,86 +144,72 @@ int decode40(const unsigned char* image_in, unsigned char* image_out) {
     5 skip 1ccccccc
     */
 
-    const unsigned char* readp = image_in;
-    unsigned char* writep      = image_out;
-    uint16_t count             = 0;
+    static constexpr auto decoder = "decode40()";
+
+    Reader reader{input, decoder};
+    size_t pos = 0;
+
+    const auto advance = [&](size_t count) {
+        require_space(output, pos, count, decoder);
+        auto* const p = output.data() + pos;
+        pos += count;
+        return p;
+    };
+
     while (true) {
-        uint16_t code = *readp++;
+        const auto code = reader.byte();
+
         if (~code & 0x80) {
             // bit 7 = 0
             if (!code) {
                 // command 0 (00000000 c v): fill
-                count = *readp++;
-                code  = *readp++;
-                while (count--)
-                    *writep++ ^= code;
+                const auto count = reader.byte();
+                const auto value = reader.byte();
+                xor_fill(advance(count), value, count);
             } else {
                 // command 1 (0ccccccc): copy
-                count = code;
-                while (count--)
-                    *writep++ ^= *readp++;
+                const auto* const src = reader.bytes(code);
+                xor_copy(advance(code), src, code);
             }
-
         } else {
             // bit 7 = 1
-            count = code & 0x7f;
+            size_t count = code & 0x7f;
             if (!count) {
-                count = dune::read_le_uint16(readp);
-                readp += 2;
-                code = count >> 8;
-                if (~code & 0x80) {
+                const auto word = reader.word();
+                if (~word & 0x8000) {
                     // bit 7 = 0
                     // command 2 (10000000 c 0ccccccc): skip
-                    if (!count) {
+                    if (!word) {
                         // end of image
                         break;
                     }
-                    writep += count;
+                    advance(word);
                 } else {
                     // bit 7 = 1
-                    count &= 0x3fff;
-                    if (~code & 0x40) {
+                    count = word & 0x3fff;
+                    if (~word & 0x4000) {
                         // bit 6 = 0
                         // command 3 (10000000 c 10cccccc): copy
-                        while (count--) {
-                            *writep++ ^= *readp++;
-                        }
+                        const auto* const src = reader.bytes(count);
+                        xor_copy(advance(count), src, count);
                     } else {
                         // bit 6 = 1
                         // command 4 (10000000 c 11cccccc v): fill
-                        code = *readp++;
-                        while (count--) {
-                            *writep++ ^= code;
-                        }
+                        const auto value = reader.byte();
+                        xor_fill(advance(count), value, count);
                     }
                 }
             } else {
                 // command 5 (1ccccccc): skip
-                writep += count;
+                advance(count);
             }
         }
     }
-    return static_cast<int>(writep - image_out);
+
+    return pos;
 }
 
-int decode80(const unsigned char* image_in, unsigned char* image_out, unsigned checksum) {
-    //
-    // should decode all the format80 stuff ;-)
-    //
-
-    const unsigned char* readp = image_in;
-    unsigned char* writep      = image_out;
-
-    unsigned int a          = 0;
-    unsigned int b          = 0;
-    unsigned int c          = 0;
-    unsigned int d          = 0;
-    unsigned int e          = 0;
-    unsigned int megacounta = 0;
-    unsigned int megacountb = 0;
-    unsigned int megacountc = 0;
-    unsigned int megacountd = 0;
-    unsigned int megacounte = 0;
+size_t decode80(std::span<const uint8_t> input, std::span<uint8_t> output) {
     /*
        1 10cccccc
        2 0cccpppp p
@@ -134,73 +218,75 @@ int decode80(const unsigned char* image_in, unsigned char* image_out, unsigned c
        5 11111111 c c p p
      */
 
+    static constexpr auto decoder = "decode80()";
+
+    Reader reader{input, decoder};
+    size_t pos = 0;
+
+    auto* const out = output.data();
+
+    // Copies count bytes from the absolute position src of the output
+    const auto copy_from = [&](size_t src, size_t count) {
+        require_space(output, pos, count, decoder);
+
+        if (src > output.size() || output.size() - src < count)
+            THROW(std::invalid_argument, "{}: Reference to data outside of the {} bytes output!", decoder,
+                  output.size());
+
+        copy_forward(out + pos, out + src, count);
+        pos += count;
+    };
+
     while (true) {
-        if ((*readp & 0xc0) == 0x80) {
+        const auto code = reader.byte();
+
+        if ((code & 0xc0) == 0x80) {
             //
             // 10cccccc (1)
             //
-            const unsigned count = readp[0] & 0x3f;
-            // sdl2::log_info("Cmd 1, count: {}", count);
-            megacounta += count;
+            const size_t count = code & 0x3f;
             if (!count) {
                 break;
             }
-            readp++;
-            memcpy_overlap(writep, readp, count);
-            readp += count;
-            writep += count;
-            a++;
-        } else if ((*readp & 0x80) == 0x00) {
+            const auto* const src = reader.bytes(count);
+            require_space(output, pos, count, decoder);
+            memcpy(out + pos, src, count);
+            pos += count;
+        } else if ((code & 0x80) == 0x00) {
             //
             // 0cccpppp p (2)
             //
-            const unsigned count = ((readp[0] & 0x70) >> 4) + 3;
-            const unsigned short relpos =
-                static_cast<unsigned short>(readp[0] & 0xf) << 8 | static_cast<unsigned short>(readp[1]);
-            readp += 2;
-            megacountb += count;
-            memcpy_overlap(writep, writep - relpos, count);
-            writep += count;
-            b++;
-        } else if (*readp == 0xff) {
+            const size_t count  = ((code & 0x70) >> 4) + 3;
+            const size_t relpos = static_cast<size_t>(code & 0xf) << 8 | reader.byte();
+            if (relpos > pos) {
+                THROW(std::invalid_argument, "{}: Reference to data before the start of the output!", decoder);
+            }
+            copy_from(pos - relpos, count);
+        } else if (code == 0xff) {
             //
             // 11111111 c c p p (5)
             //
-            const unsigned short count = dune::read_le_uint16(readp + 1);
-            const unsigned short pos   = dune::read_le_uint16(readp + 3);
-            readp += 5;
-            megacounte += count;
-            memcpy_overlap(writep, image_out + pos, count);
-            writep += count;
-            e++;
-        } else if (*readp == 0xfe) {
+            const size_t count = reader.word();
+            const size_t src   = reader.word();
+            copy_from(src, count);
+        } else if (code == 0xfe) {
             //
-            // 11111110 c c v(4)
+            // 11111110 c c v (4)
             //
-            const unsigned short count = dune::read_le_uint16(readp + 1);
-            const unsigned char color  = readp[3];
-            readp += 4;
-            memset(writep, color, count);
-            writep += count;
-            megacountd += count;
-            d++;
-        } else if ((*readp & 0xc0) == 0xc0) {
+            const size_t count = reader.word();
+            const auto color   = reader.byte();
+            require_space(output, pos, count, decoder);
+            memset(out + pos, color, count);
+            pos += count;
+        } else {
             //
             // 11cccccc p p (3)
             //
-            const unsigned short count = (*readp & 0x3f) + 3;
-            const unsigned short pos   = dune::read_le_uint16(readp + 1);
-            readp += 3;
-            megacountc += count;
-            memcpy_overlap(writep, image_out + pos, count);
-            writep += count;
-            c++;
-        } else {
-            THROW(std::invalid_argument, "Decode: File contains unknown format80 command");
+            const size_t count = (code & 0x3f) + 3;
+            const size_t src   = reader.word();
+            copy_from(src, count);
         }
     }
-    if (megacounta + megacountb + megacountc + megacountd + megacounte != checksum)
-        return -1;
 
-    return 0;
+    return pos;
 }
@@ -76,6 +76,7 @@ void createDefaultConfigFile(std::filesystem::path configfilepath, const std::st
                                 "Language = %s               # en = English, fr = French, de = German\n"
                                 "Scroll Speed = 50           # Amount to scroll the map when the cursor is near the screen border\n"
                                 "Show Tutorial Hints = true  # Show tutorial hints during the game\n"
+                                "Autosave Interval = 5       # Minutes of game time between two autosaves (0 = off)\n"
                                 "\n"
                                 "[Video]\n"
                                 "# Minimum resolution is 640x480\n"
@@ -88,6 +89,7 @@ void createDefaultConfigFile(std::filesystem::path configfilepath, const std::st
                                 "Preferred Zoom Level = 1    # 0 = no zooming, 1 = 2x, 2 = 3x\n"
                                 "Scaler = ScaleHD            # Scaler to use: ScaleHD = apply manual drawn mask to upscale, Scale2x = smooth edges, ScaleNN = nearest neighbour, \n"
                                 "RotateUnitGraphics = false  # Freely rotate unit graphics, e.g. carryall graphics\n"
+                                "Dirty Regions = true        # Only redraw the changed parts of the screen with the software renderer\n"
                                 "\n"
                                 "[Audio]\n"
                                 "# There are three different possibilities to play music\n"
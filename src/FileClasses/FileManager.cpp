@@ -23,6 +23,8 @@
 
 #include <misc/FileSystem.h>
 
+#include <misc/IFileStream.h>
+#include <misc/OFileStream.h>
 #include <misc/exceptions.h>
 #include <misc/fnkdat.h>
 #include <misc/md5.h>
@@ -32,10 +34,27 @@
 #include <filesystem>
 #include <mutex>
 
+namespace {
+/// \return the size and the modification time of a file
+std::optional<std::tuple<uint64_t, int64_t>> file_stamp(const std::filesystem::path& file) {
+    std::error_code ec;
+
+    const auto size = std::filesystem::file_size(file, ec);
+    if (ec)
+        return std::nullopt;
+
+    const auto modificationTime = std::filesystem::last_write_time(file, ec);
+    if (ec)
+        return std::nullopt;
+
+    return std::make_tuple(static_cast<uint64_t>(size),
+                           static_cast<int64_t>(modificationTime.time_since_epoch().count()));
+}
+} // namespace
+
 std::vector<std::unique_ptr<Pakfile>>
 PakFileManager::loadPakFiles(const CaseInsensitiveFilesystemCache& cache, std::span<const std::string> files) {
     sdl2::log_info("FileManager is loading PAK-Files...");
-    sdl2::log_info("MD5-Checksum                      Filename");
 
     std::vector<std::unique_ptr<Pakfile>> pakFiles;
     pakFiles.reserve(files.size());
@@ -49,16 +68,52 @@ PakFileManager::loadPakFiles(const CaseInsensitiveFilesystemCache& cache, std::s
         auto& filepath = filepath0.value();
 
         try {
-            sdl2::log_info("{}  {}", md5FromFilename(filepath), filepath.string());
             pakFiles.emplace_back(std::make_unique<Pakfile>(filepath));
         } catch (std::exception& e) {
             THROW(io_error, "Error while opening '{}': {}!", filepath.string(), e.what());
         }
     }
 
+    return pakFiles;
+}
+
+void PakFileManager::logDigests() {
+    const auto [ok, cacheFilename] = fnkdat("cache/pakdigests.bin", FNKDAT_USER | FNKDAT_CREAT);
+
+    auto digestCache = std::make_unique<PakDigestCache>(ok ? cacheFilename : std::filesystem::path{});
+
+    sdl2::log_info("MD5-Checksum                      Filename");
+
+    std::vector<std::filesystem::path> uncached;
+    for (const auto& pakFile : pakFiles_) {
+        const auto& filename = pakFile->getPakfilename();
+
+        if (auto digest = digestCache->find(filename))
+            sdl2::log_info("{}  {}", *digest, filename.string());
+        else
+            uncached.push_back(filename);
+    }
+
     sdl2::log_info("");
 
-    return pakFiles;
+    if (uncached.empty())
+        return;
+
+    // hashing new or changed PAK-Files reads them completely, so it must not delay the startup
+    digestThread_ = std::thread{[uncached = std::move(uncached), digestCache = std::move(digestCache), ok = ok] {
+        for (const auto& filename : uncached) {
+            try {
+                auto digest = md5FromFilename(filename);
+                sdl2::log_info("{}  {}", digest, filename.string());
+                digestCache->insert(filename, std::move(digest));
+            } catch (std::exception& e) {
+                sdl2::log_info("Cannot compute the MD5-Checksum of '{}': {}", filename.string(), e.what());
+            }
+        }
+
+        if (ok)
+            digestCache->save();
+    }};
 }
 
 PakFileManager::pak_directory_type PakFileManager::createPakDirectory() const {
@@ -83,6 +138,18 @@ std::optional<std::filesystem::path> CaseInsensitiveFilesystemCache::find(const
     return it->second;
 }
 
+std::vector<std::filesystem::path> CaseInsensitiveFilesystemCache::files() const {
+    std::vector<std::filesystem::path> paths;
+    paths.reserve(files_.size());
+
+    for (const auto& [filename, path] : files_)
+        paths.push_back(path);
+
+    std::ranges::sort(paths);
+
+    return paths;
+}
+
 CaseInsensitiveFilesystemCache::filesystem_directory_type
 CaseInsensitiveFilesystemCache::createFilesystemDirectory(std::span<const std::filesystem::path> paths) const {
     filesystem_directory_type files;
@@ -180,6 +247,29 @@ sdl2::RWops_ptr FileManager::openFile(std::filesystem::path filename) const {
     THROW(io_error, "Cannot find '{}'!", filename.string());
 }
 
+std::string FileManager::getContentStamp() const {
+    md5_context context;
+    md5_starts(&context);
+
+    for (const auto& path : filesystem_cache_.files()) {
+        const auto name = path.u8string();
+        md5_update(&context, reinterpret_cast<const uint8_t*>(name.data()), name.size() + 1);
+
+        const auto stamp = file_stamp(path);
+        if (!stamp)
+            continue;
+
+        const auto [size, modificationTime] = *stamp;
+        md5_update(&context, reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+        md5_update(&context, reinterpret_cast<const uint8_t*>(&modificationTime), sizeof(modificationTime));
+    }
+
+    std::array<uint8_t, 16> digest{};
+    md5_finish(&context, digest.data());
+
+    return to_hex(digest, 0);
+}
+
 bool FileManager::exists(std::filesystem::path filename) const {
     if (filename.is_absolute()) {
         std::error_code ec;
@@ -248,7 +338,84 @@ std::string PakFileManager::md5FromFilename(std::filesystem::path filename) {
 }
 
 PakFileManager::PakFileManager(const CaseInsensitiveFilesystemCache& cache, std::span<const std::string> files)
-    : pakFiles_{loadPakFiles(cache, files)}, pak_directory_(createPakDirectory()) { }
+    : pakFiles_{loadPakFiles(cache, files)}, pak_directory_(createPakDirectory()) {
+    logDigests();
+}
+
+PakFileManager::~PakFileManager() {
+    if (digestThread_.joinable())
+        digestThread_.join();
+}
+
+PakDigestCache::PakDigestCache(std::filesystem::path cacheFilename) : cacheFilename_{std::move(cacheFilename)} {
+    if (cacheFilename_.empty())
+        return;
+
+    IFileStream stream;
+    if (!stream.open(cacheFilename_))
+        return;
+
+    try {
+        const auto numEntries = stream.readUint32();
+        for (auto i = 0U; i < numEntries; ++i) {
+            const auto filename = stream.readString();
+
+            Entry entry;
+            entry.size             = stream.readUint64();
+            entry.modificationTime = stream.readSint64();
+            entry.digest           = stream.readString();
+
+            entries_[std::u8string{filename.begin(), filename.end()}] = std::move(entry);
+        }
+    } catch (InputStream::exception& e) {
+        sdl2::log_info("Ignoring the broken PAK digest cache '{}': {}", cacheFilename_.string(), e.what());
+        entries_.clear();
+    }
+}
+
+std::optional<std::string> PakDigestCache::find(const std::filesystem::path& filename) const {
+    const auto it = entries_.find(filename.u8string());
+    if (it == entries_.end())
+        return std::nullopt;
+
+    const auto stamp = file_stamp(filename);
+    if (!stamp || *stamp != std::make_tuple(it->second.size, it->second.modificationTime))
+        return std::nullopt;
+
+    return it->second.digest;
+}
+
+void PakDigestCache::insert(const std::filesystem::path& filename, std::string digest) {
+    const auto stamp = file_stamp(filename);
+    if (!stamp)
+        return;
+
+    const auto [size, modificationTime] = *stamp;
+
+    entries_[filename.u8string()] = Entry{size, modificationTime, std::move(digest)};
+}
+
+void PakDigestCache::save() const {
+    try {
+        OFileStream stream;
+        if (!stream.open(cacheFilename_)) {
+            sdl2::log_info("Cannot write the PAK digest cache '{}'!", cacheFilename_.string());
+            return;
+        }
+
+        stream.writeUint32(gsl::narrow<uint32_t>(entries_.size()));
+        for (const auto& [filename, entry] : entries_) {
+            stream.writeString({reinterpret_cast<const char*>(filename.data()), filename.size()});
+            stream.writeUint64(entry.size);
+            stream.writeSint64(entry.modificationTime);
+            stream.writeString(entry.digest);
+        }
+
+        stream.close();
+    } catch (std::exception& e) {
+        sdl2::log_info("Cannot write the PAK digest cache '{}': {}", cacheFilename_.string(), e.what());
+    }
+}
 
 std::tuple<const Pakfile*, int> PakFileManager::find(const std::string& filename) const {
     const auto it = pak_directory_.find(filename);
@@ -17,74 +17,59 @@
 
 #include <FileClasses/GFXManager.h>
 
+#include <globals.h>
+
+#include <FileClasses/FileManager.h>
 #include <FileClasses/SurfaceLoader.h>
 #include <Renderer/DuneTextures.h>
 
 #include <misc/draw_util.h>
 #include <misc/exceptions.h>
+#include <misc/fnkdat.h>
+
+#include <config.h>
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
+#include <vector>
+
+namespace {
+std::unique_ptr<TextureAtlasCache> createAtlasCache(const char* name, int width, int height) {
+    const auto [ok, filename] = fnkdat(name, FNKDAT_USER | FNKDAT_CREAT);
+    if (!ok)
+        return nullptr;
+
+    const auto& settings = dune::globals::settings;
+
+    // everything the content of the atlases depends on
+    auto key = fmt::format("{} {}x{} {} {} {} {}", VERSION, width, height, settings.video.scaler,
+                           settings.general.language, settings.video.typeface,
+                           dune::globals::pFileManager->getContentStamp());
+
+    return std::make_unique<TextureAtlasCache>(filename, std::move(key));
+}
+} // namespace
+
 GFXManager::GFXManager(SDL_Renderer* renderer, int width, int height)
-    : random_{RandomFactory{}.create("UI")}, surfaceLoader{width, height}, duneTextures{DuneTextures::create(
-                                                                               renderer, &surfaceLoader)} {
+    : random_{RandomFactory{}.create("UI")}, width_{width}, height_{height},
+      atlasCache_{createAtlasCache("cache/textureatlas.bin", width, height)},
+      cursorCache_{createAtlasCache("cache/cursors.bin", width, height)},
+      duneTextures{DuneTextures::create(renderer, [this] { return &getSurfaceLoader(); }, atlasCache_.get())} {
     initialize_cursors();
 }
 
 GFXManager::~GFXManager() = default;
 
+SurfaceLoader& GFXManager::getSurfaceLoader() const {
+    if (!surfaceLoader_)
+        surfaceLoader_ = std::make_unique<SurfaceLoader>(width_, height_);
+
+    return *surfaceLoader_;
+}
+
 const DuneTexture* GFXManager::getZoomedObjPic(ObjPic_enum id, HOUSETYPE house, unsigned int z) const {
     return &duneTextures.get_object_picture(id, house, z);
-#if 0
-    auto* surface = surfaceLoader.getZoomedObjSurface(id, house, z);
-
-    const auto idx = static_cast<int>(house);
-
-    if(objPicTex[id][idx][z] == nullptr) {
-        auto make_shadow_texture = [](SDL_Surface* surface, Uint32 oldColor, Uint32 newColor) {
-            replaceColor(surface, oldColor, newColor);
-            if(SDL_SetSurfaceBlendMode(surface, SDL_BlendMode::SDL_BLENDMODE_BLEND))
-                THROW(std::runtime_error,
-                      std::string("getObjPic(): SDL_SetSurfaceBlendMode() failed: ") + std::string(SDL_GetError()));
-            auto tex = convertSurfaceToTexture(surface);
-            if(SDL_SetTextureBlendMode(tex.get(), SDL_BlendMode::SDL_BLENDMODE_BLEND))
-                THROW(std::runtime_error,
-                      std::string("getObjPic(): SDL_SetTextureBlendMode() failed: ") + std::string(SDL_GetError()));
-
-            return tex;
-        };
-
-        // now convert to display format
-        if(id == ObjPic_Windtrap) {
-            // Windtrap uses palette animation on PALCOLOR_WINDTRAP_COLORCYCLE; fake this
-            objPicTex[id][idx][z] = convertSurfaceToTexture(surfaceLoader.generateWindtrapAnimationFrames(surface));
-#    if 1
-        } else if(id == ObjPic_Terrain_HiddenFog) {
-            const auto pHiddenFog       = convertSurfaceToDisplayFormat(surface);
-            objPicTex[id][idx][z] = make_shadow_texture(pHiddenFog.get(), COLOR_BLACK, COLOR_FOG_TRANSPARENT);
-        } else if(id == ObjPic_CarryallShadow) {
-            const auto pShadow          = convertSurfaceToDisplayFormat(surface);
-            objPicTex[id][idx][z] = make_shadow_texture(pShadow.get(), COLOR_BLACK, COLOR_SHADOW_TRANSPARENT);
-        } else if(id == ObjPic_FrigateShadow) {
-            const auto pShadow          = convertSurfaceToDisplayFormat(surface);
-            objPicTex[id][idx][z] = make_shadow_texture(pShadow.get(), COLOR_BLACK, COLOR_SHADOW_TRANSPARENT);
-        } else if(id == ObjPic_OrnithopterShadow) {
-            const auto pShadow          = convertSurfaceToDisplayFormat(surface);
-            objPicTex[id][idx][z] = make_shadow_texture(pShadow.get(), COLOR_BLACK, COLOR_SHADOW_TRANSPARENT);
-#    endif // 0
-        } else if(id == ObjPic_Bullet_SonicTemp) {
-            objPicTex[id][idx][z] = sdl2::texture_ptr{SDL_CreateTexture(
-                renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_STREAMING, surface->w, surface->h)};
-        } else if(id == ObjPic_SandwormShimmerTemp) {
-            objPicTex[id][idx][z] = sdl2::texture_ptr{SDL_CreateTexture(
-                renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, surface->w, surface->h)};
-        } else {
-            objPicTex[id][idx][z] = convertSurfaceToTexture(surface);
-        }
-    }
-
-    return objPicTex[id][idx][z].get();
-#endif     // 0
 }
 
 zoomable_texture GFXManager::getObjPic(ObjPic_enum id, HOUSETYPE house) const {
@@ -92,8 +77,11 @@ zoomable_texture GFXManager::getObjPic(ObjPic_enum id, HOUSETYPE house) const {
         THROW(std::invalid_argument, "GFXManager::getObjPic(): Unit Picture with ID {} is not available!", static_cast<int>(id));
     }
 
-    return {&duneTextures.get_object_picture(id, house, 0), &duneTextures.get_object_picture(id, house, 1),
-            &duneTextures.get_object_picture(id, house, 2)};
+    return duneTextures.get_object_pictures(id, house, dune::globals::currentZoomlevel);
+}
+
+void GFXManager::prepareZoomlevel(int z) const {
+    duneTextures.prepare_zoom_level(z);
 }
 
 const DuneTexture* GFXManager::getSmallDetailPic(SmallDetailPics_Enum id) const {
@@ -190,12 +178,6 @@ SDL_Texture* GFXManager::getTempStreamingTexture(SDL_Renderer* renderer, int wid
     }
 }
 
-sdl2::texture_ptr GFXManager::extractSmallDetailPicTex(const std::string& filename) const {
-    const auto pSurface = surfaceLoader.extractSmallDetailPic(filename);
-
-    return convertSurfaceToTexture(pSurface.get());
-}
-
 namespace {
 struct cursor_definition {
     UIGraphics_Enum id_;
@@ -203,32 +185,63 @@ struct cursor_definition {
     VAlign v_align_;
 };
 
+constexpr auto cursor_ids = std::to_array<cursor_definition>({
+    {UI_CursorNormal, HAlign::Left, VAlign::Top},
+    {UI_CursorUp, HAlign::Left, VAlign::Top},
+    {UI_CursorRight, HAlign::Center, VAlign::Top},
+    {UI_CursorDown, HAlign::Left, VAlign::Center},
+    {UI_CursorLeft, HAlign::Left, VAlign::Top},
+    {UI_CursorMove_Zoomlevel0, HAlign::Center, VAlign::Center},
+    {UI_CursorMove_Zoomlevel1, HAlign::Center, VAlign::Center},
+    {UI_CursorMove_Zoomlevel2, HAlign::Center, VAlign::Center},
+    {UI_CursorAttack_Zoomlevel0, HAlign::Center, VAlign::Center},
+    {UI_CursorAttack_Zoomlevel1, HAlign::Center, VAlign::Center},
+    {UI_CursorAttack_Zoomlevel2, HAlign::Center, VAlign::Center},
+    {UI_CursorCapture_Zoomlevel0, HAlign::Center, VAlign::Bottom},
+    {UI_CursorCapture_Zoomlevel1, HAlign::Center, VAlign::Bottom},
+    {UI_CursorCapture_Zoomlevel2, HAlign::Center, VAlign::Bottom},
+    {UI_CursorCarryallDrop_Zoomlevel0, HAlign::Center, VAlign::Bottom},
+    {UI_CursorCarryallDrop_Zoomlevel1, HAlign::Center, VAlign::Bottom},
+    {UI_CursorCarryallDrop_Zoomlevel2, HAlign::Center, VAlign::Bottom},
+});
 } // namespace
-void GFXManager::initialize_cursors() {
-    static constexpr auto cursor_ids = std::to_array<cursor_definition>({
-        {UI_CursorNormal, HAlign::Left, VAlign::Top},
-        {UI_CursorUp, HAlign::Left, VAlign::Top},
-        {UI_CursorRight, HAlign::Center, VAlign::Top},
-        {UI_CursorDown, HAlign::Left, VAlign::Center},
-        {UI_CursorLeft, HAlign::Left, VAlign::Top},
-        {UI_CursorMove_Zoomlevel0, HAlign::Center, VAlign::Center},
-        {UI_CursorMove_Zoomlevel1, HAlign::Center, VAlign::Center},
-        {UI_CursorMove_Zoomlevel2, HAlign::Center, VAlign::Center},
-        {UI_CursorAttack_Zoomlevel0, HAlign::Center, VAlign::Center},
-        {UI_CursorAttack_Zoomlevel1, HAlign::Center, VAlign::Center},
-        {UI_CursorAttack_Zoomlevel2, HAlign::Center, VAlign::Center},
-        {UI_CursorCapture_Zoomlevel0, HAlign::Center, VAlign::Bottom},
-        {UI_CursorCapture_Zoomlevel1, HAlign::Center, VAlign::Bottom},
-        {UI_CursorCapture_Zoomlevel2, HAlign::Center, VAlign::Bottom},
-        {UI_CursorCarryallDrop_Zoomlevel0, HAlign::Center, VAlign::Bottom},
-        {UI_CursorCarryallDrop_Zoomlevel1, HAlign::Center, VAlign::Bottom},
-        {UI_CursorCarryallDrop_Zoomlevel2, HAlign::Center, VAlign::Bottom},
-    });
 
-    default_cursor_.reset(SDL_CreateSystemCursor(SDL_SystemCursor::SDL_SYSTEM_CURSOR_ARROW));
+std::vector<sdl2::surface_ptr> GFXManager::loadCursorSurfaces() const {
+    if (cursorCache_) {
+        if (auto contents = cursorCache_->load(); contents && contents->atlases.size() == cursor_ids.size())
+            return std::move(contents->atlases);
+    }
+
+    std::vector<sdl2::surface_ptr> surfaces;
+    surfaces.reserve(cursor_ids.size());
 
     for (const auto& cd : cursor_ids) {
-        auto* const surface = getUIGraphicSurface(cd.id_);
+        auto* const surface = getSurfaceLoader().getUIGraphicSurface(cd.id_);
+
+        // SDL_CreateColorCursor() converts the surface to this format anyway
+        surfaces.emplace_back(surface ? SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr);
+    }
+
+    if (cursorCache_ && std::ranges::all_of(surfaces, [](const auto& surface) { return surface != nullptr; })) {
+        TextureAtlasCache::Contents contents;
+
+        for (const auto& surface : surfaces)
+            contents.atlases.emplace_back(SDL_DuplicateSurface(surface.get()));
+
+        cursorCache_->store(std::move(contents));
+    }
+
+    return surfaces;
+}
+
+void GFXManager::initialize_cursors() {
+    default_cursor_.reset(SDL_CreateSystemCursor(SDL_SystemCursor::SDL_SYSTEM_CURSOR_ARROW));
+
+    const auto surfaces = loadCursorSurfaces();
+
+    for (auto i = 0U; i < cursor_ids.size(); ++i) {
+        const auto& cd      = cursor_ids[i];
+        auto* const surface = surfaces[i].get();
 
         if (!surface)
             continue;
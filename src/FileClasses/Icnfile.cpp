@@ -19,6 +19,7 @@
 
 #include <FileClasses/Palette.h>
 
+#include <misc/dune_endian.h>
 #include <misc/exceptions.h>
 
 #include "globals.h"
@@ -49,47 +50,34 @@ Icnfile::Icnfile(SDL_RWops* icnRWop, SDL_RWops* mapRWop) {
         THROW(std::invalid_argument, "Icnfile::Icnfile(): mapRWop == nullptr!");
     }
 
-    std::unique_ptr<uint8_t[]> pMapFiledata;
-
-    const int64_t icnEndOffset = SDL_RWsize(icnRWop);
-    if (icnEndOffset <= 0) {
+    // files in PAK-Files are not copied but viewed in the mapped PAK-File
+    pIcnFiledata           = RWopsData{icnRWop};
+    const auto icnFilesize = pIcnFiledata.size();
+    if (icnFilesize == 0) {
         THROW(std::runtime_error, "Icnfile::Icnfile(): Cannot determine size of this *.icn-File!");
     }
 
-    const auto icnFilesize = static_cast<size_t>(icnEndOffset);
-    pIcnFiledata           = std::make_unique<uint8_t[]>(icnFilesize);
-
-    if (SDL_RWread(icnRWop, &pIcnFiledata[0], icnFilesize, 1) != 1) {
-        THROW(std::runtime_error, "Icnfile::Icnfile(): Reading this *.icn-File failed!");
-    }
-
-    const int64_t mapEndOffset = SDL_RWsize(mapRWop);
-    if (mapEndOffset <= 0) {
+    RWopsData pMapFiledata{mapRWop};
+    const auto mapFilesize = pMapFiledata.size();
+    if (mapFilesize == 0) {
         THROW(std::runtime_error, "Icnfile::Icnfile(): Cannot determine size of this *.map-File!");
     }
 
-    const auto mapFilesize = static_cast<size_t>(mapEndOffset);
-    pMapFiledata           = std::make_unique<uint8_t[]>(mapFilesize);
-
-    if (SDL_RWread(mapRWop, &pMapFiledata[0], mapFilesize, 1) != 1) {
-        THROW(std::runtime_error, "Icnfile::Icnfile(): Reading this *.map-File failed!");
-    }
-
     // now we can start creating the Tilesetindex
     if (mapFilesize < 2) {
         THROW(std::runtime_error, "Icnfile::Icnfile(): This *.map-File is too short!");
     }
 
-    const Uint16 numTilesets = SDL_SwapLE16(*reinterpret_cast<Uint16*>(pMapFiledata.get()));
+    const Uint16 numTilesets = dune::read_le_uint16(pMapFiledata.get());
 
     if (mapFilesize < static_cast<size_t>(numTilesets * 2)) {
         THROW(std::runtime_error, "Icnfile::Icnfile(): This *.map-File is too short!");
     }
 
     // calculate size for all entries
-    Uint16 index = SDL_SwapLE16(reinterpret_cast<Uint16*>(pMapFiledata.get())[0]);
+    Uint16 index = dune::read_le_uint16(pMapFiledata.get());
     for (int i = 1; i < numTilesets; i++) {
-        const Uint16 tmp = SDL_SwapLE16(reinterpret_cast<Uint16*>(pMapFiledata.get())[i]);
+        const Uint16 tmp = dune::read_le_uint16(pMapFiledata.get() + 2 * i);
         MapfileEntry newMapfileEntry;
         newMapfileEntry.numTiles = tmp - index;
         tilesets.push_back(newMapfileEntry);
@@ -100,7 +88,7 @@ Icnfile::Icnfile(SDL_RWops* icnRWop, SDL_RWops* mapRWop) {
     tilesets.push_back(newMapfileEntry);
 
     for (int i = 0; i < numTilesets; i++) {
-        index = SDL_SwapLE16(reinterpret_cast<Uint16*>(pMapFiledata.get())[i]);
+        index = dune::read_le_uint16(pMapFiledata.get() + 2 * i);
 
         if (static_cast<unsigned int>(mapFilesize) < (index + tilesets[i].numTiles) * 2) {
             THROW(std::runtime_error, "Icnfile::Icnfile(): This *.map-File is too short!");
@@ -108,11 +96,11 @@ Icnfile::Icnfile(SDL_RWops* icnRWop, SDL_RWops* mapRWop) {
 
         // now we can read in
         for (unsigned int j = 0; j < tilesets[i].numTiles; j++) {
-            tilesets[i].tileIndices.push_back(SDL_SwapLE16(reinterpret_cast<Uint16*>(pMapFiledata.get())[index + j]));
+            tilesets[i].tileIndices.push_back(dune::read_le_uint16(pMapFiledata.get() + 2 * (index + j)));
         }
     }
 
-    pMapFiledata.reset();
+    pMapFiledata = {};
     // reading MAP-File is now finished
 
     // check if we can access first section in ICN-File
@@ -127,7 +115,7 @@ Icnfile::Icnfile(SDL_RWops* icnRWop, SDL_RWops* mapRWop) {
         THROW(std::runtime_error, "Icnfile::Icnfile(): Invalid ICN-File: No SSET-Section found!\n");
     }
 
-    SSET_Length = SDL_SwapBE32(*reinterpret_cast<const Uint32*>(SSET + 4)) - 8;
+    SSET_Length = dune::read_be_uint32(SSET + 4) - 8;
     SSET += 16;
 
     if (pIcnFiledata.get() + icnFilesize < SSET + SSET_Length) {
@@ -141,7 +129,7 @@ Icnfile::Icnfile(SDL_RWops* icnRWop, SDL_RWops* mapRWop) {
         THROW(std::runtime_error, "Icnfile::Icnfile(): Invalid ICN-File: No RPAL-Section found!\n");
     }
 
-    RPAL_Length = SDL_SwapBE32(*reinterpret_cast<const Uint32*>(RPAL + 4));
+    RPAL_Length = dune::read_be_uint32(RPAL + 4);
     RPAL += 8;
 
     if (pIcnFiledata.get() + icnFilesize < RPAL + RPAL_Length) {
@@ -155,7 +143,7 @@ Icnfile::Icnfile(SDL_RWops* icnRWop, SDL_RWops* mapRWop) {
         THROW(std::runtime_error, "Icnfile::Icnfile(): Invalid ICN-File: No RTBL-Section found!\n");
     }
 
-    RTBL_Length = SDL_SwapBE32(*reinterpret_cast<const Uint32*>(RTBL + 4));
+    RTBL_Length = dune::read_be_uint32(RTBL + 4);
     RTBL += 8;
 
     if (pIcnFiledata.get() + icnFilesize < RTBL + RTBL_Length) {
@@ -17,13 +17,15 @@
 
 #include <FileClasses/Pakfile.h>
 #include <misc/SDL2pp.h>
+#include <misc/dune_endian.h>
 #include <misc/exceptions.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <string>
 
-#include "misc/BufferedReader.h"
-
 #include <gsl/gsl>
 
 #include <utility>
@@ -32,80 +34,50 @@ namespace {
 
 inline constexpr auto PAKFILE_RWOP_TYPE = 0x9a5f17ecU;
 
-}
+/// Internal structure used by the SDL_RWops opened by Pakfile::openFile()
+struct RWopData final {
+    std::span<const uint8_t> data;
+    size_t fileOffset;
+};
 
-BasePakfile::BasePakfile(std::filesystem::path pakfilename) : filename_{std::move(pakfilename)} { }
-
-BasePakfile::~BasePakfile() = default;
-
-/// Returns the name of the nth file in this pak-File.
-/**
-    Returns the name of the nth file in this pak-File. index specifies which file.
-    \param  index   Index in pak-File
-    \return name of the file specified by index
-*/
-const std::string& BasePakfile::getFilename(unsigned int index) const {
-    if (index >= fileEntries.size()) {
-        THROW(std::invalid_argument, "Pakfile::getFilename({}): This Pakfile has only {} entries!", index,
-              fileEntries.size());
+RWopData* getRWopData(SDL_RWops* pRWop) {
+    if (pRWop == nullptr || pRWop->type != PAKFILE_RWOP_TYPE) {
+        return nullptr;
     }
 
-    return fileEntries[index].filename;
+    return static_cast<RWopData*>(pRWop->hidden.unknown.data1);
 }
 
-size_t BasePakfile::WriteFile([[maybe_unused]] SDL_RWops* pRWop, [[maybe_unused]] const void* ptr,
-                              [[maybe_unused]] size_t size, [[maybe_unused]] size_t n) {
-    return 0;
-}
-
-int64_t BasePakfile::SizeFile(SDL_RWops* pRWop) {
-    if (pRWop == nullptr || pRWop->hidden.unknown.data1 == nullptr || pRWop->type != PAKFILE_RWOP_TYPE) {
-        return -1;
-    }
-
-    const auto* const pRWopData = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
-    const auto* const pPakfile  = pRWopData->curPakfile;
-    if (pPakfile == nullptr) {
+Sint64 SizeFile(SDL_RWops* pRWop) {
+    const auto* const pRWopData = getRWopData(pRWop);
+    if (pRWopData == nullptr) {
         return -1;
     }
 
-    if (pRWopData->fileIndex >= pPakfile->fileEntries.size()) {
-        return -1;
-    }
-
-    return pPakfile->fileEntries[pRWopData->fileIndex].endOffset
-         - pPakfile->fileEntries[pRWopData->fileIndex].startOffset + 1;
+    return static_cast<Sint64>(pRWopData->data.size());
 }
 
-int64_t BasePakfile::SeekFile(SDL_RWops* pRWop, int64_t offset, int whence) {
-    if (pRWop == nullptr || pRWop->hidden.unknown.data1 == nullptr || pRWop->type != PAKFILE_RWOP_TYPE) {
+Sint64 SeekFile(SDL_RWops* pRWop, Sint64 offset, int whence) {
+    auto* const pRWopData = getRWopData(pRWop);
+    if (pRWopData == nullptr) {
         return -1;
     }
 
-    auto* const pRWopData      = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
-    const auto* const pPakfile = pRWopData->curPakfile;
-    if (pPakfile == nullptr) {
-        return -1;
-    }
-
-    if (pRWopData->fileIndex >= pPakfile->fileEntries.size()) {
-        return -1;
-    }
+    const auto size = static_cast<Sint64>(pRWopData->data.size());
 
-    int64_t newOffset = 0;
+    Sint64 newOffset = 0;
 
     switch (whence) {
-        case SEEK_SET: {
+        case RW_SEEK_SET: {
             newOffset = offset;
         } break;
 
-        case SEEK_CUR: {
-            newOffset = pRWopData->fileOffset + offset;
+        case RW_SEEK_CUR: {
+            newOffset = static_cast<Sint64>(pRWopData->fileOffset) + offset;
         } break;
 
-        case SEEK_END: {
-            newOffset = pPakfile->fileEntries[pRWopData->fileIndex].endOffset
-                      - pPakfile->fileEntries[pRWopData->fileIndex].startOffset + 1 + offset;
+        case RW_SEEK_END: {
+            newOffset = size + offset;
         } break;
 
         default: {
@@ -113,8 +85,7 @@ int64_t BasePakfile::SeekFile(SDL_RWops* pRWop, int64_t offset, int whence) {
         }
     }
 
-    if (newOffset > pPakfile->fileEntries[pRWopData->fileIndex].endOffset
-                        - pPakfile->fileEntries[pRWopData->fileIndex].startOffset + 1) {
+    if (newOffset < 0 || newOffset > size) {
         return -1;
     }
 
@@ -122,47 +93,109 @@ int64_t BasePakfile::SeekFile(SDL_RWops* pRWop, int64_t offset, int whence) {
     return newOffset;
 }
 
-int BasePakfile::CloseFile(SDL_RWops* pRWop) {
-    if (pRWop == nullptr || pRWop->hidden.unknown.data1 == nullptr || pRWop->type != PAKFILE_RWOP_TYPE) {
+size_t ReadFile(SDL_RWops* pRWop, void* ptr, size_t size, size_t n) {
+    auto* const pRWopData = getRWopData(pRWop);
+    if (pRWopData == nullptr || ptr == nullptr || size == 0) {
+        return 0;
+    }
+
+    // only whole blocks are read
+    const auto blocks = std::min(n, (pRWopData->data.size() - pRWopData->fileOffset) / size);
+
+    std::memcpy(ptr, pRWopData->data.data() + pRWopData->fileOffset, blocks * size);
+
+    pRWopData->fileOffset += blocks * size;
+    return blocks;
+}
+
+size_t WriteFile([[maybe_unused]] SDL_RWops* pRWop, [[maybe_unused]] const void* ptr, [[maybe_unused]] size_t size,
+                 [[maybe_unused]] size_t n) {
+    return 0;
+}
+
+int CloseFile(SDL_RWops* pRWop) {
+    const auto* const pRWopData = getRWopData(pRWop);
+    if (pRWopData == nullptr) {
         return -1;
     }
 
-    const auto* const pRWopData = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
     delete pRWopData;
     pRWop->hidden.unknown.data1 = nullptr;
     SDL_FreeRW(pRWop);
     return 0;
 }
 
-void BasePakfile::readIndex() {
-    BufferedReader reader{fPakFile.get()};
+} // namespace
 
-    while (true) {
-        PakFileEntry newEntry;
+BasePakfile::BasePakfile(std::filesystem::path pakfilename) : filename_{std::move(pakfilename)} { }
+
+BasePakfile::~BasePakfile() = default;
+
+/// Returns the name of the nth file in this pak-File.
+/**
+    Returns the name of the nth file in this pak-File. index specifies which file.
+    \param  index   Index in pak-File
+    \return name of the file specified by index
+*/
+const std::string& BasePakfile::getFilename(unsigned int index) const {
+    if (index >= fileEntries.size()) {
+        THROW(std::invalid_argument, "Pakfile::getFilename({}): This Pakfile has only {} entries!", index,
+              fileEntries.size());
+    }
+
+    return fileEntries[index].filename;
+}
+
+bool BasePakfile::exists(const std::string& filename) const {
+    return std::ranges::any_of(fileEntries, [&](auto& fe) { return filename == fe.filename; });
+}
+
+/// Constructor for Pakfile
+/**
+    The PAK-File to be read is specified by the pakfilename-parameter. The file is mapped into memory
+    until the destructor is executed.
+    \param pakfilename  Filename of the *.pak-File.
+*/
+Pakfile::Pakfile(const std::filesystem::path& pakfilename)
+    : BasePakfile{pakfilename}, mappedFile_{filename_.lexically_normal().make_preferred()} {
+    readIndex();
+}
+
+/// Destructor
+/**
+    Unmaps the file and releases all memory.
+*/
+Pakfile::~Pakfile() = default;
+
+void Pakfile::readIndex() {
+    const auto data = mappedFile_.data();
 
-        if (!reader.read_one(&newEntry.startOffset, sizeof newEntry.startOffset)) {
-            THROW(std::runtime_error, "Pakfile::readIndex(): SDL_RWread() failed!");
+    auto pos = size_t{0};
+    while (true) {
+        if (pos + sizeof(uint32_t) > data.size()) {
+            THROW(std::runtime_error, "Pakfile::readIndex(): The index of {} is truncated!", filename_.string());
         }
 
+        PakFileEntry newEntry;
+
         // pak-files are always little endian encoded
-        newEntry.startOffset = SDL_SwapLE32(newEntry.startOffset);
+        newEntry.startOffset = static_cast<uint32_t>(dune::read_le_uint32(data.data() + pos));
         newEntry.endOffset   = 0;
+        pos += sizeof(uint32_t);
 
         if (newEntry.startOffset == 0) {
             break;
         }
 
-        for (;;) {
-            char tmp{};
-            if (!reader.read_type<char>(tmp))
-                THROW(std::runtime_error, "Pakfile::readIndex(): SDL_RWread() failed!");
-
-            if (tmp == '\0')
-                break;
-
-            newEntry.filename += tmp;
+        const auto* const name = data.data() + pos;
+        const auto* const end  = std::find(name, data.data() + data.size(), uint8_t{0});
+        if (end == data.data() + data.size()) {
+            THROW(std::runtime_error, "Pakfile::readIndex(): The index of {} is truncated!", filename_.string());
         }
 
+        newEntry.filename.assign(reinterpret_cast<const char*>(name), end - name);
+        pos += newEntry.filename.size() + 1;
+
         if (!fileEntries.empty()) {
             fileEntries.back().endOffset = newEntry.startOffset - 1;
         }
@@ -170,65 +203,58 @@ void BasePakfile::readIndex() {
         fileEntries.push_back(newEntry);
     }
 
-    const auto filesize = SDL_RWsize(fPakFile.get());
-    if (filesize < 0) {
-        THROW(std::runtime_error, "Pakfile::readIndex(): SDL_RWsize() failed!");
+    if (fileEntries.empty()) {
+        return;
     }
 
-    fileEntries.back().endOffset = static_cast<uint32_t>(filesize) - 1u;
-}
+    fileEntries.back().endOffset = gsl::narrow<uint32_t>(data.size()) - 1u;
 
-/// Constructor for Pakfile
-/**
-    The PAK-File to be read/write is specified by the pakfilename-parameter. If write==false the file is opened for
-    read-only and is closed in the destructor. If write==true the file is opened write-only and written out in the
-    destructor.
-    \param pakfilename  Filename of the *.pak-File.
-*/
-Pakfile::Pakfile(const std::filesystem::path& pakfilename) : BasePakfile{pakfilename} {
-
-    // Open for reading
-    sdl2::RWops_ptr file{SDL_RWFromFile(filename_.u8string(), "rb")};
+    // the views returned by getFileData() must stay inside the mapped file
+    for (const auto& entry : fileEntries) {
+        if (entry.startOffset < pos || entry.startOffset > entry.endOffset + 1 || entry.endOffset >= data.size()) {
+            THROW(std::runtime_error, "Pakfile::readIndex(): Invalid offset of '{}' in {}!", entry.filename,
+                  filename_.string());
+        }
+    }
+}
 
-    if (file == nullptr) {
-        THROW(std::invalid_argument, "Pakfile::Pakfile(): Cannot open {}!", pakfilename.string());
+int Pakfile::findFile(const std::string& filename) const {
+    for (auto i = 0U; i < fileEntries.size(); ++i) {
+        if (filename == fileEntries[i].filename)
+            return static_cast<int>(i);
     }
 
-    fPakFile = std::move(file);
+    THROW(io_error, "Pakfile::findFile(): Cannot find file with name '{}' in this PAK file!", filename);
+}
 
-    readIndex();
+std::span<const uint8_t> Pakfile::getFileData(const std::string& filename) const {
+    return getFileData(findFile(filename));
 }
 
-/// Destructor
-/**
-    Closes the filehandle and releases all memory.
-*/
-Pakfile::~Pakfile() = default;
+std::span<const uint8_t> Pakfile::getFileData(int index) const {
+    if (index < 0 || std::cmp_greater_equal(index, fileEntries.size()))
+        THROW(io_error, "Pakfile::getFileData(): There is not file at index '{}' in this PAK file!", index);
+
+    const auto& entry = fileEntries[index];
+
+    return mappedFile_.data().subspan(entry.startOffset, entry.endOffset + 1 - entry.startOffset);
+}
 
 /// Opens a file in this PAK-File.
 /**
-    This method opens the file specified by filename. It is only allowed if the Pakfile is opened for reading.
-    The returned SDL_RWops-structure can be used readonly with SDL_RWread, SDL_RWsize, SDL_RWseek and SDL_RWclose. No
-   writing is supported.<br> NOTICE: The returned SDL_RWops-Structure is only valid as long as this Pakfile-Object
-   exists. It gets invalid as soon as Pakfile:~Pakfile() is executed.
-   \param  filename    The name of this file
-   \return SDL_RWops for this file
+    This method opens the file specified by filename. The returned SDL_RWops-structure reads directly from the mapped
+    PAK-File and can be used readonly with SDL_RWread, SDL_RWsize, SDL_RWseek and SDL_RWclose. No writing is supported.
+    <br> NOTICE: The returned SDL_RWops-Structure is only valid as long as this Pakfile-Object exists. It gets invalid
+    as soon as Pakfile:~Pakfile() is executed.
+    \param  filename    The name of this file
+    \return SDL_RWops for this file
 */
 sdl2::RWops_ptr Pakfile::openFile(const std::string& filename) const {
-    // find file
-    for (auto i = 0U; i < fileEntries.size(); ++i) {
-        if (filename == fileEntries[i].filename)
-            return openFile(static_cast<int>(i));
-    }
-
-    THROW(io_error, "Pakfile::openFile(): Cannot find file with name '{}' in this PAK file!", filename);
+    return openFile(findFile(filename));
 }
 
 sdl2::RWops_ptr Pakfile::openFile(int index) const {
-    if (index < 0 || std::cmp_greater_equal(index, fileEntries.size()))
-        THROW(io_error, "Pakfile::openFile(): There is not file at index '{}' in this PAK file!", index);
-
-    // alloc RWop
+    auto pRWopData = std::make_unique<RWopData>(RWopData{getFileData(index), 0});
 
     sdl2::RWops_ptr pRWop{SDL_AllocRW()};
 
@@ -236,72 +262,29 @@ sdl2::RWops_ptr Pakfile::openFile(int index) const {
         THROW(io_error, "Pakfile::openFile(): Cannot open file at index '{}' in this PAK file!", index);
     }
 
-    // alloc RWopData
-    auto pRWopData = std::make_unique<RWopData>();
-
-    pRWop->type           = PAKFILE_RWOP_TYPE;
-    pRWopData->curPakfile = this;
-    pRWopData->fileOffset = 0;
-    pRWopData->fileIndex  = index;
-
+    pRWop->type  = PAKFILE_RWOP_TYPE;
     pRWop->read  = ReadFile;
     pRWop->write = WriteFile;
     pRWop->size  = SizeFile;
     pRWop->seek  = SeekFile;
     pRWop->close = CloseFile;
 
-    pRWop->hidden.unknown.data1 = static_cast<void*>(pRWopData.release());
+    pRWop->hidden.unknown.data1 = pRWopData.release();
 
     return pRWop;
 }
 
-bool BasePakfile::exists(const std::string& filename) const {
-    return std::ranges::any_of(fileEntries, [&](auto& fe) { return filename == fe.filename; });
-}
-
-size_t Pakfile::ReadFile(SDL_RWops* pRWop, void* ptr, size_t size, size_t n) {
-    if (pRWop == nullptr || ptr == nullptr || pRWop->hidden.unknown.data1 == nullptr
-        || pRWop->type != PAKFILE_RWOP_TYPE) {
-        return 0;
-    }
-
-    auto bytes2read = size * n;
-
-    auto* const pRWopData      = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
-    const auto* const pPakfile = static_cast<const Pakfile*>(pRWopData->curPakfile);
-    if (pPakfile == nullptr) {
-        return 0;
+std::optional<std::span<const uint8_t>> Pakfile::readFileData(SDL_RWops* rwop) {
+    auto* const pRWopData = getRWopData(rwop);
+    if (pRWopData == nullptr) {
+        return std::nullopt;
     }
 
-    if (pRWopData->fileIndex >= pPakfile->fileEntries.size()) {
-        return 0;
-    }
-
-    const auto readstartoffset = pPakfile->fileEntries[pRWopData->fileIndex].startOffset + pRWopData->fileOffset;
-
-    if (readstartoffset > pPakfile->fileEntries[pRWopData->fileIndex].endOffset) {
-        return 0;
-    }
+    const auto data = pRWopData->data.subspan(pRWopData->fileOffset);
 
-    if (readstartoffset + bytes2read > pPakfile->fileEntries[pRWopData->fileIndex].endOffset) {
-        bytes2read = pPakfile->fileEntries[pRWopData->fileIndex].endOffset + 1 - readstartoffset;
-        // round to last full block
-        bytes2read = (bytes2read / size) * size;
-        if (bytes2read == 0) {
-            return 0;
-        }
-    }
-
-    if (SDL_RWseek(pPakfile->fPakFile.get(), static_cast<Sint64>(readstartoffset), SEEK_SET) < 0) {
-        return 0;
-    }
-
-    if (SDL_RWread(pPakfile->fPakFile.get(), ptr, bytes2read, 1) != 1) {
-        return 0;
-    }
+    pRWopData->fileOffset = pRWopData->data.size();
 
-    pRWopData->fileOffset += bytes2read;
-    return bytes2read / size;
+    return data;
 }
 
 /// Constructor for OutPakfile
@@ -25,32 +25,28 @@
 
 #include <misc/SDL2pp.h>
 
+#include <algorithm>
 #include <cstddef>
 
 #include "globals.h"
 
 /// Constructor
 /**
-    The constructor reads from the rwop all data and saves them internally. The SDL_RWops can be readonly but must
-   support seeking. \param  rwop    SDL_RWops to the shp-File. (can be readonly)
+    The constructor reads from the rwop all data and saves them internally. Files in PAK-Files are not copied, so
+   the Shpfile must not outlive the FileManager. The SDL_RWops can be readonly but must support seeking.
+   \param  rwop    SDL_RWops to the shp-File. (can be readonly)
 */
 Shpfile::Shpfile(SDL_RWops* rwop) {
     if (rwop == nullptr) {
         THROW(std::invalid_argument, "Shpfile::Shpfile(): rwop == nullptr!");
     }
 
-    const int64_t endOffset = SDL_RWsize(rwop);
-    if (endOffset <= 0) {
+    pFiledata   = RWopsData{rwop};
+    shpFilesize = pFiledata.size();
+    if (shpFilesize == 0) {
         THROW(std::runtime_error, "Shpfile::Shpfile(): Cannot determine size of this *.shp-File!");
     }
 
-    shpFilesize = static_cast<size_t>(endOffset);
-    pFiledata   = std::make_unique<unsigned char[]>(shpFilesize);
-
-    if (SDL_RWread(rwop, pFiledata.get(), shpFilesize, 1) != 1) {
-        THROW(std::runtime_error, "Shpfile::Shpfile(): Reading this *.shp-File failed!");
-    }
-
     readIndex();
 }
 
@@ -75,59 +71,14 @@ sdl2::surface_ptr Shpfile::getPicture(uint32_t indexOfFile) {
 
     const auto* const Fileheader = pFiledata.get() + shpfileEntries[indexOfFile].startOffset;
 
-    const auto type = Fileheader[0];
-
     const auto sizeY = Fileheader[2];
     const auto sizeX = Fileheader[3];
 
-    std::vector<unsigned char> DecodeDestination;
-
-    /* size and also checksum */
-    const auto size = SDL_SwapLE16(*reinterpret_cast<const Uint16*>(Fileheader + 8));
-
     const auto ImageOut = std::make_unique<unsigned char[]>(static_cast<size_t>(sizeX) * sizeY);
 
-    switch (type) {
-
-        case 0: {
-            DecodeDestination.clear();
-            DecodeDestination.resize(size);
-
-            if (decode80(Fileheader + 10, DecodeDestination.data(), size) == -1) {
-                sdl2::log_info("Warning: Checksum-Error in Shp-File!");
-            }
-
-            shpCorrectLF(DecodeDestination.data(), ImageOut.get(), size);
-        } break;
-
-        case 1: {
-            DecodeDestination.clear();
-            DecodeDestination.resize(size);
-
-            if (decode80(Fileheader + 10 + 16, DecodeDestination.data(), size) == -1) {
-                sdl2::log_info("Warning: Checksum-Error in Shp-File!");
-            }
-
-            shpCorrectLF(DecodeDestination.data(), ImageOut.get(), size);
-
-            applyPalOffsets(Fileheader + 10, ImageOut.get(), sizeX * sizeY);
-        } break;
-
-        case 2: {
-            shpCorrectLF(Fileheader + 10, ImageOut.get(), size);
-        } break;
-
-        case 3: {
-
-            shpCorrectLF(Fileheader + 10 + 16, ImageOut.get(), size);
-
-            applyPalOffsets(Fileheader + 10, ImageOut.get(), sizeX * sizeY);
-        } break;
-
-        default: {
-            THROW(std::runtime_error, "Shpfile::getPicture(): Type {} in SHP-Files not supported!", type);
-        }
-    }
+    std::vector<unsigned char> DecodeDestination;
+    decodePicture(shpfileEntries[indexOfFile], {ImageOut.get(), static_cast<size_t>(sizeX) * sizeY},
+                  DecodeDestination);
 
     // create new picture surface
     sdl2::surface_ptr pic{SDL_CreateRGBSurface(0, sizeX, sizeY, 8, 0, 0, 0, 0)};
@@ -220,53 +171,10 @@ Shpfile::getPictureArrayImpl(unsigned int tilesX, unsigned int tilesY, std::span
     for (auto j = 0u; j < tilesY; j++) {
         for (auto i = 0u; i < tilesX; i++) {
 
-            const unsigned char* Fileheader = pData + shpfileEntries[TILE_GETINDEX(tiles[j * tilesX + i])].startOffset;
-            unsigned char type              = Fileheader[0];
-
-            /* size and also checksum */
-            const auto size = SDL_SwapLE16(*reinterpret_cast<const Uint16*>(Fileheader + 8));
-
             memset(ImageOut.get(), 0, static_cast<size_t>(sizeX) * sizeY);
 
-            switch (type) {
-
-                case 0: {
-                    DecodeDestination.clear();
-                    DecodeDestination.resize(size);
-
-                    if (decode80(Fileheader + 10, DecodeDestination.data(), size) == -1) {
-                        sdl2::log_info("Warning: Checksum-Error in Shp-File!");
-                    }
-
-                    shpCorrectLF(DecodeDestination.data(), ImageOut.get(), size);
-                } break;
-
-                case 1: {
-                    DecodeDestination.clear();
-                    DecodeDestination.resize(size);
-
-                    if (decode80(Fileheader + 10 + 16, DecodeDestination.data(), size) == -1) {
-                        sdl2::log_info("Warning: Checksum-Error in Shp-File!");
-                    }
-
-                    shpCorrectLF(DecodeDestination.data(), ImageOut.get(), size);
-
-                    applyPalOffsets(Fileheader + 10, ImageOut.get(), sizeX * sizeY);
-                } break;
-
-                case 2: {
-                    shpCorrectLF(Fileheader + 10, ImageOut.get(), size);
-                } break;
-
-                case 3: {
-                    shpCorrectLF(Fileheader + 10 + 16, ImageOut.get(), size);
-                    applyPalOffsets(Fileheader + 10, ImageOut.get(), sizeX * sizeY);
-                } break;
-
-                default: {
-                    THROW(std::runtime_error, "Shpfile::getPictureArray(): Type {} in SHP-Files not supported!", type);
-                }
-            }
+            decodePicture(shpfileEntries[TILE_GETINDEX(tiles[j * tilesX + i])],
+                          {ImageOut.get(), static_cast<size_t>(sizeX) * sizeY}, DecodeDestination);
 
             // Now we can copy line by line
             switch (TILE_GETTYPE(tiles[i])) {
@@ -357,8 +265,15 @@ std::unique_ptr<Animation> Shpfile::getAnimation(unsigned int startindex, unsign
     This helper method reads the index of this shp-File.
 */
 void Shpfile::readIndex() {
+    const auto* const data = pFiledata.get();
+
+    // the number of files and the first offsets
+    if (shpFilesize < 8) {
+        THROW(std::runtime_error, "Shpfile::readIndex(): Shp-File-Header is not complete! Header too small!");
+    }
+
     // First get number of files in shp-file
-    const Uint16 NumFiles = SDL_SwapLE16(reinterpret_cast<const Uint16*>(pFiledata.get())[0]);
+    const uint16_t NumFiles = dune::read_le_uint16(data);
 
     if (NumFiles == 0) {
         THROW(std::runtime_error, "Shpfile::readIndex(): There is no file in this shp-File!");
@@ -368,17 +283,14 @@ void Shpfile::readIndex() {
         /* files with only one image might be different */
 
         ShpfileEntry newShpfileEntry;
-        if (reinterpret_cast<const uint16_t*>(pFiledata.get())[2] != 0) {
+        if (dune::read_le_uint16(data + 4) != 0) {
             /* File has special header with only 2 byte offset */
-            newShpfileEntry.startOffset = static_cast<uint32_t>(reinterpret_cast<const uint16_t*>(pFiledata.get())[1]);
-            newShpfileEntry.endOffset =
-                static_cast<uint32_t>(reinterpret_cast<const uint16_t*>(pFiledata.get())[2]) - 1;
+            newShpfileEntry.startOffset = dune::read_le_uint16(data + 2);
+            newShpfileEntry.endOffset   = static_cast<uint32_t>(dune::read_le_uint16(data + 4)) - 1;
         } else {
             /* File has normal 4 byte offsets */
-            newShpfileEntry.startOffset =
-                static_cast<uint32_t>(*reinterpret_cast<const uint32_t*>(pFiledata.get() + 2)) + 2;
-            newShpfileEntry.endOffset =
-                static_cast<uint32_t>(reinterpret_cast<const uint16_t*>(pFiledata.get())[3]) - 1 + 2;
+            newShpfileEntry.startOffset = static_cast<uint32_t>(dune::read_le_uint32(data + 2)) + 2;
+            newShpfileEntry.endOffset   = static_cast<uint32_t>(dune::read_le_uint16(data + 6)) - 1 + 2;
         }
 
         shpfileEntries.push_back(newShpfileEntry);
@@ -386,7 +298,7 @@ void Shpfile::readIndex() {
     } else {
         /* File contains more than one image */
 
-        if (reinterpret_cast<const uint16_t*>(pFiledata.get())[2] != 0) {
+        if (dune::read_le_uint16(data + 4) != 0) {
             /* File has special header with only 2 byte offset */
 
             if (shpFilesize < static_cast<uint32_t>(NumFiles * 2 + 2 + 2)) {
@@ -396,7 +308,7 @@ void Shpfile::readIndex() {
             // now fill Index with start and end-offsets
             for (int i = 0; i < NumFiles; i++) {
                 ShpfileEntry newShpfileEntry{};
-                newShpfileEntry.startOffset = SDL_SwapLE16(reinterpret_cast<const Uint16*>(pFiledata.get() + 2)[i]);
+                newShpfileEntry.startOffset = dune::read_le_uint16(data + 2 + 2 * i);
 
                 if (!shpfileEntries.empty()) {
                     shpfileEntries.back().endOffset = newShpfileEntry.startOffset - 1;
@@ -411,9 +323,8 @@ void Shpfile::readIndex() {
             }
 
             // Add the endOffset for the last file
-            shpfileEntries.back().endOffset = static_cast<uint32_t>(*reinterpret_cast<const uint16_t*>(
-                                                  pFiledata.get() + 2 + static_cast<ptrdiff_t>(NumFiles) * 2))
-                                            - 1 + 2;
+            shpfileEntries.back().endOffset =
+                static_cast<uint32_t>(dune::read_le_uint16(data + 2 + static_cast<ptrdiff_t>(NumFiles) * 2)) - 1 + 2;
         } else {
             /* File has normal 4 byte offsets */
 
@@ -424,8 +335,7 @@ void Shpfile::readIndex() {
             // now fill Index with start and end-offsets
             for (auto i = 0; i < NumFiles; i++) {
                 ShpfileEntry newShpfileEntry{};
-                newShpfileEntry.startOffset =
-                    dune::read_le_uint32(reinterpret_cast<const Uint32*>(pFiledata.get() + 2)[i]) + 2;
+                newShpfileEntry.startOffset = static_cast<uint32_t>(dune::read_le_uint32(data + 2 + 4 * i)) + 2;
 
                 if (!shpfileEntries.empty()) {
                     shpfileEntries.back().endOffset = newShpfileEntry.startOffset - 1;
@@ -440,38 +350,106 @@ void Shpfile::readIndex() {
             }
 
             // Add the endOffset for the last file
-            shpfileEntries.back().endOffset = static_cast<uint32_t>(*reinterpret_cast<const uint16_t*>(
-                                                  pFiledata.get() + 2 + static_cast<ptrdiff_t>(NumFiles) * 4))
-                                            - 1 + 2;
+            shpfileEntries.back().endOffset =
+                static_cast<uint32_t>(dune::read_le_uint16(data + 2 + static_cast<ptrdiff_t>(NumFiles) * 4)) - 1 + 2;
+        }
+    }
+
+    // Every entry starts with a header of 10 bytes
+    for (const auto& entry : shpfileEntries) {
+        if (entry.startOffset > shpFilesize || shpFilesize - entry.startOffset < 10) {
+            THROW(std::runtime_error, "Shpfile::readIndex(): Entry in this SHP-File is beyond the end of this file!");
+        }
+    }
+}
+
+/// Helper method for decoding one picture.
+/**
+    This helper method decodes the picture of one entry in this shp-File.
+    \param  entry       the entry to decode
+    \param  image       the decoded picture; it must have room for all pixels of the picture
+    \param  buffer      memory for the intermediate format80 decoding
+*/
+void Shpfile::decodePicture(const ShpfileEntry& entry, std::span<unsigned char> image,
+                            std::vector<unsigned char>& buffer) const {
+    const auto data = std::span{pFiledata.get(), shpFilesize}.subspan(entry.startOffset);
+
+    if (data.size() < 10) {
+        THROW(std::runtime_error, "Shpfile::decodePicture(): Entry in this SHP-File is beyond the end of this file!");
+    }
+
+    const auto type = data[0];
+
+    /* size and also checksum */
+    const auto size = dune::read_le_uint16(data.data() + 8);
+
+    const auto hasPalOffsets = type == 1 || type == 3;
+    const auto headerSize    = hasPalOffsets ? size_t{10 + 16} : size_t{10};
+
+    if (data.size() < headerSize) {
+        THROW(std::runtime_error, "Shpfile::decodePicture(): Entry in this SHP-File is beyond the end of this file!");
+    }
+
+    const auto payload = data.subspan(headerSize);
+
+    switch (type) {
+        case 0:
+        case 1: {
+            buffer.clear();
+            buffer.resize(size);
+
+            if (decode80(payload, buffer) != size) {
+                sdl2::log_info("Warning: Checksum-Error in Shp-File!");
+            }
+
+            shpCorrectLF(buffer, image);
+        } break;
+
+        case 2:
+        case 3: {
+            shpCorrectLF(payload.first(std::min<size_t>(size, payload.size())), image);
+        } break;
+
+        default: {
+            THROW(std::runtime_error, "Shpfile::decodePicture(): Type {} in SHP-Files not supported!", type);
         }
     }
+
+    if (hasPalOffsets) {
+        applyPalOffsets(data.data() + 10, image.data(), static_cast<unsigned int>(image.size()));
+    }
 }
 
 /// Helper method for correcting the decoded picture.
 /**
     This helper method corrects the decoded picture.
     \param  in  input picture
-    \param  out output picture
-    \param  size    size of the input picture
+    \param  out output picture; pixels beyond its end are dropped
 */
-void Shpfile::shpCorrectLF(const unsigned char* in, unsigned char* out, int size) {
-    const unsigned char* end = in + size;
-    while (in < end) {
-        const auto val = *in;
-        in++;
+void Shpfile::shpCorrectLF(std::span<const unsigned char> in, std::span<unsigned char> out) {
+    auto readPos  = size_t{0};
+    auto writePos = size_t{0};
+
+    while (readPos < in.size()) {
+        const auto val = in[readPos++];
 
         if (val != 0) {
-            *out = val;
-            out++;
+            if (writePos == out.size()) {
+                return;
+            }
+            out[writePos++] = val;
         } else {
-            const unsigned char count = *in;
-            in++;
+            if (readPos == in.size()) {
+                return;
+            }
+            const auto count = in[readPos++];
             if (count == 0) {
                 return;
             }
-            memset(out, 0, count);
+            const auto n = std::min<size_t>(count, out.size() - writePos);
+            memset(out.data() + writePos, 0, n);
 
-            out += count;
+            writePos += n;
         }
     }
 }
@@ -32,9 +32,14 @@
 #include <FileClasses/Wsafile.h>
 
 #include <misc/Scaler.h>
+#include <misc/ThreadPool.h>
 #include <misc/draw_util.h>
 #include <misc/exceptions.h>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 namespace {
 
 constexpr auto GROUNDUNIT_ROW(int i) {
@@ -235,6 +240,69 @@ constexpr auto objPicTiles = std::to_array<Coord>({
 
 static_assert(std::tuple_size_v<decltype(objPicTiles)> == NUM_OBJPICS);
 
+/**
+    The WSA files the small detail pics are extracted from. Picture_Special has no picture.
+    Unused: FARTR.WSA, FHARK.WSA, FORDOS.WSA
+*/
+constexpr auto smallDetailPicFiles = std::to_array<std::pair<int, const char*>>({
+    {Picture_Barracks, "BARRAC.WSA"},
+    {Picture_ConstructionYard, "CONSTRUC.WSA"},
+    {Picture_Carryall, "CARRYALL.WSA"},
+    {Picture_Devastator, "HARKTANK.WSA"},
+    {Picture_Deviator, "ORDRTANK.WSA"},
+    {Picture_DeathHand, "GOLD-BB.WSA"},
+    {Picture_Fremen, "FREMEN.WSA"},
+    {Picture_Frigate, "FRIGATE.WSA"},
+    {Picture_GunTurret, "TURRET.WSA"},
+    {Picture_Harvester, "HARVEST.WSA"},
+    {Picture_HeavyFactory, "HVYFTRY.WSA"},
+    {Picture_HighTechFactory, "HITCFTRY.WSA"},
+    {Picture_Soldier, "INFANTRY.WSA"},
+    {Picture_IX, "IX.WSA"},
+    {Picture_Launcher, "RTANK.WSA"},
+    {Picture_LightFactory, "LITEFTRY.WSA"},
+    {Picture_MCV, "MCV.WSA"},
+    {Picture_Ornithopter, "ORNI.WSA"},
+    {Picture_Palace, "PALACE.WSA"},
+    {Picture_Quad, "QUAD.WSA"},
+    {Picture_Radar, "HEADQRTS.WSA"},
+    {Picture_RaiderTrike, "OTRIKE.WSA"},
+    {Picture_Refinery, "REFINERY.WSA"},
+    {Picture_RepairYard, "REPAIR.WSA"},
+    {Picture_RocketTurret, "RTURRET.WSA"},
+    {Picture_Saboteur, "SABOTURE.WSA"},
+    {Picture_Sandworm, "WORM.WSA"},
+    {Picture_Sardaukar, "SARDUKAR.WSA"},
+    {Picture_SiegeTank, "HTANK.WSA"},
+    {Picture_Silo, "STORAGE.WSA"},
+    {Picture_Slab1, "SLAB.WSA"},
+    {Picture_Slab4, "4SLAB.WSA"},
+    {Picture_SonicTank, "STANK.WSA"},
+    {Picture_StarPort, "STARPORT.WSA"},
+    {Picture_Tank, "LTANK.WSA"},
+    {Picture_Trike, "TRIKE.WSA"},
+    {Picture_Trooper, "HYINFY.WSA"},
+    {Picture_Wall, "WALL.WSA"},
+    {Picture_WindTrap, "WINDTRAP.WSA"},
+    {Picture_WOR, "WOR.WSA"},
+});
+
+/// The shadows are black silhouettes and therefore look the same for every house
+bool isHouseIndependentShadow(unsigned int id) {
+    return id == ObjPic_CarryallShadow || id == ObjPic_FrigateShadow || id == ObjPic_OrnithopterShadow;
+}
+
+sdl2::surface_ptr createTransparentSurface(SDL_Surface* surface, uint32_t oldColor, uint32_t newColor) {
+    auto display_surface = convertSurfaceToDisplayFormat(surface);
+
+    replaceColor(display_surface.get(), oldColor, newColor);
+
+    if (SDL_SetSurfaceBlendMode(display_surface.get(), SDL_BlendMode::SDL_BLENDMODE_BLEND))
+        THROW(std::runtime_error, "createTransparentSurface(): SDL_SetSurfaceBlendMode() failed: {}", SDL_GetError());
+
+    return display_surface;
+}
+
 } // namespace
 
 SurfaceLoader::SurfaceLoader(int width, int height) {
@@ -243,52 +311,73 @@ SurfaceLoader::SurfaceLoader(int width, int height) {
 
     auto* const file_manager = dune::globals::pFileManager.get();
 
-    // open all shp files
-    auto units   = loadShpfile("UNITS.SHP");
-    auto units1  = loadShpfile("UNITS1.SHP");
-    auto units2  = loadShpfile("UNITS2.SHP");
-    auto mouse   = loadShpfile("MOUSE.SHP");
-    auto shapes  = loadShpfile("SHAPES.SHP");
-    auto menshpa = loadShpfile("MENSHPA.SHP");
-    auto menshph = loadShpfile("MENSHPH.SHP");
-    auto menshpo = loadShpfile("MENSHPO.SHP");
-    auto menshpm = loadShpfile("MENSHPM.SHP");
-
-    std::unique_ptr<Shpfile> choam;
+    auto& pool = ThreadPool::shared();
 
+    std::string choamName;
     if (file_manager->exists(fmt::format("CHOAM.{}", _("LanguageFileExtension")))) {
-        choam = loadShpfile(fmt::format("CHOAM.{}", _("LanguageFileExtension")));
+        choamName = fmt::format("CHOAM.{}", _("LanguageFileExtension"));
     } else if (file_manager->exists("CHOAMSHP.SHP")) {
-        choam = loadShpfile("CHOAMSHP.SHP");
+        choamName = "CHOAMSHP.SHP";
     } else {
         THROW(std::runtime_error, "SurfaceLoader::SurfaceLoader(): Cannot open CHOAMSHP.SHP or CHOAM.{}!",
               _("LanguageFileExtension"));
     }
 
-    std::unique_ptr<Shpfile> bttn;
-    if (file_manager->exists(fmt::format("BTTN.{}", _("LanguageFileExtension")))) {
-        bttn = loadShpfile(fmt::format("BTTN.{}", _("LanguageFileExtension")));
-    } else {
-        // The US-Version has the buttons in SHAPES.SHP
-        // => bttn == nullptr
-    }
+    // The US-Version has the buttons in SHAPES.SHP
+    // => bttn == nullptr
+    const auto hasBttn = file_manager->exists(fmt::format("BTTN.{}", _("LanguageFileExtension")));
+
+    const auto mentatName = file_manager->exists(fmt::format("MENTAT.{}", _("LanguageFileExtension")))
+                              ? fmt::format("MENTAT.{}", _("LanguageFileExtension"))
+                              : std::string{"MENTAT.SHP"};
+
+    std::unique_ptr<Shpfile> units, units1, units2, mouse, shapes, menshpa, menshph, menshpo, menshpm, choam, bttn,
+        mentat, pieces, arrows;
+    std::unique_ptr<Icnfile> icon;
+    std::unique_ptr<Wsafile> radar;
+
+    const auto loadShp = [this](std::unique_ptr<Shpfile>& shpfile, std::string filename) {
+        return [this, &shpfile, filename = std::move(filename)] { shpfile = loadShpfile(filename); };
+    };
+
+    // decode all files in parallel; the surfaces are cut out of them afterwards
+    std::vector<std::function<void()>> jobs{
+        loadShp(units, "UNITS.SHP"),
+        loadShp(units1, "UNITS1.SHP"),
+        loadShp(units2, "UNITS2.SHP"),
+        loadShp(mouse, "MOUSE.SHP"),
+        loadShp(shapes, "SHAPES.SHP"),
+        loadShp(menshpa, "MENSHPA.SHP"),
+        loadShp(menshph, "MENSHPH.SHP"),
+        loadShp(menshpo, "MENSHPO.SHP"),
+        loadShp(menshpm, "MENSHPM.SHP"),
+        loadShp(choam, choamName),
+        loadShp(mentat, mentatName),
+        loadShp(pieces, "PIECES.SHP"),
+        loadShp(arrows, "ARROWS.SHP"),
+        // Load icon file
+        [&] {
+            icon = std::make_unique<Icnfile>(file_manager->openFile("ICON.ICN").get(),
+                                             file_manager->openFile("ICON.MAP").get());
+        },
+        // Load radar static
+        [&] { radar = loadWsafile("STATIC.WSA"); },
+    };
+
+    if (hasBttn)
+        jobs.push_back(loadShp(bttn, fmt::format("BTTN.{}", _("LanguageFileExtension"))));
+
+    // the small detail pics only depend on their own WSA file
+    for (const auto& [id, filename] : smallDetailPicFiles) {
+        // US-Version 1.07 does not contain FRIGATE.WSA
+        // We replace it with the starport
+        const auto* const name = id == Picture_Frigate && !file_manager->exists(filename) ? "STARPORT.WSA" : filename;
 
-    std::unique_ptr<Shpfile> mentat;
-    if (file_manager->exists(fmt::format("MENTAT.{}", _("LanguageFileExtension")))) {
-        mentat = loadShpfile(fmt::format("MENTAT.{}", _("LanguageFileExtension")));
-    } else {
-        mentat = loadShpfile("MENTAT.SHP");
+        jobs.emplace_back([this, id, name] { smallDetailPic[id] = extractSmallDetailPic(name); });
     }
+    smallDetailPic[Picture_Special] = nullptr;
 
-    auto pieces = loadShpfile("PIECES.SHP");
-    auto arrows = loadShpfile("ARROWS.SHP");
-
-    // Load icon file
-    auto icon =
-        std::make_unique<Icnfile>(file_manager->openFile("ICON.ICN").get(), file_manager->openFile("ICON.MAP").get());
-
-    // Load radar static
-    auto radar = loadWsafile("STATIC.WSA");
+    pool.parallel_for(jobs.size(), [&](size_t i) { jobs[i](); });
 
     // open bene palette
     Palette benePalette = LoadPalette_RW(file_manager->openFile("BENE.PAL").get());
@@ -419,84 +508,40 @@ SurfaceLoader::SurfaceLoader(int width, int height) {
     SDL_SetPaletteColors(objPic[ObjPic_Terrain_HiddenFog][harkIdx][0]->format->palette, &fogTransparent, PALCOLOR_BLACK,
                          1);
 
-    // scale obj pics and apply color key
-    for (int id = 0; id < NUM_OBJPICS; id++) {
-        for (int h = 0; h < NUM_HOUSES; h++) {
-            if (objPic[id][h][0] != nullptr) {
-                if (objPic[id][h][1] == nullptr) {
-                    objPic[id][h][1] = generateDoubledObjPic(id, h);
-                }
-                SDL_SetColorKey(objPic[id][h][1].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
+    // scale obj pics and apply color key; every task only touches the surfaces of its own id and house
+    pool.parallel_for(static_cast<size_t>(NUM_OBJPICS) * NUM_HOUSES, [&](size_t i) {
+        const auto id = static_cast<unsigned int>(i / NUM_HOUSES);
+        const auto h  = static_cast<int>(i % NUM_HOUSES);
 
-                if (objPic[id][h][2] == nullptr) {
-                    objPic[id][h][2] = generateTripledObjPic(id, h);
-                }
-                SDL_SetColorKey(objPic[id][h][2].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
+        if (objPic[id][h][0] == nullptr)
+            return;
 
-                SDL_SetColorKey(objPic[id][h][0].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
-            }
+        if (objPic[id][h][1] == nullptr) {
+            objPic[id][h][1] = generateDoubledObjPic(id, h);
         }
-    }
+        SDL_SetColorKey(objPic[id][h][1].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
 
-    objPic[ObjPic_CarryallShadow][harkIdx][0]    = createShadowSurface(objPic[ObjPic_Carryall][harkIdx][0].get());
-    objPic[ObjPic_CarryallShadow][harkIdx][1]    = createShadowSurface(objPic[ObjPic_Carryall][harkIdx][1].get());
-    objPic[ObjPic_CarryallShadow][harkIdx][2]    = createShadowSurface(objPic[ObjPic_Carryall][harkIdx][2].get());
-    objPic[ObjPic_FrigateShadow][harkIdx][0]     = createShadowSurface(objPic[ObjPic_Frigate][harkIdx][0].get());
-    objPic[ObjPic_FrigateShadow][harkIdx][1]     = createShadowSurface(objPic[ObjPic_Frigate][harkIdx][1].get());
-    objPic[ObjPic_FrigateShadow][harkIdx][2]     = createShadowSurface(objPic[ObjPic_Frigate][harkIdx][2].get());
-    objPic[ObjPic_OrnithopterShadow][harkIdx][0] = createShadowSurface(objPic[ObjPic_Ornithopter][harkIdx][0].get());
-    objPic[ObjPic_OrnithopterShadow][harkIdx][1] = createShadowSurface(objPic[ObjPic_Ornithopter][harkIdx][1].get());
-    objPic[ObjPic_OrnithopterShadow][harkIdx][2] = createShadowSurface(objPic[ObjPic_Ornithopter][harkIdx][2].get());
-
-    // load small detail pics
-    smallDetailPic[Picture_Barracks]         = extractSmallDetailPic("BARRAC.WSA");
-    smallDetailPic[Picture_ConstructionYard] = extractSmallDetailPic("CONSTRUC.WSA");
-    smallDetailPic[Picture_Carryall]         = extractSmallDetailPic("CARRYALL.WSA");
-    smallDetailPic[Picture_Devastator]       = extractSmallDetailPic("HARKTANK.WSA");
-    smallDetailPic[Picture_Deviator]         = extractSmallDetailPic("ORDRTANK.WSA");
-    smallDetailPic[Picture_DeathHand]        = extractSmallDetailPic("GOLD-BB.WSA");
-    smallDetailPic[Picture_Fremen]           = extractSmallDetailPic("FREMEN.WSA");
-    if (file_manager->exists("FRIGATE.WSA")) {
-        smallDetailPic[Picture_Frigate] = extractSmallDetailPic("FRIGATE.WSA");
-    } else {
-        // US-Version 1.07 does not contain FRIGATE.WSA
-        // We replace it with the starport
-        smallDetailPic[Picture_Frigate] = extractSmallDetailPic("STARPORT.WSA");
+        if (objPic[id][h][2] == nullptr) {
+            objPic[id][h][2] = generateTripledObjPic(id, h);
+        }
+        SDL_SetColorKey(objPic[id][h][2].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
+
+        SDL_SetColorKey(objPic[id][h][0].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
+    });
+
+    { // Scope
+        static constexpr auto shadows = std::to_array<std::pair<ObjPic_enum, ObjPic_enum>>(
+            {{ObjPic_CarryallShadow, ObjPic_Carryall},
+             {ObjPic_FrigateShadow, ObjPic_Frigate},
+             {ObjPic_OrnithopterShadow, ObjPic_Ornithopter}});
+
+        pool.parallel_for(shadows.size(), [&](size_t i) {
+            const auto [shadow, source] = shadows[i];
+
+            for (auto zoom = 0; zoom < NUM_ZOOMLEVEL; ++zoom)
+                objPic[shadow][harkIdx][zoom] = createShadowSurface(objPic[source][harkIdx][zoom].get());
+        });
     }
-    smallDetailPic[Picture_GunTurret]       = extractSmallDetailPic("TURRET.WSA");
-    smallDetailPic[Picture_Harvester]       = extractSmallDetailPic("HARVEST.WSA");
-    smallDetailPic[Picture_HeavyFactory]    = extractSmallDetailPic("HVYFTRY.WSA");
-    smallDetailPic[Picture_HighTechFactory] = extractSmallDetailPic("HITCFTRY.WSA");
-    smallDetailPic[Picture_Soldier]         = extractSmallDetailPic("INFANTRY.WSA");
-    smallDetailPic[Picture_IX]              = extractSmallDetailPic("IX.WSA");
-    smallDetailPic[Picture_Launcher]        = extractSmallDetailPic("RTANK.WSA");
-    smallDetailPic[Picture_LightFactory]    = extractSmallDetailPic("LITEFTRY.WSA");
-    smallDetailPic[Picture_MCV]             = extractSmallDetailPic("MCV.WSA");
-    smallDetailPic[Picture_Ornithopter]     = extractSmallDetailPic("ORNI.WSA");
-    smallDetailPic[Picture_Palace]          = extractSmallDetailPic("PALACE.WSA");
-    smallDetailPic[Picture_Quad]            = extractSmallDetailPic("QUAD.WSA");
-    smallDetailPic[Picture_Radar]           = extractSmallDetailPic("HEADQRTS.WSA");
-    smallDetailPic[Picture_RaiderTrike]     = extractSmallDetailPic("OTRIKE.WSA");
-    smallDetailPic[Picture_Refinery]        = extractSmallDetailPic("REFINERY.WSA");
-    smallDetailPic[Picture_RepairYard]      = extractSmallDetailPic("REPAIR.WSA");
-    smallDetailPic[Picture_RocketTurret]    = extractSmallDetailPic("RTURRET.WSA");
-    smallDetailPic[Picture_Saboteur]        = extractSmallDetailPic("SABOTURE.WSA");
-    smallDetailPic[Picture_Sandworm]        = extractSmallDetailPic("WORM.WSA");
-    smallDetailPic[Picture_Sardaukar]       = extractSmallDetailPic("SARDUKAR.WSA");
-    smallDetailPic[Picture_SiegeTank]       = extractSmallDetailPic("HTANK.WSA");
-    smallDetailPic[Picture_Silo]            = extractSmallDetailPic("STORAGE.WSA");
-    smallDetailPic[Picture_Slab1]           = extractSmallDetailPic("SLAB.WSA");
-    smallDetailPic[Picture_Slab4]           = extractSmallDetailPic("4SLAB.WSA");
-    smallDetailPic[Picture_SonicTank]       = extractSmallDetailPic("STANK.WSA");
-    smallDetailPic[Picture_Special]         = nullptr;
-    smallDetailPic[Picture_StarPort]        = extractSmallDetailPic("STARPORT.WSA");
-    smallDetailPic[Picture_Tank]            = extractSmallDetailPic("LTANK.WSA");
-    smallDetailPic[Picture_Trike]           = extractSmallDetailPic("TRIKE.WSA");
-    smallDetailPic[Picture_Trooper]         = extractSmallDetailPic("HYINFY.WSA");
-    smallDetailPic[Picture_Wall]            = extractSmallDetailPic("WALL.WSA");
-    smallDetailPic[Picture_WindTrap]        = extractSmallDetailPic("WINDTRAP.WSA");
-    smallDetailPic[Picture_WOR]             = extractSmallDetailPic("WOR.WSA");
-    // unused: FARTR.WSA, FHARK.WSA, FORDOS.WSA
 
     tinyPicture[TinyPicture_Spice]            = shapes->getPicture(94);
     tinyPicture[TinyPicture_Barracks]         = shapes->getPicture(62);
@@ -1197,46 +1242,19 @@ SurfaceLoader::SurfaceLoader(int width, int height) {
     // pBackgroundSurface is separate as we never draw it but use it to construct other sprites
     pBackgroundSurface = convertSurfaceToDisplayFormat(picFactory.createBackground().get());
 
-    { // Scope
-        auto replace_color = [&](ObjPic_enum id, HOUSETYPE house, int zoom, uint32_t oldColor, uint32_t newColor) {
-            auto display_surface = convertSurfaceToDisplayFormat(getZoomedObjSurface(id, house, zoom));
-
-            replaceColor(display_surface.get(), oldColor, newColor);
-
-            if (SDL_SetSurfaceBlendMode(display_surface.get(), SDL_BlendMode::SDL_BLENDMODE_BLEND))
-                THROW(std::runtime_error, "SurfaceLoader(): SDL_SetSurfaceBlendMode() failed: {}", SDL_GetError());
+    // Only the Harkonnen windtraps and shadows are converted here; the other houses follow in getZoomedObjSurface()
+    for (auto zoom = 0; zoom < NUM_ZOOMLEVEL; ++zoom) {
+        windtrapBase_[zoom] = std::move(objPic[ObjPic_Windtrap][harkIdx][zoom]);
 
-            objPic[static_cast<int>(id)][static_cast<int>(house)][zoom] = std::move(display_surface);
-        };
+        if (!windtrapBase_[zoom])
+            THROW(std::runtime_error, "SurfaceLoader(): Windtrap for zoom {} does not exist!", zoom);
 
-        for (auto zoom = 0; zoom < NUM_ZOOMLEVEL; ++zoom) {
-            for (auto h = 0; h < NUM_HOUSES; ++h) {
-                const auto house = static_cast<HOUSETYPE>(h);
+        objPic[ObjPic_Windtrap][harkIdx][zoom] = generateWindtrapSurface(HOUSETYPE::HOUSE_HARKONNEN, zoom);
 
-                // Create the per-house Windtrap surfaces
-                (void)getZoomedObjSurface(static_cast<unsigned int>(ObjPic_Windtrap), house, zoom);
+        for (const auto id : {ObjPic_CarryallShadow, ObjPic_FrigateShadow, ObjPic_OrnithopterShadow}) {
+            auto& shadow = objPic[id][harkIdx][zoom];
 
-                replace_color(ObjPic_CarryallShadow, house, zoom, COLOR_BLACK, COLOR_SHADOW_TRANSPARENT);
-                replace_color(ObjPic_FrigateShadow, house, zoom, COLOR_BLACK, COLOR_SHADOW_TRANSPARENT);
-                replace_color(ObjPic_OrnithopterShadow, house, zoom, COLOR_BLACK, COLOR_SHADOW_TRANSPARENT);
-            }
-        }
-
-        for (auto zoom = 0; zoom < NUM_ZOOMLEVEL; ++zoom) {
-            for (auto h = 0; h < NUM_HOUSES; ++h) {
-                const auto house = static_cast<HOUSETYPE>(h);
-
-                auto& windtrap = objPic[ObjPic_Windtrap][h][zoom];
-
-                if (!windtrap)
-                    THROW(std::runtime_error, "SurfaceLoader(): Windtrap for house {} and zoom {} does not exist!", h,
-                          zoom);
-
-                // Windtrap uses palette animation on PALCOLOR_WINDTRAP_COLORCYCLE; fake this
-                windtrap = generateWindtrapAnimationFrames(windtrap.get());
-
-                replace_color(ObjPic_Windtrap, house, zoom, COLOR_BLACK, COLOR_FOG_TRANSPARENT);
-            }
+            shadow = createTransparentSurface(shadow.get(), COLOR_BLACK, COLOR_SHADOW_TRANSPARENT);
         }
     }
 
@@ -1277,12 +1295,18 @@ SDL_Surface* SurfaceLoader::getZoomedObjSurface(unsigned int id, HOUSETYPE house
               id);
     }
 
+    constexpr auto harkonnen = static_cast<int>(HOUSETYPE::HOUSE_HARKONNEN);
+
+    if (isHouseIndependentShadow(id))
+        return objPic[id][harkonnen][z].get();
+
     const auto idx = static_cast<int>(house);
 
     auto& surface = objPic[id][idx][z];
 
-    if (surface == nullptr) {
-        constexpr auto harkonnen = static_cast<int>(HOUSETYPE::HOUSE_HARKONNEN);
+    if (surface == nullptr && id == ObjPic_Windtrap) {
+        surface = generateWindtrapSurface(house, static_cast<int>(z));
+    } else if (surface == nullptr) {
 
         // remap to this color
         if (objPic[id][harkonnen][z] == nullptr) {
@@ -1296,6 +1320,20 @@ SDL_Surface* SurfaceLoader::getZoomedObjSurface(unsigned int id, HOUSETYPE house
     return surface.get();
 }
 
+SDL_Surface* SurfaceLoader::getRemapSource(unsigned int id, unsigned int z) const {
+    if (id >= NUM_OBJPICS) {
+        THROW(std::invalid_argument, "SurfaceLoader::getRemapSource(): Unit Picture with ID {} is not available!", id);
+    }
+
+    if (isHouseIndependentShadow(id))
+        return nullptr;
+
+    if (id == ObjPic_Windtrap)
+        return windtrapBase_.at(z).get();
+
+    return objPic[id][static_cast<int>(HOUSETYPE::HOUSE_HARKONNEN)][z].get();
+}
+
 SDL_Surface* SurfaceLoader::getSmallDetailSurface(unsigned int id) {
     if (id >= NUM_SMALLDETAILPICS) {
         return nullptr;
@@ -1537,7 +1575,7 @@ std::unique_ptr<Animation> SurfaceLoader::loadAnimationFromWsa(const std::string
     return wsafile->getAnimation(0, wsafile->getNumFrames() - 1, true, false);
 }
 
-sdl2::surface_ptr SurfaceLoader::generateWindtrapAnimationFrames(SDL_Surface* windtrapPic) const {
+sdl2::surface_ptr SurfaceLoader::generateWindtrapAnimationFrames(SDL_Surface* windtrapPic) {
     static constexpr int windtrapColorQuantizizer = 255 / (NUM_WINDTRAP_ANIMATIONS / 2 - 2);
 
     const int windtrapSize = windtrapPic->h;
@@ -1590,6 +1628,20 @@ sdl2::surface_ptr SurfaceLoader::generateWindtrapAnimationFrames(SDL_Surface* wi
     return returnPic;
 }
 
+sdl2::surface_ptr SurfaceLoader::generateWindtrapSurface(HOUSETYPE house, int zoom) const {
+    const auto windtrap = mapSurfaceColorRange(windtrapBase_.at(zoom).get(), PALCOLOR_HARKONNEN,
+                                               dune::globals::houseToPaletteIndex[static_cast<int>(house)]);
+
+    return generateWindtrapSurface(windtrap.get());
+}
+
+sdl2::surface_ptr SurfaceLoader::generateWindtrapSurface(SDL_Surface* windtrap) {
+    // Windtrap uses palette animation on PALCOLOR_WINDTRAP_COLORCYCLE; fake this
+    const auto frames = generateWindtrapAnimationFrames(windtrap);
+
+    return createTransparentSurface(frames.get(), COLOR_BLACK, COLOR_FOG_TRANSPARENT);
+}
+
 sdl2::surface_ptr SurfaceLoader::generateMapChoiceArrowFrames(SDL_Surface* arrowPic, HOUSETYPE house) {
     sdl2::surface_ptr returnPic{
         SDL_CreateRGBSurface(0, arrowPic->w * 4, arrowPic->h, SCREEN_BPP, RMASK, GMASK, BMASK, AMASK)};
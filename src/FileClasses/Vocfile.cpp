@@ -20,7 +20,7 @@
 
 #include <FileClasses/Vocfile.h>
 
-#include "misc/BufferedReader.h"
+#include "misc/RWopsData.h"
 #include "misc/string_error.h"
 #include <misc/SDL2pp.h>
 
@@ -34,6 +34,8 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <span>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -52,6 +54,29 @@ inline constexpr auto VOC_CODE_DATA_16   = 9;
 
 inline constexpr auto NUM_SAMPLES_OF_SILENCE = size_t{160};
 
+/// Reads consecutive values from the content of a voc-file
+class VocReader final {
+public:
+    explicit VocReader(std::span<const uint8_t> data) : data_{data} { }
+
+    bool read_one(void* data, size_t size) {
+        if (size > data_.size())
+            return false;
+
+        memcpy(data, data_.data(), size);
+        data_ = data_.subspan(size);
+        return true;
+    }
+
+    template<typename TValue>
+    bool read_type(TValue& value) {
+        return read_one(&value, sizeof(TValue));
+    }
+
+private:
+    std::span<const uint8_t> data_;
+};
+
 /**
  * Take a sample rate parameter as it occurs in a VOC sound header, and
  * return the corresponding sample frequency.
@@ -96,7 +121,9 @@ uint32_t getSampleRateFromVOCRate(uint8_t vocSR) {
 auto read_voc(SDL_RWops* rwop) {
     using namespace std::literals;
 
-    const auto buffer = std::make_unique<BufferedReader<>>(rwop);
+    // files in PAK-Files are read straight from the mapped PAK-File
+    const RWopsData filedata{rwop};
+    VocReader reader{filedata.data()};
 
     static constexpr auto creative_voice_file = "Creative Voice File"sv;
 
@@ -106,7 +133,7 @@ auto read_voc(SDL_RWops* rwop) {
     uint16_t version = 0;
     uint16_t id      = 0;
 
-    if (!buffer->read_one(description.data(), description.size())) {
+    if (!reader.read_one(description.data(), description.size())) {
         THROW(std::runtime_error, "LoadVOC_RW(): Invalid header!");
     }
 
@@ -118,17 +145,17 @@ auto read_voc(SDL_RWops* rwop) {
         THROW(std::runtime_error, "LoadVOC_RW(): Invalid header!");
     }
 
-    if (!buffer->read_type(offset)) {
+    if (!reader.read_type(offset)) {
         THROW(std::runtime_error, "LoadVOC_RW(): Invalid header!");
     }
     offset = SDL_SwapLE16(offset);
 
-    if (!buffer->read_type(version)) {
+    if (!reader.read_type(version)) {
         THROW(std::runtime_error, "LoadVOC_RW(): Invalid header!");
     }
     version = SDL_SwapLE16(version);
 
-    if (!buffer->read_type(id)) {
+    if (!reader.read_type(id)) {
         THROW(std::runtime_error, "LoadVOC_RW(): Invalid header!");
     }
     id = SDL_SwapLE16(id);
@@ -154,13 +181,13 @@ auto read_voc(SDL_RWops* rwop) {
     uint8_t code = 0;
     auto rate    = 0U;
 
-    while (buffer->read_type(code)) {
+    while (reader.read_type(code)) {
         if (code == VOC_CODE_TERM) {
             return std::make_tuple(std::move(ret_sound), decsize, rate);
         }
 
         uint8_t tmp[3];
-        if (!buffer->read_one(tmp, sizeof tmp)) {
+        if (!reader.read_one(tmp, sizeof tmp)) {
             THROW(std::runtime_error, "LoadVOC_RW(): Invalid block length!");
         }
         size_t len = tmp[0];
@@ -170,12 +197,12 @@ auto read_voc(SDL_RWops* rwop) {
         switch (code) {
             case VOC_CODE_DATA: {
                 uint8_t time_constant = 0;
-                if (!buffer->read_type(time_constant)) {
+                if (!reader.read_type(time_constant)) {
                     THROW(std::runtime_error, "LoadVOC_RW(): Cannot read time constant!");
                 }
 
                 uint8_t packing = 0;
-                if (!buffer->read_type(packing)) {
+                if (!reader.read_type(packing)) {
                     THROW(std::runtime_error, "LoadVOC_RW(): Cannot read packing!");
                 }
                 len -= 2;
@@ -197,7 +224,7 @@ auto read_voc(SDL_RWops* rwop) {
                     ret_sound.release();
                     ret_sound.reset(tmp_ret_sound);
 
-                    if (!buffer->read_one(ret_sound.get() + decsize, len)) {
+                    if (!reader.read_one(ret_sound.get() + decsize, len)) {
                         THROW(std::runtime_error, "LoadVOC_RW(): Cannot read data!");
                     }
 
@@ -209,13 +236,13 @@ auto read_voc(SDL_RWops* rwop) {
 
             case VOC_CODE_SILENCE: {
                 uint16_t SilenceLength = 0;
-                if (!buffer->read_type(SilenceLength)) {
+                if (!reader.read_type(SilenceLength)) {
                     THROW(std::runtime_error, "LoadVOC_RW(): Cannot read silence length!");
                 }
                 SilenceLength = SDL_SwapLE16(SilenceLength);
 
                 uint8_t time_constant = 0;
-                if (!buffer->read_type(time_constant)) {
+                if (!reader.read_type(time_constant)) {
                     THROW(std::runtime_error, "LoadVOC_RW(): Cannot read time constant!");
                 }
 
@@ -19,6 +19,7 @@
 
 #include <FileClasses/Decode.h>
 #include <FileClasses/Palette.h>
+#include <misc/dune_endian.h>
 
 #include "globals.h"
 #include <Definitions.h>
@@ -141,58 +142,58 @@ Wsafile::getAnimation(unsigned int startindex, unsigned int endindex, bool bDoub
 /// Helper method to decode one frame
 /**
     This helper method decodes one frame.
-    \param  pFiledata       Pointer to the data of this wsa-File
-    \param  index           Array with startoffsets
+    \param  filedata        the data of this wsa-File
+    \param  index           Array with startoffsets (little endian uint32_t, not aligned)
     \param  numberOfFrames  Number of frames to decode
     \param  pDecodedFrames  memory to copy decoded frames to (must be x*y*NumberOfFrames bytes long)
     \param  x               x-dimension of one frame
     \param  y               y-dimension of one frame
 */
-void Wsafile::decodeFrames(const unsigned char* pFiledata, uint32_t* index, int numberOfFrames,
+void Wsafile::decodeFrames(std::span<const unsigned char> filedata, const unsigned char* index, int numberOfFrames,
                            unsigned char* pDecodedFrames, int x, int y) const {
+    const auto frameSize = static_cast<size_t>(x) * y;
+
+    std::vector<unsigned char> dec80(frameSize * 2);
+
     for (auto i = ptrdiff_t{0}; i < ptrdiff_t{numberOfFrames}; ++i) {
-        auto dec80 = std::make_unique<unsigned char[]>(static_cast<size_t>(x) * y * 2);
+        const auto offset = static_cast<uint32_t>(dune::read_le_uint32(index + sizeof(uint32_t) * i));
 
-        decode80(pFiledata + SDL_SwapLE32(index[i]), dec80.get(), 0);
+        if (offset >= filedata.size()) {
+            THROW(std::runtime_error, "Wsafile::decodeFrames(): Frame {} is beyond the end of this file!", i);
+        }
 
-        decode40(dec80.get(), pDecodedFrames + i * x * y);
+        std::ranges::fill(dec80, 0);
 
-        dec80.reset();
+        const auto size = decode80(filedata.subspan(offset), dec80);
+
+        decode40(std::span{dec80}.first(size), {pDecodedFrames + i * frameSize, frameSize});
 
         if (i < numberOfFrames - 1) {
-            memcpy(pDecodedFrames + (i + 1) * x * y, pDecodedFrames + i * x * y, ptrdiff_t{x} * y);
+            memcpy(pDecodedFrames + (i + 1) * frameSize, pDecodedFrames + i * frameSize, frameSize);
         }
     }
 }
 
 /// Helper method for reading the complete wsa-file into memory.
 /**
-    This method reads the complete file into memory. A pointer to this memory is returned and
-    should be freed with free when no longer needed.
-
+    This method reads the complete file into memory. Files in PAK-Files are not copied but viewed in the
+    mapped PAK-File.
+    \param  rwop    SDL_RWops to the wsa-File
+    \return the content of the wsa-File
 */
-std::tuple<std::unique_ptr<unsigned char[]>, size_t> Wsafile::readfile(SDL_RWops* rwop) const {
+RWopsData Wsafile::readfile(SDL_RWops* rwop) const {
     if (rwop == nullptr) {
         THROW(std::runtime_error, "Wsafile::readfile(): rwop == nullptr!");
     }
 
-    const auto endOffset = SDL_RWsize(rwop);
-    if (endOffset < 0) {
-        THROW(std::runtime_error, "Wsafile::readfile(): Cannot determine size of this *.wsa-File!");
-    }
-    const auto wsaFilesize = static_cast<size_t>(endOffset);
+    RWopsData filedata{rwop};
 
-    if (wsaFilesize < 10) {
+    // the header is at most 10 bytes and the check for its size reads the bytes 12 and 13
+    if (filedata.size() < 14) {
         THROW(std::runtime_error, "Wsafile::readfile(): No valid WSA-File: File too small!");
     }
 
-    auto pFiledata = std::make_unique<unsigned char[]>(wsaFilesize);
-
-    if (SDL_RWread(rwop, pFiledata.get(), wsaFilesize, 1) != 1) {
-        THROW(std::runtime_error, "Wsafile::readfile(): Reading this *.wsa-File failed!");
-    }
-
-    return {std::move(pFiledata), gsl::narrow<int>(wsaFilesize)};
+    return filedata;
 }
 
 /// Helper method for reading and concatenating various WSA-Files.
@@ -204,8 +205,8 @@ std::tuple<std::unique_ptr<unsigned char[]>, size_t> Wsafile::readfile(SDL_RWops
 void Wsafile::readdata(const std::initializer_list<SDL_RWops*>& rwops) {
     const auto numFiles = rwops.size();
 
-    std::vector<std::unique_ptr<unsigned char[]>> pFiledata(numFiles);
-    std::vector<uint32_t*> index(numFiles);
+    std::vector<RWopsData> pFiledata(numFiles);
+    std::vector<const unsigned char*> index(numFiles);
     std::vector<uint16_t> numberOfFrames(numFiles);
     std::vector<bool> extended(numFiles);
 
@@ -213,34 +214,42 @@ void Wsafile::readdata(const std::initializer_list<SDL_RWops*>& rwops) {
     looped    = false;
 
     for (auto i = size_t{0}; const auto rwop : rwops) {
-        auto [data, wsaFilesize] = readfile(rwop);
-
-        pFiledata[i]      = std::move(data);
-        numberOfFrames[i] = SDL_SwapLE16(*reinterpret_cast<Uint16*>(pFiledata[i].get()));
+        pFiledata[i]           = readfile(rwop);
+        const auto wsaFilesize = pFiledata[i].size();
+        numberOfFrames[i]      = dune::read_le_uint16(pFiledata[i].get());
 
         if (i == 0) {
-            sizeX = SDL_SwapLE16(*reinterpret_cast<Uint16*>(pFiledata[0].get() + 2));
-            sizeY = SDL_SwapLE16(*reinterpret_cast<Uint16*>(pFiledata[0].get() + 4));
+            sizeX = dune::read_le_uint16(pFiledata[0].get() + 2);
+            sizeY = dune::read_le_uint16(pFiledata[0].get() + 4);
         } else {
-            if (sizeX != SDL_SwapLE16(*reinterpret_cast<Uint16*>(pFiledata[i].get() + 2))
-                || sizeY != SDL_SwapLE16(*reinterpret_cast<Uint16*>(pFiledata[i].get() + 4))) {
+            if (sizeX != dune::read_le_uint16(pFiledata[i].get() + 2)
+                || sizeY != dune::read_le_uint16(pFiledata[i].get() + 4)) {
                 THROW(std::runtime_error,
                       "Wsafile::readdata(): The wsa-files have different image dimensions. Cannot concatenate them!");
             }
         }
 
-        if (reinterpret_cast<unsigned short*>(pFiledata[i].get())[6] == 0) {
-            index[i] = reinterpret_cast<uint32_t*>(pFiledata[i].get() + 10);
+        if (dune::read_le_uint16(pFiledata[i].get() + 12) == 0) {
+            index[i] = pFiledata[i].get() + 10;
         } else {
-            index[i] = reinterpret_cast<uint32_t*>(pFiledata[i].get() + 8);
+            index[i] = pFiledata[i].get() + 8;
+        }
+
+        // the index has an offset for every frame, the end of the file and the loop frame
+        const auto indexSize = sizeof(uint32_t) * (static_cast<size_t>(numberOfFrames[i]) + 2);
+        if (wsaFilesize - static_cast<size_t>(index[i] - pFiledata[i].get()) < indexSize) {
+            THROW(std::runtime_error, "Wsafile::readdata(): No valid WSA-File: File too small!");
         }
 
-        if (index[i][0] == 0) {
+        if (dune::read_le_uint32(index[i]) == 0) {
             // extended animation
+            if (numberOfFrames[i] == 0) {
+                THROW(std::runtime_error, "Wsafile::readdata(): No valid WSA-File: Extended WSA-File without frames!");
+            }
             if (i == 0U) {
                 sdl2::log_info("Extended WSA-File!");
             }
-            index[i]++;
+            index[i] += sizeof(uint32_t);
             numberOfFrames[i]--;
             extended[i] = true;
         } else {
@@ -248,7 +257,7 @@ void Wsafile::readdata(const std::initializer_list<SDL_RWops*>& rwops) {
         }
 
         if (i == 0U) {
-            if (index[0][numberOfFrames[0] + 1] == 0) {
+            if (dune::read_le_uint32(index[0] + sizeof(uint32_t) * (numberOfFrames[0] + 1)) == 0) {
                 // index[numberOfFrames[0]] point to end of file
                 // => no loop
                 looped = false;
@@ -260,11 +269,6 @@ void Wsafile::readdata(const std::initializer_list<SDL_RWops*>& rwops) {
             }
         }
 
-        if (pFiledata[i].get() + wsaFilesize
-            < reinterpret_cast<unsigned char*>(index[i]) + sizeof(uint32_t) * numberOfFrames[i]) {
-            THROW(std::runtime_error, "Wsafile::readdata(): No valid WSA-File: File too small!");
-        }
-
         numFrames += numberOfFrames[i];
         ++i;
     }
@@ -273,8 +277,9 @@ void Wsafile::readdata(const std::initializer_list<SDL_RWops*>& rwops) {
     decodedFrames.resize(static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY) * numFrames);
 
     assert(decodedFrames.size() >= static_cast<size_t>(sizeX) * sizeY);
-    decodeFrames(pFiledata[0].get(), index[0], numberOfFrames[0], decodedFrames.data(), sizeX, sizeY);
-    pFiledata[0].reset();
+    decodeFrames({pFiledata[0].get(), pFiledata[0].size()}, index[0], numberOfFrames[0], decodedFrames.data(), sizeX,
+                 sizeY);
+    pFiledata[0] = {};
 
     if (numFiles > 1) {
         auto* nextFreeFrame =
@@ -287,9 +292,10 @@ void Wsafile::readdata(const std::initializer_list<SDL_RWops*>& rwops) {
                        static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY));
             }
             assert(nextFreeFrame + static_cast<ptrdiff_t>(sizeX) * sizeY <= &decodedFrames.back());
-            decodeFrames(pFiledata[i].get(), index[i], numberOfFrames[i], nextFreeFrame, sizeX, sizeY);
+            decodeFrames({pFiledata[i].get(), pFiledata[i].size()}, index[i], numberOfFrames[i], nextFreeFrame, sizeX,
+                         sizeY);
             nextFreeFrame += static_cast<ptrdiff_t>(numberOfFrames[i]) * sizeX * sizeY;
-            pFiledata[i].reset();
+            pFiledata[i] = {};
         }
     }
 }
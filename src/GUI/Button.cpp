@@ -23,6 +23,7 @@
 #include <SoundPlayer.h>
 
 #include "misc/DrawingRectHelper.h"
+#include "misc/RedrawScheduler.h"
 #include "misc/dune_clock.h"
 
 #include <chrono>
@@ -176,8 +177,11 @@ void Button::drawOverlay([[maybe_unused]] Point position) {
     if (!isVisible() || !isEnabled() || !bHover_ || !tooltipTexture_)
         return;
 
-    if (dune::dune_clock::now() - tooltipLastMouseMotion_ <= 750ms)
+    if (dune::dune_clock::now() - tooltipLastMouseMotion_ <= 750ms) {
+        // show the tooltip once the mouse rested long enough
+        dune::RedrawScheduler::wakeAt(tooltipLastMouseMotion_ + 750ms);
         return;
+    }
 
     const auto renderRect = getRendererSize();
     const auto render_w   = static_cast<float>(renderRect.w);
@@ -19,6 +19,7 @@
 
 #include "GUI/GUIStyle.h"
 #include "globals.h"
+#include "misc/RedrawScheduler.h"
 #include "misc/dune_clock.h"
 #include "misc/string_util.h"
 
@@ -80,6 +81,10 @@ void TextBox::draw(Point position) {
 
         if (dune::dune_clock::now() - lastCaretTime_ >= 1000ms)
             lastCaretTime_ = dune::dune_clock::now();
+
+        // the caret blinks every 500ms
+        const auto caretOn = dune::dune_clock::now() - lastCaretTime_ < 500ms;
+        dune::RedrawScheduler::wakeAt(lastCaretTime_ + (caretOn ? 500ms : 1000ms));
     } else
         pTextureWithoutCaret_.draw(renderer, position.x, position.y);
 }
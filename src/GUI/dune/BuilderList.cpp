@@ -23,6 +23,7 @@
 #include <FileClasses/FontManager.h>
 #include <FileClasses/GFXManager.h>
 #include <FileClasses/TextManager.h>
+#include <misc/RedrawScheduler.h>
 #include <misc/draw_util.h>
 
 #include <Game.h>
@@ -380,8 +381,11 @@ void BuilderList::draw(Point position) {
 void BuilderList::drawOverlay(Point position) {
     using namespace std::chrono_literals;
 
-    if (dune::dune_clock::now() - lastMouseMovement <= 800ms)
+    if (dune::dune_clock::now() - lastMouseMovement <= 800ms) {
+        // show the tooltip once the mouse rested long enough
+        dune::RedrawScheduler::wakeAt(lastMouseMovement + 800ms);
         return;
+    }
 
     auto* const currentGame = dune::globals::currentGame.get();
     auto* const renderer    = dune::globals::renderer.get();
@@ -18,6 +18,7 @@
 #include <GUI/dune/ChatManager.h>
 
 #include "misc/DrawingRectHelper.h"
+#include "misc/RedrawScheduler.h"
 #include "misc/dune_clock.h"
 #include "misc/dune_localtime.h"
 #include <FileClasses/FontManager.h>
@@ -49,6 +50,10 @@ void ChatManager::draw(Point position) {
         chatMessages.pop_front();
     }
 
+    // remove the oldest message when it expires
+    if (!chatMessages.empty())
+        dune::RedrawScheduler::wakeAt(chatMessages.front().messageTime + MAX_MESSAGESHOWTIME);
+
     // determine maximum vertical size of username and time
     auto maxUsernameSizeY = 0.f;
     auto maxTimeSizeY     = 0.f;
@@ -19,6 +19,9 @@
 
 #include <globals.h>
 
+#include <SaveGameHeader.h>
+#include <sand.h>
+
 #include <FileClasses/GFXManager.h>
 #include <FileClasses/TextManager.h>
 #include <misc/FileSystem.h>
@@ -32,17 +35,34 @@
 #include <gsl/gsl>
 
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <utility>
 
 namespace {
 inline constexpr auto invalid_chars = "?*:|<>/\\\"'`";
+
+std::string getSaveGameDescription(const SaveGameHeader& header) {
+    if (header.gameType == GameType::Campaign || header.gameType == GameType::Skirmish) {
+        return fmt::sprintf(_("%s, Mission %d"), getHouseNameByNumber(header.houseID), header.mission);
+    }
+
+    return fmt::format("{}, {} {}", header.mapName, header.houseInfoList.size(), _("Houses"));
 }
 
+/// formats the game time of a savegame; format gets hours, minutes and seconds
+std::string getSaveGameTime(std::string_view format, const SaveGameHeader& header) {
+    const auto seconds = header.gameCycleCount * GAMESPEED_DEFAULT / 1000;
+
+    return fmt::sprintf(format, seconds / 3600, seconds % 3600 / 60, seconds % 60);
+}
+} // namespace
+
 LoadSaveWindow::LoadSaveWindow(bool bSave, std::string caption, std::vector<std::filesystem::path> directories,
                                std::vector<std::string> directoryTitles, std::string extension,
                                int preselectedDirectoryIndex, std::string preselectedFile, uint32_t color)
-    : Window(0, 0, 0, 0), bSaveWindow_(bSave), directories_(std::move(directories)),
+    : Window(0, 0, 0, 0), bSaveWindow_(bSave), bShowSaveGameInfo_(!bSave && extension == "dls"),
+      directories_(std::move(directories)),
       directoryTitles_(std::move(directoryTitles)), extension_(std::move(extension)),
       currentDirectoryIndex_(preselectedDirectoryIndex), preselectedFile_(preselectedFile), color_(color) {
 
@@ -82,14 +102,30 @@ LoadSaveWindow::LoadSaveWindow(bool bSave, std::string caption, std::vector<std:
         mainVBox.addWidget(&directoryHBox, 20);
     }
 
-    mainVBox.addWidget(&fileListHBox, (bSave ? 121 : 151) - (directories_.size() > 1 ? 20 : 0));
+    mainVBox.addWidget(&fileListHBox,
+                       (bSave || bShowSaveGameInfo_ ? 121 : 151) - (directories_.size() > 1 ? 20 : 0));
     fileList.setColor(color);
     fileList.setOnSelectionChange([this](bool bInteractive) { onSelectionChange(bInteractive); });
     fileList.setOnDoubleClick([this] { onOK(); });
     fileListHBox.addWidget(&fileList);
 
+    if (bShowSaveGameInfo_) {
+        fileListHBox.addWidget(Widget::create<HSpacer>(5).release());
+        fileListHBox.addWidget(&thumbnailVBox, SAVEGAME_THUMBNAIL_SIZE);
+        thumbnailVBox.addWidget(&thumbnail);
+        thumbnailVBox.addWidget(Widget::create<Spacer>().release());
+        thumbnail.setVisible(false);
+    }
+
     mainVBox.addWidget(Widget::create<VSpacer>(5).release());
 
+    if (bShowSaveGameInfo_) {
+        saveGameInfoLabel.setTextColor(color);
+        saveGameInfoLabel.setTextFontSize(12);
+        mainVBox.addWidget(&saveGameInfoLabel, 25);
+        mainVBox.addWidget(Widget::create<VSpacer>(5).release());
+    }
+
     if (bSave) {
         saveName.setTextColor(color);
         mainVBox.addWidget(&saveName);
@@ -136,17 +172,32 @@ LoadSaveWindow::~LoadSaveWindow() {
 
 void LoadSaveWindow::updateEntries() {
     fileList.clearAllEntries();
+    fileNames_.clear();
+    headers_.clear();
 
-    auto preselectedFileIndex = ListBox::invalid_index;
-    for (const auto& fileName :
-         getFileNamesList(directories_[currentDirectoryIndex_], extension_, true, FileListOrder_ModifyDate_Dsc)) {
-        const auto entryName{(fileName.stem().string())};
+    const auto& directory = directories_[currentDirectoryIndex_];
 
-        fileList.addEntry(entryName);
+    auto preselectedFileIndex = ListBox::invalid_index;
+    for (const auto& fileName : getFileNamesList(directory, extension_, true, FileListOrder_ModifyDate_Dsc)) {
+        auto entryName{(fileName.stem().string())};
 
         if (entryName == preselectedFile_) {
-            preselectedFileIndex = fileList.getNumEntries() - 1;
+            preselectedFileIndex = fileList.getNumEntries();
         }
+
+        // only the uncompressed header at the beginning of the savegame is read
+        if (bShowSaveGameInfo_) {
+            const auto& header = headers_.emplace_back(SaveGameHeader::read(directory / fileName));
+
+            auto text = header ? fmt::format("{} ({})", entryName, getSaveGameTime("%d:%02d:%02d", *header))
+                               : entryName;
+
+            fileList.addEntry(std::move(text), static_cast<int>(fileNames_.size()));
+        } else {
+            fileList.addEntry(entryName, static_cast<int>(fileNames_.size()));
+        }
+
+        fileNames_.push_back(std::move(entryName));
     }
 
     if (preselectedFileIndex != ListBox::invalid_index) {
@@ -170,7 +221,8 @@ bool LoadSaveWindow::handleKeyPress(const SDL_KeyboardEvent& key) {
                 return true;
 
             auto* const pQstBox =
-                QstBox::create(fmt::sprintf(_("Do you really want to delete '%s' ?"), fileList.getSelectedEntry()),
+                QstBox::create(fmt::sprintf(_("Do you really want to delete '%s' ?"),
+                                            getEntryFileName(fileList.getSelectedIndex())),
                                _("Yes"), _("No"), QSTBOX_BUTTON1);
 
             pQstBox->setTextColor(color_);
@@ -193,7 +245,7 @@ void LoadSaveWindow::onChildWindowClose(Window* pChildWindow) {
     if (!fileList.isValid(index))
         return;
 
-    const auto file2delete = directories_[currentDirectoryIndex_] / (fileList.getEntry(index) + "." + extension_);
+    const auto file2delete = directories_[currentDirectoryIndex_] / (getEntryFileName(index) + "." + extension_);
 
     if (std::filesystem::remove(file2delete) != 0)
         return;
@@ -239,7 +291,7 @@ void LoadSaveWindow::onOK() {
         if (!fileList.isValid(index))
             return;
 
-        filename_ = directories_[currentDirectoryIndex_] / (fileList.getEntry(index) + "." + extension_);
+        filename_ = directories_[currentDirectoryIndex_] / (getEntryFileName(index) + "." + extension_);
         filename_ = filename_.lexically_normal().native();
 
         auto* const pParentWindow = dynamic_cast<Window*>(getParent());
@@ -279,6 +331,10 @@ void LoadSaveWindow::onDirectoryChange(int i) {
 }
 
 void LoadSaveWindow::onSelectionChange([[maybe_unused]] bool bInteractive) {
+    if (bShowSaveGameInfo_) {
+        updateSaveGameInfo();
+    }
+
     if (!bSaveWindow_)
         return;
 
@@ -286,5 +342,31 @@ void LoadSaveWindow::onSelectionChange([[maybe_unused]] bool bInteractive) {
     if (!fileList.isValid(index))
         return;
 
-    saveName.setText(fileList.getEntry(index));
+    saveName.setText(getEntryFileName(index));
+}
+
+void LoadSaveWindow::updateSaveGameInfo() {
+    const auto index = fileList.getSelectedIndex();
+
+    const auto* const header = fileList.isValid(index) ? &headers_.at(fileList.getEntryIntData(index)) : nullptr;
+
+    if (header == nullptr || !header->has_value()) {
+        saveGameInfoLabel.setText(std::string{});
+        thumbnail.setVisible(false);
+        return;
+    }
+
+    saveGameInfoLabel.setText(
+        fmt::format("{}\n{}", getSaveGameDescription(**header), getSaveGameTime(_("Time: %d:%02d:%02d"), **header)));
+
+    if (auto surface = (*header)->createThumbnailSurface()) {
+        thumbnail.setSurface(std::move(surface));
+        thumbnail.setVisible(true);
+    } else {
+        thumbnail.setVisible(false);
+    }
+}
+
+const std::string& LoadSaveWindow::getEntryFileName(ListBox::index_type index) const {
+    return fileNames_.at(fileList.getEntryIntData(index));
 }
@@ -19,6 +19,7 @@
 
 #include "Renderer/DuneRenderer.h"
 #include "misc/DrawingRectHelper.h"
+#include "misc/RedrawScheduler.h"
 #include <FileClasses/FontManager.h>
 
 #include <globals.h>
@@ -47,6 +48,9 @@ void MessageTicker::draw(Point position) {
     if (messages.empty())
         return;
 
+    // the messages are shown and scrolled for a number of frames
+    dune::RedrawScheduler::invalidate();
+
     if (timer++ == MESSAGESCROLLTIME) {
         timer = -MESSAGETIME;
         // delete first message
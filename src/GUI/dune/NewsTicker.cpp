@@ -20,6 +20,7 @@
 #include <globals.h>
 
 #include <FileClasses/GFXManager.h>
+#include <misc/RedrawScheduler.h>
 
 inline constexpr auto MESSAGESCROLLSPEED = 16;
 inline constexpr auto MESSAGESCROLLTIME  = (16 * MESSAGESCROLLSPEED);
@@ -62,6 +63,9 @@ void NewsTicker::draw(Point position) {
     if (messages.empty())
         return;
 
+    // the messages are shown and scrolled for a number of frames
+    dune::RedrawScheduler::invalidate();
+
     if (timer++ == MESSAGESCROLLTIME) {
         timer = -MESSAGETIME;
         // delete first message
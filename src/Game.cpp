@@ -33,6 +33,8 @@
 #include <misc/IFileStream.h>
 #include <misc/IMemoryStream.h>
 #include <misc/OFileStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/RedrawScheduler.h>
 #include <misc/SDL2pp.h>
 #include <misc/draw_util.h>
 #include <misc/dune_events.h>
@@ -52,11 +54,14 @@
 #include <Menu/MapChoice.h>
 #include <Menu/MentatHelp.h>
 
+#include <AutoSaver.h>
 #include <Bullet.h>
 #include <Explosion.h>
 #include <GameInitSettings.h>
 #include <House.h>
 #include <Map.h>
+#include <ReplaySnapshots.h>
+#include <SaveGameHeader.h>
 #include <ScreenBorder.h>
 #include <sand.h>
 
@@ -75,6 +80,7 @@
 #include <gsl/gsl>
 
 #include <algorithm>
+#include <array>
 
 Game::Game() : localPlayerName_(dune::globals::settings.general.playerName) {
     dune::globals::currentZoomlevel = dune::globals::settings.video.preferredZoomLevel;
@@ -196,7 +202,7 @@ void Game::initGame(const GameInitSettings& newGameInitSettings) {
     }
 }
 
-void Game::initReplay(const std::filesystem::path& filename) {
+void Game::initReplay(const std::filesystem::path& filename, uint32_t startCycle) {
     bReplay_ = true;
 
     IFileStream fs;
@@ -211,12 +217,86 @@ void Game::initReplay(const std::filesystem::path& filename) {
     // read GameInitInfo
     const GameInitSettings loadedGameInitSettings(fs);
 
+    skipToGameCycle_ = startCycle;
+
+    if (pReplaySnapshots_ != nullptr) {
+        if (const auto snapshotCycle = pReplaySnapshots_->findSnapshot(startCycle)) {
+            const auto snapshot = pReplaySnapshots_->getSnapshot(*snapshotCycle);
+
+            // the snapshot already contains all commands of the replay
+            IMemoryStream memStream(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+            if (!loadSaveGame(memStream)) {
+                THROW(std::runtime_error, "Restoring the replay snapshot of game cycle {} failed!", *snapshotCycle);
+            }
+
+            return;
+        }
+    }
+
     // load all commands
     cmdManager_.load(fs);
 
     initGame(loadedGameInitSettings);
 }
 
+void Game::seekReplay(uint32_t gameCycle) {
+    if (!bReplay_) {
+        return;
+    }
+
+    const auto restoreCycle =
+        pReplaySnapshots_ != nullptr ? pReplaySnapshots_->findRestorePoint(gameCycleCount_, gameCycle) : std::nullopt;
+
+    if (restoreCycle) {
+        // initReplay() restores the snapshot in a new game and skips the remaining game cycles
+        replaySeekCycle_ = gameCycle;
+        quitGame();
+    } else if (gameCycle >= gameCycleCount_) {
+        // there is no snapshot that would save us simulating the game cycles up to gameCycle
+        skipToGameCycle_ = gameCycle;
+    }
+}
+
+void Game::skipGameTime(uint32_t milliseconds) {
+    const auto cycles = MILLI2CYCLES(milliseconds);
+
+    if (bReplay_) {
+        if (SDL_GetModState() & KMOD_SHIFT) {
+            seekReplay(gameCycleCount_ - std::min(cycles, gameCycleCount_));
+        } else {
+            seekReplay(gameCycleCount_ + cycles);
+        }
+    } else if (gameType != GameType::CustomMultiplayer) {
+        skipToGameCycle_ = gameCycleCount_ + cycles;
+    }
+}
+
+void Game::updateReplaySnapshots() {
+    if (!bReplay_ || pReplaySnapshots_ == nullptr || !pReplaySnapshots_->isSnapshotDue(gameCycleCount_)) {
+        return;
+    }
+
+    OMemoryStream stream;
+    stream.open();
+
+    saveGame(stream);
+
+    pReplaySnapshots_->addSnapshot(gameCycleCount_, stream.getBytes());
+}
+
+void Game::updateAutoSave() {
+    if (pAutoSaver_ == nullptr || autosaveInterval_ == 0 || gameCycleCount_ % autosaveInterval_ != 0
+        || finishedLevel_) {
+        return;
+    }
+
+    // only the serialization happens here; compressing and writing is done by the worker thread of AutoSaver
+    if (!pAutoSaver_->save(createSaveGameData())) {
+        sdl2::log_info("Skipping the autosave of game cycle {} as the last autosave is still being written",
+                       gameCycleCount_);
+    }
+}
+
 void Game::processObjects() {
     // update all tiles
     map_->for_all([](Tile& t) { t.update(); });
@@ -264,10 +344,13 @@ void Game::processObjects() {
     std::erase_if(explosionList_, [](auto& e) { return e->update(); });
 }
 
-void Game::drawScreen() {
+void Game::drawScreen(const SDL_Rect* interfaceClip) {
     auto* const screenborder = dune::globals::screenborder.get();
     auto* const renderer     = dune::globals::renderer.get();
 
+    // the house colored pictures of a newly selected zoom level are generated on first use
+    dune::globals::pGFXManager->prepareZoomlevel(dune::globals::currentZoomlevel);
+
     const auto top_left     = screenborder->getTopLeftTile();
     const auto bottom_right = screenborder->getBottomRightTile();
 
@@ -285,7 +368,7 @@ void Game::drawScreen() {
     const auto x2 = BottomRightTile.x + 1;
     const auto y2 = BottomRightTile.y + 1;
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    Dune_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
     const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
     const SDL_Rect tile_rect{static_cast<int>((std::ceil(screenborder->world2screenX(0)))),
@@ -298,15 +381,30 @@ void Game::drawScreen() {
     SDL_Rect on_screen_rect;
     SDL_IntersectRect(&game_board_rect, &tile_rect, &on_screen_rect);
 
-    SDL_RenderSetClipRect(renderer, &on_screen_rect);
+    Dune_RenderSetClipRect(renderer, &on_screen_rect);
+
+    // consecutive sprites from the same texture are submitted together until something else is drawn
+    spriteBatch_.begin(renderer);
+
+    dune::RenderLayerScope layer{dune::RenderLayer::Ground};
 
     /* draw ground */
-    map_->for_each(x1, y1, x2, y2, [&](Tile& t) { t.blitGround(this); });
+    terrainCache_.invalidate(map_->collectTerrainChanges());
+    terrainCache_.draw(renderer, *screenborder, TopLeftTile, BottomRightTile, [&](const SDL_Rect& tiles) {
+        map_->for_each(tiles.x, tiles.y, tiles.x + tiles.w, tiles.y + tiles.h, [&](const Tile& t) {
+            t.blitTerrain(renderer, static_cast<float>((t.location_.x - tiles.x) * zoomedTileSize),
+                          static_cast<float>((t.location_.y - tiles.y) * zoomedTileSize));
+        });
+    });
+
+    map_->for_each(x1, y1, x2, y2, [&](const Tile& t) { t.blitGround(this); });
 
     /* draw structures */
+    layer.change(dune::RenderLayer::Structures);
     map_->for_each(x1, y1, x2, y2, [&](Tile& t) { t.blitStructures(this); });
 
     /* draw underground units */
+    layer.change(dune::RenderLayer::Units);
     map_->for_each(x1, y1, x2, y2, [&](Tile& t) { t.blitUndergroundUnits(this); });
 
     /* draw dead objects */
@@ -319,6 +417,7 @@ void Game::drawScreen() {
     map_->for_each(x1, y1, x2, y2, [&](Tile& t) { t.blitNonInfantryGroundUnits(this); });
 
     /* draw bullets */
+    layer.change(dune::RenderLayer::Bullets);
     for (const auto& pBullet : dune::globals::bulletList) {
         pBullet->blitToScreen(gameCycleCount_);
     }
@@ -329,8 +428,11 @@ void Game::drawScreen() {
     }
 
     /* draw air units */
+    layer.change(dune::RenderLayer::Units);
     map_->for_each(x1, y1, x2, y2, [&](Tile& t) { t.blitAirUnits(this); });
 
+    layer.change(dune::RenderLayer::GUI);
+
     // draw the gathering point line if a structure is selected
     if (selectedList_.size() == 1) {
         auto* const pStructure = getObjectManager().getObject<StructureBase>(*selectedList_.begin());
@@ -352,52 +454,70 @@ void Game::drawScreen() {
 
     auto* const gfx = dune::globals::pGFXManager.get();
 
+    layer.change(dune::RenderLayer::Fog);
+
+    // the overlay shows what the local house has explored, which changes completely when another house becomes the
+    // local house (e.g. when loading a game or switching the house in debug mode)
+    if (fogCacheHouse_ != dune::globals::pLocalHouse) {
+        fogCacheHouse_ = dune::globals::pLocalHouse;
+        fogCache_.invalidateAll();
+    }
+
+    // the overlay is kept up to date in debug mode, too
+    fogCache_.invalidate(map_->collectFogChanges(gameCycleCount_));
+
     if (!dune::globals::debug) {
         auto* const hiddenTexZoomed    = gfx->getZoomedObjPic(ObjPic_Terrain_Hidden, zoom);
         auto* const hiddenFogTexZoomed = gfx->getZoomedObjPic(ObjPic_Terrain_HiddenFog, zoom);
 
         const auto fogOfWar = gameInitSettings_.getGameOptions().fogOfWar;
 
-        map_->for_each(top_left.x - 1, top_left.y - 1, bottom_right.x + 1, bottom_right.y + 1, [&](Tile& t) {
-            const auto x = t.getLocation().x;
-            const auto y = t.getLocation().y;
-
-            const auto* const pTile = &t;
+        const auto team_id = dune::globals::pLocalHouse->getTeamID();
 
-            const auto team_id = dune::globals::pLocalHouse->getTeamID();
+        fogCache_.draw(renderer, *screenborder, TopLeftTile, BottomRightTile, [&](const SDL_Rect& tiles) {
+            auto drawn = false;
 
-            const SDL_FRect drawLocation{screenborder->world2screenX(x * TILESIZE),
-                                         screenborder->world2screenY(y * TILESIZE), static_cast<float>(zoomedTileSize),
-                                         static_cast<float>(zoomedTileSize)};
+            map_->for_each(tiles.x, tiles.y, tiles.x + tiles.w, tiles.y + tiles.h, [&](const Tile& t) {
+                const SDL_FRect drawLocation{static_cast<float>((t.location_.x - tiles.x) * zoomedTileSize),
+                                             static_cast<float>((t.location_.y - tiles.y) * zoomedTileSize),
+                                             static_cast<float>(zoomedTileSize), static_cast<float>(zoomedTileSize)};
 
-            if (pTile->isExploredByTeam(this, team_id)) {
-                const auto hideTile = t.getHideTile(this, team_id);
+                if (t.isExploredByTeam(this, team_id)) {
+                    const auto hideTile = t.getHideTile(this, team_id);
 
-                if (hideTile != 0) {
-                    const SDL_Rect source{hideTile * zoomedTileSize, 0, zoomedTileSize, zoomedTileSize};
-                    Dune_RenderCopyF(renderer, hiddenTexZoomed, &source, &drawLocation);
-                }
+                    if (hideTile != 0) {
+                        const SDL_Rect source{hideTile * zoomedTileSize, 0, zoomedTileSize, zoomedTileSize};
+                        Dune_RenderCopyF(renderer, hiddenTexZoomed, &source, &drawLocation);
+                        drawn = true;
+                    }
 
-                if (fogOfWar) {
-                    const auto fogTile = pTile->isFoggedByTeam(this, team_id)
-                                           ? static_cast<int>(HIDDENTYPE::Terrain_HiddenFull)
-                                           : pTile->getFogTile(this, team_id);
+                    if (fogOfWar) {
+                        const auto fogTile = t.isFoggedByTeam(this, team_id)
+                                               ? static_cast<int>(HIDDENTYPE::Terrain_HiddenFull)
+                                               : t.getFogTile(this, team_id);
 
-                    if (fogTile != 0) {
-                        const SDL_Rect source{fogTile * zoomedTileSize, 0, zoomedTileSize, zoomedTileSize};
-                        Dune_RenderCopyF(renderer, hiddenFogTexZoomed, &source, &drawLocation);
+                        if (fogTile != 0) {
+                            const SDL_Rect source{fogTile * zoomedTileSize, 0, zoomedTileSize, zoomedTileSize};
+                            Dune_RenderCopyF(renderer, hiddenFogTexZoomed, &source, &drawLocation);
+                            drawn = true;
+                        }
                     }
-                }
-            } else {
-                if (!dune::globals::debug) {
+                } else {
                     const SDL_Rect source{zoomedTileSize * 15, 0, zoomedTileSize, zoomedTileSize};
                     Dune_RenderCopyF(renderer, hiddenTexZoomed, &source, &drawLocation);
+                    drawn = true;
                 }
-            }
+            });
+
+            return drawn;
         });
     }
 
-    SDL_RenderSetClipRect(renderer, nullptr);
+    layer.change(dune::RenderLayer::GUI);
+
+    spriteBatch_.end();
+
+    Dune_RenderSetClipRect(renderer, nullptr);
 
     /////////////draw placement position
 
@@ -502,6 +622,9 @@ void Game::drawScreen() {
     }
 
     ///////////draw game bar
+    if (interfaceClip)
+        dune::setFrameClip(renderer, interfaceClip);
+
     pInterface_->draw({});
     pInterface_->drawOverlay({});
 
@@ -511,6 +634,8 @@ void Game::drawScreen() {
 
     // draw chat message currently typed
     if (chatMode_) {
+        using namespace std::chrono_literals;
+
         const auto pChatTexture = gui.createText(
             renderer,
             "Chat: " + typingChatMessage_
@@ -518,9 +643,14 @@ void Game::drawScreen() {
             COLOR_WHITE, 14);
 
         pChatTexture.draw(renderer, 20.f, renderer_height - 40.f);
+
+        // the cursor blinks every 150ms
+        dune::RedrawScheduler::wakeAfter(150ms);
     }
 
     if (bShowFPS_) {
+        dune::RedrawScheduler::invalidate();
+
         const auto str = fmt::sprintf("fps: %4.1f\nrenderer: %4.1fms\nupdate: %4.1fms", 1000.0f / averageFrameTime_,
                                       averageRenderTime_, averageUpdateTime_);
 
@@ -528,7 +658,26 @@ void Game::drawScreen() {
 
         pTexture.draw(renderer, sideBarPos_.x - 14.f * 8.f, 60.f);
 
+        // what was drawn during the last frame per layer
+        std::string stats;
+        const auto& frame = dune::RenderStats::lastFrame();
+        for (auto i = 0u; i < frame.size(); ++i) {
+            const auto& layer = frame[i];
+
+            stats += fmt::format("{}: {} copies, {} calls, {} tex, {} state, {:.1f} MP\n",
+                                 dune::to_string(static_cast<dune::RenderLayer>(i)), layer.copies, layer.draw_calls,
+                                 layer.texture_switches, layer.state_changes, static_cast<double>(layer.pixels) / 1e6);
+        }
+
+        if (dune::RenderStats::dumping())
+            stats += _("Writing render statistics");
+
+        auto pStatsTexture = gui.createMultilineText(renderer, stats, COLOR_WHITE, 12);
+
+        pStatsTexture.draw(renderer, sideBarPos_.x - pStatsTexture.width_ - 8.f, 60.f + pTexture.height_ + 4.f);
+
         dune::defer_destroy_texture(std::move(pTexture));
+        dune::defer_destroy_texture(std::move(pStatsTexture));
     }
 
     if (bShowTime_) {
@@ -543,12 +692,11 @@ void Game::drawScreen() {
     }
 
     if (bPause_) {
-        SDL_SetRenderDrawColor(renderer, 0, 242, 0, 128);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        const auto rects = std::to_array<SDL_FRect>(
-            {{10, renderer_height - 20 - 36, 12, 36}, {10 + 12 + 8, renderer_height - 20 - 36, 12, 36}});
+        Dune_SetRenderDrawColor(renderer, 0, 242, 0, 128);
+        Dune_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-        SDL_RenderFillRectsF(renderer, rects.data(), static_cast<int>(rects.size()));
+        DuneFillRects(renderer,
+                      {{10, renderer_height - 20 - 36, 12, 36}, {10 + 12 + 8, renderer_height - 20 - 36, 12, 36}});
     } else if (gameCycleCount_ < skipToGameCycle_) {
         // Cache this texture...
         auto pTexture = gui.createText(renderer, ">>", COLOR_RGBA(0, 242, 0, 128), 48);
@@ -590,7 +738,131 @@ void Game::drawScreen() {
     drawCursor(on_screen_rect);
 }
 
+void Game::collectScreenChanges() {
+    using namespace std::chrono_literals;
+
+    const auto* const screenborder = dune::globals::screenborder.get();
+
+    const auto top_left = screenborder->getTopLeftCorner();
+    const auto zoom     = dune::globals::currentZoomlevel;
+
+    // Input might change any part of the interface or show a tooltip after a short delay. The placement grid, the
+    // selection rectangle and the capture cursor follow the mouse. A new local house sees a different map.
+    if (top_left != drawnTopLeft_ || zoom != drawnZoomlevel_ || dune::globals::pLocalHouse != fogCacheHouse_
+        || dune::dune_clock::now() - lastInputTime_ < 1s || selectionMode_ || currentCursorMode == CursorMode_Placing
+        || currentCursorMode == CursorMode_Capture || bShowFPS_ || bShowTime_ || chatMode_ || finished_
+        || pendingScreenshot_ || pInGameMenu_ != nullptr || pInGameMentat_ != nullptr
+        || pWaitingForOtherPlayers_ != nullptr || gameCycleCount_ < skipToGameCycle_) {
+        dirtyRegion_.markAll();
+    }
+
+    drawnTopLeft_   = top_left;
+    drawnZoomlevel_ = zoom;
+
+    if (gameCycleCount_ != drawnGameCycle_) {
+        drawnGameCycle_ = gameCycleCount_;
+
+        // the radar, the build progress and the power, spice and credits indicators change in every game cycle
+        dirtyInterface_.add(sideBarPos_);
+
+        // redraw the objects and animations where they were drawn the last time and where they are now
+        const auto changed = collectChangedTiles();
+
+        addChangedTiles(drawnChangedTiles_);
+        addChangedTiles(changed);
+
+        drawnChangedTiles_ = changed;
+    }
+
+    // the news ticker scrolls and chat messages expire while the game is paused
+    if (pInterface_->newsTickerHasMessage())
+        dirtyInterface_.add(topBarPos_);
+
+    // the chat messages are part of the interface but shown on top of the map view
+    if (!pInterface_->getChatManager().empty()) {
+        dirtyRegion_.add(screenborder->getGameBoard());
+        dirtyInterface_.add(screenborder->getGameBoard());
+    }
+}
+
+SDL_Rect Game::collectChangedTiles() {
+    const auto* const screenborder = dune::globals::screenborder.get();
+
+    // sprites, selection boxes and health bars reach into the neighbouring tiles
+    static constexpr auto margin = 2;
+
+    const auto top_left     = screenborder->getTopLeftTile() - Coord(margin, margin);
+    const auto bottom_right = screenborder->getBottomRightTile() + Coord(margin, margin);
+
+    auto x1 = bottom_right.x + 1;
+    auto y1 = bottom_right.y + 1;
+    auto x2 = top_left.x - 1;
+    auto y2 = top_left.y - 1;
+
+    const auto add = [&](int x, int y) {
+        if (x < top_left.x || x > bottom_right.x || y < top_left.y || y > bottom_right.y)
+            return;
+
+        x1 = std::min(x1, x);
+        y1 = std::min(y1, y);
+        x2 = std::max(x2, x);
+        y2 = std::max(y2, y);
+    };
+
+    map_->for_each(top_left.x, top_left.y, bottom_right.x + 1, bottom_right.y + 1, [&](const Tile& t) {
+        if (t.isAnimated(gameCycleCount_))
+            add(t.location_.x, t.location_.y);
+    });
+
+    // the terrain and fog caches are updated while drawing, so only look at their changes
+    map_->collectTerrainChanges().for_each(add);
+    map_->collectFogChanges(gameCycleCount_).for_each(add);
+
+    auto& groundChanges = map_->collectGroundChanges();
+    groundChanges.for_each(add);
+    groundChanges.clear();
+
+    for (const auto& pBullet : dune::globals::bulletList)
+        add(pBullet->getRealX().lround() / TILESIZE, pBullet->getRealY().lround() / TILESIZE);
+
+    for (const auto& pExplosion : explosionList_)
+        add(pExplosion->getPosition().x / TILESIZE, pExplosion->getPosition().y / TILESIZE);
+
+    if (indicatorFrame_ != NONE_ID)
+        add(indicatorPosition_.x / TILESIZE, indicatorPosition_.y / TILESIZE);
+
+    if (x2 < x1 || y2 < y1)
+        return {};
+
+    return {x1 - margin, y1 - margin, x2 - x1 + 1 + 2 * margin, y2 - y1 + 1 + 2 * margin};
+}
+
+void Game::addChangedTiles(const SDL_Rect& tiles) {
+    if (tiles.w <= 0 || tiles.h <= 0)
+        return;
+
+    const auto* const screenborder = dune::globals::screenborder.get();
+
+    const auto& board = screenborder->getGameBoard();
+
+    const auto x1 = std::max(board.x, screenborder->world2screenX(tiles.x * TILESIZE));
+    const auto y1 = std::max(board.y, screenborder->world2screenY(tiles.y * TILESIZE));
+    const auto x2 = std::min(board.x + board.w, screenborder->world2screenX((tiles.x + tiles.w) * TILESIZE));
+    const auto y2 = std::min(board.y + board.h, screenborder->world2screenY((tiles.y + tiles.h) * TILESIZE));
+
+    if (x2 > x1 && y2 > y1)
+        dirtyRegion_.add(SDL_FRect{x1, y1, x2 - x1, y2 - y1});
+}
+
 void Game::doInput(const GameContext& context, SDL_Event& event) {
+    // moving the mouse over the map view only changes the hardware cursor
+    if (event.type != SDL_MOUSEMOTION
+        || !dune::globals::screenborder->isScreenCoordInsideMap(static_cast<float>(event.motion.x),
+                                                                static_cast<float>(event.motion.y))) {
+        lastInputTime_ = dune::dune_clock::now();
+    }
+    dune::RedrawScheduler::invalidate();
+
     // check for a key press
 
     // first of all update mouse
@@ -877,6 +1149,14 @@ void Game::doInput(const GameContext& context, SDL_Event& event) {
                     default: break;
                 }
             } break;
+            case SDL_RENDER_TARGETS_RESET: {
+                terrainCache_.invalidateAll();
+                fogCache_.invalidateAll();
+            } break;
+            case SDL_RENDER_DEVICE_RESET: {
+                terrainCache_.release();
+                fogCache_.release();
+            } break;
             case SDL_QUIT: {
                 bQuitGame_ = true;
             } break;
@@ -944,6 +1224,8 @@ void Game::scrollViewport() {
 
             lastScrollTime_ = now;
         }
+
+        dune::RedrawScheduler::wakeAt(lastScrollTime_ + scrollInterval);
     }
 }
 
@@ -1123,18 +1405,7 @@ void Game::serviceNetwork(bool& bWaitForNetwork) {
 
     network_manager->update();
 
-    // test if we need to wait for data to arrive
-    for (const auto& playername : network_manager->getConnectedPeers()) {
-        const auto* const pPlayer = dynamic_cast<HumanPlayer*>(getPlayerByName(playername));
-        if (pPlayer != nullptr) {
-            if (pPlayer->nextExpectedCommandsCycle <= gameCycleCount_) {
-                // sdl2::log_info("Cycle {}: Waiting for player '{}' to send data for cycle {}...", GameCycleCount,
-                // pPlayer->getPlayername(), pPlayer->nextExpectedCommandsCycle);
-                bWaitForNetwork = true;
-                break;
-            }
-        }
-    }
+    bWaitForNetwork = isWaitingForNetwork();
 
     if (bWaitForNetwork) {
         if (startWaitingForOtherPlayersTime_ == dune::dune_clock::time_point{}) {
@@ -1160,6 +1431,19 @@ void Game::serviceNetwork(bool& bWaitForNetwork) {
     }
 }
 
+bool Game::isWaitingForNetwork() const {
+    const auto* const network_manager = dune::globals::pNetworkManager.get();
+    if (network_manager == nullptr)
+        return false;
+
+    // test if we need to wait for data to arrive
+    return std::ranges::any_of(network_manager->getConnectedPeers(), [this](const auto& playername) {
+        const auto* const pPlayer = dynamic_cast<const HumanPlayer*>(getPlayerByName(playername));
+
+        return pPlayer != nullptr && pPlayer->nextExpectedCommandsCycle <= gameCycleCount_;
+    });
+}
+
 void Game::updateGame(const GameContext& context) {
     pInterface_->getRadarView().update();
     cmdManager_.executeCommands(context, gameCycleCount_);
@@ -1193,6 +1477,9 @@ void Game::updateGame(const GameContext& context) {
     }
 
     gameCycleCount_++;
+
+    updateReplaySnapshots();
+    updateAutoSave();
 }
 
 void Game::doEventsUntil(const GameContext& context, const dune::dune_clock::time_point until) {
@@ -1221,6 +1508,33 @@ void Game::doEventsUntil(const GameContext& context, const dune::dune_clock::tim
     }
 }
 
+void Game::waitForRedraw(const GameContext& context) {
+    using namespace std::chrono_literals;
+
+    // draw at least once a second in case something changed without requesting a new frame
+    const auto latest = dune::dune_clock::now() + 1s;
+
+    SDL_Event event{};
+
+    while (bPause_ && !bQuitGame_ && !finishedLevel_) {
+        const auto now   = dune::dune_clock::now();
+        const auto until = std::min(dune::RedrawScheduler::nextWake(), latest);
+
+        if (until <= now)
+            return;
+
+        const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(until - now).count();
+
+        if (dune::Dune_WaitEvent(&event, static_cast<uint32_t>(timeout))) {
+            doInput(context, event);
+
+            while (SDL_PollEvent(&event)) {
+                doInput(context, event);
+            }
+        }
+    }
+}
+
 void Game::runMainLoop(const GameContext& context, MenuBase::event_handler_type handler) {
     using namespace std::chrono_literals;
 
@@ -1263,7 +1577,19 @@ void Game::runMainLoop(const GameContext& context, MenuBase::event_handler_type
 
     if (bReplay_) {
         cmdManager_.setReadOnly(true);
+
+        updateReplaySnapshots();
     } else {
+        // autosaving does not depend on the replay log
+        if (const auto minutes = dune::globals::settings.general.autosaveInterval; minutes > 0) {
+            auto [ok, savepath] =
+                fnkdat(gameType == GameType::CustomMultiplayer ? "mpsave/" : "save/", FNKDAT_USER | FNKDAT_CREAT);
+            if (ok) {
+                autosaveInterval_ = MILLI2CYCLES(minutes * 60 * 1000);
+                pAutoSaver_       = std::make_unique<AutoSaver>(std::move(savepath));
+            }
+        }
+
         auto pStream = std::make_unique<OFileStream>();
 
         const auto [ok, replayname] = fnkdat("replay/auto.rpl", FNKDAT_USER | FNKDAT_CREAT);
@@ -1335,7 +1661,8 @@ void Game::runMainLoop(const GameContext& context, MenuBase::event_handler_type
         network_manager->setOnPeerDisconnected(
             [this](const auto& name, auto bHost, auto cause) { onPeerDisconnected(name, bHost, cause); });
 
-        cmdManager_.setNetworkCycleBuffer(MILLI2CYCLES(network_manager->getMaxPeerRoundTripTime()) + 5);
+        cmdManager_.setNetworkCycleBuffer(
+            CommandManager::calcNetworkCycleBuffer(network_manager->getMaxPeerRoundTripTime()));
     }
 
     // Change music to ingame music
@@ -1357,6 +1684,13 @@ void Game::runMainLoop(const GameContext& context, MenuBase::event_handler_type
 
     auto* const renderer = dune::globals::renderer.get();
 
+    // the software renderer keeps the last frame in the window surface, so only the changed parts have to be redrawn
+    const auto dirtyRendering = dune::globals::settings.video.dirtyRegions && Dune_RenderIsSoftware(renderer);
+    if (dirtyRendering)
+        sdl2::log_info("Only redrawing the changed parts of the screen");
+
+    dirtyRegion_.markAll();
+
     // main game loop
     do {
         auto now = dune::dune_clock::now();
@@ -1380,18 +1714,46 @@ void Game::runMainLoop(const GameContext& context, MenuBase::event_handler_type
 
         const auto renderStart = dune::dune_clock::now();
 
-        // clear whole screen
-        SDL_SetRenderDrawColor(renderer, 100, 50, 0, 255);
-        SDL_RenderClear(renderer);
+        // the game view and the widgets request the next frame while being drawn
+        dune::RedrawScheduler::startFrame();
+
+        if (dirtyRendering)
+            collectScreenChanges();
+
+        if (!dirtyRendering || dirtyRegion_.isAll()) {
+            // clear whole screen
+            Dune_SetRenderDrawColor(renderer, 100, 50, 0, 255);
+            SDL_RenderClear(renderer);
+
+            drawScreen();
+
+            // Apparently this must be done after drawing, but before render present.
+            // https://discourse.libsdl.org/t/sdl-renderreadpixels-always-returns-black-rectangle/20371/6
+            if (pendingScreenshot_)
+                saveScreenshot();
+
+            Dune_RenderPresent(renderer);
+        } else if (!dirtyRegion_.empty() || !dirtyInterface_.empty()) {
+            // only redraw and present the changed parts, the rest of the window surface still shows the last frame
+            const auto screen = getRendererSize();
+
+            const std::array changed{dirtyRegion_.bounds(screen), dirtyInterface_.bounds(screen)};
 
-        drawScreen();
+            Dune_SetRenderDrawColor(renderer, 100, 50, 0, 255);
+            SDL_RenderFillRects(renderer, changed.data(), static_cast<int>(changed.size()));
 
-        // Apparently this must be done after drawing, but before render present.
-        // https://discourse.libsdl.org/t/sdl-renderreadpixels-always-returns-black-rectangle/20371/6
-        if (pendingScreenshot_)
-            saveScreenshot();
+            // the map view is drawn clipped to the first part and the interface clipped to the second one
+            dune::setFrameClip(renderer, &changed[0]);
 
-        Dune_RenderPresent(renderer);
+            drawScreen(&changed[1]);
+
+            dune::setFrameClip(renderer, nullptr);
+
+            Dune_RenderPresentRects(renderer, changed);
+        }
+
+        dirtyRegion_.clear();
+        dirtyInterface_.clear();
 
         updateFullscreen();
 
@@ -1463,6 +1825,10 @@ void Game::runMainLoop(const GameContext& context, MenuBase::event_handler_type
             if (targetGameCycle - gameCycleCount_ > 250)
                 targetGameCycle = gameCycleCount_;
 
+            // the commands of the other players might only have arrived for the first cycles of this frame
+            if (network_manager != nullptr && isWaitingForNetwork())
+                break;
+
             const auto updateStart = dune::dune_clock::now();
 
             updateGame(context);
@@ -1503,6 +1869,10 @@ void Game::runMainLoop(const GameContext& context, MenuBase::event_handler_type
                 ++count;
             }
         }
+
+        // nothing moves while the game is paused, so sleep until the screen changes
+        if (bPause_ && network_manager == nullptr)
+            waitForRedraw(context);
     } while (!bQuitGame_ && !finishedLevel_); // not sure if we need this extra bool
 
     // Game is finished
@@ -1555,6 +1925,7 @@ void Game::resumeGame() {
 void Game::onOptions() {
     if (bReplay_) {
         // don't show menu
+        replaySeekCycle_.reset();
         quitGame();
     } else {
         const auto color = SDL2RGB(
@@ -1693,7 +2064,7 @@ bool Game::loadSaveGame(InputStream& stream) {
     }
 
     uint32_t savegameVersion = stream.readUint32();
-    if (savegameVersion != SAVEGAMEVERSION) {
+    if (savegameVersion < SAVEGAMEVERSION_UNCOMPRESSED || savegameVersion > SAVEGAMEVERSION) {
         sdl2::log_info("Game::loadSaveGame(): No valid savegame! Expected savegame version {}, but got {}!",
                        SAVEGAMEVERSION, savegameVersion);
         return false;
@@ -1701,24 +2072,60 @@ bool Game::loadSaveGame(InputStream& stream) {
 
     std::string duneVersion = stream.readString();
 
+    if (savegameVersion == SAVEGAMEVERSION_UNCOMPRESSED) {
+        // the old format stores everything in one stream in the same order as the sections
+        return loadSaveGameSections(savegameVersion, stream, stream, stream, stream, stream, nullptr);
+    }
+
+    const SaveGameHeader header{stream};
+
+    const auto stateData   = readSaveGameSection(stream);
+    const auto mapData     = readSaveGameSection(stream);
+    const auto objectsData = readSaveGameSection(stream);
+    const auto bulletsData = readSaveGameSection(stream);
+    const auto commandData = readSaveGameSection(stream);
+
+    const auto asMemoryStream = [](const std::vector<uint8_t>& data) {
+        return IMemoryStream{reinterpret_cast<const char*>(data.data()), data.size()};
+    };
+
+    auto stateStream   = asMemoryStream(stateData);
+    auto mapStream     = asMemoryStream(mapData);
+    auto objectsStream = asMemoryStream(objectsData);
+    auto bulletsStream = asMemoryStream(bulletsData);
+    auto commandStream = asMemoryStream(commandData);
+
+    return loadSaveGameSections(savegameVersion, stateStream, mapStream, objectsStream, bulletsStream, commandStream,
+                                &header);
+}
+
+bool Game::loadSaveGameSections(uint32_t savegameVersion, InputStream& state, InputStream& map, InputStream& objects,
+                                InputStream& bullets, InputStream& commands, const SaveGameHeader* pHeader) {
     // if this is a multiplayer load we need to save some information before we overwrite gameInitSettings with
     // the settings saved in the savegame
     const bool bMultiplayerLoad = (gameInitSettings_.getGameType() == GameType::LoadMultiplayer);
     const GameInitSettings::HouseInfoList oldHouseInfoList = gameInitSettings_.getHouseInfoList();
 
     // read gameInitSettings
-    gameInitSettings_ = GameInitSettings(stream);
+    gameInitSettings_ = GameInitSettings(state);
+
+    // multiplayer games do not save the local player, the selection and the screen position (see saveGame())
+    const bool bMultiplayerSave = (gameInitSettings_.getGameType() == GameType::CustomMultiplayer);
 
     // read the actual house setup chosen at the beginning of the game
-    const auto numHouseInfo = stream.readUint32();
-    houseInfoListSetup_.reserve(numHouseInfo);
-    for (uint32_t i = 0; i < numHouseInfo; i++) {
-        houseInfoListSetup_.push_back(GameInitSettings::HouseInfo(stream));
+    if (pHeader != nullptr) {
+        houseInfoListSetup_ = pHeader->houseInfoList;
+    } else {
+        const auto numHouseInfo = state.readUint32();
+        houseInfoListSetup_.reserve(numHouseInfo);
+        for (uint32_t i = 0; i < numHouseInfo; i++) {
+            houseInfoListSetup_.push_back(GameInitSettings::HouseInfo(state));
+        }
     }
 
     // read map size
-    const auto mapSizeX = static_cast<short>(stream.readUint32());
-    const auto mapSizeY = static_cast<short>(stream.readUint32());
+    const auto mapSizeX = static_cast<short>(state.readUint32());
+    const auto mapSizeY = static_cast<short>(state.readUint32());
 
     // create the new map
     map_                          = std::make_unique<Map>(*this, mapSizeX, mapSizeY);
@@ -1727,23 +2134,23 @@ bool Game::loadSaveGame(InputStream& stream) {
     const GameContext context{*this, *map_, this->getObjectManager()};
 
     // read GameCycleCount
-    gameCycleCount_ = stream.readUint32();
+    gameCycleCount_ = state.readUint32();
 
     // read some settings
-    gameType  = static_cast<GameType>(stream.readSint8());
-    techLevel = stream.readUint8();
-    randomFactory.setSeed(stream.readUint8Vector());
-    auto seed = stream.readUint8Vector();
+    gameType  = static_cast<GameType>(state.readSint8());
+    techLevel = state.readUint8();
+    randomFactory.setSeed(state.readUint8Vector());
+    auto seed = state.readUint8Vector();
     randomGen.setState(seed);
 
     // read in the unit/structure data
-    objectData.load(stream);
+    objectData.load(state);
 
     // load the house(s) info
     for (auto i = 0; i < NUM_HOUSES; i++) {
-        if (stream.readBool()) {
+        if (state.readBool()) {
             // house in game
-            house_[i] = std::make_unique<House>(context, stream);
+            house_[i] = std::make_unique<House>(context, state);
         }
     }
 
@@ -1784,9 +2191,20 @@ bool Game::loadSaveGame(InputStream& stream) {
                 }
             }
         }
+    } else if (bMultiplayerSave) {
+        // a snapshot of a multiplayer replay; the players keep their names
+        dune::globals::pLocalPlayer = dynamic_cast<HumanPlayer*>(getPlayerByName(getLocalPlayerName()));
+        if (!dune::globals::pLocalPlayer) {
+            sdl2::log_info("Game::loadSaveGame(): No human player named '{}'!", getLocalPlayerName());
+
+            return false;
+        }
+
+        dune::globals::pLocalHouse =
+            house_[static_cast<int>(dune::globals::pLocalPlayer->getHouse()->getHouseID())].get();
     } else {
         // it is stored in the savegame, so set it up
-        const auto localPlayerID    = stream.readUint8();
+        const auto localPlayerID    = state.readUint8();
         dune::globals::pLocalPlayer = dynamic_cast<HumanPlayer*>(getPlayerByID(localPlayerID));
         if (!dune::globals::pLocalPlayer) {
             sdl2::log_info("Game::loadSaveGame(): No invalid playerID ({})!", localPlayerID);
@@ -1798,50 +2216,50 @@ bool Game::loadSaveGame(InputStream& stream) {
             house_[static_cast<int>(dune::globals::pLocalPlayer->getHouse()->getHouseID())].get();
     }
 
-    dune::globals::debug = stream.readBool();
-    bCheatsEnabled_      = stream.readBool();
+    dune::globals::debug = state.readBool();
+    bCheatsEnabled_      = state.readBool();
 
-    winFlags  = stream.readUint32();
-    loseFlags = stream.readUint32();
+    winFlags  = state.readUint32();
+    loseFlags = state.readUint32();
 
-    map_->load(stream);
+    map_->load(map, savegameVersion);
 
     // load the structures and units
-    objectManager_.load(stream);
+    objectManager_.load(objects);
 
-    const auto numBullets = stream.readUint32();
+    const auto numBullets = bullets.readUint32();
     dune::globals::bulletList.reserve(numBullets);
     for (auto i = 0u; i < numBullets; i++) {
-        map_->add_bullet(stream);
+        map_->add_bullet(bullets);
     }
 
-    const auto numExplosions = stream.readUint32();
+    const auto numExplosions = bullets.readUint32();
     explosionList_.reserve(numExplosions);
     for (auto i = 0u; i < numExplosions; i++) {
-        addExplosion(stream);
+        addExplosion(bullets);
     }
 
     auto* const screenborder = dune::globals::screenborder.get();
 
-    if (bMultiplayerLoad) {
+    if (bMultiplayerLoad || bMultiplayerSave) {
         screenborder->adjustScreenBorderToMapsize(map_->getSizeX(), map_->getSizeY());
 
         screenborder->setNewScreenCenter(dune::globals::pLocalHouse->getCenterOfMainBase() * TILESIZE);
 
     } else {
         // load selection list
-        selectedList_ = stream.readUint32Set();
+        selectedList_ = bullets.readUint32Set();
 
         // load the screenborder info
         screenborder->adjustScreenBorderToMapsize(map_->getSizeX(), map_->getSizeY());
-        screenborder->load(stream);
+        screenborder->load(bullets);
     }
 
     // load triggers
-    triggerManager_.load(stream);
+    triggerManager_.load(bullets);
 
     // CommandManager is at the very end of the file. DO NOT CHANGE THIS!
-    cmdManager_.load(stream);
+    cmdManager_.load(commands);
 
     finished_ = false;
 
@@ -1859,89 +2277,153 @@ bool Game::saveGame(const std::filesystem::path& filename) {
         return false;
     }
 
-    fs.writeUint32(SAVEMAGIC);
+    saveGame(fs);
 
-    fs.writeUint32(SAVEGAMEVERSION);
+    fs.close();
 
-    fs.writeString(VERSIONSTRING);
+    return true;
+}
 
-    // write gameInitSettings
-    gameInitSettings_.save(fs);
+void Game::saveGame(OutputStream& stream) {
+    createSaveGameData().write(stream);
+}
 
-    fs.writeUint32(gsl::narrow<uint32_t>(houseInfoListSetup_.size()));
-    for (const GameInitSettings::HouseInfo& houseInfo : houseInfoListSetup_) {
-        houseInfo.save(fs);
-    }
+SaveGameData Game::createSaveGameData() {
+    SaveGameData data;
+
+    data.header = createSaveGameHeader();
+
+    // see loadSaveGameSections() for the content of the sections
+    OMemoryStream section;
+    section.open();
+
+    // write gameInitSettings
+    gameInitSettings_.save(section);
 
     // write the map size
-    fs.writeUint32(map_->getSizeX());
-    fs.writeUint32(map_->getSizeY());
+    section.writeUint32(map_->getSizeX());
+    section.writeUint32(map_->getSizeY());
 
     // write GameCycleCount
-    fs.writeUint32(gameCycleCount_);
+    section.writeUint32(gameCycleCount_);
 
     // write some settings
-    fs.writeSint8(static_cast<int8_t>(gameType));
-    fs.writeUint8(static_cast<uint8_t>(techLevel));
-    fs.writeUint8Vector(randomFactory.getSeed());
-    fs.writeUint8Vector(randomGen.getState());
+    section.writeSint8(static_cast<int8_t>(gameType));
+    section.writeUint8(static_cast<uint8_t>(techLevel));
+    section.writeUint8Vector(randomFactory.getSeed());
+    section.writeUint8Vector(randomGen.getState());
 
     // write out the unit/structure data
-    objectData.save(fs);
+    objectData.save(section);
 
     // write the house(s) info
     for (int i = 0; i < NUM_HOUSES; i++) {
-        fs.writeBool(house_[i] != nullptr);
+        section.writeBool(house_[i] != nullptr);
 
         if (house_[i] != nullptr) {
-            house_[i]->save(fs);
+            house_[i]->save(section);
         }
     }
 
     if (gameInitSettings_.getGameType() != GameType::CustomMultiplayer) {
-        fs.writeUint8(dune::globals::pLocalPlayer->getPlayerID());
+        section.writeUint8(dune::globals::pLocalPlayer->getPlayerID());
     }
 
-    fs.writeBool(dune::globals::debug);
-    fs.writeBool(bCheatsEnabled_);
+    section.writeBool(dune::globals::debug);
+    section.writeBool(bCheatsEnabled_);
 
-    fs.writeUint32(winFlags);
-    fs.writeUint32(loseFlags);
+    section.writeUint32(winFlags);
+    section.writeUint32(loseFlags);
 
-    map_->save(fs, getGameCycleCount());
+    data.sections.push_back(section.releaseBytes());
+
+    map_->save(section, getGameCycleCount());
+
+    data.sections.push_back(section.releaseBytes());
 
     // save the structures and units
-    objectManager_.save(fs);
+    objectManager_.save(section);
 
-    fs.writeUint32(gsl::narrow<uint32_t>(dune::globals::bulletList.size()));
+    data.sections.push_back(section.releaseBytes());
+
+    section.writeUint32(gsl::narrow<uint32_t>(dune::globals::bulletList.size()));
     for (const auto& pBullet : dune::globals::bulletList) {
-        pBullet->save(fs);
+        pBullet->save(section);
     }
 
-    fs.writeUint32(gsl::narrow<uint32_t>(explosionList_.size()));
+    section.writeUint32(gsl::narrow<uint32_t>(explosionList_.size()));
     for (const auto& pExplosion : explosionList_) {
-        pExplosion->save(fs);
+        pExplosion->save(section);
     }
 
     if (gameInitSettings_.getGameType() != GameType::CustomMultiplayer) {
         // save selection lists
 
         // write out selected units list
-        fs.writeUint32Set(selectedList_);
+        section.writeUint32Set(selectedList_);
 
         // write the screenborder info
-        dune::globals::screenborder->save(fs);
+        dune::globals::screenborder->save(section);
     }
 
     // save triggers
-    triggerManager_.save(fs);
+    triggerManager_.save(section);
+
+    data.sections.push_back(section.releaseBytes());
 
     // CommandManager is at the very end of the file. DO NOT CHANGE THIS!
-    cmdManager_.save(fs);
+    cmdManager_.save(section);
 
-    fs.close();
+    data.sections.push_back(section.releaseBytes());
 
-    return true;
+    return data;
+}
+
+SaveGameHeader Game::createSaveGameHeader() const {
+    const auto* const pLocalHouse = dune::globals::pLocalHouse;
+
+    SaveGameHeader header;
+
+    header.mapName        = reinterpret_cast<const char*>(gameInitSettings_.getFilename().stem().u8string().c_str());
+    header.gameType       = gameInitSettings_.getGameType();
+    header.houseID        = pLocalHouse != nullptr ? pLocalHouse->getHouseID() : gameInitSettings_.getHouseID();
+    header.mission        = gameInitSettings_.getMission();
+    header.gameCycleCount = gameCycleCount_;
+    header.houseInfoList  = houseInfoListSetup_;
+
+    // the thumbnail shows the map like the radar with the local player's shroud
+    const auto sizeX = map_->getSizeX();
+    const auto sizeY = map_->getSizeY();
+    const auto scale = (std::max(sizeX, sizeY) + SAVEGAME_THUMBNAIL_SIZE - 1) / SAVEGAME_THUMBNAIL_SIZE;
+
+    header.thumbnailWidth  = gsl::narrow<uint16_t>(sizeX / scale);
+    header.thumbnailHeight = gsl::narrow<uint16_t>(sizeY / scale);
+    header.thumbnail.reserve(static_cast<size_t>(header.thumbnailWidth) * header.thumbnailHeight * 3);
+
+    for (auto y = 0; y < header.thumbnailHeight; y++) {
+        for (auto x = 0; x < header.thumbnailWidth; x++) {
+            const auto* const pTile = map_->getTile(x * scale, y * scale);
+
+            auto color = COLOR_BLACK;
+            if (pLocalHouse == nullptr || pTile->isExploredByTeam(this, pLocalHouse->getTeamID())) {
+                const auto* const pObject = pTile->getObject(objectManager_);
+
+                if (pObject != nullptr && pObject->isAStructure()) {
+                    const auto houseID = static_cast<int>(pObject->getOwner()->getHouseID());
+                    color = SDL2RGB(dune::globals::palette[dune::globals::houseToPaletteIndex[houseID]]);
+                } else {
+                    color = getColorByTerrainType(pTile->getType());
+                }
+            }
+
+            const auto rgb = RGBA2SDL(color);
+            header.thumbnail.push_back(rgb.r);
+            header.thumbnail.push_back(rgb.g);
+            header.thumbnail.push_back(rgb.b);
+        }
+    }
+
+    return header;
 }
 
 void Game::saveObject(OutputStream& stream, ObjectBase* obj) {
@@ -2378,24 +2860,18 @@ void Game::handleKeyInput(const GameContext& context, SDL_KeyboardEvent& keyboar
         } break;
 
         case SDLK_F4: {
-            // skip a 10 seconds
-            if (gameType != GameType::CustomMultiplayer || bReplay_) {
-                skipToGameCycle_ = gameCycleCount_ + (10 * 1000) / GAMESPEED_DEFAULT;
-            }
+            // skip a 10 seconds (with shift: go back in a replay)
+            skipGameTime(10 * 1000);
         } break;
 
         case SDLK_F5: {
-            // skip a 30 seconds
-            if (gameType != GameType::CustomMultiplayer || bReplay_) {
-                skipToGameCycle_ = gameCycleCount_ + (30 * 1000) / GAMESPEED_DEFAULT;
-            }
+            // skip a 30 seconds (with shift: go back in a replay)
+            skipGameTime(30 * 1000);
         } break;
 
         case SDLK_F6: {
-            // skip 2 minutes
-            if (gameType != GameType::CustomMultiplayer || bReplay_) {
-                skipToGameCycle_ = gameCycleCount_ + (120 * 1000) / GAMESPEED_DEFAULT;
-            }
+            // skip 2 minutes (with shift: go back in a replay)
+            skipGameTime(120 * 1000);
         } break;
 
         case SDLK_F10: {
@@ -2407,7 +2883,14 @@ void Game::handleKeyInput(const GameContext& context, SDL_KeyboardEvent& keyboar
         } break;
 
         case SDLK_F12: {
-            bShowFPS_ = !bShowFPS_;
+            if (SDL_GetModState() & KMOD_SHIFT) {
+                // with shift: write the render statistics of every frame to a file
+                toggleRenderStatsDump();
+            } else {
+                bShowFPS_ = !bShowFPS_;
+            }
+
+            dune::RenderStats::enable(bShowFPS_);
         } break;
 
         case SDLK_m: {
@@ -2801,6 +3284,21 @@ bool Game::handleSelectedObjectsActionClick(const GameContext& context, int xPos
     return false;
 }
 
+void Game::toggleRenderStatsDump() {
+    if (dune::RenderStats::dumping()) {
+        dune::RenderStats::stopDump();
+        addToNewsTicker(_("Render statistics stopped"));
+        return;
+    }
+
+    const auto [ok, path] = fnkdat("renderstats.csv", FNKDAT_USER | FNKDAT_CREAT);
+    if (!ok || !dune::RenderStats::startDump(path))
+        return;
+
+    const std::string filename{reinterpret_cast<const char*>(path.filename().u8string().c_str())};
+    addToNewsTicker(fmt::format("{}: '{}'", _("Writing render statistics"), filename));
+}
+
 void Game::saveScreenshot() {
     pendingScreenshot_ = false;
 
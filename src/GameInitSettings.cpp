@@ -172,12 +172,12 @@ GameInitSettings& GameInitSettings::operator=(GameInitSettings&&) noexcept = def
 
 GameInitSettings::~GameInitSettings() = default;
 
-void GameInitSettings::save(OutputStream& stream) const {
+void GameInitSettings::save(OutputStream& stream, bool bWithFiledata) const {
     stream.writeSint8(static_cast<int8_t>(gameType));
     stream.writeSint8(static_cast<int8_t>(houseID));
 
     stream.writeString(reinterpret_cast<const char*>(filename.u8string().c_str()));
-    stream.writeString(filedata);
+    stream.writeString(bWithFiledata ? std::string_view{filedata} : std::string_view{});
 
     stream.writeUint8(static_cast<Uint8>(mission));
     stream.writeUint32(alreadyPlayedRegions);
@@ -206,11 +206,15 @@ void GameInitSettings::save(OutputStream& stream) const {
 
 const std::vector<uint8_t>& GameInitSettings::getRandomSeed() noexcept {
     if (randomSeed.empty())
-        randomSeed = RandomFactory::createRandomSeed("game master seed");
+        createRandomSeed();
 
     return randomSeed;
 }
 
+void GameInitSettings::createRandomSeed() {
+    randomSeed = RandomFactory::createRandomSeed("game master seed");
+}
+
 std::string GameInitSettings::getScenarioFilename(HOUSETYPE newHouse, int mission) {
     if ((static_cast<int>(newHouse) < 0) || (newHouse >= HOUSETYPE::NUM_HOUSES)) {
         THROW(std::invalid_argument, "GameInitSettings::getScenarioFilename(): Invalid house id {}.",
@@ -259,7 +263,7 @@ void GameInitSettings::checkSaveGame(InputStream& stream) {
         THROW(std::runtime_error, "Cannot load this savegame,\n because it has a wrong magic number!");
     }
 
-    if (savegameVersion < SAVEGAMEVERSION) {
+    if (savegameVersion < SAVEGAMEVERSION_UNCOMPRESSED) {
         THROW(std::runtime_error, "Cannot load this savegame,\n because it was created with an older version:\n{}",
               duneVersion);
     }
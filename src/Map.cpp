@@ -29,8 +29,11 @@
 #include <units/InfantryBase.h>
 #include <units/UnitBase.h>
 
+#include <misc/StreamChunks.h>
+
 #include <climits>
 #include <cstddef>
+#include <numeric>
 #include <set>
 #include <stack>
 
@@ -46,11 +49,27 @@ Map::Map(Game& game, int xSize, int ySize)
 
     init_tile_location();
     init_box_sets();
+
+    radarChanges_.reset(sizeX, sizeY);
+    terrainChanges_.reset(sizeX, sizeY);
+    groundChanges_.reset(sizeX, sizeY);
+    fogChanges_.reset(sizeX, sizeY);
 }
 
 Map::~Map() = default;
 
-void Map::load(InputStream& stream) {
+namespace {
+/// number of tile columns that are stored together in one chunk of the savegame
+inline constexpr auto TILE_CHUNK_COLUMNS = 8;
+
+/// the tiles seen by a house are remembered in time slots of this many game cycles to find out when they get fogged
+inline constexpr uint32_t FOG_SLOT_CYCLES = FOGTIME / 25;
+
+/// a time slot is reused after this many slots; by then all of its tiles have been checked
+inline constexpr uint32_t FOG_SLOT_COUNT = FOGTIME / FOG_SLOT_CYCLES + 2;
+} // namespace
+
+void Map::load(InputStream& stream, uint32_t savegameVersion) {
     const auto x = stream.readSint32();
     const auto y = stream.readSint32();
 
@@ -59,8 +78,13 @@ void Map::load(InputStream& stream) {
 
     assert(tiles.size() == static_cast<size_t>(sizeX) * sizeY);
 
-    for (auto& tile : tiles)
-        tile.load(stream);
+    if (savegameVersion <= SAVEGAMEVERSION_SEQUENTIAL_MAP) {
+        for (auto& tile : tiles)
+            tile.load(stream);
+    } else {
+        // a tile only depends on its own record, so the chunks can be decoded in any order
+        dune::readChunks(stream, std::span{tiles}, [](InputStream& chunk, Tile& tile) { tile.load(chunk); });
+    }
 
     auto state = stream.readUint8Vector();
     random_.setState(state);
@@ -72,8 +96,9 @@ void Map::save(OutputStream& stream, uint32_t gameCycleCount) const {
     stream.writeSint32(sizeX);
     stream.writeSint32(sizeY);
 
-    for (const auto& tile : tiles)
-        tile.save(stream, gameCycleCount);
+    // the tiles are stored in chunks of columns, so load() can decode them in parallel
+    dune::writeChunks(stream, std::span<const Tile>{tiles}, static_cast<size_t>(TILE_CHUNK_COLUMNS) * sizeY,
+                      [gameCycleCount](OutputStream& chunk, const Tile& tile) { tile.save(chunk, gameCycleCount); });
 
     stream.writeUint8Vector(random_.getState());
 }
@@ -634,6 +659,11 @@ void Map::viewMap(HOUSETYPE houseID, const Coord& location, const int maxViewRan
 
     const auto cycle_count = dune::globals::currentGame->getGameCycleCount();
 
+    expireFog(cycle_count);
+
+    const auto current_slot = cycle_count / FOG_SLOT_CYCLES;
+    auto& seen_tiles        = fogExpiry_[current_slot % FOG_SLOT_COUNT];
+
     for_each_filter(
         location.x - maxViewRange, location.y - maxViewRange, location.x + maxViewRange + 1,
         location.y + maxViewRange + 1,
@@ -642,7 +672,62 @@ void Map::viewMap(HOUSETYPE houseID, const Coord& location, const int maxViewRan
                 maxViewRange <= 1 ? maximumDistance(location, {x, y}) : blockDistanceApprox(location, {x, y});
             return distance <= maxViewRange;
         },
-        [&](Tile& t) { t.setExplored(houseID, cycle_count); });
+        [&](Tile& t) {
+            const auto explored    = t.isExploredByHouse(houseID);
+            const auto last_access = t.getLastAccess(houseID);
+
+            // the tile gets explored or visible again
+            if (!explored || cycle_count - last_access >= FOGTIME) {
+                invalidateRadar(t.location_);
+                fogChanges_.mark(t.location_.x, t.location_.y);
+            }
+
+            // remember each tile once per time slot to check it again when it may have become fogged
+            if (!explored || last_access / FOG_SLOT_CYCLES != current_slot)
+                seen_tiles.push_back(tile_index(t.location_.x, t.location_.y));
+
+            t.setExplored(houseID, cycle_count);
+        });
+}
+
+/**
+    Marks the tiles that may have become fogged since the last call as changed for the radar and the fog overlay. A
+    tile seen during a time slot is fogged at the latest FOGTIME after the end of the slot; if it was seen again
+    meanwhile it is also remembered for a later slot. Thus only tiles that were actually seen are checked and no tile is
+    checked every cycle.
+    \param gameCycleCount  the current game cycle
+*/
+void Map::expireFog(uint32_t gameCycleCount) {
+    if (fogExpirySlot_ == INVALID_GAMECYCLE) {
+        // we do not know when the tiles were seen (e.g. after loading a savegame), so check all of them after FOGTIME
+        const auto current_slot = gameCycleCount / FOG_SLOT_CYCLES;
+
+        fogExpiry_.assign(FOG_SLOT_COUNT, {});
+
+        auto& seen_tiles = fogExpiry_[current_slot % FOG_SLOT_COUNT];
+        seen_tiles.resize(tiles.size());
+        std::iota(seen_tiles.begin(), seen_tiles.end(), 0);
+
+        fogExpirySlot_ = current_slot;
+        return;
+    }
+
+    const uint32_t due_end = gameCycleCount >= FOGTIME ? (gameCycleCount - FOGTIME) / FOG_SLOT_CYCLES : 0;
+
+    // all slots are due if we were not called for a while; each of them only needs to be checked once
+    if (due_end > fogExpirySlot_ + FOG_SLOT_COUNT)
+        fogExpirySlot_ = due_end - FOG_SLOT_COUNT;
+
+    for (; fogExpirySlot_ < due_end; ++fogExpirySlot_) {
+        auto& seen_tiles = fogExpiry_[fogExpirySlot_ % FOG_SLOT_COUNT];
+
+        for (const auto index : seen_tiles) {
+            invalidateRadar(tiles[index].location_);
+            fogChanges_.mark(tiles[index].location_.x, tiles[index].location_.y);
+        }
+
+        seen_tiles.clear();
+    }
 }
 
 /**
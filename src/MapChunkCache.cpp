@@ -0,0 +1,176 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MapChunkCache.h>
+
+#include <Definitions.h>
+#include <ScreenBorder.h>
+#include <globals.h>
+#include <mmath.h>
+
+#include <Renderer/DuneRenderer.h>
+
+#include <algorithm>
+
+namespace {
+/// The number of chunks that is kept at least, even if less chunks are visible
+inline constexpr auto MIN_CACHED_CHUNKS = 16;
+} // namespace
+
+MapChunkCache::MapChunkCache(SDL_BlendMode blendMode) : blendMode_{blendMode} { }
+
+MapChunkCache::~MapChunkCache() = default;
+
+void MapChunkCache::invalidate(dune::DirtyTiles& changes) {
+    if (changes.getSizeX() != sizeX_ || changes.getSizeY() != sizeY_) {
+        sizeX_   = changes.getSizeX();
+        sizeY_   = changes.getSizeY();
+        chunksX_ = (sizeX_ + chunk_size - 1) / chunk_size;
+        chunksY_ = (sizeY_ + chunk_size - 1) / chunk_size;
+
+        chunks_.clear();
+        chunks_.resize(static_cast<size_t>(chunksX_) * chunksY_);
+    } else if (changes.isAll()) {
+        invalidateAll();
+    } else {
+        changes.for_each([&](int x, int y) {
+            // a tile also changes the look of its neighbors (the terrain transitions)
+            const auto cx1 = std::max(0, x - 1) / chunk_size;
+            const auto cy1 = std::max(0, y - 1) / chunk_size;
+            const auto cx2 = std::min(sizeX_ - 1, x + 1) / chunk_size;
+            const auto cy2 = std::min(sizeY_ - 1, y + 1) / chunk_size;
+
+            for (auto cy = cy1; cy <= cy2; ++cy) {
+                for (auto cx = cx1; cx <= cx2; ++cx)
+                    chunks_[cy * chunksX_ + cx].dirty = true;
+            }
+        });
+    }
+
+    changes.clear();
+}
+
+void MapChunkCache::invalidateAll() {
+    for (auto& chunk : chunks_)
+        chunk.dirty = true;
+}
+
+void MapChunkCache::release() {
+    for (auto& chunk : chunks_) {
+        chunk.texture.reset();
+        chunk.dirty = true;
+    }
+}
+
+SDL_Rect MapChunkCache::chunkTiles(int cx, int cy) const noexcept {
+    const auto x = cx * chunk_size;
+    const auto y = cy * chunk_size;
+
+    return {x, y, std::min(chunk_size, sizeX_ - x), std::min(chunk_size, sizeY_ - y)};
+}
+
+void MapChunkCache::beginFrame() {
+    const auto zoom = dune::globals::currentZoomlevel;
+    if (zoom != zoom_) {
+        release();
+        zoom_ = zoom;
+    }
+
+    ++frame_;
+}
+
+void MapChunkCache::endFrame(int visibleChunks) {
+    const auto limit = std::max(MIN_CACHED_CHUNKS, 2 * visibleChunks);
+
+    auto count = std::ranges::count_if(chunks_, [](const Chunk& chunk) { return chunk.texture != nullptr; });
+    if (count <= limit)
+        return;
+
+    std::vector<Chunk*> unused;
+    for (auto& chunk : chunks_) {
+        if (chunk.texture && chunk.lastUsed != frame_)
+            unused.push_back(&chunk);
+    }
+
+    std::ranges::sort(unused, {}, &Chunk::lastUsed);
+
+    for (auto* const chunk : unused) {
+        if (count <= limit)
+            break;
+
+        chunk->texture.reset();
+        chunk->dirty = true;
+        --count;
+    }
+}
+
+bool MapChunkCache::beginChunk(SDL_Renderer* renderer, Chunk& chunk, const SDL_Rect& tiles) {
+    dune::flush_sprites();
+
+    if (!chunk.texture) {
+        const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+        chunk.texture = sdl2::texture_ptr{SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET,
+                                                            tiles.w * zoomedTileSize, tiles.h * zoomedTileSize)};
+        if (!chunk.texture) {
+            sdl2::log_error("MapChunkCache: SDL_CreateTexture() failed: {}", SDL_GetError());
+            return false;
+        }
+
+        SDL_SetTextureBlendMode(chunk.texture.get(), blendMode_);
+    }
+
+    previousTarget_ = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, chunk.texture.get())) {
+        sdl2::log_error("MapChunkCache: SDL_SetRenderTarget() failed: {}", SDL_GetError());
+        SDL_SetRenderTarget(renderer, previousTarget_);
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    batch_.begin(renderer);
+
+    return true;
+}
+
+void MapChunkCache::endChunk(SDL_Renderer* renderer, Chunk& chunk) {
+    batch_.end();
+
+    SDL_SetRenderTarget(renderer, previousTarget_);
+
+    chunk.dirty = false;
+}
+
+void MapChunkCache::drawChunk(SDL_Renderer* renderer, const ScreenBorder& screenborder, Chunk& chunk, int cx, int cy) {
+    if (!chunk.texture)
+        return;
+
+    chunk.lastUsed = frame_;
+
+    if (chunk.empty)
+        return;
+
+    const auto tiles          = chunkTiles(cx, cy);
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    const SDL_FRect dest{screenborder.world2screenX(tiles.x * TILESIZE), screenborder.world2screenY(tiles.y * TILESIZE),
+                         static_cast<float>(tiles.w * zoomedTileSize), static_cast<float>(tiles.h * zoomedTileSize)};
+
+    Dune_RenderCopyF(renderer, chunk.texture.get(), nullptr, &dest);
+}
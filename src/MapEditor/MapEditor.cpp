@@ -201,6 +201,7 @@ void MapEditor::setMap(const MapData& mapdata, const MapInfo& newMapInfo) {
     currentEditorMode_ = EditorMode();
 
     bChangedSinceLastSave_ = true;
+    ++revision_;
 }
 
 bool MapEditor::isTileBlocked(int x, int y, bool bSlabIsBlocking, bool bUnitsAreBlocking) const {
@@ -342,6 +343,8 @@ void MapEditor::undoLastOperation() {
         if (!undoOperationStack_.empty()) {
             undoOperationStack_.pop();
         }
+
+        ++revision_;
     }
 }
 
@@ -358,6 +361,8 @@ void MapEditor::redoLastOperation() {
         if (!redoOperationStack_.empty()) {
             redoOperationStack_.pop();
         }
+
+        ++revision_;
     }
 }
 
@@ -424,6 +429,7 @@ void MapEditor::loadMap(const std::filesystem::path& filepath) {
     currentEditorMode_ = EditorMode();
 
     bChangedSinceLastSave_ = false;
+    ++revision_;
 }
 
 void MapEditor::saveMap(const std::filesystem::path& filepath) {
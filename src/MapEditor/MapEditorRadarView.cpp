@@ -66,8 +66,6 @@ void MapEditorRadarView::draw(Point position) {
 
     updateRadarSurface(map, scale, offsetX, offsetY);
 
-    SDL_UpdateTexture(radarTexture.get(), nullptr, radarSurface->pixels, radarSurface->pitch);
-
     Dune_RenderCopy(renderer, radarTexture.get(), radarPosition.x, radarPosition.y);
 
     // draw viewport rect on radar
@@ -105,104 +103,108 @@ void MapEditorRadarView::draw(Point position) {
 }
 
 void MapEditorRadarView::updateRadarSurface(const MapData& map, int scale, int offsetX, int offsetY) {
+    const auto sizeX = map.getSizeX();
+    const auto sizeY = map.getSizeY();
 
-    SDL_FillRect(radarSurface.get(), nullptr, COLOR_BLACK);
+    if (sizeX != changes_.getSizeX() || sizeY != changes_.getSizeY()) {
+        // the border around the map changes as well
+        SDL_FillRect(radarSurface.get(), nullptr, COLOR_BLACK);
 
-    sdl2::surface_lock lock{radarSurface.get()};
+        changes_.reset(sizeX, sizeY);
+        tileColors_.assign(static_cast<size_t>(sizeX) * sizeY, COLOR_BLACK);
+    } else if (pMapEditor->getRevision() == drawnRevision_) {
+        return;
+    }
 
-    for (int y = 0; y < map.getSizeY(); y++) {
-        for (int x = 0; x < map.getSizeX(); x++) {
+    drawnRevision_ = pMapEditor->getRevision();
 
-            uint32_t color = getColorByTerrainType(map(x, y));
+    const auto colors = calculateTileColors(map);
 
-            if (map(x, y) == TERRAINTYPE::Terrain_Sand) {
-                std::vector<Coord>& spiceFields = pMapEditor->getSpiceFields();
+    for (int y = 0; y < sizeY; y++) {
+        for (int x = 0; x < sizeX; x++) {
+            const auto index = static_cast<size_t>(y) * sizeX + x;
 
-                for (auto& spiceField : spiceFields) {
-                    if (spiceField.x == x && spiceField.y == y) {
-                        color = COLOR_THICKSPICE;
-                        break;
-                    }
-                    if (distanceFrom(spiceField, Coord(x, y)) <= 5) {
-                        color = COLOR_SPICE;
-                        break;
-                    }
-                }
+            if (colors[index] != tileColors_[index]) {
+                tileColors_[index] = colors[index];
+                changes_.mark(x, y);
             }
+        }
+    }
 
-            // check for classic map items (spice blooms, special blooms)
-            std::vector<Coord>& spiceBlooms = pMapEditor->getSpiceBlooms();
-            for (const auto& spiceBloom : spiceBlooms) {
-                if (spiceBloom.x == x && spiceBloom.y == y) {
-                    color = COLOR_BLOOM;
-                    break;
-                }
-            }
+    const auto* const format = radarSurface->format;
 
-            std::vector<Coord>& specialBlooms = pMapEditor->getSpecialBlooms();
-            for (const auto& specialBloom : specialBlooms) {
-                if (specialBloom.x == x && specialBloom.y == y) {
-                    color = COLOR_BLOOM;
-                    break;
-                }
-            }
+    updateRadarTiles(radarSurface.get(), radarTexture.get(), changes_, scale, offsetX, offsetY, [&](int x, int y) {
+        return MapRGBA(format, tileColors_[static_cast<size_t>(y) * sizeX + x]);
+    });
+
+    changes_.clear();
+}
+
+std::vector<uint32_t> MapEditorRadarView::calculateTileColors(const MapData& map) const {
+    const auto sizeX = map.getSizeX();
+    const auto sizeY = map.getSizeY();
 
-            color = MapRGBA(radarSurface->format, color);
+    std::vector<uint32_t> colors(static_cast<size_t>(sizeX) * sizeY);
 
-            auto* radar_pixels = static_cast<uint8_t*>(radarSurface->pixels);
-            const auto pitch   = radarSurface->pitch;
+    const auto color_at = [&](int x, int y) -> uint32_t& { return colors[static_cast<size_t>(y) * sizeX + x]; };
 
-            for (int j = 0; j < scale; j++) {
-                auto* RESTRICT p = reinterpret_cast<uint32_t*>(
-                                       radar_pixels + (offsetY + static_cast<ptrdiff_t>(scale) * y + j) * pitch)
-                                 + (offsetX + static_cast<ptrdiff_t>(scale) * x);
+    for (int y = 0; y < sizeY; y++) {
+        for (int x = 0; x < sizeX; x++) {
+            color_at(x, y) = getColorByTerrainType(map(x, y));
+        }
+    }
 
-                for (int i = 0; i < scale; i++, p++) {
-                    // Do not use putPixel here to avoid overhead
-                    *p = color;
+    // The first spice field that covers a sand tile determines its color, so the spice fields are drawn in reverse
+    // order.
+    const auto& spiceFields = pMapEditor->getSpiceFields();
+    for (auto it = spiceFields.rbegin(); it != spiceFields.rend(); ++it) {
+        const auto& spiceField = *it;
+
+        for (int y = spiceField.y - 5; y <= spiceField.y + 5; y++) {
+            for (int x = spiceField.x - 5; x <= spiceField.x + 5; x++) {
+                if (!map.isInsideMap(x, y) || map(x, y) != TERRAINTYPE::Terrain_Sand)
+                    continue;
+
+                if (spiceField.x == x && spiceField.y == y) {
+                    color_at(x, y) = COLOR_THICKSPICE;
+                } else if (distanceFrom(spiceField, Coord(x, y)) <= 5) {
+                    color_at(x, y) = COLOR_SPICE;
                 }
             }
         }
     }
 
-    for (const auto& unit : pMapEditor->getUnitList()) {
-        const auto house_id = static_cast<int>(unit.house_);
-        const auto color    = SDL2RGB(dune::globals::palette[dune::globals::houseToPaletteIndex[house_id]]);
+    // classic map items (spice blooms, special blooms)
+    for (const auto* blooms : {&pMapEditor->getSpiceBlooms(), &pMapEditor->getSpecialBlooms()}) {
+        for (const auto& bloom : *blooms) {
+            if (map.isInsideMap(bloom.x, bloom.y))
+                color_at(bloom.x, bloom.y) = COLOR_BLOOM;
+        }
+    }
 
-        if (unit.position_.x >= 0 && unit.position_.x < map.getSizeX() && unit.position_.y >= 0
-            && unit.position_.y < map.getSizeY()) {
+    const auto& palette             = dune::globals::palette;
+    const auto& houseToPaletteIndex = dune::globals::houseToPaletteIndex;
 
-            const auto x0 = offsetX + scale * unit.position_.x;
-            const auto y0 = offsetY + scale * unit.position_.y;
+    for (const auto& unit : pMapEditor->getUnitList()) {
+        if (map.isInsideMap(unit.position_.x, unit.position_.y)) {
+            const auto house_id = static_cast<int>(unit.house_);
 
-            for (int i = 0; i < scale; i++) {
-                for (int j = 0; j < scale; j++) {
-                    putPixel(radarSurface.get(), x0 + i, y0 + j, color);
-                }
-            }
+            color_at(unit.position_.x, unit.position_.y) = SDL2RGB(palette[houseToPaletteIndex[house_id]]);
         }
     }
 
     for (const auto& structure : pMapEditor->getStructureList()) {
         const auto structureSize = getStructureSize(structure.itemID_);
         const auto house_id      = static_cast<int>(structure.house_);
-        const auto color         = SDL2RGB(dune::globals ::palette[dune::globals::houseToPaletteIndex[house_id]]);
-
-        for (int y = 0; y < structureSize.y; y++) {
-            const auto y0 = offsetY + scale * (structure.position_.y + y);
-
-            for (int x = 0; x < structureSize.x; x++) {
+        const auto color         = SDL2RGB(palette[houseToPaletteIndex[house_id]]);
 
-                if (x >= 0 && x < map.getSizeX() && y >= 0 && y < map.getSizeY()) {
-                    const auto x0 = offsetX + scale * (structure.position_.x + x);
-
-                    for (int i = 0; i < scale; i++) {
-                        for (int j = 0; j < scale; j++) {
-                            putPixel(radarSurface.get(), x0 + i, y0 + j, color);
-                        }
-                    }
-                }
+        for (int y = structure.position_.y; y < structure.position_.y + structureSize.y; y++) {
+            for (int x = structure.position_.x; x < structure.position_.x + structureSize.x; x++) {
+                if (map.isInsideMap(x, y))
+                    color_at(x, y) = color;
             }
         }
     }
+
+    return colors;
 }
@@ -26,6 +26,7 @@
 #include <House.h>
 #include <SoundPlayer.h>
 #include <fmt/printf.h>
+#include <misc/RedrawScheduler.h>
 #include <structures/StructureBase.h>
 #include <units/Harvester.h>
 #include <units/UnitBase.h>
@@ -222,6 +223,10 @@ void CampaignStatsMenu::doInputImpl(const SDL_Event& event) {
 
 void CampaignStatsMenu::drawSpecificStuff() {
     doState(dune::dune_clock::now() - currentStateStartTime_);
+
+    // the statistics are counted up every frame
+    if (currentState_ != CampaignStatsState::State_Finished)
+        dune::RedrawScheduler::invalidate();
 }
 
 void CampaignStatsMenu::resize(uint32_t width, uint32_t height) {
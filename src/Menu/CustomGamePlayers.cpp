@@ -37,6 +37,8 @@
 
 #include <INIMap/INIMapPreviewCreator.h>
 
+#include <SaveGameHeader.h>
+
 #include <globals.h>
 #include <sand.h>
 
@@ -104,19 +106,31 @@ CustomGamePlayers::CustomGamePlayers(GameInitSettings newGameInitSettings, bool
         }
 
         uint32_t savegameVersion = memStream.readUint32();
-        if (savegameVersion != SAVEGAMEVERSION) {
+        if (savegameVersion < SAVEGAMEVERSION_UNCOMPRESSED || savegameVersion > SAVEGAMEVERSION) {
             sdl2::log_info("CustomGamePlayers: No valid savegame! Expected savegame version {}, but got {}!",
                            SAVEGAMEVERSION, savegameVersion);
         }
 
         memStream.readString(); // dune legacy version
 
-        // read gameInitSettings
-        GameInitSettings tmpGameInitSettings(memStream);
+        GameInitSettings tmpGameInitSettings;
+
+        if (savegameVersion == SAVEGAMEVERSION_UNCOMPRESSED) {
+            // read gameInitSettings
+            tmpGameInitSettings = GameInitSettings(memStream);
+
+            uint32_t numHouseInfo = memStream.readUint32();
+            for (uint32_t i = 0; i < numHouseInfo; i++) {
+                houseInfoListSetup.push_back(GameInitSettings::HouseInfo(memStream));
+            }
+        } else {
+            SaveGameHeader header{memStream};
+            houseInfoListSetup = std::move(header.houseInfoList);
 
-        uint32_t numHouseInfo = memStream.readUint32();
-        for (uint32_t i = 0; i < numHouseInfo; i++) {
-            houseInfoListSetup.push_back(GameInitSettings::HouseInfo(memStream));
+            // gameInitSettings are at the beginning of the first section
+            const auto state = readSaveGameSection(memStream);
+            IMemoryStream stateStream(reinterpret_cast<const char*>(state.data()), state.size());
+            tmpGameInitSettings = GameInitSettings(stateStream);
         }
 
         const auto file_data = tmpGameInitSettings.getFiledata();
@@ -427,6 +441,9 @@ CustomGamePlayers::CustomGamePlayers(GameInitSettings newGameInitSettings, bool
         if (bServer) {
             network_manager->setGetChangeEventListForNewPlayerCallback(
                 [this](const auto& newPlayerName) { return getChangeEventListForNewPlayer(newPlayerName); });
+            network_manager->setOnSendGameDataProgress([this](const auto& name, auto sentBytes, auto totalBytes) {
+                onSendGameDataProgress(name, sentBytes, totalBytes);
+            });
         } else {
             network_manager->setOnStartGame([this](auto timeleft) { onStartGame(timeleft); });
         }
@@ -442,6 +459,7 @@ CustomGamePlayers::~CustomGamePlayers() {
 
     network_manager->setOnPeerDisconnected({});
     network_manager->setGetChangeEventListForNewPlayerCallback({});
+    network_manager->setOnSendGameDataProgress({});
     network_manager->setOnReceiveChangeEventList({});
     network_manager->setOnReceiveChatMessage({});
     network_manager->setOnStartGame({});
@@ -468,6 +486,7 @@ void CustomGamePlayers::update() {
         network_manager->setOnPeerDisconnected(std::function<void(const std::string&, bool, int)>());
         network_manager->setGetChangeEventListForNewPlayerCallback(
             std::function<ChangeEventList(const std::string&)>());
+        network_manager->setOnSendGameDataProgress(std::function<void(const std::string&, uint32_t, uint32_t)>());
         network_manager->setOnReceiveChangeEventList(std::function<void(const ChangeEventList&)>());
         network_manager->setOnReceiveChatMessage(std::function<void(const std::string&, const std::string&)>());
         network_manager->setOnStartGame(std::function<void(dune::dune_clock::duration)>());
@@ -1188,6 +1207,17 @@ void CustomGamePlayers::onPeerDisconnected(const std::string& playername, bool b
     addInfoMessage(playername + " disconnected!");
 }
 
+void CustomGamePlayers::onSendGameDataProgress(const std::string& playername, uint32_t sentBytes,
+                                               uint32_t totalBytes) {
+    if (sentBytes <= GAMEDATA_CHUNK_SIZE) {
+        addInfoMessage(playername + " is downloading the map...");
+    }
+
+    if (sentBytes >= totalBytes) {
+        addInfoMessage(playername + " has downloaded the map.");
+    }
+}
+
 void CustomGamePlayers::onStartGame(dune::dune_clock::duration timeLeft) {
     startGameTime = dune::dune_clock::now() + timeLeft;
     disableAllDropDownBoxes();
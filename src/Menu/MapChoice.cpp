@@ -27,6 +27,7 @@
 
 #include "Renderer/DuneRenderer.h"
 #include "misc/DrawingRectHelper.h"
+#include "misc/RedrawScheduler.h"
 #include "misc/draw_util.h"
 #include <misc/exceptions.h>
 #include <misc/string_util.h>
@@ -160,6 +161,14 @@ void MapChoice::drawSpecificStuff() {
     SDL_UpdateTexture(mapTexture.get(), nullptr, mapSurface->pixels, mapSurface->pitch);
     Dune_RenderCopy(renderer, mapTexture.get(), nullptr, &centerAreaRect);
 
+    // the map is blended in step by step every frame, afterwards the arrows move to the next frame every 128ms
+    if (mapChoiceState == MAPCHOICESTATE_ARROWS) {
+        const auto sinceArrowFrame = dune::as_milliseconds(dune::dune_clock::now().time_since_epoch()) % 128U;
+        dune::RedrawScheduler::wakeAfter(dune::as_dune_clock_duration(128U - sinceArrowFrame));
+    } else {
+        dune::RedrawScheduler::invalidate();
+    }
+
     switch (mapChoiceState) {
 
         case MAPCHOICESTATE_FADEINPLANET: {
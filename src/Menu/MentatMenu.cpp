@@ -20,6 +20,7 @@
 #include <globals.h>
 
 #include "misc/DrawingRectHelper.h"
+#include "misc/RedrawScheduler.h"
 #include <FileClasses/GFXManager.h>
 
 #include <regex>
@@ -227,6 +228,8 @@ void MentatMenu::update() {
         textLabel.resize(620, 240);
     }
 
+    dune::RedrawScheduler::wakeAt(nextMentatTextSwitch);
+
     auto* const gfx = dune::globals::pGFXManager.get();
 
     if (specialAnim.getAnimation() != nullptr && specialAnim.getAnimation()->isFinished()) {
@@ -235,6 +238,8 @@ void MentatMenu::update() {
             nextSpecialAnimation =
                 dune::dune_clock::now() + dune::as_dune_clock_duration(gfx->random().rand(8000, 20000));
         }
+
+        dune::RedrawScheduler::wakeAt(nextSpecialAnimation);
     }
 
     const Point mouse(dune::globals::drawnMouseX - getPosition().x, dune::globals::drawnMouseY - getPosition().y);
@@ -23,6 +23,7 @@
 #include "GUI/GUIStyle.h"
 #include "misc/DrawingRectHelper.h"
 #include "misc/Fullscreen.h"
+#include "misc/RedrawScheduler.h"
 #include "misc/draw_util.h"
 #include "misc/dune_clock.h"
 #include "misc/dune_events.h"
@@ -69,6 +70,38 @@ bool MenuBase::doEventsUntil(const dune::dune_clock::time_point until) {
     return true;
 }
 
+bool MenuBase::waitForRedraw() {
+    using namespace std::chrono_literals;
+
+    // draw at least once a second in case something changed without requesting a new frame
+    const auto latest = dune::dune_clock::now() + 1s;
+
+    SDL_Event event{};
+
+    while (!quitting) {
+        const auto now   = dune::dune_clock::now();
+        const auto until = std::min(dune::RedrawScheduler::nextWake(), latest);
+
+        if (until <= now)
+            return true;
+
+        const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(until - now).count();
+
+        if (dune::Dune_WaitEvent(&event, static_cast<uint32_t>(timeout))) {
+            if (!doInput(event))
+                return false;
+
+            while (SDL_PollEvent(&event)) {
+                // check the events
+                if (!doInput(event))
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 int MenuBase::showMenu(event_handler_type handler) {
     sdl_handler_         = std::move(handler);
     auto cleanup_handler = gsl::finally([&] { sdl_handler_ = {}; });
@@ -86,10 +119,16 @@ int MenuBase::showMenuImpl() {
     while (!quitting) {
         const auto frameStart = dune::dune_clock::now();
 
+        // the menu and its widgets request the next frame while being updated and drawn
+        dune::RedrawScheduler::startFrame();
+
         update();
 
         if (dune::globals::pNetworkManager != nullptr) {
             dune::globals::pNetworkManager->update();
+
+            // the network callbacks change the menu without requesting a new frame
+            dune::RedrawScheduler::invalidate();
         }
 
         if (quitting) {
@@ -114,10 +153,11 @@ int MenuBase::showMenuImpl() {
                 break;
         }
 
-        if (!dune::globals::settings.video.frameLimit)
-            continue;
+        if (dune::globals::settings.video.frameLimit && !doEventsUntil(frameStart + 32ms))
+            break;
 
-        if (!doEventsUntil(frameStart + 32ms))
+        // sleep while nothing changes
+        if (!waitForRedraw())
             break;
     }
 
@@ -128,7 +168,7 @@ void MenuBase::draw() {
     auto* const renderer = dune::globals::renderer.get();
 
     const SDL_Rect clipRect{getPosition().x, getPosition().y, getSize().x, getSize().y};
-    SDL_RenderSetClipRect(renderer, &clipRect);
+    Dune_RenderSetClipRect(renderer, &clipRect);
 
     parent::draw();
 
@@ -136,7 +176,7 @@ void MenuBase::draw() {
 
     parent::drawOverlay();
 
-    SDL_RenderSetClipRect(renderer, nullptr);
+    Dune_RenderSetClipRect(renderer, nullptr);
 }
 
 void MenuBase::drawSpecificStuff() { }
@@ -205,6 +245,8 @@ void MenuBase::doInputImpl(const SDL_Event& event) {
 }
 
 bool MenuBase::doInput(const SDL_Event& event) {
+    dune::RedrawScheduler::invalidate();
+
     doInputImpl(event);
 
     handleInput(event);
@@ -174,6 +174,7 @@ void MultiPlayerMenu::onConnect() {
         [this](const auto& settings, const auto& events) { onReceiveGameInfo(settings, events); });
     network_manager->setOnPeerDisconnected(
         [this](auto playername, auto host, auto cause) { onPeerDisconnected(playername, host, cause); });
+    network_manager->setOnGameDataProgress([this](auto received, auto total) { onGameDataProgress(received, total); });
     network_manager->connect(hostname, port, dune::globals::settings.general.playerName);
 
     openWindow(MsgBox::create(_("Connecting...")));
@@ -185,12 +186,22 @@ void MultiPlayerMenu::onPeerDisconnected([[maybe_unused]] const std::string& pla
 
         network_manager->setOnReceiveGameInfo(std::function<void(const GameInitSettings&, const ChangeEventList&)>());
         network_manager->setOnPeerDisconnected(std::function<void(const std::string&, bool, int)>());
+        network_manager->setOnGameDataProgress(std::function<void(uint32_t, uint32_t)>());
         closeChildWindow();
 
         showDisconnectMessageBox(cause);
     }
 }
 
+void MultiPlayerMenu::onGameDataProgress(uint32_t receivedBytes, uint32_t totalBytes) {
+    auto* const pMsgBox = dynamic_cast<MsgBox*>(pChildWindow_);
+    if (pMsgBox == nullptr || totalBytes == 0)
+        return;
+
+    const auto percent = static_cast<uint64_t>(receivedBytes) * 100 / totalBytes;
+    pMsgBox->setText(fmt::format("{} {}%", _("Downloading map..."), percent));
+}
+
 void MultiPlayerMenu::onJoin() {
     const auto selectedEntry = gameList.getSelectedIndex();
     if (!gameList.isValid(selectedEntry))
@@ -204,6 +215,7 @@ void MultiPlayerMenu::onJoin() {
         [this](const auto& settings, const auto& events) { onReceiveGameInfo(settings, events); });
     network_manager->setOnPeerDisconnected(
         [this](auto playername, auto host, auto cause) { onPeerDisconnected(playername, host, cause); });
+    network_manager->setOnGameDataProgress([this](auto received, auto total) { onGameDataProgress(received, total); });
     network_manager->connect(pGameServerInfo->serverAddress, dune::globals::settings.general.playerName);
 
     openWindow(MsgBox::create(_("Connecting...")));
@@ -372,6 +384,7 @@ void MultiPlayerMenu::onReceiveGameInfo(const GameInitSettings& gameInitSettings
     closeChildWindow();
 
     dune::globals::pNetworkManager->setOnPeerDisconnected({});
+    dune::globals::pNetworkManager->setOnGameDataProgress({});
 
     auto pCustomGamePlayers = std::make_unique<CustomGamePlayers>(gameInitSettings, false);
     pCustomGamePlayers->onReceiveChangeEventList(changeEventList);
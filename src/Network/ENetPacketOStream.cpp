@@ -0,0 +1,104 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Network/ENetPacketOStream.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+// Most packets (command lists, selection lists, chat) are well below this size; the buffers only grow beyond it
+// while a packet is written.
+inline constexpr size_t DEFAULT_BUFFER_SIZE = 1024;
+
+// Larger buffers (e.g. the map data in NETWORKPACKET_SENDGAMEINFO) are rare and are not worth keeping around.
+inline constexpr size_t MAX_POOLED_BUFFER_SIZE = 64 * 1024;
+inline constexpr size_t MAX_POOLED_BUFFERS     = 32;
+
+struct Pool {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ENetPacketBufferPool::buffer_type>> buffers;
+};
+
+Pool& getPool() {
+    // Never destroyed: packets may still be destroyed by ENet during static destruction.
+    static auto* const pool = new Pool;
+    return *pool;
+}
+
+} // namespace
+
+std::unique_ptr<ENetPacketBufferPool::buffer_type> ENetPacketBufferPool::acquire(size_t minSize) {
+    minSize = std::max(minSize, DEFAULT_BUFFER_SIZE);
+
+    {
+        auto& pool = getPool();
+
+        const std::lock_guard lock{pool.mutex};
+
+        if (!pool.buffers.empty()) {
+            auto buffer = std::move(pool.buffers.back());
+            pool.buffers.pop_back();
+
+            if (buffer->size() < minSize) {
+                buffer->resize(minSize);
+            }
+
+            return buffer;
+        }
+    }
+
+    return std::make_unique<buffer_type>(minSize);
+}
+
+void ENetPacketBufferPool::release(std::unique_ptr<buffer_type> buffer) {
+    if (buffer->size() > MAX_POOLED_BUFFER_SIZE) {
+        return;
+    }
+
+    auto& pool = getPool();
+
+    const std::lock_guard lock{pool.mutex};
+
+    if (pool.buffers.size() < MAX_POOLED_BUFFERS) {
+        pool.buffers.push_back(std::move(buffer));
+    }
+}
+
+ENetPacket* ENetPacketBufferPool::createPacket(std::unique_ptr<buffer_type> buffer, size_t size, enet_uint32 flags) {
+    // With ENET_PACKET_FLAG_NO_ALLOCATE ENet neither copies nor frees the data.
+    auto* const packet = enet_packet_create(buffer->data(), size, flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+    if (packet == nullptr) {
+        release(std::move(buffer));
+        THROW(OutputStream::error, "ENetPacketBufferPool::createPacket(): enet_packet_create() failed!");
+    }
+
+    packet->userData     = buffer.release();
+    packet->freeCallback = &ENetPacketBufferPool::onPacketDestroyed;
+
+    return packet;
+}
+
+void ENET_CALLBACK ENetPacketBufferPool::onPacketDestroyed(ENetPacket* packet) {
+    std::unique_ptr<buffer_type> buffer{static_cast<buffer_type*>(packet->userData)};
+    packet->userData = nullptr;
+
+    if (buffer != nullptr) {
+        release(std::move(buffer));
+    }
+}
@@ -0,0 +1,317 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Network/GameDataTransfer.h>
+
+#include <Definitions.h>
+
+#include <misc/FileSystem.h>
+#include <misc/IMemoryStream.h>
+#include <misc/compression_util.h>
+#include <misc/exceptions.h>
+#include <misc/fnkdat.h>
+#include <misc/md5.h>
+#include <misc/string_util.h>
+
+#include <algorithm>
+#include <future>
+
+namespace {
+
+GameDataHash calculateHash(std::span<const uint8_t> data) {
+    GameDataHash hash{};
+    md5(data.data(), data.size(), hash.data());
+    return hash;
+}
+
+std::span<const uint8_t> asBytes(const std::string& data) {
+    return {reinterpret_cast<const uint8_t*>(data.data()), data.size()};
+}
+
+/// the sections of a savegame are already compressed (see writeSaveGameSection()), so compressing it again is useless
+bool isCompressedSaveGame(const std::string& filedata) {
+    IMemoryStream stream{filedata.data(), filedata.size()};
+
+    try {
+        return stream.readUint32() == SAVEMAGIC && stream.readUint32() > SAVEGAMEVERSION_UNCOMPRESSED;
+    } catch (InputStream::eof&) {
+        return false;
+    }
+}
+
+} // namespace
+
+GameDataUpload::GameDataUpload(std::string filedata) {
+    auto prepare = [filedata = std::move(filedata)] {
+        PreparedData prepared;
+        prepared.hash        = calculateHash(asBytes(filedata));
+        prepared.size        = static_cast<uint32_t>(filedata.size());
+        prepared.bCompressed = !isCompressedSaveGame(filedata);
+
+        if (prepared.bCompressed) {
+            prepared.data = dune::zlib_compress(asBytes(filedata));
+        } else {
+            prepared.data.assign(filedata.begin(), filedata.end());
+        }
+
+        return prepared;
+    };
+
+    // hashing and compressing up to 64 MB is too long for a task on ThreadPool::shared()
+    prepared_ = std::async(std::launch::async, std::move(prepare)).share();
+}
+
+void GameDataUpload::writeGameInfo(OutputStream& stream, const GameInitSettings& gameInitSettings,
+                                   const ChangeEventList& changeEventList) const {
+    const auto& prepared = prepared_.get();
+
+    gameInitSettings.save(stream, false);
+    changeEventList.save(stream);
+
+    stream.writeUint32(prepared.size);
+    stream.writeUint32(static_cast<uint32_t>(prepared.data.size()));
+    stream.writeBool(prepared.bCompressed);
+    stream.writeUint8Vector({prepared.hash.begin(), prepared.hash.end()});
+
+    // small maps are sent right away to save a round trip
+    if (prepared.data.size() <= GAMEDATA_CHUNK_SIZE) {
+        stream.writeString({reinterpret_cast<const char*>(prepared.data.data()), prepared.data.size()});
+    } else {
+        stream.writeString({});
+    }
+}
+
+bool GameDataUpload::writeChunk(OutputStream& stream, uint32_t offset) const {
+    const auto& data = prepared_.get().data;
+
+    if (offset >= data.size() || offset % GAMEDATA_CHUNK_SIZE != 0) {
+        return false;
+    }
+
+    const auto length = std::min<size_t>(GAMEDATA_CHUNK_SIZE, data.size() - offset);
+
+    stream.writeUint32(offset);
+    stream.writeString({reinterpret_cast<const char*>(data.data() + offset), length});
+
+    return true;
+}
+
+GameDataDownload::GameDataDownload(InputStream& stream) : gameInitSettings_(stream), changeEventList_(stream) {
+    size_           = stream.readUint32();
+    compressedSize_ = stream.readUint32();
+    bCompressed_    = stream.readBool();
+
+    // the sizes come from the network, so they are checked before anything is allocated
+    if (size_ > GAMEDATA_MAX_SIZE || compressedSize_ > GAMEDATA_MAX_SIZE || compressedSize_ == 0
+        || (!bCompressed_ && compressedSize_ != size_)) {
+        THROW(std::runtime_error, "Invalid game data size {} ({} bytes to transfer)!", size_, compressedSize_);
+    }
+
+    const auto hash = stream.readUint8Vector();
+    if (hash.size() != hash_.size()) {
+        THROW(std::runtime_error, "Invalid game data hash of size {}!", hash.size());
+    }
+    std::ranges::copy(hash, hash_.begin());
+
+    const auto inlineData = stream.readString();
+    if (!inlineData.empty()) {
+        if (inlineData.size() != compressedSize_) {
+            THROW(std::runtime_error, "Invalid game data of size {} (expected {})!", inlineData.size(),
+                  compressedSize_);
+        }
+
+        compressedData_.assign(inlineData.begin(), inlineData.end());
+        complete();
+        return;
+    }
+
+    auto [ok, cacheDirectory] = fnkdat("cache/gamedata/", FNKDAT_USER | FNKDAT_CREAT);
+    std::error_code ec;
+    if (ok
+        && (std::filesystem::is_directory(cacheDirectory, ec)
+            || std::filesystem::create_directories(cacheDirectory, ec))) {
+        cacheDirectory_ = std::move(cacheDirectory);
+    }
+
+    if (findLocalCopy()) {
+        bComplete_ = true;
+        return;
+    }
+
+    openPartFile();
+}
+
+GameDataDownload::~GameDataDownload() = default;
+
+std::optional<uint32_t> GameDataDownload::getNextRequest() {
+    if (bComplete_ || nextRequestOffset_ >= compressedSize_) {
+        return std::nullopt;
+    }
+
+    if (nextRequestOffset_ - compressedData_.size() >= GAMEDATA_MAX_REQUESTS * GAMEDATA_CHUNK_SIZE) {
+        return std::nullopt;
+    }
+
+    const auto offset = nextRequestOffset_;
+    nextRequestOffset_ += GAMEDATA_CHUNK_SIZE;
+    return offset;
+}
+
+void GameDataDownload::addChunk(InputStream& stream) {
+    const auto offset = stream.readUint32();
+    const auto chunk  = stream.readString();
+
+    // ENet delivers reliable packets in order, so every chunk has to continue where the last one ended
+    const auto expectedLength = std::min<size_t>(GAMEDATA_CHUNK_SIZE, compressedSize_ - compressedData_.size());
+    if (bComplete_ || offset != compressedData_.size() || chunk.size() != expectedLength) {
+        THROW(std::runtime_error, "Unexpected game data chunk at offset {} of size {}!", offset, chunk.size());
+    }
+
+    compressedData_.insert(compressedData_.end(), chunk.begin(), chunk.end());
+
+    if (partFile_ && SDL_RWwrite(partFile_.get(), chunk.data(), chunk.size(), 1) != 1) {
+        sdl2::log_info("Cannot write to the game data download cache: {}", SDL_GetError());
+        partFile_.reset();
+    }
+
+    if (compressedData_.size() == compressedSize_) {
+        complete();
+    }
+}
+
+void GameDataDownload::addChangeEventList(const ChangeEventList& changeEventList) {
+    std::ranges::copy(changeEventList.changeEventList_, std::back_inserter(changeEventList_.changeEventList_));
+}
+
+bool GameDataDownload::findLocalCopy() {
+    const auto hex      = to_hex(hash_, 0);
+    const auto filename = gameInitSettings_.getFilename();
+
+    std::vector<std::filesystem::path> candidates;
+
+    if (!cacheDirectory_.empty()) {
+        candidates.push_back(cacheDirectory_ / hex);
+    }
+
+    if (gameInitSettings_.getGameType() == GameType::LoadMultiplayer) {
+        auto [ok, savepath] = fnkdat("mpsave/", FNKDAT_USER | FNKDAT_CREAT);
+        candidates.push_back(savepath / filename.filename().replace_extension(".dls"));
+    } else {
+        auto mapFile = filename.filename().replace_extension(".ini");
+
+        candidates.push_back(getDuneLegacyDataDir() / "maps/multiplayer/" / mapFile);
+        candidates.push_back(getDuneLegacyDataDir() / "maps/singleplayer/" / mapFile);
+
+        auto [ok, multiplayerMaps] = fnkdat("maps/multiplayer/", FNKDAT_USER | FNKDAT_CREAT);
+        candidates.push_back(multiplayerMaps / mapFile);
+
+        auto [ok2, singleplayerMaps] = fnkdat("maps/singleplayer/", FNKDAT_USER | FNKDAT_CREAT);
+        candidates.push_back(singleplayerMaps / mapFile);
+    }
+
+    for (const auto& candidate : candidates) {
+        std::error_code ec;
+        if (std::filesystem::file_size(candidate, ec) != size_ || ec) {
+            continue;
+        }
+
+        auto filedata = readCompleteFile(candidate);
+        if (filedata.size() != size_ || calculateHash(asBytes(filedata)) != hash_) {
+            continue;
+        }
+
+        sdl2::log_info("Using local copy '{}' of the game data",
+                       reinterpret_cast<const char*>(candidate.u8string().c_str()));
+
+        gameInitSettings_.setFiledata(std::move(filedata));
+        return true;
+    }
+
+    return false;
+}
+
+void GameDataDownload::openPartFile() {
+    if (cacheDirectory_.empty()) {
+        return;
+    }
+
+    const auto partFilename = cacheDirectory_ / (to_hex(hash_, 0) + ".part");
+
+    // resume a previous download; only complete chunks are kept and at least the last chunk is requested again
+    std::error_code ec;
+    const auto partSize = std::filesystem::file_size(partFilename, ec);
+    if (!ec && partSize > 0) {
+        const auto resumeSize =
+            std::min<uintmax_t>(partSize, compressedSize_ - 1) / GAMEDATA_CHUNK_SIZE * GAMEDATA_CHUNK_SIZE;
+        const auto partData = readCompleteFile(partFilename);
+
+        if (resumeSize != partSize) {
+            std::filesystem::resize_file(partFilename, resumeSize, ec);
+        }
+
+        if (!ec && partData.size() >= resumeSize) {
+            compressedData_.assign(partData.begin(), partData.begin() + static_cast<ptrdiff_t>(resumeSize));
+            nextRequestOffset_ = static_cast<uint32_t>(resumeSize);
+
+            if (resumeSize > 0) {
+                sdl2::log_info("Resuming game data download at {} of {} bytes", resumeSize, compressedSize_);
+            }
+        }
+    }
+
+    const auto* const mode = compressedData_.empty() ? "wb" : "ab";
+    partFile_ = sdl2::RWops_ptr{SDL_RWFromFile(reinterpret_cast<const char*>(partFilename.u8string().c_str()), mode)};
+    if (!partFile_) {
+        sdl2::log_info("Cannot open the game data download cache: {}", SDL_GetError());
+    }
+}
+
+void GameDataDownload::complete() {
+    partFile_.reset();
+
+    const auto hex = to_hex(hash_, 0);
+
+    auto filedata = bCompressed_ ? dune::zlib_decompress(compressedData_, size_) : std::move(compressedData_);
+    if (filedata.size() != size_ || calculateHash(filedata) != hash_) {
+        if (!cacheDirectory_.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(cacheDirectory_ / (hex + ".part"), ec);
+        }
+
+        THROW(std::runtime_error, "The received game data is corrupt!");
+    }
+
+    if (!cacheDirectory_.empty()) {
+        const auto cacheFilename = cacheDirectory_ / hex;
+
+        if (const auto file = sdl2::RWops_ptr{
+                SDL_RWFromFile(reinterpret_cast<const char*>(cacheFilename.u8string().c_str()), "wb")}) {
+            if (!filedata.empty() && SDL_RWwrite(file.get(), filedata.data(), filedata.size(), 1) != 1) {
+                sdl2::log_info("Cannot write to the game data download cache: {}", SDL_GetError());
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::remove(cacheDirectory_ / (hex + ".part"), ec);
+    }
+
+    gameInitSettings_.setFiledata({filedata.begin(), filedata.end()});
+    compressedData_.clear();
+    compressedData_.shrink_to_fit();
+    nextRequestOffset_ = compressedSize_;
+    bComplete_         = true;
+}
@@ -21,9 +21,11 @@
 
 #include <GameInitSettings.h>
 
+#include <misc/IMemoryStream.h>
 #include <misc/exceptions.h>
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 NetworkManager::NetworkManager(uint16_t port, std::string metaserver) {
@@ -57,6 +59,16 @@ NetworkManager::NetworkManager(uint16_t port, std::string metaserver) {
 }
 
 NetworkManager::~NetworkManager() {
+    if (pLastCommandListPacket_ != nullptr && --pLastCommandListPacket_->referenceCount == 0) {
+        enet_packet_destroy(pLastCommandListPacket_);
+    }
+
+    for (const auto& delayedPacket : delayedPackets_) {
+        if (--delayedPacket.pPacket->referenceCount == 0) {
+            enet_packet_destroy(delayedPacket.pPacket);
+        }
+    }
+
     pMetaServerClient_.reset();
     pLANGameFinderAndAnnouncer_.reset();
     enet_host_destroy(host_);
@@ -79,6 +91,12 @@ void NetworkManager::startServer(bool bLANServer, std::string serverName, std::s
     playerName_        = std::move(playerName);
     pGameInitSettings_ = pGameInitSettings;
 
+    // prepared in the background, so it is usually ready when the first player joins
+    pGameDataUpload_ = std::make_unique<GameDataUpload>(pGameInitSettings->getFiledata());
+
+    sentSelectionLists_.clear();
+    receivedSelectionLists_.clear();
+
     std::string map_name{reinterpret_cast<const char*>(pGameInitSettings->getFilename().u8string().c_str())};
 
     if (bLANServer) {
@@ -150,6 +168,15 @@ void NetworkManager::connect(ENetAddress address, std::string playerName) {
 
     this->playerName_ = std::move(playerName);
 
+    bRelayed_ = false;
+    relayPeerNames_.clear();
+
+    pGameDataDownload_.reset();
+    pendingStartGameTime_.reset();
+
+    sentSelectionLists_.clear();
+    receivedSelectionLists_.clear();
+
     connectPeer_->data = new PeerData(connectPeer_, PeerData::PeerState::WaitingForConnect);
     awaitingConnectionList_.push_back(connectPeer_);
 }
@@ -201,15 +228,10 @@ void NetworkManager::update() {
                         peerData->peerState_ = PeerData::PeerState::Connected;
                         peerData->timeout_   = dune::dune_clock::time_point{};
                         awaitingConnectionList_.remove(pCurrentPeer);
+                        bResendSelectionLists_ = true;
 
                         // send peer game settings
-                        ENetPacketOStream packetOStream2(ENET_PACKET_FLAG_RELIABLE);
-                        packetOStream2.writeUint32(NETWORKPACKET_SENDGAMEINFO);
-                        pGameInitSettings_->save(packetOStream2);
-
-                        changeEventList.save(packetOStream2);
-
-                        sendPacketToPeer(pCurrentPeer, packetOStream2);
+                        sendGameInfo(pCurrentPeer, changeEventList);
                     } else {
                         // instruct all connected peers to connect
 
@@ -254,6 +276,8 @@ void NetworkManager::update() {
         }
     }
 
+    sendDelayedPackets();
+
     ENetEvent event;
     while (enet_host_service(host_, &event, 0) > 0) {
 
@@ -390,6 +414,9 @@ void NetworkManager::update() {
 
                 if (peer == connectPeer_) {
                     connectPeer_ = nullptr;
+
+                    pGameDataDownload_.reset();
+                    pendingStartGameTime_.reset();
                 }
 
             } break;
@@ -399,6 +426,14 @@ void NetworkManager::update() {
             } break;
         }
     }
+
+    // the start of the game was announced while we were still downloading the game data
+    if (pendingStartGameTime_ && !pGameDataDownload_ && pOnStartGame_) {
+        const auto timeLeft = std::max(*pendingStartGameTime_ - dune::dune_clock::now(), dune::dune_clock::duration{});
+        pendingStartGameTime_.reset();
+
+        pOnStartGame_(timeLeft);
+    }
 }
 
 void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStream) {
@@ -494,15 +529,10 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                                 peerData->peerState_ = PeerData::PeerState::Connected;
                                 peerData->timeout_   = dune::dune_clock::time_point{};
                                 awaitingConnectionList_.remove(pCurrentPeer);
+                                bResendSelectionLists_ = true;
 
                                 // send peer game settings
-                                ENetPacketOStream packetOStream2(ENET_PACKET_FLAG_RELIABLE);
-                                packetOStream2.writeUint32(NETWORKPACKET_SENDGAMEINFO);
-                                pGameInitSettings_->save(packetOStream2);
-
-                                changeEventList.save(packetOStream2);
-
-                                sendPacketToPeer(pCurrentPeer, packetOStream2);
+                                sendGameInfo(pCurrentPeer, changeEventList);
                             }
                         }
                     }
@@ -522,6 +552,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                             peerData->peerState_ = PeerData::PeerState::Connected;
                             peerData->timeout_   = dune::dune_clock::time_point{};
                             awaitingConnectionList_.erase(iter);
+                            bResendSelectionLists_ = true;
                             break;
                         }
                     }
@@ -543,12 +574,71 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 peerData->peerState_ = PeerData::PeerState::Connected;
                 peerData->timeout_   = dune::dune_clock::time_point{};
                 awaitingConnectionList_.clear();
+                bResendSelectionLists_ = true;
 
-                const GameInitSettings gameInitSettings(packetStream);
-                const ChangeEventList changeEventList(packetStream);
+                try {
+                    pGameDataDownload_ = std::make_unique<GameDataDownload>(packetStream);
+                } catch (std::exception& e) {
+                    sdl2::log_info("NetworkManager: Receiving the game info failed: {}", e.what());
+                    disconnect();
+                    break;
+                }
 
-                if (pOnReceiveGameInfo_) {
-                    pOnReceiveGameInfo_(gameInitSettings, changeEventList);
+                if (pGameDataDownload_->isComplete()) {
+                    finishGameDataDownload();
+                } else {
+                    debugNetwork("Downloading {} bytes of game data\n", pGameDataDownload_->getTotalBytes());
+                    requestGameData();
+                }
+            } break;
+
+            case NETWORKPACKET_GAMEDATAREQUEST: {
+                if (!bIsServer_ || pGameDataUpload_ == nullptr
+                    || std::ranges::find(peerList_, peer) == peerList_.end()) {
+                    break;
+                }
+
+                const auto offset = packetStream.readUint32();
+
+                ENetPacketOStream packetOStream(ENET_PACKET_FLAG_RELIABLE, GAMEDATA_CHUNK_SIZE + 16);
+                packetOStream.writeUint32(NETWORKPACKET_GAMEDATACHUNK);
+                if (!pGameDataUpload_->writeChunk(packetOStream, offset)) {
+                    sdl2::log_info("NetworkManager: Invalid game data request for offset {}", offset);
+                    break;
+                }
+
+                sendPacketToPeer(peer, packetOStream);
+
+                if (pOnSendGameDataProgress_) {
+                    const auto* peerData = static_cast<PeerData*>(peer->data);
+                    const auto total     = pGameDataUpload_->getTransferSize();
+                    pOnSendGameDataProgress_(peerData ? peerData->name_ : std::string{},
+                                             std::min(offset + GAMEDATA_CHUNK_SIZE, total), total);
+                }
+            } break;
+
+            case NETWORKPACKET_GAMEDATACHUNK: {
+                if (peer != connectPeer_ || pGameDataDownload_ == nullptr) {
+                    break;
+                }
+
+                try {
+                    pGameDataDownload_->addChunk(packetStream);
+                } catch (std::exception& e) {
+                    sdl2::log_info("NetworkManager: Downloading the game data failed: {}", e.what());
+                    pGameDataDownload_.reset();
+                    disconnect();
+                    break;
+                }
+
+                if (pOnGameDataProgress_) {
+                    pOnGameDataProgress_(pGameDataDownload_->getReceivedBytes(), pGameDataDownload_->getTotalBytes());
+                }
+
+                if (pGameDataDownload_->isComplete()) {
+                    finishGameDataDownload();
+                } else {
+                    requestGameData();
                 }
             } break;
 
@@ -618,7 +708,9 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
             case NETWORKPACKET_CHANGEEVENTLIST: {
                 const ChangeEventList changeEventList(packetStream);
 
-                if (pOnReceiveChangeEventList_) {
+                if (pGameDataDownload_) {
+                    pGameDataDownload_->addChangeEventList(changeEventList);
+                } else if (pOnReceiveChangeEventList_) {
                     pOnReceiveChangeEventList_(changeEventList);
                 }
             } break;
@@ -626,7 +718,9 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
             case NETWORKPACKET_STARTGAME: {
                 const auto timeLeft = packetStream.readUint32();
 
-                if (pOnStartGame_) {
+                if (pGameDataDownload_) {
+                    pendingStartGameTime_ = dune::dune_clock::now() + dune::as_dune_clock_duration(timeLeft);
+                } else if (pOnStartGame_) {
                     pOnStartGame_(dune::as_dune_clock_duration(timeLeft));
                 }
             } break;
@@ -644,18 +738,42 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 }
             } break;
 
-            case NETWORKPACKET_SELECTIONLIST: {
+            case NETWORKPACKET_SELECTIONLIST:
+            case NETWORKPACKET_SELECTIONLISTDELTA: {
                 auto* peerData = static_cast<PeerData*>(peer->data);
                 if (!peerData) {
                     break;
                 }
 
-                const auto groupListIndex = packetStream.readSint32();
-                const auto selectedList   = packetStream.readUint32Set();
+                handleSelectionList(peerData->name_, packetStream, packetType == NETWORKPACKET_SELECTIONLISTDELTA);
+            } break;
+
+            case NETWORKPACKET_RELAYPEERS: {
+                if (bIsServer_ || peer != connectPeer_) {
+                    break;
+                }
+
+                const auto numPeers = packetStream.readUint32();
+
+                std::vector<std::string> relayPeerNames;
+                for (auto i = 0U; i < numPeers && packetStream.bytesLeft() > 0; ++i) {
+                    relayPeerNames.push_back(packetStream.readString());
+                }
+
+                updateRelayPeers(std::move(relayPeerNames));
+            } break;
 
-                if (pOnReceiveSelectionList_) {
-                    pOnReceiveSelectionList_(peerData->name_, selectedList, groupListIndex);
+            case NETWORKPACKET_RELAYED: {
+                if (!bRelayed_ || peer != connectPeer_) {
+                    break;
                 }
+
+                const auto originName = packetStream.readString();
+                const auto payload    = packetStream.readString();
+
+                IMemoryStream payloadStream(payload.data(), payload.size());
+
+                handleRelayedPacket(originName, payloadStream);
             } break;
 
             default: {
@@ -670,6 +788,118 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
     }
 }
 
+void NetworkManager::handleRelayedPacket(const std::string& originName, InputStream& packetStream) {
+    const auto packetType = packetStream.readUint32();
+
+    switch (packetType) {
+        case NETWORKPACKET_CHATMESSAGE: {
+            const auto message = packetStream.readString();
+            if (pOnReceiveChatMessage_) {
+                pOnReceiveChatMessage_(originName, message);
+            }
+        } break;
+
+        case NETWORKPACKET_COMMANDLIST: {
+            const CommandList commandList(packetStream);
+
+            if (pOnReceiveCommandList_) {
+                pOnReceiveCommandList_(originName, commandList);
+            }
+        } break;
+
+        case NETWORKPACKET_SELECTIONLIST:
+        case NETWORKPACKET_SELECTIONLISTDELTA: {
+            handleSelectionList(originName, packetStream, packetType == NETWORKPACKET_SELECTIONLISTDELTA);
+        } break;
+
+        default: {
+            sdl2::log_info("NetworkManager: Unknown relayed packet type {} from '{}'", packetType, originName);
+        }
+    }
+}
+
+void NetworkManager::handleSelectionList(const std::string& name, InputStream& packetStream, bool bDelta) {
+    const auto groupListIndex = packetStream.readSint32();
+
+    auto& selectedList = receivedSelectionLists_[std::make_pair(name, groupListIndex)];
+
+    if (bDelta) {
+        // the delta is relative to the last list we received for this group index (channel 0 is reliable and ordered)
+        const auto addedList   = packetStream.readUint32Set();
+        const auto removedList = packetStream.readUint32Set();
+
+        for (const auto objectID : removedList) {
+            selectedList.erase(objectID);
+        }
+
+        selectedList.insert(addedList.begin(), addedList.end());
+    } else {
+        selectedList = packetStream.readUint32Set();
+    }
+
+    if (pOnReceiveSelectionList_) {
+        pOnReceiveSelectionList_(name, selectedList, groupListIndex);
+    }
+}
+
+void NetworkManager::sendGameInfo(ENetPeer* peer, const ChangeEventList& changeEventList) {
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    packetStream.writeUint32(NETWORKPACKET_SENDGAMEINFO);
+    pGameDataUpload_->writeGameInfo(packetStream, *pGameInitSettings_, changeEventList);
+
+    sendPacketToPeer(peer, packetStream);
+}
+
+void NetworkManager::requestGameData() {
+    while (const auto offset = pGameDataDownload_->getNextRequest()) {
+        ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+        packetStream.writeUint32(NETWORKPACKET_GAMEDATAREQUEST);
+        packetStream.writeUint32(*offset);
+
+        sendPacketToHost(packetStream);
+    }
+}
+
+void NetworkManager::finishGameDataDownload() {
+    // the callback usually runs the whole lobby, so we must not be in the middle of a download anymore
+    const auto pGameDataDownload = std::move(pGameDataDownload_);
+
+    // a relay server waits for all players to have the game data before starting the game
+    if (bRelayed_) {
+        ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+        packetStream.writeUint32(NETWORKPACKET_GAMEDATACOMPLETE);
+
+        sendPacketToHost(packetStream);
+    }
+
+    if (pOnReceiveGameInfo_) {
+        pOnReceiveGameInfo_(pGameDataDownload->getGameInitSettings(), pGameDataDownload->getChangeEventList());
+    }
+}
+
+void NetworkManager::updateRelayPeers(std::vector<std::string> relayPeerNames) {
+    if (!bRelayed_) {
+        debugNetwork("NetworkManager: Host is a relay server\n");
+        bRelayed_ = true;
+    }
+
+    // the relay server tells us about players leaving only by omitting them from the next list
+    for (const auto& oldName : relayPeerNames_) {
+        if (std::ranges::find(relayPeerNames, oldName) == relayPeerNames.end()) {
+            debugNetwork("NetworkManager: '{}' left the relay server\n", oldName);
+
+            if (pOnPeerDisconnected_) {
+                pOnPeerDisconnected_(oldName, false, NETWORKDISCONNECT_QUIT);
+            }
+        }
+    }
+
+    relayPeerNames_ = std::move(relayPeerNames);
+
+    // the relay server sends a new list whenever a player joins, even under the name of a player who just left
+    bResendSelectionLists_ = true;
+}
+
 void NetworkManager::sendPacketToHost(ENetPacketOStream& packetStream, int channel) {
     if (connectPeer_ == nullptr) {
         sdl2::log_info("NetworkManager: sendPacketToHost() called on server!");
@@ -681,8 +911,10 @@ void NetworkManager::sendPacketToHost(ENetPacketOStream& packetStream, int chann
 
     ENetPacket* enetPacket = packetStream.getPacket();
 
-    if (enet_peer_send(connectPeer_, static_cast<enet_uint8>(channel), enetPacket) < 0) {
-        sdl2::log_info("NetworkManager: Cannot send packet!");
+    sendPacket(connectPeer_, static_cast<enet_uint8>(channel), enetPacket);
+
+    if (enetPacket->referenceCount == 0) {
+        enet_packet_destroy(enetPacket);
     }
 }
 
@@ -692,9 +924,7 @@ void NetworkManager::sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetS
 
     ENetPacket* enetPacket = packetStream.getPacket();
 
-    if (enet_peer_send(peer, static_cast<enet_uint8>(channel), enetPacket) < 0) {
-        sdl2::log_info("NetworkManager: Cannot send packet!");
-    }
+    sendPacket(peer, static_cast<enet_uint8>(channel), enetPacket);
 
     if (enetPacket->referenceCount == 0) {
         enet_packet_destroy(enetPacket);
@@ -702,15 +932,20 @@ void NetworkManager::sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetS
 }
 
 void NetworkManager::sendPacketToAllConnectedPeers(ENetPacketOStream& packetStream, int channel) {
-    if (channel < 0 || channel >= std::numeric_limits<enet_uint8>::max())
-        THROW(std::invalid_argument, "Invalid channel ({})!", channel);
+    sendPacketToAllConnectedPeers(packetStream.getPacket(), channel);
+}
 
-    ENetPacket* enetPacket = packetStream.getPacket();
+void NetworkManager::sendPacketToAllConnectedPeers(ENetPacket* enetPacket, int channel) {
+    if (channel < 0 || channel >= std::numeric_limits<enet_uint8>::max()) {
+        if (enetPacket->referenceCount == 0) {
+            enet_packet_destroy(enetPacket);
+        }
+        THROW(std::invalid_argument, "Invalid channel ({})!", channel);
+    }
 
+    // all peers share the same packet, so it is serialized only once
     for (auto* pCurrentPeer : peerList_) {
-        if (enet_peer_send(pCurrentPeer, static_cast<enet_uint8>(channel), enetPacket) < 0) {
-            sdl2::log_info("NetworkManager: Cannot send packet!");
-        }
+        sendPacket(pCurrentPeer, static_cast<enet_uint8>(channel), enetPacket);
     }
 
     if (enetPacket->referenceCount == 0) {
@@ -718,6 +953,88 @@ void NetworkManager::sendPacketToAllConnectedPeers(ENetPacketOStream& packetStre
     }
 }
 
+void NetworkManager::sendPacket(ENetPeer* peer, enet_uint8 channel, ENetPacket* enetPacket) {
+    if (!simulatedConditions_.isActive()) {
+        if (enet_peer_send(peer, channel, enetPacket) < 0) {
+            sdl2::log_info("NetworkManager: Cannot send packet!");
+        }
+        return;
+    }
+
+    const auto bReliable = (enetPacket->flags & ENET_PACKET_FLAG_RELIABLE) != 0;
+    const auto bLost     = std::bernoulli_distribution{simulatedConditions_.packetLoss}(simulatedConditionsRandom_);
+
+    if (bLost && !bReliable) {
+        return;
+    }
+
+    auto delay = simulatedConditions_.latency;
+    if (simulatedConditions_.jitter.count() > 0) {
+        delay += dune::dune_clock::duration{std::uniform_int_distribution<dune::dune_clock::rep>{
+            0, simulatedConditions_.jitter.count()}(simulatedConditionsRandom_)};
+    }
+    if (bLost) {
+        // ENet would resend a lost reliable packet after roughly one round trip
+        delay += 2 * simulatedConditions_.latency + simulatedConditions_.jitter;
+    }
+
+    auto sendTime = simulatedNow() + delay;
+
+    if (bReliable) {
+        // ENet numbers reliable packets when they are handed over, so they must not overtake each other
+        for (const auto& delayedPacket : delayedPackets_) {
+            if (delayedPacket.peerID == peer->incomingPeerID && delayedPacket.connectID == peer->connectID
+                && (delayedPacket.pPacket->flags & ENET_PACKET_FLAG_RELIABLE) != 0) {
+                sendTime = std::max(sendTime, delayedPacket.sendTime);
+            }
+        }
+    }
+
+    ++enetPacket->referenceCount;
+
+    const auto insertPos = std::ranges::upper_bound(delayedPackets_, sendTime, {}, &DelayedPacket::sendTime);
+    delayedPackets_.insert(insertPos,
+                           DelayedPacket{sendTime, peer->incomingPeerID, peer->connectID, channel, enetPacket});
+}
+
+void NetworkManager::sendDelayedPackets() {
+    const auto now = simulatedNow();
+
+    const auto last =
+        std::ranges::find_if(delayedPackets_, [now](const auto& delayedPacket) { return delayedPacket.sendTime > now; });
+
+    for (auto it = delayedPackets_.begin(); it != last; ++it) {
+        --it->pPacket->referenceCount;
+
+        // the peer might have disconnected in the meantime and its slot might even be used by another connection
+        auto* const peer = &host_->peers[it->peerID];
+        if (peer->state == ENET_PEER_STATE_CONNECTED && peer->connectID == it->connectID
+            && enet_peer_send(peer, it->channel, it->pPacket) < 0) {
+            sdl2::log_info("NetworkManager: Cannot send packet!");
+        }
+
+        if (it->pPacket->referenceCount == 0) {
+            enet_packet_destroy(it->pPacket);
+        }
+    }
+
+    delayedPackets_.erase(delayedPackets_.begin(), last);
+}
+
+void NetworkManager::setSimulatedNetworkConditions(const SimulatedNetworkConditions& conditions) {
+    simulatedConditions_ = conditions;
+    simulatedConditionsRandom_.seed(conditions.seed);
+
+    if (!simulatedConditions_.isActive()) {
+        // do not let the remaining delayed packets be overtaken by the ones sent from now on
+        for (auto& delayedPacket : delayedPackets_) {
+            delayedPacket.sendTime = dune::dune_clock::time_point{};
+        }
+
+        sendDelayedPackets();
+    }
+}
+
 void NetworkManager::sendChatMessage(std::string_view message) {
     ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
     packetStream.writeUint32(NETWORKPACKET_CHATMESSAGE);
@@ -750,24 +1067,88 @@ void NetworkManager::sendStartGame(unsigned int timeLeft) {
 }
 
 void NetworkManager::sendCommandList(const CommandList& commandList) {
-    ENetPacketOStream packetStream(ENET_PACKET_FLAG_UNSEQUENCED);
+    // the command list covers a sliding window of cycles, so it has about the same size as last time
+    const auto sizeHint = pLastCommandListPacket_ != nullptr ? pLastCommandListPacket_->dataLength : 0;
+
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_UNSEQUENCED, sizeHint);
     packetStream.writeUint32(NETWORKPACKET_COMMANDLIST);
     commandList.save(packetStream);
 
-    sendPacketToAllConnectedPeers(packetStream, 1);
+    auto* const enetPacket = packetStream.getPacket();
+
+    if (pLastCommandListPacket_ != nullptr && --pLastCommandListPacket_->referenceCount == 0) {
+        enet_packet_destroy(pLastCommandListPacket_);
+    }
+
+    ++enetPacket->referenceCount;
+    pLastCommandListPacket_ = enetPacket;
+
+    sendPacketToAllConnectedPeers(enetPacket, 1);
+}
+
+bool NetworkManager::resendCommandList() {
+    if (pLastCommandListPacket_ == nullptr) {
+        return false;
+    }
+
+    sendPacketToAllConnectedPeers(pLastCommandListPacket_, 1);
+
+    return true;
 }
 
 void NetworkManager::sendSelectedList(const dune::selected_set_type& selectedList, int groupListIndex) {
+    // a peer that (re)connected since the last call does not know our previous lists
+    if (bResendSelectionLists_) {
+        sentSelectionLists_.clear();
+        bResendSelectionLists_ = false;
+    }
+
+    auto [iter, bFirstList] = sentSelectionLists_.try_emplace(groupListIndex);
+    auto& sentList          = iter->second;
+
+    dune::selected_set_type addedList;
+    dune::selected_set_type removedList;
+
+    if (!bFirstList) {
+        std::ranges::copy_if(selectedList, std::inserter(addedList, addedList.end()),
+                             [&](auto objectID) { return !sentList.contains(objectID); });
+        std::ranges::copy_if(sentList, std::inserter(removedList, removedList.end()),
+                             [&](auto objectID) { return !selectedList.contains(objectID); });
+
+        if (addedList.empty() && removedList.empty()) {
+            return;
+        }
+    }
+
     ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
-    packetStream.writeUint32(NETWORKPACKET_SELECTIONLIST);
-    packetStream.writeSint32(groupListIndex);
-    packetStream.writeUint32Set(selectedList);
+
+    if (bFirstList || addedList.size() + removedList.size() >= selectedList.size()) {
+        packetStream.writeUint32(NETWORKPACKET_SELECTIONLIST);
+        packetStream.writeSint32(groupListIndex);
+        packetStream.writeUint32Set(selectedList);
+    } else {
+        packetStream.writeUint32(NETWORKPACKET_SELECTIONLISTDELTA);
+        packetStream.writeSint32(groupListIndex);
+        packetStream.writeUint32Set(addedList);
+        packetStream.writeUint32Set(removedList);
+    }
+
+    sentList = selectedList;
 
     sendPacketToAllConnectedPeers(packetStream, 0);
 }
 
 std::vector<std::string> NetworkManager::getConnectedPeers() const {
     std::vector<std::string> peerNameList;
+
+    if (bRelayed_) {
+        // the relay server reports all players including ourselves
+        std::ranges::copy_if(relayPeerNames_, std::back_inserter(peerNameList),
+                             [this](const auto& name) { return name != playerName_; });
+
+        return peerNameList;
+    }
+
     peerNameList.reserve(peerList_.size());
 
     for (const auto* pPeer : peerList_) {
@@ -786,5 +1167,9 @@ int NetworkManager::getMaxPeerRoundTripTime() const {
     const auto max_rtt =
         std::ranges::max(peerList_, {}, [](const auto* const p) { return p->roundTripTime; })->roundTripTime;
 
+    // Relayed data makes two trips: to the relay server and from there to the other players.
+    if (bRelayed_)
+        return 2 * static_cast<int>(max_rtt);
+
     return static_cast<int>(max_rtt);
 }
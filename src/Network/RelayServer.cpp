@@ -0,0 +1,507 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Network/RelayServer.h>
+
+#include <Network/ENetHelper.h>
+#include <Network/ENetPacketIStream.h>
+#include <Network/NetworkManager.h>
+
+#include <FileClasses/INIFile.h>
+
+#include <misc/IMemoryStream.h>
+#include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
+
+#include <Definitions.h>
+#include <SaveGameHeader.h>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace {
+inline constexpr auto RELAY_START_GAME_DELAY = dune::as_dune_clock_duration(5000);
+
+bool isSamePlayerSetting(const ChangeEventList::ChangeEvent& a, const ChangeEventList::ChangeEvent& b) {
+    using EventType = ChangeEventList::ChangeEvent::EventType;
+
+    const auto kind = [](EventType type) { return type == EventType::SetHumanPlayer ? EventType::ChangePlayer : type; };
+
+    return a.slot_ == b.slot_ && kind(a.eventType_) == kind(b.eventType_);
+}
+
+/// Counts the houses on a map the same way CustomGamePlayers::extractMapInfo() does
+int countHousesOnMap(const std::string& mapData) {
+    const sdl2::RWops_ptr rwops{SDL_RWFromConstMem(mapData.data(), gsl::narrow<int>(mapData.size()))};
+
+    const INIFile inimap(rwops.get());
+
+    static constexpr std::string_view sections[] = {"Harkonnen", "Atreides", "Ordos",   "Fremen",  "Sardaukar",
+                                                    "Mercenary", "Player1",  "Player2", "Player3", "Player4",
+                                                    "Player5",   "Player6"};
+
+    return gsl::narrow<int>(
+        std::ranges::count_if(sections, [&](std::string_view section) { return inimap.hasSection(section); }));
+}
+} // namespace
+
+RelayServer::PlayerSlots RelayServer::readPlayerSlots(const GameInitSettings& gameInitSettings) {
+    if (gameInitSettings.getGameType() != GameType::LoadMultiplayer)
+        return {countHousesOnMap(gameInitSettings.getFiledata()), gameInitSettings.isMultiplePlayersPerHouse()};
+
+    // a savegame is played with the houses that were in the game and the settings it was started with
+    const auto& fileData = gameInitSettings.getFiledata();
+    IMemoryStream stream(fileData.data(), fileData.size());
+
+    if (stream.readUint32() != SAVEMAGIC)
+        THROW(std::invalid_argument, "RelayServer: No valid savegame!");
+
+    const auto savegameVersion = stream.readUint32();
+    if (savegameVersion < SAVEGAMEVERSION_UNCOMPRESSED || savegameVersion > SAVEGAMEVERSION)
+        THROW(std::invalid_argument, "RelayServer: Unsupported savegame version {}!", savegameVersion);
+
+    stream.readString(); // dune legacy version
+
+    if (savegameVersion == SAVEGAMEVERSION_UNCOMPRESSED) {
+        const GameInitSettings savedGameInitSettings(stream);
+
+        const auto numHouseInfo = stream.readUint32();
+        if (numHouseInfo > static_cast<uint32_t>(NUM_HOUSES))
+            THROW(std::invalid_argument, "RelayServer: The savegame has {} houses!", numHouseInfo);
+
+        return {static_cast<int>(numHouseInfo), savedGameInitSettings.isMultiplePlayersPerHouse()};
+    }
+
+    const SaveGameHeader header{stream};
+
+    // gameInitSettings are at the beginning of the first section
+    const auto state = readSaveGameSection(stream);
+    IMemoryStream stateStream(reinterpret_cast<const char*>(state.data()), state.size());
+    const GameInitSettings savedGameInitSettings(stateStream);
+
+    return {gsl::narrow<int>(header.houseInfoList.size()), savedGameInitSettings.isMultiplePlayersPerHouse()};
+}
+
+RelayServer::RelayServer(uint16_t port, GameInitSettings gameInitSettings, int maxPlayers)
+    : templateGameInitSettings_(std::move(gameInitSettings)),
+      gameDataUpload_(templateGameInitSettings_.getFiledata()),
+      playerSlots_(readPlayerSlots(templateGameInitSettings_)), maxPlayers_(maxPlayers) {
+
+    if (maxPlayers <= 0 || maxPlayers > playerSlots_.getMaxPlayers())
+        THROW(std::invalid_argument, "The map has slots for {} players but {} players were requested!",
+              playerSlots_.getMaxPlayers(), maxPlayers);
+
+    if (enet_initialize() != 0) {
+        THROW(std::runtime_error, "RelayServer: An error occurred while initializing ENet.");
+    }
+
+    ENetAddress address{};
+    address.host = ENET_HOST_ANY;
+    address.port = port;
+
+    host_ = enet_host_create(&address, static_cast<size_t>(maxPlayers) + 8, 2, 0, 0);
+    if (host_ == nullptr) {
+        enet_deinitialize();
+        THROW(std::runtime_error, "RelayServer: An error occurred while trying to create a server host on port {}.",
+              port);
+    }
+
+    if (enet_host_compress_with_range_coder(host_) < 0) {
+        enet_host_destroy(host_);
+        enet_deinitialize();
+        THROW(std::runtime_error, "RelayServer: Cannot activate range coder.");
+    }
+
+    resetLobby();
+}
+
+RelayServer::~RelayServer() {
+    for (auto i = 0U; i < host_->peerCount; ++i) {
+        auto& peer = host_->peers[i];
+        std::unique_ptr<ClientData> clientData{static_cast<ClientData*>(peer.data)};
+        peer.data = nullptr;
+    }
+
+    enet_host_destroy(host_);
+    enet_deinitialize();
+}
+
+int RelayServer::getNumPlayers() const noexcept {
+    return static_cast<int>(clients_.size());
+}
+
+void RelayServer::resetLobby() {
+    gameInitSettings_ = templateGameInitSettings_;
+    gameInitSettings_.createRandomSeed();
+
+    lobbyEvents_.clear();
+    bGameStarted_ = false;
+}
+
+void RelayServer::update() {
+    const auto now = dune::dune_clock::now();
+
+    for (auto i = 0U; i < host_->peerCount; ++i) {
+        auto& peer            = host_->peers[i];
+        const auto* const cd = static_cast<ClientData*>(peer.data);
+
+        if (cd != nullptr && cd->clientState_ == ClientData::ClientState::WaitingForName
+            && cd->timeout_ != dune::dune_clock::time_point{} && now > cd->timeout_) {
+            enet_peer_disconnect(&peer, NETWORKDISCONNECT_TIMEOUT);
+        }
+    }
+
+    ENetEvent event;
+    while (enet_host_service(host_, &event, 0) > 0) {
+        switch (event.type) {
+            case ENET_EVENT_TYPE_CONNECT: {
+                onConnect(event.peer);
+            } break;
+
+            case ENET_EVENT_TYPE_RECEIVE: {
+                onReceive(event.peer, event.packet, event.channelID);
+            } break;
+
+            case ENET_EVENT_TYPE_DISCONNECT: {
+                onDisconnect(event.peer, event.data);
+            } break;
+
+            default: {
+
+            } break;
+        }
+    }
+}
+
+void RelayServer::onConnect(ENetPeer* peer) {
+    debugNetwork("RelayServer({}): {}:{} connected.", getPort(), Address2String(peer->address), peer->address.port);
+
+    if (bGameStarted_ || getNumPlayers() >= maxPlayers_) {
+        enet_peer_disconnect_later(peer, NETWORKDISCONNECT_GAME_FULL);
+        return;
+    }
+
+    auto clientData      = std::make_unique<ClientData>(peer);
+    clientData->timeout_ = dune::dune_clock::now() + AWAITING_CONNECTION_TIMEOUT;
+    peer->data           = clientData.release();
+
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    packetStream.writeUint32(NETWORKPACKET_SENDNAME);
+    packetStream.writeString(gameInitSettings_.getServername());
+
+    sendPacketToPeer(peer, packetStream);
+}
+
+void RelayServer::onDisconnect(ENetPeer* peer, uint32_t cause) {
+    std::unique_ptr<ClientData> clientData{static_cast<ClientData*>(peer->data)};
+    peer->data = nullptr;
+
+    if (clientData == nullptr)
+        return;
+
+    debugNetwork("RelayServer({}): {}:{} ({}) disconnected ({}).", getPort(), Address2String(peer->address),
+                 peer->address.port, clientData->name_, cause);
+
+    if (std::erase(clients_, peer) == 0)
+        return;
+
+    if (!bGameStarted_) {
+        // the slot falls back to what the map says
+        std::erase_if(lobbyEvents_, [&](const auto& changeEvent) {
+            return changeEvent.eventType_ == ChangeEventList::ChangeEvent::EventType::SetHumanPlayer
+                && changeEvent.newStringValue_ == clientData->name_;
+        });
+    }
+
+    if (clients_.empty()) {
+        if (bGameStarted_)
+            debugNetwork("RelayServer({}): All players left. Waiting for a new match.", getPort());
+
+        resetLobby();
+        return;
+    }
+
+    // the remaining players notice the missing name and call their onPeerDisconnected handler
+    sendPeerList();
+}
+
+void RelayServer::onReceive(ENetPeer* peer, ENetPacket* packet, enet_uint8 channel) {
+    ENetPacketIStream packetStream(packet);
+
+    auto* const clientData = static_cast<ClientData*>(peer->data);
+    if (clientData == nullptr)
+        return;
+
+    try {
+        const auto packetType = packetStream.readUint32();
+
+        if (clientData->clientState_ == ClientData::ClientState::WaitingForName) {
+            if (packetType == NETWORKPACKET_SENDNAME) {
+                onReceiveName(*clientData, packetStream.readString());
+            }
+            return;
+        }
+
+        switch (packetType) {
+            case NETWORKPACKET_CHANGEEVENTLIST: {
+                if (!bGameStarted_) {
+                    onReceiveChangeEventList(*clientData, ChangeEventList(packetStream));
+                }
+            } break;
+
+            case NETWORKPACKET_CHATMESSAGE:
+            case NETWORKPACKET_COMMANDLIST:
+            case NETWORKPACKET_SELECTIONLIST:
+            case NETWORKPACKET_SELECTIONLISTDELTA: {
+                relayPacket(*clientData, packet, channel);
+            } break;
+
+            case NETWORKPACKET_GAMEDATAREQUEST: {
+                const auto offset = packetStream.readUint32();
+
+                ENetPacketOStream packetOStream(ENET_PACKET_FLAG_RELIABLE, GAMEDATA_CHUNK_SIZE + 16);
+                packetOStream.writeUint32(NETWORKPACKET_GAMEDATACHUNK);
+                if (gameDataUpload_.writeChunk(packetOStream, offset)) {
+                    sendPacketToPeer(peer, packetOStream);
+                }
+            } break;
+
+            case NETWORKPACKET_GAMEDATACOMPLETE: {
+                clientData->bHasGameData_ = true;
+
+                startGameIfReady();
+            } break;
+
+            case NETWORKPACKET_SENDNAME:
+            case NETWORKPACKET_PEER_CONNECTED:
+            case NETWORKPACKET_DISCONNECT: {
+                // only meaningful in a full mesh
+            } break;
+
+            default: {
+                sdl2::log_info("RelayServer({}): Unknown packet type {} from '{}'", getPort(), packetType,
+                               clientData->name_);
+            }
+        }
+    } catch (InputStream::eof&) {
+        sdl2::log_info("RelayServer({}): Received packet is too small", getPort());
+    } catch (std::exception& e) {
+        sdl2::log_info("RelayServer({}): {}", getPort(), e.what());
+    }
+}
+
+void RelayServer::onReceiveName(ClientData& clientData, std::string name) {
+    auto* const peer = clientData.pPeer_;
+
+    const auto bNameTaken = name.empty() || name == gameInitSettings_.getServername()
+                         || std::ranges::any_of(clients_, [&](const ENetPeer* p) {
+                                return static_cast<const ClientData*>(p->data)->name_ == name;
+                            });
+
+    if (bNameTaken) {
+        enet_peer_disconnect_later(peer, NETWORKDISCONNECT_PLAYER_EXISTS);
+        return;
+    }
+
+    const auto slot = findFreeSlot();
+    if (bGameStarted_ || slot < 0) {
+        enet_peer_disconnect_later(peer, NETWORKDISCONNECT_GAME_FULL);
+        return;
+    }
+
+    clientData.name_        = std::move(name);
+    clientData.slot_        = slot;
+    clientData.clientState_ = ClientData::ClientState::Connected;
+    clientData.timeout_     = dune::dune_clock::time_point{};
+
+    debugNetwork("RelayServer({}): '{}' joined in slot {}.", getPort(), clientData.name_, slot);
+
+    const ChangeEventList::ChangeEvent joinEvent(static_cast<uint32_t>(slot), clientData.name_);
+
+    {
+        ChangeEventList changeEventList;
+        changeEventList.changeEventList_.push_back(joinEvent);
+
+        ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+        packetStream.writeUint32(NETWORKPACKET_CHANGEEVENTLIST);
+        changeEventList.save(packetStream);
+
+        sendPacketToAllClients(packetStream);
+    }
+
+    addLobbyEvent(joinEvent);
+    clients_.push_back(peer);
+
+    // the new player has to know that we are a relay before the lobby opens
+    sendPeerList();
+
+    ChangeEventList changeEventList;
+    changeEventList.changeEventList_ = lobbyEvents_;
+
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    packetStream.writeUint32(NETWORKPACKET_SENDGAMEINFO);
+    gameDataUpload_.writeGameInfo(packetStream, gameInitSettings_, changeEventList);
+
+    sendPacketToPeer(peer, packetStream);
+}
+
+void RelayServer::onReceiveChangeEventList(const ClientData& clientData, ChangeEventList changeEventList) {
+    // the clients index their lobby with the slots, so a single bad slot would make all of them crash
+    if (!std::ranges::all_of(changeEventList.changeEventList_, [this](const auto& e) { return isValidSlot(e); })) {
+        debugNetwork("RelayServer({}): Ignoring change event list with invalid slots from '{}'.", getPort(),
+                     clientData.name_);
+        return;
+    }
+
+    for (const auto& changeEvent : changeEventList.changeEventList_) {
+        addLobbyEvent(changeEvent);
+    }
+
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    packetStream.writeUint32(NETWORKPACKET_CHANGEEVENTLIST);
+    changeEventList.save(packetStream);
+
+    // the sender has already applied the change locally
+    sendPacketToAllClients(packetStream, 0, clientData.pPeer_);
+}
+
+void RelayServer::relayPacket(const ClientData& clientData, const ENetPacket* packet, enet_uint8 channel) {
+    if (clients_.size() < 2)
+        return;
+
+    ENetPacketOStream packetStream(packet->flags & (ENET_PACKET_FLAG_RELIABLE | ENET_PACKET_FLAG_UNSEQUENCED));
+    packetStream.writeUint32(NETWORKPACKET_RELAYED);
+    packetStream.writeString(clientData.name_);
+    packetStream.writeString(
+        std::string_view{reinterpret_cast<const char*>(packet->data), static_cast<size_t>(packet->dataLength)});
+
+    sendPacketToAllClients(packetStream, channel, clientData.pPeer_);
+}
+
+void RelayServer::addLobbyEvent(const ChangeEventList::ChangeEvent& changeEvent) {
+    // Only the latest setting per slot matters for players joining later.
+    std::erase_if(lobbyEvents_, [&](const auto& e) { return isSamePlayerSetting(e, changeEvent); });
+
+    lobbyEvents_.push_back(changeEvent);
+}
+
+bool RelayServer::isValidSlot(const ChangeEventList::ChangeEvent& changeEvent) const noexcept {
+    using EventType = ChangeEventList::ChangeEvent::EventType;
+
+    const auto numHouses = static_cast<uint32_t>(playerSlots_.numHouses);
+
+    switch (changeEvent.eventType_) {
+        case EventType::ChangeHouse:
+        case EventType::ChangeTeam: return changeEvent.slot_ < numHouses;
+
+        // every house has two player slots; the second one is closed without multiple players per house
+        case EventType::ChangePlayer:
+        case EventType::SetHumanPlayer: return changeEvent.slot_ < 2 * numHouses;
+
+        default: return false;
+    }
+}
+
+int RelayServer::findFreeSlot() const {
+    // Fill the first player of every house before putting a second player into a house.
+    const auto bMultiplePlayersPerHouse = playerSlots_.multiplePlayersPerHouse;
+    const auto numHouses                = bMultiplePlayersPerHouse ? (maxPlayers_ + 1) / 2 : maxPlayers_;
+
+    for (auto i = 0; i < maxPlayers_; ++i) {
+        const auto slot = i < numHouses ? 2 * i : 2 * (i - numHouses) + 1;
+
+        const auto bUsed = std::ranges::any_of(
+            clients_, [slot](const ENetPeer* p) { return static_cast<const ClientData*>(p->data)->slot_ == slot; });
+
+        if (!bUsed)
+            return slot;
+    }
+
+    return -1;
+}
+
+void RelayServer::sendPeerList() {
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    packetStream.writeUint32(NETWORKPACKET_RELAYPEERS);
+    packetStream.writeUint32(static_cast<uint32_t>(clients_.size()));
+    for (const auto* const pPeer : clients_) {
+        packetStream.writeString(static_cast<const ClientData*>(pPeer->data)->name_);
+    }
+
+    sendPacketToAllClients(packetStream);
+}
+
+void RelayServer::startGameIfReady() {
+    if (bGameStarted_ || getNumPlayers() < maxPlayers_)
+        return;
+
+    // players that are still downloading the game data could not start in time
+    const auto bAllHaveGameData = std::ranges::all_of(
+        clients_, [](const ENetPeer* p) { return static_cast<const ClientData*>(p->data)->bHasGameData_; });
+
+    if (bAllHaveGameData)
+        sendStartGame();
+}
+
+void RelayServer::sendStartGame() {
+    debugNetwork("RelayServer({}): All {} players joined. Starting game.", getPort(), getNumPlayers());
+
+    bGameStarted_ = true;
+
+    const auto timeLeft = dune::as_milliseconds(RELAY_START_GAME_DELAY);
+
+    for (auto* const pPeer : clients_) {
+        ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+        packetStream.writeUint32(NETWORKPACKET_STARTGAME);
+        packetStream.writeUint32(static_cast<uint32_t>(timeLeft) - pPeer->roundTripTime / 2);
+
+        sendPacketToPeer(pPeer, packetStream);
+    }
+}
+
+void RelayServer::sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetStream, enet_uint8 channel) {
+    ENetPacket* enetPacket = packetStream.getPacket();
+
+    if (enet_peer_send(peer, channel, enetPacket) < 0) {
+        sdl2::log_info("RelayServer: Cannot send packet!");
+    }
+
+    if (enetPacket->referenceCount == 0) {
+        enet_packet_destroy(enetPacket);
+    }
+}
+
+void RelayServer::sendPacketToAllClients(ENetPacketOStream& packetStream, enet_uint8 channel,
+                                         const ENetPeer* pExcept) {
+    ENetPacket* enetPacket = packetStream.getPacket();
+
+    for (auto* const pPeer : clients_) {
+        if (pPeer == pExcept)
+            continue;
+
+        if (enet_peer_send(pPeer, channel, enetPacket) < 0) {
+            sdl2::log_info("RelayServer: Cannot send packet!");
+        }
+    }
+
+    if (enetPacket->referenceCount == 0) {
+        enet_packet_destroy(enetPacket);
+    }
+}
@@ -1,7 +1,10 @@
 add_sources(NETWORK_SOURCES
 	ChangeEventList.cpp
 	ENetHttp.cpp
+	ENetPacketOStream.cpp
+	GameDataTransfer.cpp
 	LANGameFinderAndAnnouncer.cpp
 	MetaServerClient.cpp
 	NetworkManager.cpp
+	RelayServer.cpp
 )
@@ -82,8 +82,6 @@ void RadarView::draw(Point position) {
 
             updateRadarSurface(scale, offsetX, offsetY);
 
-            SDL_UpdateTexture(radarTexture.get(), nullptr, radarSurface->pixels, radarSurface->pitch);
-
             const SDL_Rect dest = calcDrawingRect(radarTexture.get(), radarPosition.x, radarPosition.y);
             Dune_RenderCopy(renderer, radarTexture.get(), nullptr, &dest);
 
@@ -201,36 +199,31 @@ void RadarView::switchRadarMode(bool bOn) {
     }
 }
 
-void RadarView::updateRadarSurface(int scale, int offsetX, int offsetY) const {
-
-    // Lock radarSurface for direct access to the pixels
-    sdl2::surface_lock lock{radarSurface.get()};
-
-    auto* map              = dune::globals::currentGameMap;
+void RadarView::updateRadarSurface(int scale, int offsetX, int offsetY) {
+    auto* const map        = dune::globals::currentGameMap;
     const auto* const game = dune::globals::currentGame.get();
     auto* const house      = dune::globals::pLocalHouse;
+    const auto debug       = dune::globals::debug;
 
     const auto radar_on = currentRadarMode == RadarMode::RadarOn || currentRadarMode == RadarMode::AnimationRadarOff;
 
-    const auto pitch = static_cast<ptrdiff_t>(radarSurface->pitch);
-
-    auto* const RESTRICT pixels = static_cast<uint8_t*>(radarSurface->pixels) + offsetY * pitch;
-
-    map->for_all([&](Tile& t) {
-        auto color = t.getRadarColor(game, house, radar_on);
-        color      = MapRGBA(radarSurface->format, color);
+    auto& changes = map->collectRadarChanges(game->getGameCycleCount());
 
-        auto* const RESTRICT out = pixels + pitch * scale * t.getLocation().y;
+    // these change the color of every tile
+    if (map != drawnMap_ || house != drawnHouse_ || radar_on != drawnRadarOn_ || debug != drawnDebug_) {
+        changes.markAll();
 
-        const auto offset = offsetX + scale * t.getLocation().x;
+        drawnMap_     = map;
+        drawnHouse_   = house;
+        drawnRadarOn_ = radar_on;
+        drawnDebug_   = debug;
+    }
 
-        for (auto j = 0; j < scale; j++) {
-            auto* p = reinterpret_cast<uint32_t*>(out + j * pitch) + offset;
+    const auto* const format = radarSurface->format;
 
-            for (auto i = 0; i < scale; ++i, ++p) {
-                // Do not use putPixel here to avoid overhead
-                *p = color;
-            }
-        }
+    updateRadarTiles(radarSurface.get(), radarTexture.get(), changes, scale, offsetX, offsetY, [&](int x, int y) {
+        return MapRGBA(format, map->getTile(x, y)->getRadarColor(game, house, radar_on));
     });
+
+    changes.clear();
 }
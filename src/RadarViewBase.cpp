@@ -109,3 +109,22 @@ bool RadarViewBase::handleMouseRight(int32_t x, int32_t y, bool pressed) {
     bRadarInteraction = false;
     return false;
 }
+
+void RadarViewBase::uploadRadarChanges(SDL_Surface* surface, SDL_Texture* texture, const dune::DirtyTiles& changes,
+                                       int scale, int offsetX, int offsetY) {
+    if (changes.isAll()) {
+        SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch);
+        return;
+    }
+
+    const auto pitch = static_cast<ptrdiff_t>(surface->pitch);
+    const auto bpp   = static_cast<ptrdiff_t>(surface->format->BytesPerPixel);
+
+    changes.for_each_rect([&](const SDL_Rect& tiles) {
+        const SDL_Rect rect{offsetX + tiles.x * scale, offsetY + tiles.y * scale, tiles.w * scale, tiles.h * scale};
+
+        const auto* const pixels = static_cast<const uint8_t*>(surface->pixels) + rect.y * pitch + rect.x * bpp;
+
+        SDL_UpdateTexture(texture, &rect, pixels, surface->pitch);
+    });
+}
@@ -0,0 +1,136 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Renderer/DuneRenderStats.h>
+
+#include <misc/SDL2pp.h>
+
+#include <fmt/format.h>
+
+#include <string>
+
+namespace dune {
+
+namespace {
+sdl2::RWops_ptr dumpFile;
+uint32_t dumpFrame = 0;
+
+void writeDump(const RenderFrameStats& frame) {
+    std::string lines;
+
+    for (auto i = 0u; i < NUM_RENDER_LAYERS; ++i) {
+        const auto& stats = frame[i];
+
+        fmt::format_to(std::back_inserter(lines), "{},{},{},{},{},{},{}\n", dumpFrame,
+                       to_string(static_cast<RenderLayer>(i)), stats.copies, stats.draw_calls, stats.texture_switches,
+                       stats.state_changes, stats.pixels);
+    }
+
+    if (1 != SDL_RWwrite(dumpFile.get(), lines.data(), lines.size(), 1)) {
+        sdl2::log_error("Writing the render statistics failed: {}", SDL_GetError());
+        dumpFile.reset();
+    }
+
+    ++dumpFrame;
+}
+} // namespace
+
+std::string_view to_string(RenderLayer layer) noexcept {
+    switch (layer) {
+        case RenderLayer::Ground: return "ground";
+        case RenderLayer::Structures: return "structures";
+        case RenderLayer::Units: return "units";
+        case RenderLayer::Bullets: return "bullets";
+        case RenderLayer::Fog: return "fog";
+        case RenderLayer::GUI: return "gui";
+        default: return "unknown";
+    }
+}
+
+void RenderStats::enable(bool enable) {
+    enabled_ = enable || dumpFile != nullptr;
+    texture_ = nullptr;
+
+    current_ = {};
+    last_    = {};
+}
+
+void RenderStats::countCopyImpl(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_FRect* dest, bool batched) {
+    auto& stats = current_[static_cast<size_t>(layer_)];
+
+    ++stats.copies;
+
+    if (!batched)
+        ++stats.draw_calls;
+
+    if (texture != texture_) {
+        texture_ = texture;
+        ++stats.texture_switches;
+    }
+
+    if (dest) {
+        stats.pixels += static_cast<int64_t>(dest->w * dest->h);
+    } else {
+        SDL_Rect viewport;
+        SDL_RenderGetViewport(renderer, &viewport);
+
+        stats.pixels += static_cast<int64_t>(viewport.w) * viewport.h;
+    }
+}
+
+void RenderStats::endFrame() {
+    if (!enabled_)
+        return;
+
+    last_    = current_;
+    current_ = {};
+    texture_ = nullptr;
+
+    if (dumpFile)
+        writeDump(last_);
+}
+
+bool RenderStats::startDump(const std::filesystem::path& path) {
+    dumpFile = sdl2::RWops_ptr{SDL_RWFromFile(reinterpret_cast<const char*>(path.u8string().c_str()), "wb")};
+    if (!dumpFile) {
+        sdl2::log_error("Unable to open {} for the render statistics: {}", path.string(), SDL_GetError());
+        return false;
+    }
+
+    static constexpr std::string_view header = "frame,layer,copies,draw_calls,texture_switches,state_changes,pixels\n";
+    if (1 != SDL_RWwrite(dumpFile.get(), header.data(), header.size(), 1)) {
+        sdl2::log_error("Writing the render statistics failed: {}", SDL_GetError());
+        dumpFile.reset();
+        return false;
+    }
+
+    dumpFrame = 0;
+
+    enable(true);
+
+    return true;
+}
+
+void RenderStats::stopDump() {
+    dumpFile.reset();
+}
+
+bool RenderStats::dumping() noexcept {
+    return dumpFile != nullptr;
+}
+
+} // namespace dune
@@ -24,8 +24,11 @@
 
 #include <SDL2/SDL_render.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <optional>
+#include <vector>
 
 void DuneDrawSelectionBox(SDL_Renderer* renderer, float x, float y, float w, float h, uint32_t color) {
     setRenderDrawColor(renderer, color);
@@ -63,33 +66,156 @@ void DuneDrawSelectionBox(SDL_Renderer* renderer, float x, float y, float w, flo
     }
 }
 
+namespace {
+std::optional<SDL_Rect> frame_clip; ///< the part of the screen that is drawn to in this frame (see dune::setFrameClip)
+} // namespace
+
 namespace dune {
 
+void setFrameClip(SDL_Renderer* renderer, const SDL_Rect* clip) {
+    flush_sprites();
+
+    if (clip)
+        frame_clip = *clip;
+    else
+        frame_clip.reset();
+
+    SDL_RenderSetClipRect(renderer, clip);
+}
+
 RenderClip::RenderClip(SDL_Renderer* renderer, const SDL_Rect& clip)
     : was_clipping_{SDL_RenderIsClipEnabled(renderer)}, renderer_{renderer} {
 
+    flush_sprites();
+
     if (was_clipping_)
         SDL_RenderGetClipRect(renderer, &old_clip);
 
-    SDL_RenderSetClipRect(renderer, &clip);
+    Dune_RenderSetClipRect(renderer, &clip);
 }
 
 RenderClip::~RenderClip() {
+    flush_sprites();
+
     if (was_clipping_)
-        SDL_RenderSetClipRect(renderer_, &old_clip);
+        Dune_RenderSetClipRect(renderer_, &old_clip);
     else
-        SDL_RenderSetClipRect(renderer_, nullptr);
+        Dune_RenderSetClipRect(renderer_, nullptr);
 }
 
 } // namespace dune
 
+int Dune_RenderSetClipRect(SDL_Renderer* renderer, const SDL_Rect* rect) {
+    dune::flush_sprites();
+
+    // render targets (e.g. the map chunk caches) are not restricted by the frame clip
+    if (!frame_clip || SDL_GetRenderTarget(renderer))
+        return SDL_RenderSetClipRect(renderer, rect);
+
+    if (!rect)
+        return SDL_RenderSetClipRect(renderer, &*frame_clip);
+
+    SDL_Rect clip;
+    if (!SDL_IntersectRect(rect, &*frame_clip, &clip))
+        clip = {frame_clip->x, frame_clip->y, 0, 0};
+
+    return SDL_RenderSetClipRect(renderer, &clip);
+}
+
+bool Dune_RenderIsSoftware(SDL_Renderer* renderer) {
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info))
+        return false;
+
+    return (info.flags & SDL_RENDERER_SOFTWARE) != 0;
+}
+
+void Dune_RenderPresentRects(SDL_Renderer* renderer, std::span<const SDL_Rect> rects) {
+    auto* const window = SDL_RenderGetWindow(renderer);
+    if (!window || !Dune_RenderIsSoftware(renderer)) {
+        Dune_RenderPresent(renderer);
+        return;
+    }
+
+    DuneRendererImplementation::endFrame();
+
+    // map the logical render coordinates to pixels of the window surface
+    SDL_Rect viewport;
+    SDL_RenderGetViewport(renderer, &viewport);
+
+    auto scaleX = 1.f;
+    auto scaleY = 1.f;
+    SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+
+    auto width  = 0;
+    auto height = 0;
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+
+    std::vector<SDL_Rect> pixels;
+    pixels.reserve(rects.size());
+
+    for (const auto& rect : rects) {
+        const auto x1 = std::max(0, static_cast<int>(std::floor(static_cast<float>(viewport.x + rect.x) * scaleX)));
+        const auto y1 = std::max(0, static_cast<int>(std::floor(static_cast<float>(viewport.y + rect.y) * scaleY)));
+        const auto x2 =
+            std::min(width, static_cast<int>(std::ceil(static_cast<float>(viewport.x + rect.x + rect.w) * scaleX)));
+        const auto y2 =
+            std::min(height, static_cast<int>(std::ceil(static_cast<float>(viewport.y + rect.y + rect.h) * scaleY)));
+
+        if (rect.w > 0 && rect.h > 0 && x2 > x1 && y2 > y1)
+            pixels.push_back({x1, y1, x2 - x1, y2 - y1});
+    }
+
+    // SDL_RenderPresent() would copy the whole window surface to the window
+    if (!pixels.empty()) {
+        if (SDL_RenderFlush(renderer)
+            || SDL_UpdateWindowSurfaceRects(window, pixels.data(), static_cast<int>(pixels.size()))) {
+            sdl2::log_error("Unable to present the changed parts of the screen: {}", SDL_GetError());
+
+            SDL_RenderPresent(renderer);
+        }
+    }
+
+    dune::destroy_textures();
+}
+
+namespace {
+/**
+    Returns the active sprite batch if it collects the sprites drawn to renderer. Otherwise the sprites collected so far
+    are submitted as something is drawn immediately.
+*/
+dune::SpriteBatch* batch_for(SDL_Renderer* renderer) {
+    auto* const batch = dune::SpriteBatch::active();
+    if (batch && batch->renderer() == renderer)
+        return batch;
+
+    dune::flush_sprites();
+
+    return nullptr;
+}
+
+/// The part of texture that is drawn if srcrect (relative to the texture) is requested
+SDL_Rect atlas_source(const DuneTexture* texture, const SDL_Rect* srcrect) {
+    if (!srcrect)
+        return texture->source_rect();
+
+    assert(srcrect->x >= 0 && srcrect->y >= 0 && srcrect->w > 0 && srcrect->h > 0);
+    assert(srcrect->x + srcrect->w <= texture->source_.w);
+    assert(srcrect->y + srcrect->h <= texture->source_.h);
+
+    return {texture->source_.x + srcrect->x, texture->source_.y + srcrect->y, srcrect->w, srcrect->h};
+}
+} // namespace
+
 int Dune_RenderCopyEx(SDL_Renderer* renderer, const DuneTexture* texture, const SDL_Rect* srcrect,
                       const SDL_Rect* dstrect, const double angle, const SDL_Point* center,
                       const SDL_RendererFlip flip) {
+    dune::flush_sprites();
+
     assert(texture && texture->texture_);
     assert(texture->source_.x >= 0 && texture->source_.y >= 0 && texture->source_.w > 0 && texture->source_.h > 0);
 
-    DuneRendererImplementation::countRenderCopy(texture->texture_);
+    DuneRendererImplementation::countRenderCopy(renderer, texture->texture_, dstrect);
 
     if (srcrect) {
         assert(srcrect->x >= 0 && srcrect->y >= 0 && srcrect->w > 0 && srcrect->h > 0);
@@ -108,10 +234,12 @@ int Dune_RenderCopyEx(SDL_Renderer* renderer, const DuneTexture* texture, const
 int Dune_RenderCopyExF(SDL_Renderer* renderer, const DuneTexture* texture, const SDL_Rect* srcrect,
                        const SDL_FRect* dstrect, const double angle, const SDL_FPoint* center,
                        const SDL_RendererFlip flip) {
+    dune::flush_sprites();
+
     assert(texture && texture->texture_);
     assert(texture->source_.x >= 0 && texture->source_.y >= 0 && texture->source_.w > 0 && texture->source_.h > 0);
 
-    DuneRendererImplementation::countRenderCopy(texture->texture_);
+    DuneRendererImplementation::countRenderCopy(renderer, texture->texture_, dstrect);
 
     if (srcrect) {
         assert(srcrect->x >= 0 && srcrect->y >= 0 && srcrect->w > 0 && srcrect->h > 0);
@@ -132,7 +260,18 @@ void Dune_RenderCopy(SDL_Renderer* renderer, const DuneTexture* texture, const S
     assert(texture && texture->texture_);
     assert(texture->source_.x >= 0 && texture->source_.y >= 0 && texture->source_.w > 0 && texture->source_.h > 0);
 
-    DuneRendererImplementation::countRenderCopy(texture->texture_);
+    if (dstrect) {
+        if (auto* const batch = batch_for(renderer)) {
+            const SDL_FRect dest{static_cast<float>(dstrect->x), static_cast<float>(dstrect->y),
+                                 static_cast<float>(dstrect->w), static_cast<float>(dstrect->h)};
+            batch->add(texture->texture_, atlas_source(texture, srcrect), dest);
+            return;
+        }
+    } else {
+        dune::flush_sprites();
+    }
+
+    DuneRendererImplementation::countRenderCopy(renderer, texture->texture_, dstrect);
 
     if (srcrect) {
         assert(srcrect->x >= 0 && srcrect->y >= 0 && srcrect->w > 0 && srcrect->h > 0);
@@ -155,7 +294,16 @@ void Dune_RenderCopyF(SDL_Renderer* renderer, const DuneTexture* texture, const
     assert(texture && texture->texture_);
     assert(texture->source_.x >= 0 && texture->source_.y >= 0 && texture->source_.w > 0 && texture->source_.h > 0);
 
-    DuneRendererImplementation::countRenderCopy(texture->texture_);
+    if (dstrect) {
+        if (auto* const batch = batch_for(renderer)) {
+            batch->add(texture->texture_, atlas_source(texture, srcrect), *dstrect);
+            return;
+        }
+    } else {
+        dune::flush_sprites();
+    }
+
+    DuneRendererImplementation::countRenderCopy(renderer, texture->texture_, dstrect);
 
     if (srcrect) {
         assert(srcrect->x >= 0 && srcrect->y >= 0 && srcrect->w > 0 && srcrect->h > 0);
@@ -173,21 +321,37 @@ void Dune_RenderCopyF(SDL_Renderer* renderer, const DuneTexture* texture, const
     }
 }
 
+void Dune_RenderCopyF(SDL_Renderer* renderer, const DuneTexture* texture, const SDL_Rect* srcrect,
+                      const SDL_FRect* dstrect, uint8_t alpha) {
+    assert(texture && texture->texture_ && dstrect);
+
+    if (auto* const batch = batch_for(renderer)) {
+        batch->add(texture->texture_, atlas_source(texture, srcrect), *dstrect, alpha);
+        return;
+    }
+
+    Dune_SetTextureAlphaMod(texture->texture_, alpha);
+    Dune_RenderCopyF(renderer, texture, srcrect, dstrect);
+    Dune_SetTextureAlphaMod(texture->texture_, 255);
+}
+
 void Dune_RenderCopy(SDL_Renderer* renderer, SDL_Texture* texture, int x, int y) {
-    DuneRendererImplementation::countRenderCopy(texture);
+    dune::flush_sprites();
 
     int w{}, h{};
     SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
 
     const SDL_FRect dest{static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)};
 
+    DuneRendererImplementation::countRenderCopy(renderer, texture, &dest);
+
     if (0 != SDL_RenderCopyF(renderer, texture, nullptr, &dest))
         sdl2::log_error("RenderCopyF failed: {}", SDL_GetError());
 }
 
 #if _DEBUG
 
-void DuneRendererImplementation::countRenderCopy(SDL_Texture* texture) {
+void DuneRendererImplementation::countRenderTexture(SDL_Texture* texture) {
     if (render_texture != texture) {
         render_texture = texture;
         ++render_texture_changes;
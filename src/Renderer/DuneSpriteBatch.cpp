@@ -0,0 +1,129 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Renderer/DuneSpriteBatch.h>
+
+#include <Renderer/DuneRenderStats.h>
+#include <misc/SDL2pp.h>
+
+#include <cassert>
+
+namespace dune {
+
+SpriteBatch::SpriteBatch() = default;
+
+SpriteBatch::~SpriteBatch() {
+    if (active_ == this)
+        end();
+}
+
+void SpriteBatch::begin(SDL_Renderer* renderer) {
+    assert(renderer_ == nullptr && "SpriteBatch::begin() called twice");
+
+    flush_sprites();
+
+    renderer_ = renderer;
+    previous_ = active_;
+    active_   = this;
+}
+
+void SpriteBatch::end() {
+    assert(active_ == this && "SpriteBatch::end() called for an inactive batch");
+
+    flush();
+
+    active_   = previous_;
+    previous_ = nullptr;
+    renderer_ = nullptr;
+}
+
+void SpriteBatch::add(SDL_Texture* texture, const SDL_Rect& source, const SDL_FRect& dest, uint8_t alpha) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    RenderStats::countCopy(renderer_, texture, &dest, true);
+
+    if (texture != texture_) {
+        flush();
+
+        int w = 0, h = 0;
+        if (0 != SDL_QueryTexture(texture, nullptr, nullptr, &w, &h) || w <= 0 || h <= 0) {
+            sdl2::log_error("SpriteBatch::add(): SDL_QueryTexture failed: {}", SDL_GetError());
+            return;
+        }
+
+        texture_ = texture;
+        scaleX_  = 1.f / static_cast<float>(w);
+        scaleY_  = 1.f / static_cast<float>(h);
+    }
+
+    const SDL_Color color{255, 255, 255, alpha};
+
+    const auto u1 = static_cast<float>(source.x) * scaleX_;
+    const auto v1 = static_cast<float>(source.y) * scaleY_;
+    const auto u2 = static_cast<float>(source.x + source.w) * scaleX_;
+    const auto v2 = static_cast<float>(source.y + source.h) * scaleY_;
+
+    const auto x2 = dest.x + dest.w;
+    const auto y2 = dest.y + dest.h;
+
+    vertices_.push_back({{dest.x, dest.y}, color, {u1, v1}});
+    vertices_.push_back({{x2, dest.y}, color, {u2, v1}});
+    vertices_.push_back({{dest.x, y2}, color, {u1, v2}});
+    vertices_.push_back({{x2, y2}, color, {u2, v2}});
+#else
+    // without SDL_RenderGeometry() every sprite is drawn on its own
+    RenderStats::countCopy(renderer_, texture, &dest);
+
+    if (alpha != 255) {
+        RenderStats::countStateChange();
+        SDL_SetTextureAlphaMod(texture, alpha);
+    }
+
+    if (0 != SDL_RenderCopyF(renderer_, texture, &source, &dest))
+        sdl2::log_error("SpriteBatch::add(): SDL_RenderCopyF failed: {}", SDL_GetError());
+
+    if (alpha != 255)
+        SDL_SetTextureAlphaMod(texture, 255);
+#endif
+}
+
+void SpriteBatch::flush() {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (vertices_.empty())
+        return;
+
+    const auto quads = static_cast<int>(vertices_.size() / 4);
+
+    // the two triangles of a quad are (0, 1, 2) and (2, 1, 3)
+    for (auto quad = static_cast<int>(indices_.size() / 6); quad < quads; ++quad) {
+        const auto first = 4 * quad;
+
+        indices_.insert(indices_.end(), {first, first + 1, first + 2, first + 2, first + 1, first + 3});
+    }
+
+    const auto result = SDL_RenderGeometry(renderer_, texture_, vertices_.data(), static_cast<int>(vertices_.size()),
+                                           indices_.data(), 6 * quads);
+    if (0 != result)
+        sdl2::log_error("SpriteBatch::flush(): SDL_RenderGeometry failed: {}", SDL_GetError());
+
+    RenderStats::countDrawCall();
+
+    vertices_.clear();
+#endif
+    texture_ = nullptr;
+}
+
+} // namespace dune
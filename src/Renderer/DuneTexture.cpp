@@ -50,18 +50,23 @@ void DuneTexture::reset() {
 }
 
 void DuneTexture::draw(SDL_Renderer* renderer, float x, float y) const noexcept {
-    DuneRendererImplementation::countRenderCopy(texture_);
-
     const auto src = source_.as_sdl();
     const SDL_FRect dst{x, y, width_, height_};
 
+    if (auto* const batch = dune::SpriteBatch::active(); batch && batch->renderer() == renderer) {
+        batch->add(texture_, src, dst);
+        return;
+    }
+
+    dune::flush_sprites();
+
+    DuneRendererImplementation::countRenderCopy(renderer, texture_, &dst);
+
     if (SDL_RenderCopyF(renderer, texture_, &src, &dst))
         sdl2::log_error("DuneTexture::draw() SDL_RenderCopyF failed: {}", SDL_GetError());
 }
 
 void DuneTexture::draw(SDL_Renderer* renderer, float x, float y, const SDL_Rect& source) const noexcept {
-    DuneRendererImplementation::countRenderCopy(texture_);
-
     if (source.x < 0 || source.y < 0 || source.w < 1 || source.h < 1) {
         sdl2::log_error("DuneTexture::draw() The source rectangle is invalid ({}x{} at {}x{})", source.w, source.h,
                         source.x, source.y);
@@ -76,16 +81,27 @@ void DuneTexture::draw(SDL_Renderer* renderer, float x, float y, const SDL_Rect&
         return;
     }
 
+    if (auto* const batch = dune::SpriteBatch::active(); batch && batch->renderer() == renderer) {
+        batch->add(texture_, src, dst);
+        return;
+    }
+
+    dune::flush_sprites();
+
+    DuneRendererImplementation::countRenderCopy(renderer, texture_, &dst);
+
     if (SDL_RenderCopyF(renderer, texture_, &src, &dst))
         sdl2::log_error("DuneTexture::draw() SDL_RenderCopyF failed: {}", SDL_GetError());
 }
 
 void DuneTexture::draw(SDL_Renderer* renderer, float x, float y, double angle) const noexcept {
-    DuneRendererImplementation::countRenderCopy(texture_);
+    dune::flush_sprites();
 
     const auto src = source_.as_sdl();
     const SDL_FRect dst{x, y, width_, height_};
 
+    DuneRendererImplementation::countRenderCopy(renderer, texture_, &dst);
+
     if (SDL_RenderCopyExF(renderer, texture_, &src, &dst, angle, nullptr, SDL_RendererFlip::SDL_FLIP_NONE))
         sdl2::log_error("DuneTexture::draw() SDL_RenderCopyExF failed: {}", SDL_GetError());
 }
@@ -124,8 +140,12 @@ void DuneTextureOwned::reset() {
 }
 
 void DuneTextureOwned::draw(SDL_Renderer* renderer, float x, float y) const noexcept {
+    dune::flush_sprites();
+
     const SDL_FRect dst{x, y, width_, height_};
 
+    DuneRendererImplementation::countRenderCopy(renderer, texture_.get(), &dst);
+
     if (SDL_RenderCopyF(renderer, texture_.get(), nullptr, &dst))
         sdl2::log_error("DuneTextureOwned::draw() SDL_RenderCopyF failed: {}", SDL_GetError());
 }
@@ -17,13 +17,19 @@
 
 #include <Renderer/DuneTextures.h>
 
+#include <globals.h>
+
 #include <FileClasses/SurfaceLoader.h>
 #include <GUI/ObjectInterfaces/PalaceInterface.h>
+#include <Renderer/TextureAtlasCache.h>
+#include <misc/draw_util.h>
 #include <rectpack2D/finders_interface.h>
 
 // #include "FileClasses/SaveTextureAsBmp.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <optional>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
@@ -38,8 +44,10 @@ DuneTextures::DuneTextures(std::vector<sdl2::texture_ptr>&& textures, object_pic
                            small_details_type&& small_details, tiny_pictures_type&& tiny_pictures,
                            ui_graphics_type&& ui_graphics, map_choice_type&& map_choice,
                            generated_type&& generated_pictures,
-                 decoration_border_type&& decoration_border, border_style_type&& border_style)
-    : object_pictures_{object_pictures}, small_details_{small_details}, tiny_pictures_{tiny_pictures},
+                 decoration_border_type&& decoration_border, border_style_type&& border_style,
+                 remap_sources_type&& remap_sources, std::unique_ptr<StreamingAtlas>&& streaming_atlas)
+    : remap_sources_{std::move(remap_sources)}, object_pictures_{object_pictures},
+      streaming_atlas_{std::move(streaming_atlas)}, small_details_{small_details}, tiny_pictures_{tiny_pictures},
       ui_graphics_{ui_graphics}, map_choice_{map_choice}, generated_pictures_{generated_pictures},
       decoration_border_{decoration_border}, border_style_{std::move(border_style)},
       textures_{std::move(textures)} { }
@@ -140,6 +148,68 @@ bool compare_surfaces(SDL_Surface* a, SDL_Surface* b) {
     return true;
 }
 
+sdl2::texture_ptr create_atlas_texture(SDL_Renderer* renderer, SDL_Surface* atlas_surface) {
+    auto texture = sdl2::texture_ptr{SDL_CreateTextureFromSurface(renderer, atlas_surface)};
+
+    if (texture && SDL_SetTextureBlendMode(texture.get(), SDL_BlendMode::SDL_BLENDMODE_BLEND)) {
+        sdl2::log_warn("Unable to set texture atlas blend mode");
+    }
+
+    return texture;
+}
+
+/// Draws the surface to atlas_rect and copies its edge pixels to the guard around it
+bool draw_with_guard(SDL_Surface* surface, SDL_Surface* atlas_surface, SDL_Rect atlas_rect, uint32_t format) {
+    if (!drawSurface(surface, nullptr, atlas_surface, &atlas_rect)) {
+        // Retry after converting from palette to 32-bit surface...
+        const sdl2::surface_ptr copy{SDL_ConvertSurfaceFormat(surface, format, 0)};
+
+        if (!copy) {
+            sdl2::log_warn("Unable to copy surface: {}", SDL_GetError());
+            return false;
+        }
+
+        if (!drawSurface(copy.get(), nullptr, atlas_surface, &atlas_rect)) {
+            sdl2::log_warn("Unable to draw object");
+            return false;
+        }
+    }
+
+    // Copy the edge pixels to the guard.
+
+    { // Top
+        const SDL_Rect src{0, 0, surface->w, 1};
+        SDL_Rect dst{atlas_rect.x, atlas_rect.y - 1, src.w, 1};
+
+        drawSurface(surface, &src, atlas_surface, &dst);
+    }
+
+    { // Left
+        const SDL_Rect src{0, 0, 1, surface->h};
+        SDL_Rect dst{atlas_rect.x - 1, atlas_rect.y, 1, src.h};
+
+        drawSurface(surface, &src, atlas_surface, &dst);
+    }
+
+    { // Bottom
+        const SDL_Rect src{0, surface->h - 1, surface->w, 1};
+        SDL_Rect dst{atlas_rect.x, atlas_rect.y + surface->h, src.w, 1};
+
+        drawSurface(surface, &src, atlas_surface, &dst);
+    }
+
+    { // Right
+        const SDL_Rect src{surface->w - 1, 0, 1, surface->h};
+        SDL_Rect dst{atlas_rect.x + surface->w, atlas_rect.y, 1, src.h};
+
+        drawSurface(surface, &src, atlas_surface, &dst);
+    }
+
+    // Fill in the corners
+
+    return true;
+}
+
 class Packer final {
     std::vector<rect_type> rectangles_;
 
@@ -321,60 +391,13 @@ public:
         if (!packer_.pack(max_side))
             return nullptr;
 
-        const sdl2::surface_ptr atlas_surface{
+        sdl2::surface_ptr atlas_surface{
             SDL_CreateRGBSurfaceWithFormat(0, packer_.width(), packer_.height(), SDL_BITSPERPIXEL(format), format)};
 
         const auto draw = [&](const auto& r, [[maybe_unused]] int s_idx, SDL_Surface* surface) {
-            SDL_Rect atlas_rect{r.x + guard, r.y + guard, r.w - 2 * guard, r.h - 2 * guard};
-
-            if (!drawSurface(surface, nullptr, atlas_surface.get(), &atlas_rect)) {
-                // Retry after converting from palette to 32-bit surface...
-                const sdl2::surface_ptr copy{SDL_ConvertSurfaceFormat(surface, format, 0)};
+            const SDL_Rect atlas_rect{r.x + guard, r.y + guard, r.w - 2 * guard, r.h - 2 * guard};
 
-                if (!copy) {
-                    sdl2::log_warn("Unable to copy surface: {}", SDL_GetError());
-                    return false;
-                }
-
-                if (!drawSurface(copy.get(), nullptr, atlas_surface.get(), &atlas_rect)) {
-                    sdl2::log_warn("Unable to draw object");
-                    return false;
-                }
-            }
-
-            // Copy the edge pixels to the guard.
-
-            { // Top
-                const SDL_Rect src{0, 0, surface->w, 1};
-                SDL_Rect dst{atlas_rect.x, atlas_rect.y - 1, src.w, 1};
-
-                drawSurface(surface, &src, atlas_surface.get(), &dst);
-            }
-
-            { // Left
-                const SDL_Rect src{0, 0, 1, surface->h};
-                SDL_Rect dst{atlas_rect.x - 1, atlas_rect.y, 1, src.h};
-
-                drawSurface(surface, &src, atlas_surface.get(), &dst);
-            }
-
-            { // Bottom
-                const SDL_Rect src{0, surface->h - 1, surface->w, 1};
-                SDL_Rect dst{atlas_rect.x, atlas_rect.y + surface->h, src.w, 1};
-
-                drawSurface(surface, &src, atlas_surface.get(), &dst);
-            }
-
-            { // Right
-                const SDL_Rect src{surface->w - 1, 0, 1, surface->h};
-                SDL_Rect dst{atlas_rect.x + surface->w, atlas_rect.y, 1, src.h};
-
-                drawSurface(surface, &src, atlas_surface.get(), &dst);
-            }
-
-            // Fill in the corners
-
-            return true;
+            return draw_with_guard(surface, atlas_surface.get(), atlas_rect, format);
         };
 
         for (const auto& set : surface_sets_) {
@@ -388,15 +411,16 @@ public:
 
         // SDL_SaveBMP(atlas_surface.get(), path.u8string().c_str());
 
-        auto texture = sdl2::texture_ptr{SDL_CreateTextureFromSurface(renderer, atlas_surface.get())};
+        auto texture = create_atlas_texture(renderer, atlas_surface.get());
 
-        if (texture && SDL_SetTextureBlendMode(texture.get(), SDL_BlendMode::SDL_BLENDMODE_BLEND)) {
-            sdl2::log_warn("Unable to set texture atlas blend mode");
-        }
+        atlas_surface_ = std::move(atlas_surface);
 
         return texture;
     }
 
+    /// returns the pixels of the atlas created by the last call to pack()
+    sdl2::surface_ptr release_atlas_surface() { return std::move(atlas_surface_); }
+
     template<typename Identifier, typename Lookup>
     void update(int key, SDL_Texture* texture, Lookup&& lookup) {
         static_assert(std::is_invocable_r_v<const DuneTexture&, Lookup, int>);
@@ -413,6 +437,7 @@ public:
     void clear() {
         packer_.clear();
         surface_sets_.clear();
+        atlas_surface_.reset();
     }
 
     [[nodiscard]] bool empty() const noexcept { return packer_.empty(); }
@@ -421,8 +446,38 @@ private:
     Packer packer_;
 
     std::vector<PackableSet> surface_sets_;
+
+    sdl2::surface_ptr atlas_surface_;
 };
 
+// There is only one kind of these items, stored in the Harkonnen slot.
+const std::unordered_set<uint32_t> harkonnen_only_object_pictures = {
+    ObjPic_ExplosionSmall,
+    ObjPic_ExplosionMedium1,
+    ObjPic_ExplosionMedium2,
+    ObjPic_ExplosionLarge1,
+    ObjPic_ExplosionLarge2,
+    ObjPic_ExplosionSmallUnit,
+    ObjPic_ExplosionFlames,
+    ObjPic_ExplosionSpiceBloom,
+    ObjPic_SandwormSegment,
+    ObjPic_Terrain,
+    ObjPic_DestroyedStructure,
+    ObjPic_RockDamage,
+    ObjPic_SandDamage,
+    ObjPic_Terrain_Hidden,
+    ObjPic_Terrain_HiddenFog,
+    ObjPic_Terrain_Tracks,
+    ObjPic_Star,
+    ObjPic_CarryallShadow,
+    ObjPic_FrigateShadow,
+    ObjPic_OrnithopterShadow,
+};
+
+/**
+    Packs the Harkonnen object pictures. The other houses are recolored on demand by DuneTextures, so a mission only
+    pays for the houses that actually appear in it.
+*/
 class ObjectPicturePacker final {
 public:
     using identifier_type = std::tuple<uint32_t, HOUSETYPE, int>;
@@ -434,33 +489,13 @@ public:
             if (id == ObjPic_Bullet_SonicTemp || id == ObjPic_SandwormShimmerTemp)
                 continue;
 
-            const auto harkonnen_only = harkonnen_only_.contains(id);
-
             for (auto zoom = 0; zoom < NUM_ZOOMLEVEL; ++zoom) {
-                SDL_Surface* harkonnen = nullptr;
-                auto harkonnen_key     = 0;
-
-                for_each_housetype([&](auto house) {
-                    const auto is_harkonnen = house == HOUSETYPE::HOUSE_HARKONNEN;
-
-                    if (harkonnen_only && !is_harkonnen)
-                        return;
-
-                    auto* const surface = surfaceLoader->getZoomedObjSurface(id, house, zoom);
+                auto* const surface = surfaceLoader->getZoomedObjSurface(id, zoom);
 
-                    if (!surface)
-                        return;
+                if (!surface)
+                    continue;
 
-                    if (is_harkonnen) {
-                        harkonnen     = surface;
-                        harkonnen_key = surfaces_.add({id, house, zoom}, surface);
-                    } else if (harkonnen && compare_surfaces(harkonnen, surface)) {
-                        // We are identical to the Harkonnen image, so let it find the Harkonnen version.
-                        surfaces_.add_duplicate(harkonnen_key, {id, house, zoom});
-                    } else {
-                        surfaces_.add({id, house, zoom}, surface);
-                    }
-                });
+                surfaces_.add({id, HOUSETYPE::HOUSE_HARKONNEN, zoom}, surface);
             }
         }
     }
@@ -474,14 +509,6 @@ public:
         factory23.update<identifier_type>(key, texture, [&](auto n) -> DuneTexture& { return lookup_dune_texture(n); });
     }
 
-    void update_duplicates() {
-        surfaces_.update_duplicates([&](const auto& identifier) -> DuneTexture& {
-            const auto& [id, house, zoom] = identifier;
-
-            return dune_textures_.at(zoom).at(id).at(static_cast<int>(house));
-        });
-    }
-
     [[nodiscard]] DuneTextures::object_pictures_type object_pictures2() const { return dune_textures_; }
 
 private:
@@ -496,30 +523,6 @@ private:
     PackableSurfaces<identifier_type> surfaces_;
 
     textures_type dune_textures_;
-
-    // There is only one kind of these items, stored in the Harkonnen slot.
-    static const std::unordered_set<uint32_t> harkonnen_only_;
-};
-
-// There is only one kind of these items, stored in the Harkonnen slot.
-const std::unordered_set<uint32_t> ObjectPicturePacker::harkonnen_only_ = {
-    ObjPic_ExplosionSmall,
-    ObjPic_ExplosionMedium1,
-    ObjPic_ExplosionMedium2,
-    ObjPic_ExplosionLarge1,
-    ObjPic_ExplosionLarge2,
-    ObjPic_ExplosionSmallUnit,
-    ObjPic_ExplosionFlames,
-    ObjPic_ExplosionSpiceBloom,
-    ObjPic_SandwormSegment,
-    ObjPic_Terrain,
-    ObjPic_DestroyedStructure,
-    ObjPic_RockDamage,
-    ObjPic_SandDamage,
-    ObjPic_Terrain_Hidden,
-    ObjPic_Terrain_HiddenFog,
-    ObjPic_Terrain_Tracks,
-    ObjPic_Star,
 };
 
 class UiGraphicPacker final {
@@ -871,7 +874,361 @@ private:
 
 } // namespace
 
-DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surfaceLoader) {
+/**
+    A texture atlas that grows while the game is running. Surfaces are placed on shelves of fixed size pages and
+    uploaded with SDL_UpdateTexture(); a new page is created once the last one is full.
+*/
+class StreamingAtlas final {
+public:
+    StreamingAtlas(SDL_Renderer* renderer, uint32_t format, int max_side)
+        : renderer_{renderer}, format_{format}, max_side_{max_side}, page_side_{std::min(max_side, 2048)} { }
+
+    /**
+        Copies a surface into the atlas.
+        \param  surface the surface to add
+        \return the texture of the surface
+    */
+    DuneTexture add(SDL_Surface* surface) {
+        const auto w = surface->w + 2 * guard;
+        const auto h = surface->h + 2 * guard;
+
+        const auto [texture, rect] = allocate(w, h);
+
+        const sdl2::surface_ptr pixels{SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(format_), format_)};
+
+        if (!pixels)
+            THROW(std::runtime_error, "StreamingAtlas: Unable to create a surface: {}", SDL_GetError());
+
+        if (!draw_with_guard(surface, pixels.get(), {guard, guard, surface->w, surface->h}, format_))
+            THROW(std::runtime_error, "StreamingAtlas: Unable to draw a {}x{} surface!", surface->w, surface->h);
+
+        { // Scope
+            const sdl2::surface_lock lock{pixels.get()};
+
+            if (SDL_UpdateTexture(texture, &rect, lock.pixels(), lock.pitch()))
+                THROW(std::runtime_error, "StreamingAtlas: Unable to update the texture: {}", SDL_GetError());
+        }
+
+        return DuneTexture{texture, {rect.x + guard, rect.y + guard, surface->w, surface->h}};
+    }
+
+private:
+    struct Page {
+        sdl2::texture_ptr texture;
+        int width{};
+        int height{};
+        int x{};            ///< the end of the used part of the current shelf
+        int y{};            ///< the top of the current shelf
+        int shelf_height{}; ///< the height of the current shelf
+    };
+
+    /// Reserves w x h pixels on the last page or on a new one
+    std::tuple<SDL_Texture*, SDL_Rect> allocate(int w, int h) {
+        if (!pages_.empty()) {
+            auto& page = pages_.back();
+
+            if (const auto rect = place(page, w, h))
+                return {page.texture.get(), *rect};
+        }
+
+        if (w > max_side_ || h > max_side_)
+            THROW(std::runtime_error, "StreamingAtlas: A {}x{} surface exceeds the maximum texture size!", w, h);
+
+        auto& page  = pages_.emplace_back();
+        page.width  = std::max(page_side_, w);
+        page.height = std::max(page_side_, h);
+        page.texture.reset(SDL_CreateTexture(renderer_, format_, SDL_TEXTUREACCESS_STATIC, page.width, page.height));
+
+        if (!page.texture) {
+            pages_.pop_back();
+            THROW(std::runtime_error, "StreamingAtlas: Unable to create a {}x{} texture: {}", w, h, SDL_GetError());
+        }
+
+        if (SDL_SetTextureBlendMode(page.texture.get(), SDL_BlendMode::SDL_BLENDMODE_BLEND))
+            sdl2::log_warn("Unable to set texture atlas blend mode");
+
+        sdl2::log_info("Created streaming atlas page {} with {}x{}", pages_.size(), page.width, page.height);
+
+        return {page.texture.get(), *place(page, w, h)};
+    }
+
+    /// Appends w x h pixels to the current shelf of the page or starts a new shelf
+    static std::optional<SDL_Rect> place(Page& page, int w, int h) {
+        if (page.x + w > page.width) {
+            // Start a new shelf
+            page.x = 0;
+            page.y += page.shelf_height;
+            page.shelf_height = 0;
+        }
+
+        if (page.x + w > page.width || page.y + h > page.height)
+            return std::nullopt;
+
+        const SDL_Rect rect{page.x, page.y, w, h};
+
+        page.x += w;
+        page.shelf_height = std::max(page.shelf_height, h);
+
+        return rect;
+    }
+
+    SDL_Renderer* const renderer_;
+    const uint32_t format_;
+    const int max_side_;
+    const int page_side_;
+
+    std::vector<Page> pages_;
+};
+
+const DuneTexture& DuneTextures::get_object_picture(unsigned int id, HOUSETYPE house, int zoom) const {
+    auto& texture = object_pictures_.at(zoom).at(id).at(static_cast<int>(house));
+
+    if (!texture && house != HOUSETYPE::HOUSE_HARKONNEN)
+        create_object_pictures(id, {&house, 1}, zoom);
+
+    return texture;
+}
+
+zoomable_texture DuneTextures::get_object_pictures(unsigned int id, HOUSETYPE house, int zoom) const {
+    const auto h = static_cast<int>(house);
+
+    if (house != HOUSETYPE::HOUSE_HARKONNEN && !is_requested_.at(id).at(h)) {
+        is_requested_[id][h] = true;
+        requested_.emplace_back(id, house);
+    }
+
+    prepare_zoom_level(zoom);
+
+    return {&object_pictures_[0][id][h], &object_pictures_[1][id][h], &object_pictures_[2][id][h]};
+}
+
+void DuneTextures::prepare_zoom_level(int zoom) const {
+    auto& prepared = prepared_.at(zoom);
+
+    if (prepared == requested_.size())
+        return;
+
+    // Remap every picture to all the houses it is missing for in one pass over its Harkonnen version
+    std::vector<std::tuple<unsigned int, HOUSETYPE>> pending;
+
+    for (auto i = prepared; i < requested_.size(); ++i) {
+        const auto& [id, house] = requested_[i];
+
+        if (!object_pictures_[zoom][id][static_cast<int>(house)])
+            pending.push_back(requested_[i]);
+    }
+
+    std::ranges::sort(pending);
+
+    std::vector<HOUSETYPE> houses;
+
+    for (auto it = pending.begin(); it != pending.end();) {
+        const auto id = std::get<0>(*it);
+
+        houses.clear();
+        for (; it != pending.end() && std::get<0>(*it) == id; ++it)
+            houses.push_back(std::get<1>(*it));
+
+        create_object_pictures(id, houses, zoom);
+    }
+
+    prepared = requested_.size();
+}
+
+void DuneTextures::create_object_pictures(unsigned int id, std::span<const HOUSETYPE> houses, int zoom) const {
+    auto& pictures        = object_pictures_.at(zoom).at(id);
+    const auto& harkonnen = pictures[static_cast<int>(HOUSETYPE::HOUSE_HARKONNEN)];
+    auto* const source    = remap_sources_.at(zoom).at(id).get();
+
+    if (!harkonnen || !source || !streaming_atlas_) {
+        for (const auto house : houses)
+            pictures[static_cast<int>(house)] = harkonnen;
+        return;
+    }
+
+    std::vector<int> colors;
+    colors.reserve(houses.size());
+    for (const auto house : houses)
+        colors.push_back(dune::globals::houseToPaletteIndex[static_cast<int>(house)]);
+
+    auto surfaces = mapSurfaceColorRange(source, PALCOLOR_HARKONNEN, colors);
+
+    for (auto i = 0u; i < houses.size(); ++i) {
+        auto& texture = pictures[static_cast<int>(houses[i])];
+
+        // We are identical to the Harkonnen image, so let it use the Harkonnen version.
+        if (compare_surfaces(source, surfaces[i].get())) {
+            texture = harkonnen;
+            continue;
+        }
+
+        if (id == ObjPic_Windtrap)
+            surfaces[i] = SurfaceLoader::generateWindtrapSurface(surfaces[i].get());
+
+        texture = streaming_atlas_->add(surfaces[i].get());
+    }
+}
+
+namespace {
+/**
+    All texture lookup tables of DuneTextures. They are visited in a fixed order, so they can be stored in a
+    TextureAtlasCache.
+*/
+struct TextureTables final {
+    DuneTextures::object_pictures_type object_pictures{};
+    DuneTextures::small_details_type small_details{};
+    DuneTextures::tiny_pictures_type tiny_pictures{};
+    DuneTextures::ui_graphics_type ui_graphics{};
+    DuneTextures::map_choice_type map_choice{};
+    DuneTextures::generated_type generated_pictures{};
+    DuneTextures::decoration_border_type decoration_border{};
+    DuneTextures::border_style_type border_style{};
+    DuneTextures::remap_sources_type remap_sources{};
+
+    template<typename F>
+    void for_each_texture(F&& f) {
+        for (auto& zoom : object_pictures)
+            for (auto& id : zoom)
+                for (auto& texture : id)
+                    f(texture);
+
+        for (auto& texture : small_details)
+            f(texture);
+        for (auto& texture : tiny_pictures)
+            f(texture);
+
+        for (auto& house : ui_graphics)
+            for (auto& texture : house)
+                f(texture);
+        for (auto& house : map_choice)
+            for (auto& texture : house)
+                f(texture);
+
+        for (auto& texture : generated_pictures)
+            f(texture);
+
+        auto& db = decoration_border;
+        for (auto* texture : {&db.ball, &db.hspacer, &db.vspacer, &db.hborder, &db.vborder})
+            f(*texture);
+
+        for (auto& bs : border_style) {
+            for (auto* texture :
+                 {&bs.leftUpperCorner, &bs.rightUpperCorner, &bs.leftLowerCorner, &bs.rightLowerCorner})
+                f(*texture);
+        }
+    }
+
+    template<typename F>
+    void for_each_colors(F&& f) {
+        for (auto& bs : border_style) {
+            f(bs.hborder);
+            f(bs.vborder);
+        }
+    }
+
+    template<typename F>
+    void for_each_picture(F&& f) {
+        for (auto& zoom : remap_sources)
+            for (auto& picture : zoom)
+                f(picture);
+    }
+};
+
+/// Copies the pictures the other houses are colored from; the pictures that look the same for every house are skipped
+DuneTextures::remap_sources_type copy_remap_sources(SurfaceLoader* surfaceLoader) {
+    DuneTextures::remap_sources_type sources;
+
+    for (auto zoom = 0; zoom < NUM_ZOOMLEVEL; ++zoom) {
+        for (auto id = 0u; id < NUM_OBJPICS; ++id) {
+            if (harkonnen_only_object_pictures.contains(id) || id == ObjPic_Bullet_SonicTemp
+                || id == ObjPic_SandwormShimmerTemp)
+                continue;
+
+            if (auto* const source = surfaceLoader->getRemapSource(id, zoom)) {
+                sources[zoom][id] = sdl2::surface_ptr{SDL_DuplicateSurface(source)};
+                if (!sources[zoom][id])
+                    THROW(sdl_error, "Cannot copy object picture {}: {}", id, SDL_GetError());
+            }
+        }
+    }
+
+    return sources;
+}
+
+TextureAtlasCache::Contents create_cache_contents(const std::vector<sdl2::texture_ptr>& textures,
+                                                  std::vector<sdl2::surface_ptr>&& atlases, TextureTables tables) {
+    TextureAtlasCache::Contents contents;
+
+    contents.atlases = std::move(atlases);
+
+    tables.for_each_texture([&](const DuneTexture& texture) {
+        auto& slot = contents.slots.emplace_back();
+
+        if (!texture)
+            return;
+
+        const auto it = std::ranges::find_if(textures, [&](const auto& t) { return t.get() == texture.texture_; });
+        if (it == textures.end())
+            THROW(std::runtime_error, "Texture is not part of an atlas!");
+
+        slot.atlas = static_cast<int32_t>(it - textures.begin());
+        slot.rect  = texture.source_;
+    });
+
+    tables.for_each_colors([&](std::vector<SDL_Color>& colors) { contents.colors.push_back(std::move(colors)); });
+
+    tables.for_each_picture([&](sdl2::surface_ptr& picture) { contents.pictures.push_back(std::move(picture)); });
+
+    return contents;
+}
+
+bool load_cache_contents(SDL_Renderer* renderer, uint32_t format, int max_side, TextureAtlasCache::Contents& contents,
+                         std::vector<sdl2::texture_ptr>& textures, TextureTables& tables) {
+    auto numSlots = size_t{0};
+    tables.for_each_texture([&](const DuneTexture&) { ++numSlots; });
+
+    auto numColors = size_t{0};
+    tables.for_each_colors([&](const std::vector<SDL_Color>&) { ++numColors; });
+
+    auto numPictures = size_t{0};
+    tables.for_each_picture([&](const sdl2::surface_ptr&) { ++numPictures; });
+
+    if (contents.slots.size() != numSlots || contents.colors.size() != numColors
+        || contents.pictures.size() != numPictures)
+        return false;
+
+    for (const auto& atlas : contents.atlases) {
+        if (atlas->format->format != format || atlas->w > max_side || atlas->h > max_side)
+            return false;
+    }
+
+    for (const auto& atlas : contents.atlases) {
+        auto texture = create_atlas_texture(renderer, atlas.get());
+        if (!texture)
+            return false;
+
+        textures.push_back(std::move(texture));
+    }
+
+    auto slot = contents.slots.begin();
+    tables.for_each_texture([&](DuneTexture& texture) {
+        if (slot->atlas >= 0)
+            texture = DuneTexture{textures.at(slot->atlas).get(), slot->rect.as_sdl()};
+        ++slot;
+    });
+
+    auto colors = contents.colors.begin();
+    tables.for_each_colors([&](std::vector<SDL_Color>& c) { c = *colors++; });
+
+    auto picture = contents.pictures.begin();
+    tables.for_each_picture([&](sdl2::surface_ptr& p) { p = std::move(*picture++); });
+
+    return true;
+}
+} // namespace
+
+DuneTextures
+DuneTextures::create(SDL_Renderer* renderer, surface_loader_type getSurfaceLoader, TextureAtlasCache* cache) {
     SDL_RendererInfo info;
     SDL_GetRendererInfo(renderer, &info);
 
@@ -895,6 +1252,31 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
         return longest_side;
     }();
 
+    if (cache) {
+        if (auto contents = cache->load()) {
+            std::vector<sdl2::texture_ptr> textures;
+            TextureTables tables;
+
+            if (load_cache_contents(renderer, format, max_side, *contents, textures, tables)) {
+                sdl2::log_info("Loaded {} texture atlases from the cache", textures.size());
+
+                return DuneTextures{std::move(textures),
+                                    std::move(tables.object_pictures),
+                                    std::move(tables.small_details),
+                                    std::move(tables.tiny_pictures),
+                                    std::move(tables.ui_graphics),
+                                    std::move(tables.map_choice),
+                                    std::move(tables.generated_pictures),
+                                    std::move(tables.decoration_border),
+                                    std::move(tables.border_style),
+                                    std::move(tables.remap_sources),
+                                    std::make_unique<StreamingAtlas>(renderer, format, max_side)};
+            }
+
+            sdl2::log_info("The texture atlas cache does not fit this renderer");
+        }
+    }
+
     ObjectPicturePacker object_picture_packer;
     UiGraphicPacker ui_graphic_packer;
     MapChoicePacker map_choice_packer;
@@ -904,6 +1286,9 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
     DecorationBorderPicturesPacker decoration_border_packer;
     BorderStylePicturesPacker border_style_pictures_packer;
 
+    // only now the surfaces are needed
+    auto* const surfaceLoader = getSurfaceLoader();
+
     object_picture_packer.initialize(surfaceLoader);
     ui_graphic_packer.initialize(surfaceLoader);
     map_choice_packer.initialize(surfaceLoader);
@@ -914,10 +1299,18 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
     border_style_pictures_packer.initialize(surfaceLoader);
 
     std::vector<sdl2::texture_ptr> textures;
+    std::vector<sdl2::surface_ptr> atlases;
 
     { // Scope
         AtlasFactory23 factory23;
 
+        const auto add_texture = [&](sdl2::texture_ptr texture) {
+            if (cache)
+                atlases.push_back(factory23.release_atlas_surface());
+
+            textures.emplace_back(std::move(texture));
+        };
+
         for (auto zoom = 0; zoom < NUM_ZOOMLEVEL; ++zoom) {
 
             const auto opp_key = object_picture_packer.add(
@@ -934,7 +1327,7 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
 
             object_picture_packer.update(factory23, opp_key, texture.get());
 
-            textures.emplace_back(std::move(texture));
+            add_texture(std::move(texture));
 
             factory23.clear();
         }
@@ -972,7 +1365,7 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
                     ui_graphic_packer.update(factory23, key, texture.get());
                 keys.clear();
 
-                textures.emplace_back(std::move(texture));
+                add_texture(std::move(texture));
 
                 factory23.clear();
             };
@@ -1025,13 +1418,12 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
             decoration_border_packer.update(factory23, dbp_key, texture.get());
             border_style_pictures_packer.update(factory23, bsp_key, texture.get());
 
-            textures.emplace_back(std::move(texture));
+            add_texture(std::move(texture));
 
             factory23.clear();
         }
 
         // Now, fill in duplicates
-        object_picture_packer.update_duplicates();
         ui_graphic_packer.update_duplicates();
         map_choice_packer.update_duplicates();
         tiny_picture_packer.update_duplicates();
@@ -1050,6 +1442,20 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
     //    SaveTextureAsPng(renderer, texture.get(), reinterpret_cast<const char*>(path.u8string().c_str()));
     //}
 
+    if (cache) {
+        TextureTables tables{object_picture_packer.object_pictures2(),
+                             small_detail_pics_packer.dune_textures(),
+                             tiny_picture_packer.dune_textures(),
+                             ui_graphic_packer.dune_textures(),
+                             map_choice_packer.dune_textures(),
+                             generated_pictures_packer.dune_textures(),
+                             decoration_border_packer.dune_textures(),
+                             border_style_pictures_packer.dune_textures(),
+                             copy_remap_sources(surfaceLoader)};
+
+        cache->store(create_cache_contents(textures, std::move(atlases), std::move(tables)));
+    }
+
     return DuneTextures{std::move(textures),
                         object_picture_packer.object_pictures2(),
                         small_detail_pics_packer.dune_textures(),
@@ -1058,5 +1464,7 @@ DuneTextures DuneTextures::create(SDL_Renderer* renderer, SurfaceLoader* surface
                         map_choice_packer.dune_textures(),
                         generated_pictures_packer.dune_textures(),
                         decoration_border_packer.dune_textures(),
-                        border_style_pictures_packer.dune_textures()};
+                        border_style_pictures_packer.dune_textures(),
+                        copy_remap_sources(surfaceLoader),
+                        std::make_unique<StreamingAtlas>(renderer, format, max_side)};
 }
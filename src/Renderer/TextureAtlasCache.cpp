@@ -0,0 +1,309 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Renderer/TextureAtlasCache.h>
+
+#include <misc/IFileStream.h>
+#include <misc/OFileStream.h>
+#include <misc/compression_util.h>
+#include <misc/exceptions.h>
+
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr uint32_t TEXTUREATLASCACHE_VERSION = 2;
+
+constexpr int32_t MAX_ATLAS_SIDE   = 16384; ///< larger atlases are treated as a broken cache
+constexpr size_t MAX_DEFLATE_RATIO = 1032;  ///< deflate cannot compress better than this
+
+// the smallest possible size of the records in the file, used to check their counts against the file size
+constexpr size_t MIN_ATLAS_RECORD_SIZE   = 5 * sizeof(uint32_t);
+constexpr size_t SLOT_RECORD_SIZE        = sizeof(int32_t) + 4 * sizeof(int16_t);
+constexpr size_t MIN_COLORS_RECORD_SIZE  = sizeof(uint32_t);
+constexpr size_t MIN_PICTURE_RECORD_SIZE = sizeof(uint8_t);
+
+std::vector<uint8_t> get_pixels(SDL_Surface* surface) {
+    const sdl2::surface_lock lock{surface};
+
+    const auto rowSize = static_cast<size_t>(surface->w) * surface->format->BytesPerPixel;
+
+    std::vector<uint8_t> pixels(rowSize * surface->h);
+
+    const auto* const src = static_cast<const uint8_t*>(lock.pixels());
+    for (auto y = 0; y < surface->h; ++y)
+        std::memcpy(&pixels[y * rowSize], src + static_cast<ptrdiff_t>(y) * lock.pitch(), rowSize);
+
+    return pixels;
+}
+
+/// \return the size of the pixels of an atlas in the file
+size_t get_pixels_size(uint32_t format, int w, int h) {
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_BYTESPERPIXEL(format) == 0)
+        THROW(std::runtime_error, "Invalid atlas format {}", format);
+
+    if (w <= 0 || h <= 0 || w > MAX_ATLAS_SIDE || h > MAX_ATLAS_SIDE)
+        THROW(std::runtime_error, "Invalid atlas size {}x{}", w, h);
+
+    return static_cast<size_t>(w) * SDL_BYTESPERPIXEL(format) * h;
+}
+
+sdl2::surface_ptr create_surface(uint32_t format, int w, int h, std::span<const uint8_t> pixels) {
+    const auto rowSize = static_cast<size_t>(w) * SDL_BYTESPERPIXEL(format);
+    if (pixels.size() != rowSize * h)
+        THROW(std::runtime_error, "Atlas has {} bytes instead of {}", pixels.size(), rowSize * h);
+
+    sdl2::surface_ptr surface{SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(format), format)};
+    if (!surface)
+        THROW(sdl_error, "Cannot create surface: {}", SDL_GetError());
+
+    if (surface->format->BytesPerPixel != SDL_BYTESPERPIXEL(format))
+        THROW(std::runtime_error, "Invalid atlas format {}", format);
+
+    const sdl2::surface_lock lock{surface.get()};
+
+    auto* const dest = static_cast<uint8_t*>(lock.pixels());
+    for (auto y = 0; y < h; ++y)
+        std::memcpy(dest + static_cast<ptrdiff_t>(y) * lock.pitch(), &pixels[y * rowSize], rowSize);
+
+    return surface;
+}
+
+/// Writes the pixels of an atlas or a picture
+void write_surface(OutputStream& stream, SDL_Surface* surface) {
+    const auto pixels = get_pixels(surface);
+
+    stream.writeUint32(surface->format->format);
+    stream.writeSint32(surface->w);
+    stream.writeSint32(surface->h);
+    stream.writeUint32(static_cast<uint32_t>(pixels.size()));
+    stream.writeUint8Vector(dune::zlib_compress(pixels));
+}
+
+/// Reads a surface written by write_surface(); all sizes are checked before anything is allocated
+sdl2::surface_ptr read_surface(InputStream& stream) {
+    const auto format = stream.readUint32();
+    const auto w      = stream.readSint32();
+    const auto h      = stream.readSint32();
+    const auto size   = stream.readUint32();
+
+    if (size != get_pixels_size(format, w, h))
+        THROW(std::runtime_error, "Surface has {} bytes instead of {}", size, get_pixels_size(format, w, h));
+
+    const auto compressed = stream.readUint8Vector();
+    if (size / MAX_DEFLATE_RATIO > compressed.size())
+        THROW(std::runtime_error, "Surface cannot decompress from {} to {} bytes", compressed.size(), size);
+
+    const auto pixels = dune::zlib_decompress(compressed, size);
+
+    return create_surface(format, w, h, pixels);
+}
+
+/// Writes an 8-bit picture with its palette and color key, or nullptr
+void write_picture(OutputStream& stream, SDL_Surface* picture) {
+    stream.writeBool(picture != nullptr);
+    if (!picture)
+        return;
+
+    const auto* const palette = picture->format->palette;
+    if (!palette)
+        THROW(std::runtime_error, "Picture of format {} has no palette", picture->format->format);
+
+    write_surface(stream, picture);
+
+    static_assert(sizeof(SDL_Color) == 4);
+    stream.writeUint8Vector(
+        {reinterpret_cast<const uint8_t*>(palette->colors), static_cast<size_t>(palette->ncolors) * 4});
+
+    uint32_t key = 0;
+    stream.writeBool(SDL_GetColorKey(picture, &key) == 0);
+    stream.writeUint32(key);
+}
+
+/// Reads a picture written by write_picture()
+sdl2::surface_ptr read_picture(InputStream& stream) {
+    if (!stream.readBool())
+        return nullptr;
+
+    auto picture = read_surface(stream);
+
+    auto* const palette = picture->format->palette;
+    if (!palette)
+        THROW(std::runtime_error, "Picture of format {} has no palette", picture->format->format);
+
+    const auto rgba = stream.readUint8Vector();
+    if (rgba.size() != static_cast<size_t>(palette->ncolors) * 4)
+        THROW(std::runtime_error, "Picture has a palette of {} bytes instead of {}", rgba.size(), palette->ncolors * 4);
+
+    std::vector<SDL_Color> colors(palette->ncolors);
+    std::memcpy(colors.data(), rgba.data(), rgba.size());
+    SDL_SetPaletteColors(palette, colors.data(), 0, palette->ncolors);
+
+    const auto hasKey = stream.readBool();
+    const auto key    = stream.readUint32();
+    if (hasKey && key >= static_cast<uint32_t>(palette->ncolors))
+        THROW(std::runtime_error, "Invalid color key {}", key);
+
+    if (hasKey)
+        SDL_SetColorKey(picture.get(), SDL_TRUE, key);
+
+    return picture;
+}
+} // namespace
+
+TextureAtlasCache::TextureAtlasCache(std::filesystem::path filename, std::string key)
+    : filename_{std::move(filename)}, key_{std::move(key)} { }
+
+TextureAtlasCache::~TextureAtlasCache() {
+    if (thread_.joinable())
+        thread_.join();
+}
+
+std::optional<TextureAtlasCache::Contents> TextureAtlasCache::load() const {
+    IFileStream stream;
+    if (!stream.open(filename_))
+        return std::nullopt;
+
+    try {
+        if (stream.readUint32() != TEXTUREATLASCACHE_VERSION || stream.readString() != key_)
+            return std::nullopt;
+
+        Contents contents;
+
+        // all counts and sizes are checked against the rest of the file before anything is allocated
+        const auto numAtlases = stream.readUint32();
+        if (numAtlases > stream.bytesLeft() / MIN_ATLAS_RECORD_SIZE)
+            THROW(std::runtime_error, "Invalid number of atlases {}", numAtlases);
+
+        for (auto i = 0U; i < numAtlases; ++i)
+            contents.atlases.push_back(read_surface(stream));
+
+        const auto numSlots = stream.readUint32();
+        if (numSlots > stream.bytesLeft() / SLOT_RECORD_SIZE)
+            THROW(std::runtime_error, "Invalid number of slots {}", numSlots);
+
+        contents.slots.resize(numSlots);
+        for (auto& slot : contents.slots) {
+            slot.atlas  = stream.readSint32();
+            slot.rect.x = stream.readSint16();
+            slot.rect.y = stream.readSint16();
+            slot.rect.w = stream.readSint16();
+            slot.rect.h = stream.readSint16();
+
+            if (slot.atlas < -1 || slot.atlas >= static_cast<int32_t>(numAtlases))
+                THROW(std::runtime_error, "Invalid atlas index {}", slot.atlas);
+
+            if (slot.atlas == -1)
+                continue;
+
+            // the shorts are promoted to int, so the sums below cannot overflow
+            const auto& rect        = slot.rect;
+            const auto* const atlas  = contents.atlases[slot.atlas].get();
+            if (rect.x < 0 || rect.y < 0 || rect.w < 0 || rect.h < 0 || rect.x + rect.w > atlas->w
+                || rect.y + rect.h > atlas->h)
+                THROW(std::runtime_error, "Invalid rectangle {},{} {}x{} in atlas {} of {}x{}", rect.x, rect.y, rect.w,
+                      rect.h, slot.atlas, atlas->w, atlas->h);
+        }
+
+        const auto numColors = stream.readUint32();
+        if (numColors > stream.bytesLeft() / MIN_COLORS_RECORD_SIZE)
+            THROW(std::runtime_error, "Invalid number of color strips {}", numColors);
+
+        contents.colors.resize(numColors);
+        for (auto& colors : contents.colors) {
+            const auto rgba = stream.readUint8Vector();
+            if (rgba.size() % 4 != 0)
+                THROW(std::runtime_error, "Invalid color strip of {} bytes", rgba.size());
+
+            colors.resize(rgba.size() / 4);
+            std::memcpy(colors.data(), rgba.data(), rgba.size());
+        }
+
+        const auto numPictures = stream.readUint32();
+        if (numPictures > stream.bytesLeft() / MIN_PICTURE_RECORD_SIZE)
+            THROW(std::runtime_error, "Invalid number of pictures {}", numPictures);
+
+        contents.pictures.reserve(numPictures);
+        for (auto i = 0U; i < numPictures; ++i)
+            contents.pictures.push_back(read_picture(stream));
+
+        return contents;
+    } catch (std::exception& e) {
+        sdl2::log_info("Ignoring the broken texture atlas cache '{}': {}", filename_.string(), e.what());
+        return std::nullopt;
+    }
+}
+
+void TextureAtlasCache::store(Contents&& contents) {
+    if (thread_.joinable())
+        thread_.join();
+
+    // compressing the atlases takes a while and must not delay the startup
+    thread_ = std::thread{[this, contents = std::move(contents)] { write(contents); }};
+}
+
+void TextureAtlasCache::write(const Contents& contents) const {
+    auto tmpFilename = filename_;
+    tmpFilename += ".tmp";
+
+    try {
+        OFileStream stream;
+        if (!stream.open(tmpFilename)) {
+            sdl2::log_info("Cannot write the texture atlas cache '{}'!", tmpFilename.string());
+            return;
+        }
+
+        stream.writeUint32(TEXTUREATLASCACHE_VERSION);
+        stream.writeString(key_);
+
+        stream.writeUint32(static_cast<uint32_t>(contents.atlases.size()));
+        for (const auto& atlas : contents.atlases)
+            write_surface(stream, atlas.get());
+
+        stream.writeUint32(static_cast<uint32_t>(contents.slots.size()));
+        for (const auto& slot : contents.slots) {
+            stream.writeSint32(slot.atlas);
+            stream.writeSint16(slot.rect.x);
+            stream.writeSint16(slot.rect.y);
+            stream.writeSint16(slot.rect.w);
+            stream.writeSint16(slot.rect.h);
+        }
+
+        stream.writeUint32(static_cast<uint32_t>(contents.colors.size()));
+        for (const auto& colors : contents.colors) {
+            static_assert(sizeof(SDL_Color) == 4);
+            stream.writeUint8Vector({reinterpret_cast<const uint8_t*>(colors.data()), colors.size() * 4});
+        }
+
+        stream.writeUint32(static_cast<uint32_t>(contents.pictures.size()));
+        for (const auto& picture : contents.pictures)
+            write_picture(stream, picture.get());
+
+        stream.close();
+    } catch (std::exception& e) {
+        sdl2::log_info("Cannot write the texture atlas cache '{}': {}", tmpFilename.string(), e.what());
+
+        std::error_code ec;
+        std::filesystem::remove(tmpFilename, ec);
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpFilename, filename_, ec);
+    if (ec)
+        sdl2::log_info("Cannot rename '{}': {}", tmpFilename.string(), ec.message());
+}
@@ -1,8 +1,11 @@
 add_sources(RENDERER_SOURCES
+	DuneRenderStats.cpp
 	DuneRenderer.cpp
 	DuneRotateTexture.cpp
+	DuneSpriteBatch.cpp
 	DuneSurface.cpp
 	DuneTexture.cpp
 	DuneTextures.cpp
 	DuneTileTexture.cpp
+	TextureAtlasCache.cpp
 )
@@ -0,0 +1,98 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReplaySnapshots.h>
+
+#include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
+
+#include <iterator>
+
+ReplaySnapshots::ReplaySnapshots(uint32_t interval, size_t maxBytes) : interval_(interval), maxBytes_(maxBytes) {
+    if (interval == 0) {
+        THROW(std::invalid_argument, "ReplaySnapshots: The snapshot interval must not be 0!");
+    }
+}
+
+ReplaySnapshots::~ReplaySnapshots() = default;
+
+bool ReplaySnapshots::isSnapshotDue(uint32_t gameCycle) const {
+    return gameCycle % interval_ == 0 && !snapshots_.contains(gameCycle);
+}
+
+void ReplaySnapshots::addSnapshot(uint32_t gameCycle, std::span<const uint8_t> savegame) {
+    std::vector<uint8_t> snapshot{savegame.begin(), savegame.end()};
+
+    if (const auto it = snapshots_.find(gameCycle); it != snapshots_.end()) {
+        sdl2::log_info("ReplaySnapshots: Replaced snapshot for game cycle {}", gameCycle);
+
+        memoryUsage_ -= it->second.size();
+        snapshots_.erase(it);
+    }
+
+    memoryUsage_ += snapshot.size();
+    snapshots_.emplace(gameCycle, std::move(snapshot));
+
+    while (memoryUsage_ > maxBytes_ && snapshots_.size() > 1) {
+        thinOut();
+    }
+}
+
+std::optional<uint32_t> ReplaySnapshots::findSnapshot(uint32_t gameCycle) const {
+    auto it = snapshots_.upper_bound(gameCycle);
+    if (it == snapshots_.begin()) {
+        return std::nullopt;
+    }
+
+    return std::prev(it)->first;
+}
+
+std::optional<uint32_t> ReplaySnapshots::findRestorePoint(uint32_t currentCycle, uint32_t targetCycle) const {
+    const auto snapshotCycle = findSnapshot(targetCycle);
+
+    if (targetCycle >= currentCycle && snapshotCycle && *snapshotCycle <= currentCycle) {
+        return std::nullopt;
+    }
+
+    return snapshotCycle;
+}
+
+std::vector<uint8_t> ReplaySnapshots::getSnapshot(uint32_t gameCycle) const {
+    const auto it = snapshots_.find(gameCycle);
+    if (it == snapshots_.end()) {
+        THROW(std::invalid_argument, "ReplaySnapshots: There is no snapshot for game cycle {}!", gameCycle);
+    }
+
+    return it->second;
+}
+
+void ReplaySnapshots::thinOut() {
+    interval_ *= 2;
+
+    for (auto it = snapshots_.begin(); it != snapshots_.end();) {
+        // the first snapshot is always kept so that we can go back to the beginning of the replay
+        if (it != snapshots_.begin() && it->first % interval_ != 0) {
+            memoryUsage_ -= it->second.size();
+            it = snapshots_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    sdl2::log_info("ReplaySnapshots: Using {} KiB for {} snapshots, taking a snapshot every {} game cycles now",
+                   memoryUsage_ / 1024, snapshots_.size(), interval_);
+}
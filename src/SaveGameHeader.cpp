@@ -0,0 +1,178 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <SaveGameHeader.h>
+
+#include <Colors.h>
+#include <Definitions.h>
+#include <config.h>
+
+#include <misc/IFileStream.h>
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/compression_util.h>
+#include <misc/exceptions.h>
+
+#include <gsl/gsl>
+
+SaveGameHeader::SaveGameHeader() = default;
+
+SaveGameHeader::SaveGameHeader(InputStream& stream) {
+    // the header is stored as one block, so fields can be appended without breaking older readers
+    const auto block = stream.readString();
+    IMemoryStream memStream(block.data(), block.size());
+
+    mapName        = memStream.readString();
+    gameType       = static_cast<GameType>(memStream.readSint8());
+    houseID        = static_cast<HOUSETYPE>(memStream.readSint8());
+    mission        = memStream.readUint8();
+    gameCycleCount = memStream.readUint32();
+
+    const auto numHouseInfo = memStream.readUint32();
+    houseInfoList.reserve(numHouseInfo);
+    for (auto i = 0u; i < numHouseInfo; i++) {
+        houseInfoList.emplace_back(memStream);
+    }
+
+    thumbnailWidth  = memStream.readUint16();
+    thumbnailHeight = memStream.readUint16();
+
+    const auto pixels = memStream.readString();
+    if (pixels.size() != static_cast<size_t>(thumbnailWidth) * thumbnailHeight * 3) {
+        THROW(std::runtime_error, "Invalid savegame thumbnail of size {}x{} with {} bytes!", thumbnailWidth,
+              thumbnailHeight, pixels.size());
+    }
+    thumbnail.assign(pixels.begin(), pixels.end());
+}
+
+SaveGameHeader::SaveGameHeader(const SaveGameHeader&)                = default;
+SaveGameHeader::SaveGameHeader(SaveGameHeader&&) noexcept            = default;
+SaveGameHeader& SaveGameHeader::operator=(const SaveGameHeader&)     = default;
+SaveGameHeader& SaveGameHeader::operator=(SaveGameHeader&&) noexcept = default;
+
+SaveGameHeader::~SaveGameHeader() = default;
+
+void SaveGameHeader::save(OutputStream& stream) const {
+    OMemoryStream memStream;
+    memStream.open();
+
+    memStream.writeString(mapName);
+    memStream.writeSint8(static_cast<int8_t>(gameType));
+    memStream.writeSint8(static_cast<int8_t>(houseID));
+    memStream.writeUint8(static_cast<uint8_t>(mission));
+    memStream.writeUint32(gameCycleCount);
+
+    memStream.writeUint32(gsl::narrow<uint32_t>(houseInfoList.size()));
+    for (const auto& houseInfo : houseInfoList) {
+        houseInfo.save(memStream);
+    }
+
+    memStream.writeUint16(thumbnailWidth);
+    memStream.writeUint16(thumbnailHeight);
+    memStream.writeString({reinterpret_cast<const char*>(thumbnail.data()), thumbnail.size()});
+
+    stream.writeString({memStream.getData(), memStream.getDataLength()});
+}
+
+std::optional<SaveGameHeader> SaveGameHeader::read(const std::filesystem::path& savegame) {
+    IFileStream fs;
+
+    if (!fs.open(savegame)) {
+        return std::nullopt;
+    }
+
+    try {
+        if (fs.readUint32() != SAVEMAGIC) {
+            return std::nullopt;
+        }
+
+        // the header is the same in all versions with sections
+        const auto version = fs.readUint32();
+        if (version <= SAVEGAMEVERSION_UNCOMPRESSED || version > SAVEGAMEVERSION) {
+            return std::nullopt;
+        }
+
+        fs.readString(); // dune legacy version
+
+        return SaveGameHeader{fs};
+    } catch (std::exception& e) {
+        sdl2::log_info("Cannot read the header of savegame '{}': {}",
+                       reinterpret_cast<const char*>(savegame.u8string().c_str()), e.what());
+    }
+
+    return std::nullopt;
+}
+
+sdl2::surface_ptr SaveGameHeader::createThumbnailSurface() const {
+    if (thumbnailWidth == 0 || thumbnailHeight == 0) {
+        return nullptr;
+    }
+
+    sdl2::surface_ptr surface{
+        SDL_CreateRGBSurface(0, thumbnailWidth, thumbnailHeight, SCREEN_BPP, RMASK, GMASK, BMASK, AMASK)};
+    if (surface == nullptr) {
+        return nullptr;
+    }
+
+    sdl2::surface_lock lock{surface.get()};
+
+    const auto* pixel = thumbnail.data();
+    for (auto y = 0; y < thumbnailHeight; y++) {
+        auto* const out = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(surface->pixels) + y * surface->pitch);
+
+        for (auto x = 0; x < thumbnailWidth; x++, pixel += 3) {
+            out[x] = COLOR_RGB(pixel[0], pixel[1], pixel[2]);
+        }
+    }
+
+    return surface;
+}
+
+SaveGameData::SaveGameData()                                   = default;
+SaveGameData::SaveGameData(SaveGameData&&) noexcept            = default;
+SaveGameData::~SaveGameData()                                  = default;
+SaveGameData& SaveGameData::operator=(SaveGameData&&) noexcept = default;
+
+void SaveGameData::write(OutputStream& stream) const {
+    stream.writeUint32(SAVEMAGIC);
+
+    stream.writeUint32(SAVEGAMEVERSION);
+
+    stream.writeString(VERSIONSTRING);
+
+    // the header is not compressed, so the load/save window can read it quickly
+    header.save(stream);
+
+    // every section is compressed on its own
+    for (const auto& section : sections) {
+        writeSaveGameSection(stream, section);
+    }
+}
+
+void writeSaveGameSection(OutputStream& stream, std::span<const uint8_t> data) {
+    const auto compressed = dune::zlib_compress(data);
+
+    stream.writeUint32(gsl::narrow<uint32_t>(data.size()));
+    stream.writeString({reinterpret_cast<const char*>(compressed.data()), compressed.size()});
+}
+
+std::vector<uint8_t> readSaveGameSection(InputStream& stream) {
+    const auto size       = stream.readUint32();
+    const auto compressed = stream.readString();
+
+    return dune::zlib_decompress({reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size()}, size);
+}
@@ -38,10 +38,29 @@
 
 #include <gsl/gsl>
 
+#include <algorithm>
+#include <span>
+
 namespace {
-inline constexpr auto FOGTIME = MILLI2CYCLES(10 * 1000);
+/// The radar has to recompute the color of the tile at location (e.g. an object entered or left it)
+void invalidateRadar(const Coord& location) {
+    if (auto* const map = dune::globals::currentGameMap)
+        map->invalidateRadar(location);
+}
+
+/// The cached terrain of the tile at location has to be rendered again (e.g. its type changed)
+void invalidateTerrain(const Coord& location) {
+    if (auto* const map = dune::globals::currentGameMap)
+        map->invalidateTerrain(location);
 }
 
+/// The tile at location has to be drawn again, but its cached terrain is still valid (e.g. it was damaged)
+void invalidateGround(const Coord& location) {
+    if (auto* const map = dune::globals::currentGameMap)
+        map->invalidateGround(location);
+}
+} // namespace
+
 Tile::Tile() : sprite_{dune::globals::pGFXManager->getObjPic(ObjPic_Terrain)} { }
 
 Tile::~Tile() = default;
@@ -56,16 +75,22 @@ void Tile::load(InputStream& stream) {
     stream.readBools(&bLastAccess[0], &bLastAccess[1], &bLastAccess[2], &bLastAccess[3], &bLastAccess[4],
                      &bLastAccess[5], &bLastAccess[6]);
 
+    // the set last access times are followed by fog color, owner and sand region
+    std::array<uint32_t, NUM_TEAMS + 3> values{};
+    const auto numLastAccess = std::ranges::count(bLastAccess, true);
+    stream.readUint32s(std::span{values}.first(numLastAccess + 3));
+
+    auto value = values.begin();
     for (int i = 0; i < NUM_TEAMS; i++) {
         if (bLastAccess[i]) {
-            lastAccess_[i] = stream.readUint32();
+            lastAccess_[i] = *value++;
         }
     }
 
-    fogColor_ = stream.readUint32();
+    fogColor_ = *value++;
 
-    owner_      = static_cast<HOUSETYPE>(stream.readSint32());
-    sandRegion_ = stream.readUint32();
+    owner_      = static_cast<HOUSETYPE>(static_cast<int32_t>(*value++));
+    sandRegion_ = *value;
 
     spice_ = stream.readFixPoint();
 
@@ -86,13 +111,20 @@ void Tile::load(InputStream& stream) {
     if (bHasDamage) {
         damage_.clear();
         const uint32_t numDamage = stream.readUint32();
+        if (numDamage > stream.bytesLeft() / (4 * sizeof(int32_t))) {
+            THROW(InputStream::eof, "Tile::load(): Invalid number of damage entries: {}", numDamage);
+        }
+
+        std::vector<int32_t> damageValues(4 * static_cast<size_t>(numDamage));
+        stream.readSint32s(damageValues);
+
         damage_.reserve(numDamage);
-        for (uint32_t i = 0; i < numDamage; i++) {
+        for (auto i = 0U; i < damageValues.size(); i += 4) {
             DAMAGETYPE newDamage;
-            newDamage.damageType_ = static_cast<TerrainDamage_enum>(stream.readUint32());
-            newDamage.tile_       = stream.readSint32();
-            newDamage.realPos_.x  = stream.readSint32();
-            newDamage.realPos_.y  = stream.readSint32();
+            newDamage.damageType_ = static_cast<TerrainDamage_enum>(damageValues[i]);
+            newDamage.tile_       = damageValues[i + 1];
+            newDamage.realPos_.x  = damageValues[i + 2];
+            newDamage.realPos_.y  = damageValues[i + 3];
 
             damage_.push_back(newDamage);
         }
@@ -121,9 +153,13 @@ void Tile::load(InputStream& stream) {
     stream.readBools(&bTrackCounter[0], &bTrackCounter[1], &bTrackCounter[2], &bTrackCounter[3], &bTrackCounter[4],
                      &bTrackCounter[5], &bTrackCounter[6], &bTrackCounter[7]);
 
+    std::array<uint32_t, NUM_ANGLES> tracksCreationTime{};
+    stream.readUint32s(std::span{tracksCreationTime}.first(std::ranges::count(bTrackCounter, true)));
+
+    auto trackTime = tracksCreationTime.begin();
     for (int i = 0; i < NUM_ANGLES; i++) {
         if (bTrackCounter[i]) {
-            tracksCreationTime_[i] = stream.readUint32();
+            tracksCreationTime_[i] = *trackTime++;
         }
     }
 
@@ -151,16 +187,22 @@ void Tile::save(OutputStream& stream, uint32_t gameCycleCount) const {
 
     stream.writeBools((lastAccess_[0] != 0), (lastAccess_[1] != 0), (lastAccess_[2] != 0), (lastAccess_[3] != 0),
                       (lastAccess_[4] != 0), (lastAccess_[5] != 0), (lastAccess_[6] != 0));
+
+    // write the set last access times, fog color, owner and sand region as one block
+    std::array<uint32_t, NUM_TEAMS + 3> values{};
+    auto value = values.begin();
     for (const auto lastAccessFromTeam : lastAccess_) {
         if (lastAccessFromTeam != 0) {
-            stream.writeUint32(lastAccessFromTeam);
+            *value++ = lastAccessFromTeam;
         }
     }
 
-    stream.writeUint32(fogColor_);
+    *value++ = fogColor_;
+
+    *value++ = static_cast<uint32_t>(owner_);
+    *value++ = sandRegion_;
 
-    stream.writeUint32(static_cast<uint32_t>(owner_));
-    stream.writeUint32(sandRegion_);
+    stream.writeUint32s({values.begin(), value});
 
     stream.writeFixPoint(spice_);
 
@@ -170,12 +212,16 @@ void Tile::save(OutputStream& stream, uint32_t gameCycleCount) const {
 
     if (!damage_.empty()) {
         stream.writeUint32(gsl::narrow<uint32_t>(damage_.size()));
+
+        std::vector<int32_t> damageValues;
+        damageValues.reserve(4 * damage_.size());
         for (const auto& damageItem : damage_) {
-            stream.writeUint32(static_cast<uint32_t>(damageItem.damageType_));
-            stream.writeSint32(damageItem.tile_);
-            stream.writeSint32(damageItem.realPos_.x);
-            stream.writeSint32(damageItem.realPos_.y);
+            damageValues.push_back(static_cast<int32_t>(damageItem.damageType_));
+            damageValues.push_back(damageItem.tile_);
+            damageValues.push_back(damageItem.realPos_.x);
+            damageValues.push_back(damageItem.realPos_.y);
         }
+        stream.writeSint32s(damageValues);
     }
 
     if (!deadUnits_.empty()) {
@@ -203,11 +249,8 @@ void Tile::save(OutputStream& stream, uint32_t gameCycleCount) const {
                       (tracksCreationTimeToSave[2] != 0), (tracksCreationTimeToSave[3] != 0),
                       (tracksCreationTimeToSave[4] != 0), (tracksCreationTimeToSave[5] != 0),
                       (tracksCreationTimeToSave[6] != 0), (tracksCreationTimeToSave[7] != 0));
-    for (const auto i : tracksCreationTimeToSave) {
-        if (i != 0) {
-            stream.writeUint32(i);
-        }
-    }
+    const auto tracksEnd = std::ranges::remove(tracksCreationTimeToSave, 0U).begin();
+    stream.writeUint32s({tracksCreationTimeToSave.begin(), tracksEnd});
 
     if (!assignedAirUnitList_.empty()) {
         stream.writeUint32Vector(assignedAirUnitList_);
@@ -228,6 +271,7 @@ void Tile::save(OutputStream& stream, uint32_t gameCycleCount) const {
 
 void Tile::assignAirUnit(uint32_t newObjectID) {
     assignedAirUnitList_.push_back(newObjectID);
+    invalidateRadar(location_);
 }
 
 void Tile::assignDeadUnit(deadUnitEnum type, HOUSETYPE house, CoordF position) {
@@ -240,6 +284,7 @@ void Tile::assignDeadUnit(deadUnitEnum type, HOUSETYPE house, CoordF position) {
 
 void Tile::assignNonInfantryGroundObject(uint32_t newObjectID) {
     assignedNonInfantryGroundObjectList_.push_back(newObjectID);
+    invalidateRadar(location_);
 }
 
 int Tile::assignInfantry(ObjectManager& objectManager, uint32_t newObjectID, int8_t currentPosition) {
@@ -271,21 +316,19 @@ int Tile::assignInfantry(ObjectManager& objectManager, uint32_t newObjectID, int
     }
 
     assignedInfantryList_.push_back(newObjectID);
+    invalidateRadar(location_);
+
     return newPosition;
 }
 
 void Tile::assignUndergroundUnit(uint32_t newObjectID) {
     assignedUndergroundUnitList_.push_back(newObjectID);
+    invalidateRadar(location_);
 }
 
-void Tile::blitGround(Game* game) {
-    if (hasANonInfantryGroundObject() && getNonInfantryGroundObject(game->getObjectManager())->isAStructure())
-        return;
-
-    const auto* const gfx          = dune::globals::pGFXManager.get();
-    const auto* const screenborder = dune::globals::screenborder.get();
-    auto* const renderer           = dune::globals::renderer.get();
-    const auto zoom                = dune::globals::currentZoomlevel;
+void Tile::blitTerrain(SDL_Renderer* renderer, float x, float y) const {
+    const auto* const gfx = dune::globals::pGFXManager.get();
+    const auto zoom       = dune::globals::currentZoomlevel;
 
     const auto tileIndex       = static_cast<int>(getTerrainTile());
     const auto indexX          = tileIndex % NUM_TERRAIN_TILES_X;
@@ -293,9 +336,7 @@ void Tile::blitGround(Game* game) {
     const auto zoomed_tilesize = world2zoomedWorld(TILESIZE);
     SDL_Rect source{indexX * zoomed_tilesize, indexY * zoomed_tilesize, zoomed_tilesize, zoomed_tilesize};
 
-    const SDL_FRect pos{screenborder->world2screenX(getLocation().x * TILESIZE),
-                        screenborder->world2screenY(getLocation().y * TILESIZE), static_cast<float>(zoomed_tilesize),
-                        static_cast<float>(zoomed_tilesize)};
+    const SDL_FRect pos{x, y, static_cast<float>(zoomed_tilesize), static_cast<float>(zoomed_tilesize)};
 
     // draw terrain
     if (destroyedStructureTile_ == DestroyedStructure_None || destroyedStructureTile_ == DestroyedStructure_Wall) {
@@ -307,15 +348,28 @@ void Tile::blitGround(Game* game) {
         const SDL_Rect source2 = {destroyedStructureTile_ * zoomed_tilesize, 0, zoomed_tilesize, zoomed_tilesize};
         Dune_RenderCopyF(renderer, pDestroyedStructureTex, &source2, &pos);
     }
+}
+
+void Tile::blitGround(Game* game) const {
+    if (hasANonInfantryGroundObject() && getNonInfantryGroundObject(game->getObjectManager())->isAStructure())
+        return;
 
     if (isFoggedByTeam(game, dune::globals::pLocalHouse->getTeamID()))
         return;
 
-    source.y = 0;
+    const auto* const gfx          = dune::globals::pGFXManager.get();
+    const auto* const screenborder = dune::globals::screenborder.get();
+    auto* const renderer           = dune::globals::renderer.get();
+    const auto zoom                = dune::globals::currentZoomlevel;
 
-    const auto gameCycleCount = game->getGameCycleCount();
+    const auto zoomed_tilesize = world2zoomedWorld(TILESIZE);
+    SDL_Rect source{0, 0, zoomed_tilesize, zoomed_tilesize};
+
+    const SDL_FRect pos{screenborder->world2screenX(getLocation().x * TILESIZE),
+                        screenborder->world2screenY(getLocation().y * TILESIZE), static_cast<float>(zoomed_tilesize),
+                        static_cast<float>(zoomed_tilesize)};
 
-    source.y = 0;
+    const auto gameCycleCount = game->getGameCycleCount();
 
     // tracks
     const auto* const pTracks = gfx->getZoomedObjPic(ObjPic_Terrain_Tracks, zoom);
@@ -323,10 +377,8 @@ void Tile::blitGround(Game* game) {
         const auto tracktime = static_cast<int>(gameCycleCount - tracksCreationTime_[i]);
         if ((tracksCreationTime_[i] != 0) && (tracktime < TRACKSTIME)) {
             source.x = ((10 - i) % 8) * zoomed_tilesize;
-            SDL_SetTextureAlphaMod(pTracks->texture_,
-                                   static_cast<Uint8>(std::min(255, 256 * (TRACKSTIME - tracktime) / TRACKSTIME)));
-            Dune_RenderCopyF(renderer, pTracks, &source, &pos);
-            SDL_SetTextureAlphaMod(pTracks->texture_, 255);
+            Dune_RenderCopyF(renderer, pTracks, &source, &pos,
+                             static_cast<uint8_t>(std::min(255, 256 * (TRACKSTIME - tracktime) / TRACKSTIME)));
         }
     }
 
@@ -549,6 +601,17 @@ void Tile::addDamage(Tile::TerrainDamage_enum damageType, int tile, Coord realPo
 #else
     damage_.push_back({damageType, tile, realPos});
 #endif
+
+    invalidateGround(location_);
+}
+
+bool Tile::isAnimated(uint32_t gameCycleCount) const noexcept {
+    if (hasAnObject() || !deadUnits_.empty())
+        return true;
+
+    return std::ranges::any_of(tracksCreationTime_, [=](auto creationTime) {
+        return (creationTime != 0) && (static_cast<int>(gameCycleCount - creationTime) < TRACKSTIME);
+    });
 }
 
 void Tile::update_impl() {
@@ -563,6 +626,8 @@ void Tile::update_impl() {
 void Tile::clearTerrain() {
     damage_.clear();
     deadUnits_.clear();
+
+    invalidateGround(location_);
 }
 
 void Tile::setTrack(ANGLETYPE direction, uint32_t gameCycleCounter) {
@@ -591,18 +656,22 @@ static void erase_remove(Container& c, Val val) {
 
 void Tile::unassignAirUnit(uint32_t objectID) {
     erase_remove(assignedAirUnitList_, objectID);
+    invalidateRadar(location_);
 }
 
 void Tile::unassignNonInfantryGroundObject(uint32_t objectID) {
     erase_remove(assignedNonInfantryGroundObjectList_, objectID);
+    invalidateRadar(location_);
 }
 
 void Tile::unassignUndergroundUnit(uint32_t objectID) {
     erase_remove(assignedUndergroundUnitList_, objectID);
+    invalidateRadar(location_);
 }
 
 void Tile::unassignInfantry(uint32_t objectID, [[maybe_unused]] int currentPosition) {
     erase_remove(assignedInfantryList_, objectID);
+    invalidateRadar(location_);
 }
 
 void Tile::unassignObject(uint32_t objectID) {
@@ -622,6 +691,9 @@ void Tile::setType(const GameContext& context, TERRAINTYPE newType) {
     type_                   = newType;
     destroyedStructureTile_ = DestroyedStructure_None;
 
+    map.invalidateRadar(location_);
+    map.invalidateTerrain(location_);
+
     terrainTile_ = TERRAINTILETYPE::TerrainTile_Invalid;
     map.for_each_neighbor(location_.x, location_.y,
                           [](Tile& t) { t.terrainTile_ = TERRAINTILETYPE::TerrainTile_Invalid; });
@@ -734,6 +806,15 @@ void Tile::setSpice(FixPoint newSpice) {
         type_ = TERRAINTYPE::Terrain_Spice;
     }
     spice_ = newSpice;
+
+    invalidateRadar(location_);
+    invalidateTerrain(location_);
+}
+
+void Tile::setDestroyedStructureTile(int newDestroyedStructureTile) {
+    destroyedStructureTile_ = newDestroyedStructureTile;
+
+    invalidateTerrain(location_);
 }
 
 AirUnit* Tile::getAirUnit(const ObjectManager& objectManager) const {
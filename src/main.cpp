@@ -331,6 +331,7 @@ void load_settings(const INIFile& myINIFile) {
     settings.general.language          = myINIFile.getStringValue("General", "Language", "en");
     settings.general.scrollSpeed       = myINIFile.getIntValue("General", "Scroll Speed", 50);
     settings.general.showTutorialHints = myINIFile.getBoolValue("General", "Show Tutorial Hints", true);
+    settings.general.autosaveInterval  = myINIFile.getIntValue("General", "Autosave Interval", 5);
     settings.video.width               = myINIFile.getIntValue("Video", "Width", 640);
     settings.video.height              = myINIFile.getIntValue("Video", "Height", 480);
     settings.video.physicalWidth       = myINIFile.getIntValue("Video", "Physical Width", 640);
@@ -342,6 +343,7 @@ void load_settings(const INIFile& myINIFile) {
     settings.video.rotateUnitGraphics  = myINIFile.getBoolValue("Video", "RotateUnitGraphics", false);
     settings.video.renderer            = myINIFile.getStringValue("Video", "Renderer", "default");
     settings.video.typeface            = myINIFile.getStringValue("Video", "Typeface", "default");
+    settings.video.dirtyRegions        = myINIFile.getBoolValue("Video", "Dirty Regions", true);
     settings.audio.musicType           = myINIFile.getStringValue("Audio", "Music Type", "adl");
     settings.audio.playMusic           = myINIFile.getBoolValue("Audio", "Play Music", true);
     settings.audio.musicVolume         = myINIFile.getIntValue("Audio", "Music Volume", 64);
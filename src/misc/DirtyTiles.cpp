@@ -0,0 +1,49 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/DirtyTiles.h>
+
+#include <algorithm>
+
+namespace dune {
+
+DirtyTiles::DirtyTiles(int sizeX, int sizeY) {
+    reset(sizeX, sizeY);
+}
+
+void DirtyTiles::reset(int sizeX, int sizeY) {
+    sizeX_ = std::max(sizeX, 0);
+    sizeY_ = std::max(sizeY, 0);
+
+    flags_.assign(static_cast<size_t>(sizeX_) * sizeY_, 0);
+    tiles_.clear();
+    bands_.assign((sizeY_ + band_height - 1) / band_height, SDL_Rect{});
+
+    all_ = true;
+}
+
+void DirtyTiles::clear() {
+    for (const auto index : tiles_)
+        flags_[index] = 0;
+
+    tiles_.clear();
+    std::ranges::fill(bands_, SDL_Rect{});
+
+    all_ = false;
+}
+
+} // namespace dune
@@ -21,6 +21,7 @@
 
 #include <SDL2/SDL_endian.h>
 
+#include <algorithm>
 #include <cmath>
 
 #ifdef _WIN32
@@ -30,7 +31,8 @@
 #    include <Windows.h>
 #endif
 
-IFileStream::IFileStream() : fp(nullptr), sizeBytes_(0), bytePos_(0) { }
+IFileStream::IFileStream()
+    : fp(nullptr), sizeBytes_(0), bytePos_(0), buffer_(std::make_unique<uint8_t[]>(BUFFER_SIZE)) { }
 
 IFileStream::~IFileStream() {
     close();
@@ -47,12 +49,16 @@ bool IFileStream::open(const std::filesystem::path& filename) {
     fp = fopen(normal.c_str(), "rb");
 #endif
 
+    if (fp == nullptr) {
+        return false;
+    }
+
     fseek(fp, 0, SEEK_END);
     sizeBytes_ = ftell(fp);
     fseek(fp, 0, SEEK_SET);
     bytePos_ = 0;
 
-    return fp != nullptr;
+    return true;
 }
 
 void IFileStream::close() {
@@ -61,87 +67,44 @@ void IFileStream::close() {
         fp         = nullptr;
         sizeBytes_ = 0;
         bytePos_   = 0;
+        bufferPos_ = 0;
+        bufferEnd_ = 0;
     }
 }
 
 std::string IFileStream::readString() {
-    uint32_t length = 0;
-
-    length = readUint32();
+    const auto length = readUint32();
 
     if (length == 0) {
         return "";
     }
-    std::string str;
-
-    str.resize(length);
 
-    if (fread(str.data(), length, 1, fp) != 1) {
-        if (feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readString(): End-of-File reached!");
-        }
-        THROW(InputStream::error, "IFileStream::readString(): An I/O-Error occurred!");
+    if (length > bytesLeft()) {
+        THROW(InputStream::eof, "IFileStream::readString(): End-of-File reached!");
     }
 
-    bytePos_ += length;
+    std::string str;
+    str.resize(length);
+
+    read(reinterpret_cast<uint8_t*>(str.data()), length, "readString");
 
     return str;
 }
 
 uint8_t IFileStream::readUint8() {
-    uint8_t tmp = 0;
-    if (fread(&tmp, sizeof(uint8_t), 1, fp) != 1) {
-        if (feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint8(): End-of-File reached!");
-        }
-        THROW(InputStream::error, "IFileStream::readUint8(): An I/O-Error occurred!");
-    }
-
-    bytePos_ += sizeof(uint8_t);
-
-    return tmp;
+    return get<uint8_t>("readUint8");
 }
 
 uint16_t IFileStream::readUint16() {
-    uint16_t tmp = 0;
-    if (fread(&tmp, sizeof(uint16_t), 1, fp) != 1) {
-        if (feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint16(): End-of-File reached!");
-        }
-        THROW(InputStream::error, "IFileStream::readUint16(): An I/O-Error occurred!");
-    }
-
-    bytePos_ += sizeof(uint16_t);
-
-    return SDL_SwapLE16(tmp);
+    return SDL_SwapLE16(get<uint16_t>("readUint16"));
 }
 
 uint32_t IFileStream::readUint32() {
-    uint32_t tmp = 0;
-    if (fread(&tmp, sizeof(uint32_t), 1, fp) != 1) {
-        if (feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint32(): End-of-File reached!");
-        }
-        THROW(InputStream::error, "IFileStream::readUint32(): An I/O-Error occurred!");
-    }
-
-    bytePos_ += sizeof(uint32_t);
-
-    return SDL_SwapLE32(tmp);
+    return SDL_SwapLE32(get<uint32_t>("readUint32"));
 }
 
 uint64_t IFileStream::readUint64() {
-    uint64_t tmp = 0;
-    if (fread(&tmp, sizeof(uint64_t), 1, fp) != 1) {
-        if (feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint64(): End-of-File reached!");
-        }
-        THROW(InputStream::error, "IFileStream::readUint64(): An I/O-Error occurred!");
-    }
-
-    bytePos_ += sizeof(uint64_t);
-
-    return SDL_SwapLE64(tmp);
+    return SDL_SwapLE64(get<uint64_t>("readUint64"));
 }
 
 bool IFileStream::readBool() {
@@ -157,3 +120,47 @@ float IFileStream::readFloat() {
     memcpy(&tmp2, &tmp, sizeof(uint32_t)); // workaround for a strange optimization in gcc 4.1
     return tmp2;
 }
+
+void IFileStream::readBytes(std::span<uint8_t> data) {
+    read(data.data(), data.size(), "readBytes");
+}
+
+void IFileStream::read(uint8_t* data, size_t size, const char* caller) {
+    while (size > 0) {
+        if (bufferPos_ == bufferEnd_) {
+            if (size >= BUFFER_SIZE) {
+                // large blocks bypass the buffer
+                if (fp == nullptr || fread(data, size, 1, fp) != 1) {
+                    if (fp == nullptr || feof(fp) != 0) {
+                        THROW(InputStream::eof, "IFileStream::{}(): End-of-File reached!", caller);
+                    }
+                    THROW(InputStream::error, "IFileStream::{}(): An I/O-Error occurred!", caller);
+                }
+                bytePos_ += static_cast<long>(size);
+                return;
+            }
+
+            fillBuffer(caller);
+        }
+
+        const auto count = std::min(size, bufferEnd_ - bufferPos_);
+        std::memcpy(data, buffer_.get() + bufferPos_, count);
+
+        data += count;
+        size -= count;
+        bufferPos_ += count;
+        bytePos_ += static_cast<long>(count);
+    }
+}
+
+void IFileStream::fillBuffer(const char* caller) {
+    bufferPos_ = 0;
+    bufferEnd_ = fp == nullptr ? 0 : fread(buffer_.get(), 1, BUFFER_SIZE, fp);
+
+    if (bufferEnd_ == 0) {
+        if (fp == nullptr || feof(fp) != 0) {
+            THROW(InputStream::eof, "IFileStream::{}(): End-of-File reached!", caller);
+        }
+        THROW(InputStream::error, "IFileStream::{}(): An I/O-Error occurred!", caller);
+    }
+}
@@ -69,3 +69,14 @@ float IMemoryStream::readFloat() {
     memcpy(&tmp2, &tmp, sizeof(uint32_t)); // workaround for a strange optimization in gcc 4.1
     return tmp2;
 }
+
+void IMemoryStream::readBytes(std::span<uint8_t> data) {
+    if (data.size() > bufferSize - currentPos) {
+        THROW(InputStream::eof, "IMemoryStream::readBytes(): End-of-File reached!");
+    }
+
+    if (!data.empty()) {
+        memcpy(data.data(), pBuffer + currentPos, data.size());
+    }
+    currentPos += data.size();
+}
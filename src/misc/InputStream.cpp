@@ -1,5 +1,9 @@
 #include "misc/InputStream.h"
 
+#include "misc/exceptions.h"
+
+#include <algorithm>
+
 InputStream::InputStream()  = default;
 InputStream::~InputStream() = default;
 
@@ -45,6 +49,24 @@ void InputStream::readBools(bool* pVal1, bool* pVal2, bool* pVal3, bool* pVal4,
         *pVal8 = (val & 0x80) != 0;
 }
 
+void InputStream::readBytes(std::span<uint8_t> data) {
+    for (auto& x : data) {
+        x = readUint8();
+    }
+}
+
+void InputStream::readUint32s(std::span<uint32_t> data) {
+    readBytes({reinterpret_cast<uint8_t*>(data.data()), data.size_bytes()});
+
+#if SDL_BYTEORDER != SDL_LIL_ENDIAN
+    std::ranges::transform(data, data.begin(), [](auto x) { return SDL_SwapLE32(x); });
+#endif
+}
+
+void InputStream::readSint32s(std::span<int32_t> data) {
+    readUint32s({reinterpret_cast<uint32_t*>(data.data()), data.size()});
+}
+
 std::vector<uint8_t> InputStream::readUint8Vector() {
     std::vector<uint8_t> vec;
     readUint8Vector(vec);
@@ -53,21 +75,23 @@ std::vector<uint8_t> InputStream::readUint8Vector() {
 }
 
 void InputStream::readUint8Vector(std::vector<uint8_t>& vec) {
-    vec.clear();
     const auto size = readUint32();
-    vec.reserve(size);
-    for (unsigned int i = 0; i < size; i++) {
-        vec.push_back(readUint8());
+    if (size > bytesLeft()) {
+        THROW(InputStream::eof, "InputStream::readUint8Vector(): End-of-File reached!");
     }
+
+    vec.resize(size);
+    readBytes(vec);
 }
 
 void InputStream::readUint32Vector(std::vector<uint32_t>& vec) {
-    vec.clear();
     const auto size = readUint32();
-    vec.reserve(size);
-    for (unsigned int i = 0; i < size; i++) {
-        vec.push_back(readUint32());
+    if (size > bytesLeft() / sizeof(uint32_t)) {
+        THROW(InputStream::eof, "InputStream::readUint32Vector(): End-of-File reached!");
     }
+
+    vec.resize(size);
+    readUint32s(vec);
 }
 
 std::vector<uint32_t> InputStream::readUint32Vector() {
@@ -0,0 +1,116 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/MappedFile.h>
+
+#include <misc/exceptions.h>
+#include <misc/string_error.h>
+
+#include <gsl/gsl>
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <Windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& filename) {
+    const auto hFile = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot open '{}'!", filename.string());
+    }
+
+    // the mapping keeps the file open
+    auto cleanup = gsl::finally([hFile] { CloseHandle(hFile); });
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize)) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot determine the size of '{}'!", filename.string());
+    }
+
+    size_ = gsl::narrow<size_t>(fileSize.QuadPart);
+    if (size_ == 0) {
+        return;
+    }
+
+    hMapping_ = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (hMapping_ == nullptr) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot map '{}'!", filename.string());
+    }
+
+    pData_ = static_cast<const uint8_t*>(MapViewOfFile(hMapping_, FILE_MAP_READ, 0, 0, 0));
+    if (pData_ == nullptr) {
+        CloseHandle(hMapping_);
+        THROW(io_error, "MappedFile::MappedFile(): Cannot map '{}'!", filename.string());
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (pData_ != nullptr) {
+        UnmapViewOfFile(pData_);
+    }
+    if (hMapping_ != nullptr) {
+        CloseHandle(hMapping_);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& filename) {
+    const auto fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot open '{}': {}", filename.string(), dune::string_error(errno));
+    }
+
+    // the mapping keeps the file open
+    auto cleanup = gsl::finally([fd] { ::close(fd); });
+
+    struct stat fileStat { };
+    if (fstat(fd, &fileStat) != 0) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot determine the size of '{}': {}", filename.string(),
+              dune::string_error(errno));
+    }
+
+    size_ = gsl::narrow<size_t>(fileStat.st_size);
+    if (size_ == 0) {
+        return;
+    }
+
+    auto* const pData = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (pData == MAP_FAILED) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot map '{}': {}", filename.string(), dune::string_error(errno));
+    }
+
+    pData_ = static_cast<const uint8_t*>(pData);
+}
+
+MappedFile::~MappedFile() {
+    if (pData_ != nullptr) {
+        munmap(const_cast<uint8_t*>(pData_), size_);
+    }
+}
+
+#endif
@@ -23,6 +23,8 @@
 
 #include <gsl/gsl>
 
+#include <utility>
+
 #ifdef _WIN32
 #    ifndef WIN32_LEAN_AND_MEAN
 #        define WIN32_LEAN_AND_MEAN
@@ -30,10 +32,14 @@
 #    include <Windows.h>
 #endif
 
-OFileStream::OFileStream() = default;
+OFileStream::OFileStream() : buffer_(std::make_unique<uint8_t[]>(BUFFER_SIZE)) { }
 
 OFileStream::~OFileStream() {
-    close();
+    try {
+        close();
+    } catch (std::exception& e) {
+        sdl2::log_info("OFileStream::~OFileStream(): {}", e.what());
+    }
 }
 
 bool OFileStream::open(const std::filesystem::path& filename) {
@@ -51,55 +57,58 @@ bool OFileStream::open(const std::filesystem::path& filename) {
 }
 
 void OFileStream::close() {
-    if (fp != nullptr) {
+    if (fp == nullptr) {
+        bufferUsed_ = 0;
+        return;
+    }
+
+    auto cleanup = gsl::finally([&] {
         fclose(fp);
         fp = nullptr;
-    }
+    });
+
+    flushBuffer();
 }
 
 void OFileStream::flush() {
     if (fp != nullptr) {
+        flushBuffer();
         fflush(fp);
     }
 }
 
+void OFileStream::flushBuffer() {
+    if (bufferUsed_ == 0) {
+        return;
+    }
+
+    const auto size = std::exchange(bufferUsed_, 0);
+
+    if (fp == nullptr || fwrite(buffer_.get(), size, 1, fp) != 1) {
+        THROW(OutputStream::error, "OFileStream::flushBuffer(): An I/O-Error occurred!");
+    }
+}
+
 void OFileStream::writeString(std::string_view str) {
     writeUint32(gsl::narrow<uint32_t>(str.length()));
 
-    if (!str.empty()) {
-        if (fwrite(str.data(), str.length(), 1, fp) != 1) {
-            THROW(OutputStream::error, "OFileStream::writeString(): An I/O-Error occurred!");
-        }
-    }
+    writeBytes({reinterpret_cast<const uint8_t*>(str.data()), str.length()});
 }
 
 void OFileStream::writeUint8(uint8_t x) {
-    if (fwrite(&x, sizeof(uint8_t), 1, fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint8(): An I/O-Error occurred!");
-    }
+    put(x);
 }
 
 void OFileStream::writeUint16(uint16_t x) {
-    x = SDL_SwapLE16(x);
-
-    if (fwrite(&x, sizeof(uint16_t), 1, fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint16(): An I/O-Error occurred!");
-    }
+    put(SDL_SwapLE16(x));
 }
 
 void OFileStream::writeUint32(uint32_t x) {
-    x = SDL_SwapLE32(x);
-
-    if (fwrite(&x, sizeof(uint32_t), 1, fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint32(): An I/O-Error occurred!");
-    }
+    put(SDL_SwapLE32(x));
 }
 
 void OFileStream::writeUint64(uint64_t x) {
-    x = SDL_SwapLE64(x);
-    if (fwrite(&x, sizeof(uint64_t), 1, fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint64(): An I/O-Error occurred!");
-    }
+    put(SDL_SwapLE64(x));
 }
 
 void OFileStream::writeBool(bool x) {
@@ -111,3 +120,28 @@ void OFileStream::writeFloat(float x) {
     memcpy(&tmp, &x, sizeof(uint32_t)); // workaround for a strange optimization in gcc 4.1
     writeUint32(tmp);
 }
+
+void OFileStream::writeBytes(std::span<const uint8_t> data) {
+    if (data.empty()) {
+        return;
+    }
+
+    if (bufferUsed_ + data.size() <= BUFFER_SIZE) {
+        std::memcpy(buffer_.get() + bufferUsed_, data.data(), data.size());
+        bufferUsed_ += data.size();
+        return;
+    }
+
+    flushBuffer();
+
+    // large blocks bypass the buffer
+    if (data.size() >= BUFFER_SIZE) {
+        if (fp == nullptr || fwrite(data.data(), data.size(), 1, fp) != 1) {
+            THROW(OutputStream::error, "OFileStream::writeBytes(): An I/O-Error occurred!");
+        }
+        return;
+    }
+
+    std::memcpy(buffer_.get(), data.data(), data.size());
+    bufferUsed_ = data.size();
+}
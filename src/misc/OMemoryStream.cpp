@@ -1,98 +1,90 @@
-#include "misc/OMemoryStream.h"
-
-#include <cstdlib>
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/OMemoryStream.h>
+
+#include <SDL2/SDL_endian.h>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+template<typename T>
+void append(std::vector<uint8_t>& buffer, T x) {
+    const auto pos = buffer.size();
+    buffer.resize(pos + sizeof(T));
+    memcpy(buffer.data() + pos, &x, sizeof(T));
+}
+} // namespace
 
 OMemoryStream::OMemoryStream() = default;
 
-OMemoryStream::~OMemoryStream() {
-    free(pBuffer);
-}
+OMemoryStream::~OMemoryStream() = default;
 
 void OMemoryStream::open() {
-    free(pBuffer);
-
-    currentPos = 0;
-    bufferSize = 4;
-    pBuffer    = static_cast<char*>(malloc(4));
-    if(pBuffer == nullptr) {
-        THROW(OMemoryStream::error, "OMemoryStream::open(): malloc failed!");
-    }
-}
-
-void OMemoryStream::writeUint8(Uint8 x) {
-    ensureBufferSize(currentPos + sizeof(Uint8));
-    *reinterpret_cast<Uint8*>(pBuffer + currentPos) = x;
-    currentPos += sizeof(Uint8);
-}
-
-void OMemoryStream::writeFloat(float x) {
-    if constexpr(sizeof(float) != sizeof(Uint32)) {
-        THROW(OMemoryStream::error,
-              "OMemoryStream::writeFloat(): sizeof(float) != sizeof(Uint32). Cannot save floats on such systems.");
-    }
-    Uint32 tmp;
-    memcpy(&tmp, &x, sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
-    writeUint32(tmp);
+    buffer.clear();
 }
 
 void OMemoryStream::ensureBufferSize(size_t minBufferSize) {
-    if(minBufferSize < bufferSize) {
+    if (minBufferSize <= buffer.capacity()) {
         return;
     }
 
-    size_t newBufferSize = ((bufferSize * 3) / 2);
-    if(newBufferSize < minBufferSize) {
-        newBufferSize = minBufferSize;
-    }
-
-    auto* const pNewBuffer = static_cast<char*>(realloc(pBuffer, newBufferSize));
-    if(pNewBuffer == nullptr) {
-        THROW(OMemoryStream::error, "OMemoryStream::ensureBufferSize(): realloc failed!");
-    }
-    pBuffer    = pNewBuffer;
-    bufferSize = newBufferSize;
+    buffer.reserve(std::max(minBufferSize, (buffer.capacity() * 3) / 2));
 }
 
 void OMemoryStream::flush() { }
 
-void OMemoryStream::writeString(const std::string& str) {
-    ensureBufferSize(currentPos + str.length() + sizeof(Uint32));
+void OMemoryStream::writeString(std::string_view str) {
+    ensureBufferSize(buffer.size() + str.length() + sizeof(uint32_t));
 
-    writeUint32(str.length());
+    writeUint32(gsl::narrow<uint32_t>(str.length()));
 
-    if(!str.empty()) {
-        memcpy(pBuffer + currentPos, str.c_str(), str.length());
-        currentPos += str.length();
-    }
+    buffer.insert(buffer.end(), str.begin(), str.end());
 }
 
-void OMemoryStream::writeUint16(Uint16 x) {
-    ensureBufferSize(currentPos + sizeof(Uint16));
-
-    x = SDL_SwapLE16(x);
-
-    *reinterpret_cast<Uint16*>(pBuffer + currentPos) = x;
-    currentPos += sizeof(Uint16);
+void OMemoryStream::writeUint8(uint8_t x) {
+    buffer.push_back(x);
 }
 
-void OMemoryStream::writeUint32(Uint32 x) {
-    ensureBufferSize(currentPos + sizeof(Uint32));
-
-    x = SDL_SwapLE32(x);
+void OMemoryStream::writeUint16(uint16_t x) {
+    append(buffer, SDL_SwapLE16(x));
+}
 
-    *reinterpret_cast<Uint32*>(pBuffer + currentPos) = x;
-    currentPos += sizeof(Uint32);
+void OMemoryStream::writeUint32(uint32_t x) {
+    append(buffer, SDL_SwapLE32(x));
 }
 
-void OMemoryStream::writeUint64(Uint64 x) {
-    ensureBufferSize(currentPos + sizeof(Uint64));
+void OMemoryStream::writeUint64(uint64_t x) {
+    append(buffer, SDL_SwapLE64(x));
+}
 
-    x = SDL_SwapLE64(x);
+void OMemoryStream::writeBool(bool x) {
+    writeUint8(x ? 1 : 0);
+}
 
-    *reinterpret_cast<Uint64*>(pBuffer + currentPos) = x;
-    currentPos += sizeof(Uint64);
+void OMemoryStream::writeFloat(float x) {
+    uint32_t tmp = 0;
+    memcpy(&tmp, &x, sizeof(uint32_t));
+    writeUint32(tmp);
 }
 
-void OMemoryStream::writeBool(bool x) {
-    writeUint8(x == true ? 1 : 0);
+void OMemoryStream::writeBytes(std::span<const uint8_t> data) {
+    buffer.insert(buffer.end(), data.begin(), data.end());
 }
@@ -1,5 +1,8 @@
 #include "misc/OutputStream.h"
 
+#include <algorithm>
+#include <array>
+
 OutputStream::OutputStream()  = default;
 OutputStream::~OutputStream() = default;
 
@@ -33,18 +36,39 @@ void OutputStream::writeBools(bool val1, bool val2, bool val3, bool val4, bool v
     writeUint8(val);
 }
 
+void OutputStream::writeBytes(std::span<const uint8_t> data) {
+    for (const auto x : data) {
+        writeUint8(x);
+    }
+}
+
+void OutputStream::writeUint32s(std::span<const uint32_t> data) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    writeBytes({reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()});
+#else
+    // swap in small blocks to keep the number of virtual calls low
+    std::array<uint32_t, 256> buffer;
+    while (!data.empty()) {
+        const auto count = std::min(data.size(), buffer.size());
+        std::transform(data.begin(), data.begin() + count, buffer.begin(), [](auto x) { return SDL_SwapLE32(x); });
+        writeBytes({reinterpret_cast<const uint8_t*>(buffer.data()), count * sizeof(uint32_t)});
+        data = data.subspan(count);
+    }
+#endif
+}
+
+void OutputStream::writeSint32s(std::span<const int32_t> data) {
+    writeUint32s({reinterpret_cast<const uint32_t*>(data.data()), data.size()});
+}
+
 void OutputStream::writeUint8Vector(std::span<const uint8_t> dataVector) {
     writeUint32(static_cast<uint32_t>(dataVector.size()));
-    for (const auto data : dataVector) {
-        writeUint8(data);
-    }
+    writeBytes(dataVector);
 }
 
 void OutputStream::writeUint32Vector(std::span<const uint32_t> dataVector) {
     writeUint32(static_cast<uint32_t>(dataVector.size()));
-    for (const auto data : dataVector) {
-        writeUint32(data);
-    }
+    writeUint32s(dataVector);
 }
 
 void OutputStream::writeUint32Set(const dune::selected_set_type& dataSet) {
@@ -0,0 +1,53 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/RWopsData.h>
+
+#include <FileClasses/Pakfile.h>
+#include <misc/exceptions.h>
+
+#include <gsl/gsl>
+
+RWopsData::RWopsData(SDL_RWops* rwop) {
+    if (rwop == nullptr) {
+        THROW(std::invalid_argument, "RWopsData::RWopsData(): rwop == nullptr!");
+    }
+
+    if (const auto data = Pakfile::readFileData(rwop)) {
+        data_ = *data;
+        return;
+    }
+
+    const auto size     = SDL_RWsize(rwop);
+    const auto position = SDL_RWtell(rwop);
+    if (size < 0 || position < 0 || position > size) {
+        THROW(std::runtime_error, "RWopsData::RWopsData(): Cannot determine the size of the data: {}", SDL_GetError());
+    }
+
+    const auto length = gsl::narrow<size_t>(size - position);
+    if (length == 0) {
+        return;
+    }
+
+    buffer_ = std::make_unique<uint8_t[]>(length);
+
+    if (SDL_RWread(rwop, buffer_.get(), length, 1) != 1) {
+        THROW(std::runtime_error, "RWopsData::RWopsData(): Reading the data failed: {}", SDL_GetError());
+    }
+
+    data_ = {buffer_.get(), length};
+}
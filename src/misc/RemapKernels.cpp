@@ -0,0 +1,282 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/RemapKernels.h>
+
+#include <misc/exceptions.h>
+#include <misc/simd_support.h>
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace {
+
+using dune::remap::ColorMap;
+using dune::remap::InstructionSet;
+
+/// A target of remap() with the row that is currently remapped
+struct RowTarget {
+    const ColorMap* map;
+    uint8_t* dst;
+    uint16_t groups; ///< bit i is set if one of the colors 16 * i to 16 * i + 15 is changed by the map
+};
+
+using remap_row_type = void (*)(const uint8_t* src, int width, std::span<const RowTarget> targets);
+
+// The source may also be the destination of a single target, so the kernels must not use RESTRICT
+
+void remap_pixels(const uint8_t* src, int begin, int end, std::span<const RowTarget> targets) {
+    for (const auto& target : targets) {
+        const auto& table = target.map->table();
+
+        for (auto x = begin; x < end; ++x)
+            target.dst[x] = table[src[x]];
+    }
+}
+
+void remap_row_scalar(const uint8_t* src, int width, std::span<const RowTarget> targets) {
+    remap_pixels(src, 0, width, targets);
+}
+
+/// Without a byte shuffle every changed color costs a compare and a select, so only sparse maps are vectorized.
+constexpr size_t max_vector_compares = 8;
+
+/// With a byte shuffle every group of 16 colors with changes costs a lookup, a compare and a blend.
+constexpr int max_vector_lookups = 8;
+
+// The vectorized kernels remap the row into one target after the other. The row stays in the cache, so the source
+// is still only read from memory once.
+
+#ifdef DUNE_HAVE_SSE2
+
+void remap_row_sse2(const uint8_t* src, int width, std::span<const RowTarget> targets) {
+    const auto vector_end = width - width % 16;
+
+    for (const auto& target : targets) {
+        const auto changed = target.map->changed();
+
+        if (changed.size() > max_vector_compares) {
+            remap_pixels(src, 0, width, {&target, 1});
+            continue;
+        }
+
+        __m128i from[max_vector_compares];
+        __m128i to[max_vector_compares];
+        for (auto i = 0u; i < changed.size(); ++i) {
+            from[i] = _mm_set1_epi8(static_cast<char>(changed[i]));
+            to[i]   = _mm_set1_epi8(static_cast<char>((*target.map)[changed[i]]));
+        }
+
+        for (auto x = 0; x < vector_end; x += 16) {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+
+            auto result = v;
+            for (auto i = 0u; i < changed.size(); ++i) {
+                const auto mask = _mm_cmpeq_epi8(v, from[i]);
+
+                result = _mm_or_si128(_mm_and_si128(mask, to[i]), _mm_andnot_si128(mask, result));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(target.dst + x), result);
+        }
+
+        remap_pixels(src, vector_end, width, {&target, 1});
+    }
+}
+
+#endif // DUNE_HAVE_SSE2
+
+#ifdef DUNE_HAVE_AVX2
+
+/**
+    The 256 entry table is split into 16 groups of 16 entries, one per high nibble. Each group is looked up with a byte
+    shuffle of the low nibbles and blended in where the high nibble matches. Groups without changed colors are skipped,
+    so a house color map only needs a single lookup.
+*/
+DUNE_TARGET_AVX2 void remap_row_avx2(const uint8_t* src, int width, std::span<const RowTarget> targets) {
+    const auto vector_end = width - width % 32;
+    const auto low_nibble = _mm256_set1_epi8(0x0f);
+
+    for (const auto& target : targets) {
+        if (std::popcount(target.groups) > max_vector_lookups) {
+            remap_pixels(src, 0, width, {&target, 1});
+            continue;
+        }
+
+        const auto* const table = target.map->table().data();
+
+        __m256i entries[max_vector_lookups];
+        __m256i high_nibbles[max_vector_lookups];
+
+        auto count = 0;
+        for (auto groups = static_cast<unsigned>(target.groups); groups; groups &= groups - 1, ++count) {
+            const auto group = std::countr_zero(groups);
+
+            entries[count] =
+                _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * group)));
+            high_nibbles[count] = _mm256_set1_epi8(static_cast<char>(group));
+        }
+
+        for (auto x = 0; x < vector_end; x += 32) {
+            const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x));
+
+            const auto lo = _mm256_and_si256(v, low_nibble);
+            const auto hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibble);
+
+            auto result = v;
+            for (auto i = 0; i < count; ++i) {
+                result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(entries[i], lo),
+                                            _mm256_cmpeq_epi8(hi, high_nibbles[i]));
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(target.dst + x), result);
+        }
+
+        remap_pixels(src, vector_end, width, {&target, 1});
+    }
+}
+
+#endif // DUNE_HAVE_AVX2
+
+#ifdef DUNE_HAVE_NEON
+
+void remap_row_neon(const uint8_t* src, int width, std::span<const RowTarget> targets) {
+    const auto vector_end = width - width % 16;
+
+    for (const auto& target : targets) {
+        const auto changed = target.map->changed();
+
+        if (changed.size() > max_vector_compares) {
+            remap_pixels(src, 0, width, {&target, 1});
+            continue;
+        }
+
+        uint8x16_t from[max_vector_compares];
+        uint8x16_t to[max_vector_compares];
+        for (auto i = 0u; i < changed.size(); ++i) {
+            from[i] = vdupq_n_u8(changed[i]);
+            to[i]   = vdupq_n_u8((*target.map)[changed[i]]);
+        }
+
+        for (auto x = 0; x < vector_end; x += 16) {
+            const auto v = vld1q_u8(src + x);
+
+            auto result = v;
+            for (auto i = 0u; i < changed.size(); ++i)
+                result = vbslq_u8(vceqq_u8(v, from[i]), to[i], result);
+
+            vst1q_u8(target.dst + x, result);
+        }
+
+        remap_pixels(src, vector_end, width, {&target, 1});
+    }
+}
+
+#endif // DUNE_HAVE_NEON
+
+remap_row_type remap_row(InstructionSet set) {
+    if (!dune::scaler::is_supported(set))
+        THROW(std::invalid_argument, "The remap kernels for {} are not supported by this CPU!",
+              dune::scaler::instruction_set_name(set));
+
+    switch (set) {
+#ifdef DUNE_HAVE_SSE2
+        case InstructionSet::SSE2: return remap_row_sse2;
+#endif
+#ifdef DUNE_HAVE_AVX2
+        case InstructionSet::AVX2: return remap_row_avx2;
+#endif
+#ifdef DUNE_HAVE_NEON
+        case InstructionSet::NEON: return remap_row_neon;
+#endif
+        default: return remap_row_scalar;
+    }
+}
+
+} // namespace
+
+namespace dune::remap {
+
+ColorMap::ColorMap() {
+    for (auto i = 0; i < 256; ++i)
+        map_[i] = static_cast<uint8_t>(i);
+}
+
+ColorMap::ColorMap(const uint8_t map[256]) {
+    std::copy_n(map, 256, map_.begin());
+
+    update_changed();
+}
+
+ColorMap ColorMap::range(int src_color, int dest_color) {
+    ColorMap map;
+
+    const auto offset = static_cast<uint8_t>(src_color - dest_color);
+
+    for (auto color = std::max(0, src_color); color < std::min(256, src_color + 7); ++color)
+        map.map_[color] = static_cast<uint8_t>(color - offset);
+
+    map.update_changed();
+
+    return map;
+}
+
+ColorMap& ColorMap::set(uint8_t from, uint8_t to) {
+    map_[from] = to;
+
+    update_changed();
+
+    return *this;
+}
+
+void ColorMap::update_changed() {
+    num_changed_ = 0;
+
+    for (auto i = 0; i < 256; ++i) {
+        if (map_[i] != i)
+            changed_[num_changed_++] = static_cast<uint8_t>(i);
+    }
+}
+
+void remap(InstructionSet set, const uint8_t* src, int src_pitch, int width, int height,
+           std::span<const Target> targets) {
+    const auto row = remap_row(set);
+
+    if (width <= 0 || height <= 0 || targets.empty())
+        return;
+
+    std::vector<RowTarget> rows;
+    rows.reserve(targets.size());
+
+    for (const auto& target : targets) {
+        uint16_t groups = 0;
+        for (const auto color : target.map->changed())
+            groups |= static_cast<uint16_t>(1u << (color >> 4));
+
+        rows.push_back({target.map, target.pixels, groups});
+    }
+
+    for (auto y = 0; y < height; ++y) {
+        row(src + static_cast<ptrdiff_t>(y) * src_pitch, width, rows);
+
+        for (auto i = 0u; i < rows.size(); ++i)
+            rows[i].dst += targets[i].pitch;
+    }
+}
+
+} // namespace dune::remap
@@ -0,0 +1,768 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/ScalerKernels.h>
+
+#include <Definitions.h>
+
+#include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
+#include <misc/simd_support.h>
+
+#include <SDL2/SDL_cpuinfo.h>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using dune::scaler::InstructionSet;
+
+/// Marks the first and the last column of every tile, so the vectorized kernels can clamp at the tile borders.
+class TileEdges final {
+public:
+    TileEdges(int width, int tile_width) : left_(width), right_(width) {
+        for (auto x = 0; x < width; ++x) {
+            left_[x]  = x % tile_width == 0 ? 0xff : 0;
+            right_[x] = x % tile_width == tile_width - 1 ? 0xff : 0;
+        }
+    }
+
+    [[nodiscard]] const uint8_t* left() const noexcept { return left_.data(); }
+    [[nodiscard]] const uint8_t* right() const noexcept { return right_.data(); }
+
+private:
+    std::vector<uint8_t> left_;
+    std::vector<uint8_t> right_;
+};
+
+/// The source rows around the current row, already clamped to the tile
+struct Rows {
+    const uint8_t* up;
+    const uint8_t* cur;
+    const uint8_t* down;
+    const uint8_t* left;  ///< 0xff in the first column of a tile
+    const uint8_t* right; ///< 0xff in the last column of a tile
+    int width;
+};
+
+using scale2x_row_type = void (*)(const Rows& rows, uint8_t* dst0, uint8_t* dst1);
+using scale3x_row_type = void (*)(const Rows& rows, uint8_t* dst0, uint8_t* dst1, uint8_t* dst2);
+using nn_row_type      = void (*)(const uint8_t* src, int width, uint8_t* dst);
+
+/*
+
+    Scale center pixel E into 4 or 9 new pixels (see http://scale2x.sourceforge.net/algorithm.html)
+
+        Source                                      Dest
+    +---+---+---+       +--+--+             +--+--+--+
+    | A | B | C |       |E0|E1|             |E0|E1|E2|
+    +---+---+---+       +--+--+             +--+--+--+
+    | D | E | F |   ->  |E2|E3|     or      |E3|E4|E5|
+    +---+---+---+       +--+--+             +--+--+--+
+    | G | H | I |                           |E6|E7|E8|
+    +---+---+---+                           +--+--+--+
+
+*/
+
+void scale2x_pixels(const Rows& r, int begin, int end, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1) {
+    for (auto x = begin; x < end; ++x) {
+        const auto E = r.cur[x];
+        const auto B = r.up[x];
+        const auto H = r.down[x];
+        const auto D = r.left[x] ? E : r.cur[x - 1];
+        const auto F = r.right[x] ? E : r.cur[x + 1];
+
+        if (B != H && D != F) {
+            dst0[2 * x]     = D == B ? D : E;
+            dst0[2 * x + 1] = B == F ? F : E;
+            dst1[2 * x]     = D == H ? D : E;
+            dst1[2 * x + 1] = H == F ? F : E;
+        } else {
+            dst0[2 * x]     = E;
+            dst0[2 * x + 1] = E;
+            dst1[2 * x]     = E;
+            dst1[2 * x + 1] = E;
+        }
+    }
+}
+
+void scale3x_pixels(const Rows& r, int begin, int end, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1,
+                    uint8_t* RESTRICT dst2) {
+    for (auto x = begin; x < end; ++x) {
+        const auto E = r.cur[x];
+        const auto B = r.up[x];
+        const auto H = r.down[x];
+        const auto D = r.left[x] ? E : r.cur[x - 1];
+        const auto F = r.right[x] ? E : r.cur[x + 1];
+        const auto A = r.left[x] ? B : r.up[x - 1];
+        const auto C = r.right[x] ? B : r.up[x + 1];
+        const auto G = r.left[x] ? H : r.down[x - 1];
+        const auto I = r.right[x] ? H : r.down[x + 1];
+
+        auto* const RESTRICT e0 = &dst0[3 * x];
+        auto* const RESTRICT e3 = &dst1[3 * x];
+        auto* const RESTRICT e6 = &dst2[3 * x];
+
+        if (B != H && D != F) {
+            e0[0] = D == B ? D : E;
+            e0[1] = (D == B && E != C) || (B == F && E != A) ? B : E;
+            e0[2] = B == F ? F : E;
+            e3[0] = (D == B && E != G) || (D == H && E != A) ? D : E;
+            e3[1] = E;
+            e3[2] = (B == F && E != I) || (H == F && E != C) ? F : E;
+            e6[0] = D == H ? D : E;
+            e6[1] = (D == H && E != I) || (H == F && E != G) ? H : E;
+            e6[2] = H == F ? F : E;
+        } else {
+            e0[0] = e0[1] = e0[2] = E;
+            e3[0] = e3[1] = e3[2] = E;
+            e6[0] = e6[1] = e6[2] = E;
+        }
+    }
+}
+
+void double_nn_pixels(const uint8_t* RESTRICT src, int begin, int end, uint8_t* RESTRICT dst) {
+    for (auto x = begin; x < end; ++x) {
+        dst[2 * x]     = src[x];
+        dst[2 * x + 1] = src[x];
+    }
+}
+
+void triple_nn_pixels(const uint8_t* RESTRICT src, int begin, int end, uint8_t* RESTRICT dst) {
+    for (auto x = begin; x < end; ++x) {
+        dst[3 * x]     = src[x];
+        dst[3 * x + 1] = src[x];
+        dst[3 * x + 2] = src[x];
+    }
+}
+
+void scale2x_row_scalar(const Rows& rows, uint8_t* dst0, uint8_t* dst1) {
+    scale2x_pixels(rows, 0, rows.width, dst0, dst1);
+}
+
+void scale3x_row_scalar(const Rows& rows, uint8_t* dst0, uint8_t* dst1, uint8_t* dst2) {
+    scale3x_pixels(rows, 0, rows.width, dst0, dst1, dst2);
+}
+
+void double_nn_row_scalar(const uint8_t* src, int width, uint8_t* dst) {
+    double_nn_pixels(src, 0, width, dst);
+}
+
+void triple_nn_row_scalar(const uint8_t* src, int width, uint8_t* dst) {
+    triple_nn_pixels(src, 0, width, dst);
+}
+
+/// Spreads three vectors of n bytes to a0 b0 c0 a1 b1 c1 ...
+void interleave3(const uint8_t* RESTRICT a, const uint8_t* RESTRICT b, const uint8_t* RESTRICT c, int n,
+                 uint8_t* RESTRICT out) {
+    for (auto i = 0; i < n; ++i) {
+        out[3 * i]     = a[i];
+        out[3 * i + 1] = b[i];
+        out[3 * i + 2] = c[i];
+    }
+}
+
+#ifdef DUNE_HAVE_SSE2
+
+inline __m128i load_sse2(const uint8_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+inline void store_sse2(uint8_t* p, __m128i v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+inline __m128i select_sse2(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128i when_sse2(__m128i cond, __m128i a, __m128i b) {
+    return _mm_and_si128(cond, _mm_cmpeq_epi8(a, b));
+}
+
+void scale2x_row_sse2(const Rows& r, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1) {
+    constexpr auto N = 16;
+
+    const auto ones = _mm_set1_epi8(-1);
+
+    // The first column of the row is always a tile edge, so the vector loop can read cur[x - 1]
+    scale2x_pixels(r, 0, 1, dst0, dst1);
+
+    auto x = 1;
+    for (; x + N < r.width; x += N) {
+        const auto E = load_sse2(r.cur + x);
+        const auto B = load_sse2(r.up + x);
+        const auto H = load_sse2(r.down + x);
+        const auto D = select_sse2(load_sse2(r.left + x), E, load_sse2(r.cur + x - 1));
+        const auto F = select_sse2(load_sse2(r.right + x), E, load_sse2(r.cur + x + 1));
+
+        const auto c = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(B, H), _mm_cmpeq_epi8(D, F)), ones);
+
+        const auto E0 = select_sse2(when_sse2(c, D, B), D, E);
+        const auto E1 = select_sse2(when_sse2(c, B, F), F, E);
+        const auto E2 = select_sse2(when_sse2(c, D, H), D, E);
+        const auto E3 = select_sse2(when_sse2(c, H, F), F, E);
+
+        store_sse2(dst0 + 2 * x, _mm_unpacklo_epi8(E0, E1));
+        store_sse2(dst0 + 2 * x + N, _mm_unpackhi_epi8(E0, E1));
+        store_sse2(dst1 + 2 * x, _mm_unpacklo_epi8(E2, E3));
+        store_sse2(dst1 + 2 * x + N, _mm_unpackhi_epi8(E2, E3));
+    }
+
+    scale2x_pixels(r, x, r.width, dst0, dst1);
+}
+
+void scale3x_row_sse2(const Rows& r, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1, uint8_t* RESTRICT dst2) {
+    constexpr auto N = 16;
+
+    const auto ones = _mm_set1_epi8(-1);
+
+    // SSE2 cannot shuffle bytes, so the results are spread to the three pixels per row from memory
+    alignas(16) std::array<std::array<uint8_t, N>, 9> e{};
+
+    scale3x_pixels(r, 0, 1, dst0, dst1, dst2);
+
+    auto x = 1;
+    for (; x + N < r.width; x += N) {
+        const auto left  = load_sse2(r.left + x);
+        const auto right = load_sse2(r.right + x);
+
+        const auto E = load_sse2(r.cur + x);
+        const auto B = load_sse2(r.up + x);
+        const auto H = load_sse2(r.down + x);
+        const auto D = select_sse2(left, E, load_sse2(r.cur + x - 1));
+        const auto F = select_sse2(right, E, load_sse2(r.cur + x + 1));
+        const auto A = select_sse2(left, B, load_sse2(r.up + x - 1));
+        const auto C = select_sse2(right, B, load_sse2(r.up + x + 1));
+        const auto G = select_sse2(left, H, load_sse2(r.down + x - 1));
+        const auto I = select_sse2(right, H, load_sse2(r.down + x + 1));
+
+        const auto c = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(B, H), _mm_cmpeq_epi8(D, F)), ones);
+
+        const auto DB = when_sse2(c, D, B);
+        const auto BF = when_sse2(c, B, F);
+        const auto DH = when_sse2(c, D, H);
+        const auto HF = when_sse2(c, H, F);
+
+        const auto ne = [&](__m128i v) { return _mm_andnot_si128(_mm_cmpeq_epi8(E, v), ones); };
+
+        const auto nA = ne(A);
+        const auto nC = ne(C);
+        const auto nG = ne(G);
+        const auto nI = ne(I);
+
+        const auto or_and = [](__m128i a, __m128i b, __m128i c, __m128i d) {
+            return _mm_or_si128(_mm_and_si128(a, b), _mm_and_si128(c, d));
+        };
+
+        store_sse2(e[0].data(), select_sse2(DB, D, E));
+        store_sse2(e[1].data(), select_sse2(or_and(DB, nC, BF, nA), B, E));
+        store_sse2(e[2].data(), select_sse2(BF, F, E));
+        store_sse2(e[3].data(), select_sse2(or_and(DB, nG, DH, nA), D, E));
+        store_sse2(e[4].data(), E);
+        store_sse2(e[5].data(), select_sse2(or_and(BF, nI, HF, nC), F, E));
+        store_sse2(e[6].data(), select_sse2(DH, D, E));
+        store_sse2(e[7].data(), select_sse2(or_and(DH, nI, HF, nG), H, E));
+        store_sse2(e[8].data(), select_sse2(HF, F, E));
+
+        interleave3(e[0].data(), e[1].data(), e[2].data(), N, dst0 + 3 * x);
+        interleave3(e[3].data(), e[4].data(), e[5].data(), N, dst1 + 3 * x);
+        interleave3(e[6].data(), e[7].data(), e[8].data(), N, dst2 + 3 * x);
+    }
+
+    scale3x_pixels(r, x, r.width, dst0, dst1, dst2);
+}
+
+void double_nn_row_sse2(const uint8_t* RESTRICT src, int width, uint8_t* RESTRICT dst) {
+    constexpr auto N = 16;
+
+    auto x = 0;
+    for (; x + N <= width; x += N) {
+        const auto v = load_sse2(src + x);
+
+        store_sse2(dst + 2 * x, _mm_unpacklo_epi8(v, v));
+        store_sse2(dst + 2 * x + N, _mm_unpackhi_epi8(v, v));
+    }
+
+    double_nn_pixels(src, x, width, dst);
+}
+
+#endif // DUNE_HAVE_SSE2
+
+#ifdef DUNE_HAVE_AVX2
+
+/// pshufb masks that spread 3 x 16 bytes to a0 b0 c0 a1 b1 c1 ...; -128 clears a byte
+constexpr auto make_interleave3_masks() {
+    std::array<std::array<std::array<int8_t, 16>, 3>, 3> masks{};
+
+    for (auto block = 0; block < 3; ++block) {
+        for (auto source = 0; source < 3; ++source) {
+            for (auto i = 0; i < 16; ++i) {
+                const auto n = 16 * block + i;
+
+                masks[block][source][i] = static_cast<int8_t>(n % 3 == source ? n / 3 : -128);
+            }
+        }
+    }
+
+    return masks;
+}
+
+/// pshufb masks that repeat every one of 16 bytes three times
+constexpr auto make_triple_masks() {
+    std::array<std::array<int8_t, 16>, 3> masks{};
+
+    for (auto block = 0; block < 3; ++block) {
+        for (auto i = 0; i < 16; ++i)
+            masks[block][i] = static_cast<int8_t>((16 * block + i) / 3);
+    }
+
+    return masks;
+}
+
+alignas(16) constexpr auto interleave3_masks = make_interleave3_masks();
+alignas(16) constexpr auto triple_masks      = make_triple_masks();
+
+DUNE_TARGET_AVX2 inline __m256i load_avx2(const uint8_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+DUNE_TARGET_AVX2 inline void store_avx2(uint8_t* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+DUNE_TARGET_AVX2 inline __m128i load_mask(const std::array<int8_t, 16>& mask) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask.data()));
+}
+
+DUNE_TARGET_AVX2 inline __m256i select_avx2(__m256i mask, __m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, mask);
+}
+
+DUNE_TARGET_AVX2 inline __m256i when_avx2(__m256i cond, __m256i a, __m256i b) {
+    return _mm256_and_si256(cond, _mm256_cmpeq_epi8(a, b));
+}
+
+DUNE_TARGET_AVX2 inline __m256i not_equal_avx2(__m256i a, __m256i b) {
+    return _mm256_xor_si256(_mm256_cmpeq_epi8(a, b), _mm256_set1_epi8(-1));
+}
+
+DUNE_TARGET_AVX2 inline __m256i or_and_avx2(__m256i a, __m256i b, __m256i c, __m256i d) {
+    return _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, d));
+}
+
+/// Stores a0 b0 a1 b1 ... a31 b31
+DUNE_TARGET_AVX2 inline void store_interleaved2_avx2(uint8_t* out, __m256i a, __m256i b) {
+    // unpack works within the 128 bit lanes, so the lanes have to be put in order afterwards
+    const auto lo = _mm256_unpacklo_epi8(a, b);
+    const auto hi = _mm256_unpackhi_epi8(a, b);
+
+    store_avx2(out, _mm256_permute2x128_si256(lo, hi, 0x20));
+    store_avx2(out + 32, _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+DUNE_TARGET_AVX2 inline void store_interleaved3_half(uint8_t* out, __m128i a, __m128i b, __m128i c) {
+    for (auto block = 0; block < 3; ++block) {
+        const auto& masks = interleave3_masks[block];
+
+        const auto v = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, load_mask(masks[0])),
+                                                 _mm_shuffle_epi8(b, load_mask(masks[1]))),
+                                    _mm_shuffle_epi8(c, load_mask(masks[2])));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * block), v);
+    }
+}
+
+/// Stores a0 b0 c0 a1 b1 c1 ... a31 b31 c31
+DUNE_TARGET_AVX2 inline void store_interleaved3_avx2(uint8_t* out, __m256i a, __m256i b, __m256i c) {
+    store_interleaved3_half(out, _mm256_castsi256_si128(a), _mm256_castsi256_si128(b), _mm256_castsi256_si128(c));
+    store_interleaved3_half(out + 48, _mm256_extracti128_si256(a, 1), _mm256_extracti128_si256(b, 1),
+                            _mm256_extracti128_si256(c, 1));
+}
+
+DUNE_TARGET_AVX2 void scale2x_row_avx2(const Rows& r, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1) {
+    constexpr auto N = 32;
+
+    const auto ones = _mm256_set1_epi8(-1);
+
+    scale2x_pixels(r, 0, 1, dst0, dst1);
+
+    auto x = 1;
+    for (; x + N < r.width; x += N) {
+        const auto E = load_avx2(r.cur + x);
+        const auto B = load_avx2(r.up + x);
+        const auto H = load_avx2(r.down + x);
+        const auto D = select_avx2(load_avx2(r.left + x), E, load_avx2(r.cur + x - 1));
+        const auto F = select_avx2(load_avx2(r.right + x), E, load_avx2(r.cur + x + 1));
+
+        const auto c = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi8(B, H), _mm256_cmpeq_epi8(D, F)), ones);
+
+        store_interleaved2_avx2(dst0 + 2 * x, select_avx2(when_avx2(c, D, B), D, E),
+                                select_avx2(when_avx2(c, B, F), F, E));
+        store_interleaved2_avx2(dst1 + 2 * x, select_avx2(when_avx2(c, D, H), D, E),
+                                select_avx2(when_avx2(c, H, F), F, E));
+    }
+
+    scale2x_pixels(r, x, r.width, dst0, dst1);
+}
+
+DUNE_TARGET_AVX2 void
+scale3x_row_avx2(const Rows& r, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1, uint8_t* RESTRICT dst2) {
+    constexpr auto N = 32;
+
+    const auto ones = _mm256_set1_epi8(-1);
+
+    scale3x_pixels(r, 0, 1, dst0, dst1, dst2);
+
+    auto x = 1;
+    for (; x + N < r.width; x += N) {
+        const auto left  = load_avx2(r.left + x);
+        const auto right = load_avx2(r.right + x);
+
+        const auto E = load_avx2(r.cur + x);
+        const auto B = load_avx2(r.up + x);
+        const auto H = load_avx2(r.down + x);
+        const auto D = select_avx2(left, E, load_avx2(r.cur + x - 1));
+        const auto F = select_avx2(right, E, load_avx2(r.cur + x + 1));
+        const auto A = select_avx2(left, B, load_avx2(r.up + x - 1));
+        const auto C = select_avx2(right, B, load_avx2(r.up + x + 1));
+        const auto G = select_avx2(left, H, load_avx2(r.down + x - 1));
+        const auto I = select_avx2(right, H, load_avx2(r.down + x + 1));
+
+        const auto c = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi8(B, H), _mm256_cmpeq_epi8(D, F)), ones);
+
+        const auto DB = when_avx2(c, D, B);
+        const auto BF = when_avx2(c, B, F);
+        const auto DH = when_avx2(c, D, H);
+        const auto HF = when_avx2(c, H, F);
+
+        const auto nA = not_equal_avx2(E, A);
+        const auto nC = not_equal_avx2(E, C);
+        const auto nG = not_equal_avx2(E, G);
+        const auto nI = not_equal_avx2(E, I);
+
+        store_interleaved3_avx2(dst0 + 3 * x, select_avx2(DB, D, E), select_avx2(or_and_avx2(DB, nC, BF, nA), B, E),
+                                select_avx2(BF, F, E));
+        store_interleaved3_avx2(dst1 + 3 * x, select_avx2(or_and_avx2(DB, nG, DH, nA), D, E), E,
+                                select_avx2(or_and_avx2(BF, nI, HF, nC), F, E));
+        store_interleaved3_avx2(dst2 + 3 * x, select_avx2(DH, D, E), select_avx2(or_and_avx2(DH, nI, HF, nG), H, E),
+                                select_avx2(HF, F, E));
+    }
+
+    scale3x_pixels(r, x, r.width, dst0, dst1, dst2);
+}
+
+DUNE_TARGET_AVX2 void double_nn_row_avx2(const uint8_t* RESTRICT src, int width, uint8_t* RESTRICT dst) {
+    constexpr auto N = 32;
+
+    auto x = 0;
+    for (; x + N <= width; x += N) {
+        const auto v = load_avx2(src + x);
+
+        store_interleaved2_avx2(dst + 2 * x, v, v);
+    }
+
+    double_nn_pixels(src, x, width, dst);
+}
+
+DUNE_TARGET_AVX2 void triple_nn_row_avx2(const uint8_t* RESTRICT src, int width, uint8_t* RESTRICT dst) {
+    constexpr auto N = 16;
+
+    auto x = 0;
+    for (; x + N <= width; x += N) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+
+        for (auto block = 0; block < 3; ++block) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * x + 16 * block),
+                             _mm_shuffle_epi8(v, load_mask(triple_masks[block])));
+        }
+    }
+
+    triple_nn_pixels(src, x, width, dst);
+}
+
+#endif // DUNE_HAVE_AVX2
+
+#ifdef DUNE_HAVE_NEON
+
+inline uint8x16_t when_neon(uint8x16_t cond, uint8x16_t a, uint8x16_t b) {
+    return vandq_u8(cond, vceqq_u8(a, b));
+}
+
+inline uint8x16_t or_and_neon(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d) {
+    return vorrq_u8(vandq_u8(a, b), vandq_u8(c, d));
+}
+
+void scale2x_row_neon(const Rows& r, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1) {
+    constexpr auto N = 16;
+
+    scale2x_pixels(r, 0, 1, dst0, dst1);
+
+    auto x = 1;
+    for (; x + N < r.width; x += N) {
+        const auto E = vld1q_u8(r.cur + x);
+        const auto B = vld1q_u8(r.up + x);
+        const auto H = vld1q_u8(r.down + x);
+        const auto D = vbslq_u8(vld1q_u8(r.left + x), E, vld1q_u8(r.cur + x - 1));
+        const auto F = vbslq_u8(vld1q_u8(r.right + x), E, vld1q_u8(r.cur + x + 1));
+
+        const auto c = vmvnq_u8(vorrq_u8(vceqq_u8(B, H), vceqq_u8(D, F)));
+
+        const uint8x16x2_t row0{{vbslq_u8(when_neon(c, D, B), D, E), vbslq_u8(when_neon(c, B, F), F, E)}};
+        const uint8x16x2_t row1{{vbslq_u8(when_neon(c, D, H), D, E), vbslq_u8(when_neon(c, H, F), F, E)}};
+
+        vst2q_u8(dst0 + 2 * x, row0);
+        vst2q_u8(dst1 + 2 * x, row1);
+    }
+
+    scale2x_pixels(r, x, r.width, dst0, dst1);
+}
+
+void scale3x_row_neon(const Rows& r, uint8_t* RESTRICT dst0, uint8_t* RESTRICT dst1, uint8_t* RESTRICT dst2) {
+    constexpr auto N = 16;
+
+    scale3x_pixels(r, 0, 1, dst0, dst1, dst2);
+
+    auto x = 1;
+    for (; x + N < r.width; x += N) {
+        const auto left  = vld1q_u8(r.left + x);
+        const auto right = vld1q_u8(r.right + x);
+
+        const auto E = vld1q_u8(r.cur + x);
+        const auto B = vld1q_u8(r.up + x);
+        const auto H = vld1q_u8(r.down + x);
+        const auto D = vbslq_u8(left, E, vld1q_u8(r.cur + x - 1));
+        const auto F = vbslq_u8(right, E, vld1q_u8(r.cur + x + 1));
+        const auto A = vbslq_u8(left, B, vld1q_u8(r.up + x - 1));
+        const auto C = vbslq_u8(right, B, vld1q_u8(r.up + x + 1));
+        const auto G = vbslq_u8(left, H, vld1q_u8(r.down + x - 1));
+        const auto I = vbslq_u8(right, H, vld1q_u8(r.down + x + 1));
+
+        const auto c = vmvnq_u8(vorrq_u8(vceqq_u8(B, H), vceqq_u8(D, F)));
+
+        const auto DB = when_neon(c, D, B);
+        const auto BF = when_neon(c, B, F);
+        const auto DH = when_neon(c, D, H);
+        const auto HF = when_neon(c, H, F);
+
+        const auto nA = vmvnq_u8(vceqq_u8(E, A));
+        const auto nC = vmvnq_u8(vceqq_u8(E, C));
+        const auto nG = vmvnq_u8(vceqq_u8(E, G));
+        const auto nI = vmvnq_u8(vceqq_u8(E, I));
+
+        const uint8x16x3_t row0{{vbslq_u8(DB, D, E), vbslq_u8(or_and_neon(DB, nC, BF, nA), B, E), vbslq_u8(BF, F, E)}};
+        const uint8x16x3_t row1{
+            {vbslq_u8(or_and_neon(DB, nG, DH, nA), D, E), E, vbslq_u8(or_and_neon(BF, nI, HF, nC), F, E)}};
+        const uint8x16x3_t row2{{vbslq_u8(DH, D, E), vbslq_u8(or_and_neon(DH, nI, HF, nG), H, E), vbslq_u8(HF, F, E)}};
+
+        vst3q_u8(dst0 + 3 * x, row0);
+        vst3q_u8(dst1 + 3 * x, row1);
+        vst3q_u8(dst2 + 3 * x, row2);
+    }
+
+    scale3x_pixels(r, x, r.width, dst0, dst1, dst2);
+}
+
+void double_nn_row_neon(const uint8_t* RESTRICT src, int width, uint8_t* RESTRICT dst) {
+    constexpr auto N = 16;
+
+    auto x = 0;
+    for (; x + N <= width; x += N) {
+        const auto v = vld1q_u8(src + x);
+
+        vst2q_u8(dst + 2 * x, uint8x16x2_t{{v, v}});
+    }
+
+    double_nn_pixels(src, x, width, dst);
+}
+
+void triple_nn_row_neon(const uint8_t* RESTRICT src, int width, uint8_t* RESTRICT dst) {
+    constexpr auto N = 16;
+
+    auto x = 0;
+    for (; x + N <= width; x += N) {
+        const auto v = vld1q_u8(src + x);
+
+        vst3q_u8(dst + 3 * x, uint8x16x3_t{{v, v, v}});
+    }
+
+    triple_nn_pixels(src, x, width, dst);
+}
+
+#endif // DUNE_HAVE_NEON
+
+struct Kernels {
+    scale2x_row_type scale2x;
+    scale3x_row_type scale3x;
+    nn_row_type double_nn;
+    nn_row_type triple_nn;
+};
+
+const Kernels& kernels(InstructionSet set) {
+    static constexpr Kernels scalar{scale2x_row_scalar, scale3x_row_scalar, double_nn_row_scalar,
+                                    triple_nn_row_scalar};
+
+    if (!dune::scaler::is_supported(set))
+        THROW(std::invalid_argument, "The scaler kernels for {} are not supported by this CPU!",
+              dune::scaler::instruction_set_name(set));
+
+    switch (set) {
+#ifdef DUNE_HAVE_SSE2
+        case InstructionSet::SSE2: {
+            static constexpr Kernels sse2{scale2x_row_sse2, scale3x_row_sse2, double_nn_row_sse2,
+                                          triple_nn_row_scalar};
+            return sse2;
+        }
+#endif
+#ifdef DUNE_HAVE_AVX2
+        case InstructionSet::AVX2: {
+            static constexpr Kernels avx2{scale2x_row_avx2, scale3x_row_avx2, double_nn_row_avx2,
+                                          triple_nn_row_avx2};
+            return avx2;
+        }
+#endif
+#ifdef DUNE_HAVE_NEON
+        case InstructionSet::NEON: {
+            static constexpr Kernels neon{scale2x_row_neon, scale3x_row_neon, double_nn_row_neon,
+                                          triple_nn_row_neon};
+            return neon;
+        }
+#endif
+        default: return scalar;
+    }
+}
+
+template<int Factor, typename Row>
+void scale_tiled(Row row, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height,
+                 int tile_width, int tile_height) {
+    if (width <= 0 || height <= 0 || tile_width <= 0 || tile_height <= 0)
+        return;
+
+    const TileEdges edges{width, tile_width};
+
+    for (auto y = 0; y < height; ++y) {
+        const auto tile_y = y % tile_height;
+
+        const auto up   = tile_y == 0 ? y : y - 1;
+        const auto down = tile_y == tile_height - 1 ? y : y + 1;
+
+        const Rows rows{src + static_cast<ptrdiff_t>(up) * src_pitch,
+                        src + static_cast<ptrdiff_t>(y) * src_pitch,
+                        src + static_cast<ptrdiff_t>(down) * src_pitch,
+                        edges.left(),
+                        edges.right(),
+                        width};
+
+        auto* const out = dst + static_cast<ptrdiff_t>(Factor) * y * dst_pitch;
+
+        if constexpr (Factor == 2)
+            row(rows, out, out + dst_pitch);
+        else
+            row(rows, out, out + dst_pitch, out + 2 * static_cast<ptrdiff_t>(dst_pitch));
+    }
+}
+
+template<int Factor>
+void scale_nn(nn_row_type row, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+              int height) {
+    if (width <= 0 || height <= 0)
+        return;
+
+    for (auto y = 0; y < height; ++y) {
+        auto* const out = dst + static_cast<ptrdiff_t>(Factor) * y * dst_pitch;
+
+        row(src + static_cast<ptrdiff_t>(y) * src_pitch, width, out);
+
+        // The other rows are copies of the first one
+        for (auto i = 1; i < Factor; ++i)
+            std::memcpy(out + static_cast<ptrdiff_t>(i) * dst_pitch, out, static_cast<size_t>(Factor) * width);
+    }
+}
+
+} // namespace
+
+namespace dune::scaler {
+
+InstructionSet best_instruction_set() {
+    static const auto best = [] {
+        auto set = InstructionSet::Scalar;
+
+        for (const auto candidate : {InstructionSet::AVX2, InstructionSet::NEON, InstructionSet::SSE2}) {
+            if (is_supported(candidate)) {
+                set = candidate;
+                break;
+            }
+        }
+
+        sdl2::log_info("Scaler: Using {} kernels", instruction_set_name(set));
+
+        return set;
+    }();
+
+    return best;
+}
+
+bool is_supported(InstructionSet set) {
+    switch (set) {
+        case InstructionSet::Scalar: return true;
+#ifdef DUNE_HAVE_SSE2
+        case InstructionSet::SSE2: return SDL_TRUE == SDL_HasSSE2();
+#endif
+#ifdef DUNE_HAVE_AVX2
+        case InstructionSet::AVX2: return SDL_TRUE == SDL_HasAVX2();
+#endif
+#ifdef DUNE_HAVE_NEON
+        case InstructionSet::NEON: return SDL_TRUE == SDL_HasNEON();
+#endif
+        default: return false;
+    }
+}
+
+const char* instruction_set_name(InstructionSet set) {
+    switch (set) {
+        case InstructionSet::Scalar: return "scalar";
+        case InstructionSet::SSE2: return "SSE2";
+        case InstructionSet::AVX2: return "AVX2";
+        case InstructionSet::NEON: return "NEON";
+        default: return "unknown";
+    }
+}
+
+void scale2x(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height,
+             int tile_width, int tile_height) {
+    scale_tiled<2>(kernels(set).scale2x, src, src_pitch, dst, dst_pitch, width, height, tile_width, tile_height);
+}
+
+void scale3x(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width, int height,
+             int tile_width, int tile_height) {
+    scale_tiled<3>(kernels(set).scale3x, src, src_pitch, dst, dst_pitch, width, height, tile_width, tile_height);
+}
+
+void double_nn(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+               int height) {
+    scale_nn<2>(kernels(set).double_nn, src, src_pitch, dst, dst_pitch, width, height);
+}
+
+void triple_nn(InstructionSet set, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+               int height) {
+    scale_nn<3>(kernels(set).triple_nn, src, src_pitch, dst, dst_pitch, width, height);
+}
+
+} // namespace dune::scaler
@@ -0,0 +1,81 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/ThreadPool.h>
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int numThreads) {
+    numThreads = std::max(1U, numThreads);
+
+    threads_.reserve(numThreads);
+    for (auto i = 0U; i < numThreads; i++)
+        threads_.emplace_back([this] { run(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const std::lock_guard lock{mutex_};
+        stop_ = true;
+    }
+
+    condition_.notify_all();
+
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+
+    return pool;
+}
+
+unsigned int ThreadPool::defaultNumThreads() noexcept {
+    const auto hardwareThreads = std::thread::hardware_concurrency();
+
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        const std::lock_guard lock{mutex_};
+        tasks_.push_back(std::move(task));
+    }
+
+    condition_.notify_one();
+}
+
+void ThreadPool::run() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock{mutex_};
+            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        // packaged_task stores exceptions in the future, so nothing escapes here
+        task();
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/compression_util.h>
+
+#include <misc/exceptions.h>
+
+#include <lodepng.h>
+
+namespace dune {
+
+std::vector<uint8_t> zlib_compress(std::span<const uint8_t> data) {
+    auto settings       = lodepng_default_compress_settings;
+    settings.windowsize = 32768; // the default of 2048 is tuned for speed on small images
+
+    std::vector<unsigned char> out;
+    if (const auto error = lodepng::compress(out, data.data(), data.size(), settings)) {
+        THROW(std::runtime_error, "zlib_compress(): {}", lodepng_error_text(error));
+    }
+
+    return out;
+}
+
+std::vector<uint8_t> zlib_decompress(std::span<const uint8_t> data, size_t expectedSize) {
+    auto settings            = lodepng_default_decompress_settings;
+    settings.max_output_size = expectedSize;
+
+    // expectedSize may come from untrusted data, so the output only grows as far as the data really decompresses
+    std::vector<unsigned char> out;
+
+    if (const auto error = lodepng::decompress(out, data.data(), data.size(), settings)) {
+        THROW(std::runtime_error, "zlib_decompress(): {}", lodepng_error_text(error));
+    }
+
+    if (out.size() != expectedSize) {
+        THROW(std::runtime_error, "zlib_decompress(): Expected {} bytes but got {}!", expectedSize, out.size());
+    }
+
+    return out;
+}
+
+} // namespace dune
@@ -18,12 +18,14 @@
 #include <misc/draw_util.h>
 
 #include "misc/DrawingRectHelper.h"
+#include <misc/RemapKernels.h>
 #include <misc/exceptions.h>
 #include <misc/sdl_support.h>
 
 #include <globals.h>
 
 #include <cstddef>
+#include <deque>
 #include <mutex>
 
 uint32_t getPixel(SDL_Surface* surface, int x, int y) {
@@ -211,6 +213,21 @@ sdl2::surface_ptr renderReadSurface(SDL_Renderer* renderer) {
 void replaceColor(SDL_Surface* surface, uint32_t oldColor, uint32_t newColor) {
     sdl2::surface_lock lock{surface};
 
+    if (surface->format->BytesPerPixel == 1) {
+        // No 8-bit pixel can have a larger color
+        if (oldColor > 255)
+            return;
+
+        auto* const pixels = static_cast<uint8_t*>(surface->pixels);
+
+        dune::remap::ColorMap map;
+        map.set(static_cast<uint8_t>(oldColor), static_cast<uint8_t>(newColor));
+
+        dune::remap::remap(pixels, surface->pitch, pixels, surface->pitch, surface->w, surface->h, map);
+
+        return;
+    }
+
     for (auto y = 0; y < surface->h; y++) {
         for (auto x = 0; x < surface->w; ++x) {
             const auto color = getPixel(surface, x, y);
@@ -224,13 +241,10 @@ void replaceColor(SDL_Surface* surface, uint32_t oldColor, uint32_t newColor) {
 void mapColor(SDL_Surface* surface, const uint8_t colorMap[256]) {
     sdl2::surface_lock lock{surface};
 
-    for (auto y = 0; y < surface->h; y++) {
-        uint8_t* RESTRICT p = static_cast<uint8_t*>(surface->pixels) + static_cast<ptrdiff_t>(y) * surface->pitch;
+    auto* const pixels = static_cast<uint8_t*>(surface->pixels);
 
-        for (auto x = 0; x < surface->w; ++x, ++p) {
-            *p = colorMap[*p];
-        }
-    }
+    dune::remap::remap(pixels, surface->pitch, pixels, surface->pitch, surface->w, surface->h,
+                       dune::remap::ColorMap{colorMap});
 }
 
 sdl2::surface_ptr copySurface(SDL_Surface* inSurface) {
@@ -512,36 +526,64 @@ sdl2::surface_ptr createShadowSurface(SDL_Surface* source) {
     return retPic;
 }
 
-sdl2::surface_ptr mapSurfaceColorRange(SDL_Surface* source, int srcColor, int destColor) {
-    if (!source)
-        THROW(std::runtime_error, "mapSurfaceColorRange(): Null source!");
-
+namespace {
+sdl2::surface_ptr copyForColorMapping(SDL_Surface* source) {
     sdl2::surface_ptr retPic{SDL_ConvertSurface(source, source->format, 0)};
 
-    if (!source)
+    if (!retPic)
         THROW(std::runtime_error, "mapSurfaceColorRange(): Cannot copy image!");
 
     if (retPic->format->BytesPerPixel == 1) {
         SDL_SetSurfaceBlendMode(retPic.get(), SDL_BLENDMODE_NONE);
     }
 
-    const auto offset = static_cast<uint8_t>(srcColor - destColor);
+    return retPic;
+}
+} // namespace
+
+sdl2::surface_ptr mapSurfaceColorRange(SDL_Surface* source, int srcColor, int destColor) {
+    if (!source)
+        THROW(std::runtime_error, "mapSurfaceColorRange(): Null source!");
+
+    auto retPic = copyForColorMapping(source);
 
     const sdl2::surface_lock lock{retPic.get()};
 
-    const auto pitch            = static_cast<ptrdiff_t>(lock.pitch());
-    auto* const RESTRICT pixels = static_cast<uint8_t*>(lock.pixels());
+    auto* const pixels = static_cast<uint8_t*>(lock.pixels());
 
-    for (auto y = 0; y < retPic->h; ++y) {
-        auto* RESTRICT p = &pixels[y * pitch];
+    dune::remap::remap(pixels, lock.pitch(), pixels, lock.pitch(), retPic->w, retPic->h,
+                       dune::remap::ColorMap::range(srcColor, destColor));
 
-        for (auto x = 0; x < retPic->w; ++x, ++p) {
-            if (*p >= srcColor && *p < srcColor + 7)
-                *p -= offset;
-        }
+    return retPic;
+}
+
+std::vector<sdl2::surface_ptr>
+mapSurfaceColorRange(SDL_Surface* source, int srcColor, std::span<const int> destColors) {
+    if (!source)
+        THROW(std::runtime_error, "mapSurfaceColorRange(): Null source!");
+
+    std::vector<sdl2::surface_ptr> surfaces;
+    std::vector<dune::remap::ColorMap> maps;
+    std::vector<dune::remap::Target> targets;
+    std::deque<sdl2::surface_lock> locks;
+
+    surfaces.reserve(destColors.size());
+    maps.reserve(destColors.size());
+    targets.reserve(destColors.size());
+
+    for (const auto destColor : destColors) {
+        auto& surface = surfaces.emplace_back(copyForColorMapping(source));
+        const auto& lock = locks.emplace_back(surface.get());
+
+        targets.push_back({&maps.emplace_back(dune::remap::ColorMap::range(srcColor, destColor)),
+                           static_cast<uint8_t*>(lock.pixels()), lock.pitch()});
     }
 
-    return retPic;
+    const sdl2::surface_lock source_lock{source};
+
+    dune::remap::remap(static_cast<const uint8_t*>(source->pixels), source->pitch, source->w, source->h, targets);
+
+    return surfaces;
 }
 
 bool drawSurface(SDL_Surface* src, const SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect,
@@ -1,5 +1,7 @@
 add_sources(MISC_SOURCES
 	BlendBlitter.cpp
+	compression_util.cpp
+	DirtyTiles.cpp
 	draw_util.cpp
 	dune_localtime.cpp
 	dune_timer_resolution.cpp
@@ -10,13 +12,18 @@ add_sources(MISC_SOURCES
 	IFileStream.cpp
 	IMemoryStream.cpp
 	InputStream.cpp
+	MappedFile.cpp
 	md5.cpp
 	OFileStream.cpp
-	#OMemoryStream.cpp
+	OMemoryStream.cpp
 	OutputStream.cpp
 	Random.cpp
+	RemapKernels.cpp
+	RWopsData.cpp
 	Scaler.cpp
+	ScalerKernels.cpp
 	SDL_LogRenderer.cpp
 	sound_util.cpp
 	string_util.cpp
+	ThreadPool.cpp
 )
@@ -0,0 +1,202 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headless relay server for multiplayer games. It never opens a window and does not need the original
+// Dune II data files; it only loads the map (or multiplayer savegame) that should be played.
+
+#include <Definitions.h>
+#include <GameInitSettings.h>
+
+#include <Network/RelayServer.h>
+
+#include <misc/FileSystem.h>
+#include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
+
+#include "logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> bQuit = false;
+
+void onSignal(int /*signal*/) {
+    bQuit = true;
+}
+
+void printUsage() {
+    fprintf(stderr, "Usage:\n\tdunelegacy-relay (--map=X.ini|--savegame=X.dls) [--players=N] [--port=N] "
+                    "[--games=N] [--name=X] [--multiple-players-per-house] [--quiet]\n");
+}
+
+struct RelayOptions {
+    std::filesystem::path mapFile;
+    std::filesystem::path saveGameFile;
+    std::string serverName = "Dune Legacy Relay";
+    int players            = 2;
+    int games              = 1;
+    uint16_t port          = DEFAULT_PORT;
+    bool multiplePlayersPerHouse{};
+    bool quiet{};
+};
+
+/// Parses text as a decimal number and fails on anything else (atoi() would return 0 or the value of a prefix)
+template<typename T>
+bool parseNumber(std::string_view text, T& value) {
+    const auto* const last = text.data() + text.size();
+
+    const auto [ptr, ec] = std::from_chars(text.data(), last, value);
+
+    return ec == std::errc{} && ptr == last;
+}
+
+bool parseOptions(int argc, char* argv[], RelayOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string_view parameter(argv[i]);
+
+        const auto value = [&](std::string_view prefix) { return parameter.substr(prefix.size()); };
+
+        if (parameter.starts_with("--map=")) {
+            options.mapFile = std::filesystem::path{value("--map=")};
+        } else if (parameter.starts_with("--savegame=")) {
+            options.saveGameFile = std::filesystem::path{value("--savegame=")};
+        } else if (parameter.starts_with("--players=")) {
+            if (!parseNumber(value("--players="), options.players))
+                return false;
+        } else if (parameter.starts_with("--games=")) {
+            if (!parseNumber(value("--games="), options.games))
+                return false;
+        } else if (parameter.starts_with("--port=")) {
+            if (!parseNumber(value("--port="), options.port))
+                return false;
+        } else if (parameter.starts_with("--name=")) {
+            options.serverName = std::string{value("--name=")};
+        } else if (parameter == "--multiple-players-per-house") {
+            options.multiplePlayersPerHouse = true;
+        } else if (parameter == "--quiet") {
+            options.quiet = true;
+        } else {
+            return false;
+        }
+    }
+
+    return (options.mapFile.empty() != options.saveGameFile.empty()) && options.players > 0 && options.games > 0
+        && !options.serverName.empty();
+}
+
+GameInitSettings createGameInitSettings(const RelayOptions& options) {
+    auto serverName = options.serverName;
+
+    if (!options.mapFile.empty()) {
+        return GameInitSettings(getBasename(options.mapFile, true), readCompleteFile(options.mapFile),
+                                std::move(serverName), options.multiplePlayersPerHouse,
+                                SettingsClass::GameOptionsClass{});
+    }
+
+    return GameInitSettings(getBasename(options.saveGameFile, true), readCompleteFile(options.saveGameFile),
+                            std::move(serverName));
+}
+
+int runRelay(const RelayOptions& options) {
+    const auto gameInitSettings = createGameInitSettings(options);
+
+    if (const auto maxPlayers = RelayServer::readPlayerSlots(gameInitSettings).getMaxPlayers();
+        options.players > maxPlayers) {
+        sdl2::log_error(SDL_LOG_CATEGORY_APPLICATION, "The map has slots for only {} players but --players={}!",
+                        maxPlayers, options.players);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::unique_ptr<RelayServer>> servers;
+    servers.reserve(options.games);
+
+    for (auto i = 0; i < options.games; ++i) {
+        const auto port = static_cast<uint16_t>(options.port + i);
+
+        servers.push_back(std::make_unique<RelayServer>(port, gameInitSettings, options.players));
+
+        sdl2::log_info("Relay server for {} players listening on port {}", options.players, port);
+    }
+
+    while (!bQuit) {
+        // Sleep until any of the hosts has something to do; enet_host_service() would only wait on one of them.
+        ENetSocketSet readSet;
+        ENET_SOCKETSET_EMPTY(readSet);
+
+        ENetSocket maxSocket{};
+        for (const auto& server : servers) {
+            const auto socket = server->getSocket();
+            ENET_SOCKETSET_ADD(readSet, socket);
+            maxSocket = std::max(maxSocket, socket);
+        }
+
+        // Wake up regularly anyway so that ENet can resend and time out peers.
+        if (enet_socketset_select(maxSocket, &readSet, nullptr, 10) < 0 && !bQuit) {
+            sdl2::log_error(SDL_LOG_CATEGORY_APPLICATION, "Waiting for network events failed!");
+        }
+
+        for (auto& server : servers) {
+            server->update();
+        }
+    }
+
+    sdl2::log_info("Shutting down relay server");
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    dune::logging_initialize();
+
+    RelayOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    try {
+        dune::logging_configure(false);
+
+        if (options.quiet) {
+            SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN);
+        }
+
+        const auto ret = runRelay(options);
+
+        dune::logging_complete();
+
+        return ret;
+    } catch (const std::exception& e) {
+        sdl2::log_error(SDL_LOG_CATEGORY_APPLICATION, "Dune Legacy Relay: Unrecoverable error: {}", e.what());
+
+        return EXIT_FAILURE;
+    }
+}
@@ -32,11 +32,14 @@
 
 #include <Game.h>
 #include <GameInitSettings.h>
+#include <ReplaySnapshots.h>
+#include <ScreenBorder.h>
 #include <data.h>
 
 #include <misc/exceptions.h>
 
 #include <algorithm>
+#include <optional>
 #include <utility>
 
 /**
@@ -626,14 +629,35 @@ void startReplay(const std::filesystem::path& filename, MenuBase::event_handler_
 
     auto cleanup = gsl::finally([&] { dune::globals::currentGame.reset(); });
 
-    dune::globals::currentGame = std::make_unique<Game>();
+    // the snapshots outlive the game objects, so seeking can restore them in a fresh game
+    ReplaySnapshots replaySnapshots;
 
-    auto* const game = dune::globals::currentGame.get();
+    std::optional<uint32_t> startCycle;
 
-    dune::globals::currentGame->initReplay(filename);
+    do {
+        // keep the view when seeking
+        const auto screenCenter = startCycle ? std::optional{dune::globals::screenborder->getCurrentCenter()}
+                                             : std::nullopt;
 
-    const GameContext context{*game, *game->getMap(), game->getObjectManager()};
-    game->runMainLoop(context, std::move(handler));
+        // Make sure to delete the old game before creating a new one (see startSinglePlayerGame())
+        dune::globals::currentGame.reset();
+
+        dune::globals::currentGame = std::make_unique<Game>();
+
+        auto* const game = dune::globals::currentGame.get();
+
+        game->setReplaySnapshots(&replaySnapshots);
+        game->initReplay(filename, startCycle.value_or(0));
+
+        if (screenCenter) {
+            dune::globals::screenborder->setNewScreenCenter(*screenCenter);
+        }
+
+        const GameContext context{*game, *game->getMap(), game->getObjectManager()};
+        game->runMainLoop(context, handler);
+
+        startCycle = game->getReplaySeekCycle();
+    } while (startCycle);
 
     // Change music to menu music
     dune::globals::musicPlayer->changeMusic(MUSIC_MENU);
@@ -1,5 +1,6 @@
 add_sources(TOP_SOURCES
 	AStarSearch.cpp
+	AutoSaver.cpp
 	Bullet.cpp
 	Choam.cpp
 	Command.cpp
@@ -11,6 +12,7 @@ add_sources(TOP_SOURCES
 	globals.cpp
 	House.cpp
 	Map.cpp
+	MapChunkCache.cpp
 	MapSeed.cpp
 	mmath.cpp
 	ObjectBase.cpp
@@ -19,7 +21,9 @@ add_sources(TOP_SOURCES
 	ObjectPointer.cpp
 	RadarView.cpp
 	RadarViewBase.cpp
+	ReplaySnapshots.cpp
 	sand.cpp
+	SaveGameHeader.cpp
 	ScreenBorder.cpp
 	SoundPlayer.cpp
 	Tile.cpp
@@ -42,3 +46,4 @@ include(Trigger/sources.cmake)
 include(units/sources.cmake)
 
 add_sources(EXE_SOURCES main.cpp logging.cpp)
+add_sources(RELAY_SOURCES relay_main.cpp logging.cpp)
@@ -159,8 +159,8 @@ void Sandworm::blitToScreen() {
             const auto dest = calcDrawingRect(shimmerMaskTex, screenborder->world2screenX(loc.x),
                                               screenborder->world2screenY(loc.y), HAlign::Center, VAlign::Center);
 
-            SDL_SetTextureAlphaMod(shimmerMaskTex->texture_, 4);
-            SDL_SetTextureBlendMode(shimmerMaskTex->texture_, SDL_BLENDMODE_ADD);
+            Dune_SetTextureAlphaMod(shimmerMaskTex->texture_, 4);
+            Dune_SetTextureBlendMode(shimmerMaskTex->texture_, SDL_BLENDMODE_ADD);
 
             const CoordF current{dest.x + offset, dest.y};
 
@@ -179,8 +179,8 @@ void Sandworm::blitToScreen() {
 
             previous = current;
 
-            SDL_SetTextureAlphaMod(shimmerMaskTex->texture_, 255);
-            SDL_SetTextureBlendMode(shimmerMaskTex->texture_, SDL_BLENDMODE_BLEND);
+            Dune_SetTextureAlphaMod(shimmerMaskTex->texture_, 255);
+            Dune_SetTextureBlendMode(shimmerMaskTex->texture_, SDL_BLENDMODE_BLEND);
         }
     }
 
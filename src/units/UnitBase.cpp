@@ -86,11 +86,14 @@ UnitBase::UnitBase(const UnitBaseConstants& constants, uint32_t objectID, const
     nextSpot.x              = stream.readSint32();
     nextSpot.y              = stream.readSint32();
     const auto numPathNodes = stream.readUint32();
+    if (numPathNodes > stream.bytesLeft() / (2 * sizeof(int32_t))) {
+        THROW(InputStream::eof, "UnitBase::UnitBase(): Invalid path length: {}", numPathNodes);
+    }
+    std::vector<int32_t> pathValues(2 * static_cast<size_t>(numPathNodes));
+    stream.readSint32s(pathValues);
     pathList.resize(numPathNodes);
     for (auto i = 0u; i < numPathNodes; ++i) {
-        auto x                         = stream.readSint32();
-        auto y                         = stream.readSint32();
-        pathList[numPathNodes - 1 - i] = {x, y};
+        pathList[numPathNodes - 1 - i] = {pathValues[2 * i], pathValues[2 * i + 1]};
     }
 
     findTargetTimer      = stream.readSint32();
@@ -150,10 +153,13 @@ void UnitBase::save(OutputStream& stream) const {
     stream.writeSint32(nextSpot.x);
     stream.writeSint32(nextSpot.y);
     stream.writeUint32(gsl::narrow<uint32_t>(pathList.size()));
+    std::vector<int32_t> pathValues;
+    pathValues.reserve(2 * pathList.size());
     for (const auto& coord : dune::reverse(pathList)) {
-        stream.writeSint32(coord.x);
-        stream.writeSint32(coord.y);
+        pathValues.push_back(coord.x);
+        pathValues.push_back(coord.y);
     }
+    stream.writeSint32s(pathValues);
 
     stream.writeSint32(findTargetTimer);
     stream.writeSint32(primaryWeaponTimer);
@@ -354,6 +360,7 @@ void UnitBase::deviate(const GameContext& context, House* newOwner) {
         clearPath();
         doSetAttackMode(context, GUARD);
         owner_ = newOwner;
+        map.invalidateRadar(location_);
 
         graphic_ = dune::globals::pGFXManager->getObjPic(graphicID_, getOwner()->getHouseID());
 
@@ -1403,6 +1410,8 @@ void UnitBase::quitDeviation(const GameContext& context) {
         owner_         = context.game.getHouse(originalHouseID_);
         graphic_       = dune::globals::pGFXManager->getObjPic(graphicID_, getOwner()->getHouseID());
         deviationTimer = INVALID;
+
+        context.map.invalidateRadar(location_);
     }
 }
 
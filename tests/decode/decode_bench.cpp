@@ -0,0 +1,136 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Decodes all SHP, WSA and CPS files in the given PAK files and prints how long it took.
+
+#include <FileClasses/Cpsfile.h>
+#include <FileClasses/Pakfile.h>
+#include <FileClasses/Palfile.h>
+#include <FileClasses/Shpfile.h>
+#include <FileClasses/Wsafile.h>
+
+#include <globals.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    fprintf(stderr, "Usage:\n\tdecode_bench [--runs=N] DUNE.PAK [more PAK files...]\n");
+}
+
+struct Stats {
+    int files = 0;
+    int errors = 0;
+    std::chrono::steady_clock::duration time{};
+};
+
+void decodeFile(const Pakfile& pakfile, int index, std::string_view extension) {
+    if (extension == ".SHP") {
+        Shpfile shpfile{pakfile.openFile(index).get()};
+
+        for (auto i = 0; i < shpfile.getNumFiles(); ++i)
+            std::ignore = shpfile.getPicture(i);
+    } else if (extension == ".WSA") {
+        Wsafile wsafile{pakfile.openFile(index).get()};
+    } else {
+        std::ignore = LoadCPS_RW(pakfile.openFile(index).get());
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    auto runs = 10;
+
+    std::vector<std::unique_ptr<Pakfile>> pakfiles;
+
+    try {
+        for (auto i = 1; i < argc; i++) {
+            const std::string_view parameter(argv[i]);
+
+            if (parameter.starts_with("--runs=")) {
+                runs = atoi(argv[i] + 7);
+            } else if (parameter.starts_with("--")) {
+                printUsage();
+                return EXIT_FAILURE;
+            } else {
+                pakfiles.push_back(std::make_unique<Pakfile>(argv[i]));
+            }
+        }
+
+        if (pakfiles.empty() || runs <= 0) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+
+        // The pictures get the game palette
+        for (const auto& pakfile : pakfiles) {
+            if (pakfile->exists("IBM.PAL"))
+                dune::globals::palette = LoadPalette_RW(pakfile->openFile("IBM.PAL").get());
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Error: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    const std::string_view extensions[] = {".SHP", ".WSA", ".CPS"};
+    Stats stats[std::size(extensions)];
+
+    for (auto run = 0; run < runs; ++run) {
+        for (const auto& pakfile : pakfiles) {
+            for (auto i = 0; i < pakfile->getNumFiles(); ++i) {
+                const auto& filename = pakfile->getFilename(i);
+
+                for (auto e = 0u; e < std::size(extensions); ++e) {
+                    if (!filename.ends_with(extensions[e]))
+                        continue;
+
+                    const auto start = std::chrono::steady_clock::now();
+
+                    try {
+                        decodeFile(*pakfile, i, extensions[e]);
+                    } catch (const std::exception& ex) {
+                        if (run == 0)
+                            fprintf(stderr, "%s: %s\n", filename.c_str(), ex.what());
+                        ++stats[e].errors;
+                    }
+
+                    stats[e].time += std::chrono::steady_clock::now() - start;
+                    ++stats[e].files;
+                }
+            }
+        }
+    }
+
+    for (auto e = 0u; e < std::size(extensions); ++e) {
+        const auto ms = std::chrono::duration<double, std::milli>(stats[e].time).count() / runs;
+
+        printf("%s: %4d files, %3d errors, %8.3f ms per run\n", extensions[e].data(), stats[e].files / runs,
+               stats[e].errors / runs, ms);
+    }
+
+    return EXIT_SUCCESS;
+}
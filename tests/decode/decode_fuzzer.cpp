@@ -0,0 +1,110 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// libFuzzer harness for the format80 and format40 decoders and the SHP, WSA and CPS parsers. Build with
+// -DDUNE_FUZZERS=ON and clang, then run
+//     decode_fuzzer [corpus directory]
+// Any crash or sanitizer report is a bug; corrupt data must only ever throw std::invalid_argument from the decoders
+// and std::exception from the parsers. The files of the game data are a good seed corpus.
+
+#include <FileClasses/Cpsfile.h>
+#include <FileClasses/Decode.h>
+#include <FileClasses/Palette.h>
+#include <FileClasses/Shpfile.h>
+#include <FileClasses/Wsafile.h>
+#include <misc/SDL2pp.h>
+#include <misc/dune_endian.h>
+
+#include <globals.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace {
+void fuzzDecoders(const uint8_t* data, size_t size) {
+    // The first two bytes choose the size of the output, so the bounds of small and large outputs are both tested
+    if (size < 2)
+        return;
+
+    const auto output_size = static_cast<size_t>(data[0]) | static_cast<size_t>(data[1]) << 8;
+    const std::span input{data + 2, size - 2};
+
+    std::vector<uint8_t> output(output_size);
+
+    try {
+        decode80(input, output);
+    } catch (const std::invalid_argument&) { }
+
+    try {
+        decode40(input, output);
+    } catch (const std::invalid_argument&) { }
+}
+
+void fuzzShp(const uint8_t* data, size_t size) {
+    try {
+        const sdl2::RWops_ptr rwop{SDL_RWFromConstMem(data, static_cast<int>(size))};
+        Shpfile shpfile{rwop.get()};
+
+        for (auto i = 0; i < shpfile.getNumFiles(); ++i)
+            std::ignore = shpfile.getPicture(i);
+    } catch (const std::exception&) { }
+}
+
+void fuzzWsa(const uint8_t* data, size_t size) {
+    // all frames are decoded at once; skip headers that only test how much memory can be allocated
+    if (size < 6
+        || size_t{dune::read_le_uint16(data)} * dune::read_le_uint16(data + 2) * dune::read_le_uint16(data + 4)
+               > 16 * 1024 * 1024)
+        return;
+
+    try {
+        const sdl2::RWops_ptr rwop{SDL_RWFromConstMem(data, static_cast<int>(size))};
+        const Wsafile wsafile{rwop.get()};
+
+        for (auto i = 0; i < wsafile.getNumFrames(); ++i)
+            std::ignore = wsafile.getPicture(i);
+    } catch (const std::exception&) { }
+}
+
+void fuzzCps(const uint8_t* data, size_t size) {
+    try {
+        const sdl2::RWops_ptr rwop{SDL_RWFromConstMem(data, static_cast<int>(size))};
+        std::ignore = LoadCPS_RW(rwop.get());
+    } catch (const std::exception&) { }
+}
+} // namespace
+
+extern "C" int LLVMFuzzerInitialize(int* /*argc*/, char*** /*argv*/) {
+    // the pictures get the palette of the screen
+    dune::globals::palette = Palette{256};
+
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    fuzzDecoders(data, size);
+
+    fuzzShp(data, size);
+    fuzzWsa(data, size);
+    fuzzCps(data, size);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "FileClasses/Decode.h"
+#include "FileClasses/Wsafile.h"
+#include "misc/SDL2pp.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using bytes = std::vector<uint8_t>;
+
+bytes decode(const bytes& input, size_t output_size) {
+    bytes output(output_size);
+    output.resize(decode80(input, output));
+    return output;
+}
+
+void loadWsa(const bytes& file) {
+    const sdl2::RWops_ptr rwop{SDL_RWFromConstMem(file.data(), static_cast<int>(file.size()))};
+    const Wsafile wsafile{rwop.get()};
+}
+
+} // namespace
+
+TEST(decode80, literal_copy_and_fill) {
+    // 10000011 'a' 'b' 'c', 11111110 5 0 'x', end
+    const auto output = decode({0x83, 'a', 'b', 'c', 0xfe, 5, 0, 'x', 0x80}, 16);
+
+    EXPECT_EQ((bytes{'a', 'b', 'c', 'x', 'x', 'x', 'x', 'x'}), output);
+}
+
+TEST(decode80, relative_copy_repeats_short_patterns) {
+    // 'a' 'b' 'c', then copy 10 bytes from 3 back, then 4 bytes from 1 back
+    const auto output = decode({0x83, 'a', 'b', 'c', 0x70, 3, 0x82, 'y', 'z', 0x10, 1, 0x80}, 32);
+
+    EXPECT_EQ((bytes{'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'y', 'z', 'z', 'z', 'z', 'z'}),
+              output);
+}
+
+TEST(decode80, absolute_copies) {
+    // 'a' 'b', then 11cccccc: 5 bytes from position 0, then 11111111: 3 bytes from position 5
+    const auto output = decode({0x82, 'a', 'b', 0xc2, 0, 0, 0xff, 3, 0, 5, 0, 0x80}, 16);
+
+    EXPECT_EQ((bytes{'a', 'b', 'a', 'b', 'a', 'b', 'a', 'b', 'a', 'b'}), output);
+}
+
+TEST(decode80, rejects_corrupt_data) {
+    // no end command
+    EXPECT_THROW(decode({0x83, 'a', 'b', 'c'}, 16), std::invalid_argument);
+    // literal longer than the data
+    EXPECT_THROW(decode({0x85, 'a', 'b'}, 16), std::invalid_argument);
+    // output too small
+    EXPECT_THROW(decode({0xfe, 17, 0, 'x', 0x80}, 16), std::invalid_argument);
+    EXPECT_THROW(decode({0x83, 'a', 'b', 'c', 0x80}, 2), std::invalid_argument);
+    // relative copy from before the start
+    EXPECT_THROW(decode({0x82, 'a', 'b', 0x00, 3, 0x80}, 16), std::invalid_argument);
+    // absolute copy from beyond the end
+    EXPECT_THROW(decode({0xc0, 14, 0, 0x80}, 16), std::invalid_argument);
+    EXPECT_THROW(decode({0xff, 1, 0, 0xff, 0xff, 0x80}, 16), std::invalid_argument);
+    // empty input
+    EXPECT_THROW(decode({}, 16), std::invalid_argument);
+}
+
+TEST(decode40, xors_into_the_previous_frame) {
+    bytes frame{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    // fill 2 x 0xff, skip 1, copy 2 bytes, long skip 1, long fill 2 x 0x0f, long copy 1 byte, end
+    const bytes input{0x00, 2, 0xff, 0x81, 0x02, 0xf0, 0xf0, 0x80, 1, 0, 0x80, 2, 0xc0, 0x0f, 0x80, 1, 0x80, 0xaa,
+                      0x80, 0, 0};
+
+    EXPECT_EQ(9u, decode40(input, frame));
+    EXPECT_EQ((bytes{0xfe, 0xfd, 3, 0xf4, 0xf5, 6, 0x08, 0x07, 9 ^ 0xaa, 10}), frame);
+}
+
+TEST(decode40, rejects_corrupt_data) {
+    bytes frame(4);
+
+    EXPECT_THROW(decode40(bytes{0x85}, frame), std::invalid_argument);
+    EXPECT_THROW(decode40(bytes{0x00, 5, 1, 0x80, 0, 0}, frame), std::invalid_argument);
+    EXPECT_THROW(decode40(bytes{0x02, 1}, frame), std::invalid_argument);
+    EXPECT_THROW(decode40(bytes{0x80, 5, 0}, frame), std::invalid_argument);
+}
+
+TEST(decode, random_data_never_escapes_the_buffers) {
+    std::mt19937 generator{42};
+
+    for (auto i = 0; i < 20000; ++i) {
+        bytes input(generator() % 64);
+        for (auto& b : input)
+            b = static_cast<uint8_t>(generator() % 4 == 0 ? 0x80 : generator());
+
+        bytes output(generator() % 300);
+
+        try {
+            EXPECT_LE(decode80(input, output), output.size());
+        } catch (const std::invalid_argument&) { }
+
+        try {
+            EXPECT_LE(decode40(input, output), output.size());
+        } catch (const std::invalid_argument&) { }
+    }
+}
+
+TEST(wsafile, rejects_truncated_headers) {
+    // 3 frames of 1x1 pixels; the index starts at byte 10 and needs 5 offsets
+    bytes file{3, 0, 1, 0, 1, 0, 0, 0, 0, 0};
+    for (const auto offset : {30, 31, 32, 33})
+        file.insert(file.end(), {static_cast<uint8_t>(offset), 0, 0, 0});
+
+    EXPECT_THROW(loadWsa(bytes(file.begin(), file.begin() + 12)), std::runtime_error);
+    EXPECT_THROW(loadWsa(file), std::runtime_error);
+
+    // an extended animation without frames
+    EXPECT_THROW(loadWsa(bytes{0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}), std::runtime_error);
+}
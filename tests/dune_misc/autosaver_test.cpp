@@ -0,0 +1,81 @@
+#include "AutoSaver.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace {
+SaveGameData make_savegame(uint32_t gameCycle) {
+    SaveGameData data;
+    data.header.mapName        = "test";
+    data.header.gameCycleCount = gameCycle;
+    data.sections.emplace_back(1000, static_cast<uint8_t>(gameCycle));
+    return data;
+}
+
+class autosaver : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* const testName = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+
+        directory_ = std::filesystem::temp_directory_path() / (std::string{"dune_autosaver_test_"} + testName);
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    std::filesystem::path directory_;
+};
+} // namespace
+
+TEST_F(autosaver, rotates_through_slots) {
+    AutoSaver saver{directory_, 2};
+
+    for (auto cycle = 1U; cycle <= 3U; cycle++) {
+        ASSERT_TRUE(saver.save(make_savegame(cycle)));
+        saver.wait();
+    }
+
+    const auto first  = SaveGameHeader::read(saver.getSlotFilename(0));
+    const auto second = SaveGameHeader::read(saver.getSlotFilename(1));
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+
+    // the third autosave has overwritten the first one
+    EXPECT_EQ(first->gameCycleCount, 3U);
+    EXPECT_EQ(second->gameCycleCount, 2U);
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        EXPECT_NE(entry.path().extension(), ".tmp");
+    }
+}
+
+TEST_F(autosaver, continues_with_oldest_slot) {
+    {
+        AutoSaver saver{directory_, 3};
+        saver.save(make_savegame(1));
+        saver.wait();
+    }
+
+    AutoSaver saver{directory_, 3};
+    saver.save(make_savegame(2));
+    saver.wait();
+
+    const auto header = SaveGameHeader::read(saver.getSlotFilename(1));
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->gameCycleCount, 2U);
+}
+
+TEST_F(autosaver, pending_save_is_written_on_destruction) {
+    std::filesystem::path filename;
+    {
+        AutoSaver saver{directory_, 1};
+        filename = saver.getSlotFilename(0);
+        saver.save(make_savegame(7));
+    }
+
+    const auto header = SaveGameHeader::read(filename);
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->gameCycleCount, 7U);
+}
@@ -0,0 +1,80 @@
+#include <misc/DirtyRegion.h>
+
+#include <gtest/gtest.h>
+
+using dune::DirtyRegion;
+
+namespace {
+constexpr SDL_Rect screen{0, 0, 640, 480};
+
+void expect_rect(const SDL_Rect& expected, const SDL_Rect& actual) {
+    EXPECT_EQ(expected.x, actual.x);
+    EXPECT_EQ(expected.y, actual.y);
+    EXPECT_EQ(expected.w, actual.w);
+    EXPECT_EQ(expected.h, actual.h);
+}
+} // namespace
+
+TEST(dirty_region, starts_empty) {
+    const DirtyRegion region;
+
+    EXPECT_TRUE(region.empty());
+    EXPECT_FALSE(region.isAll());
+    expect_rect({}, region.bounds(screen));
+}
+
+TEST(dirty_region, empty_rects_are_ignored) {
+    DirtyRegion region;
+
+    region.add(SDL_Rect{10, 10, 0, 5});
+    region.add(SDL_Rect{10, 10, 5, -1});
+
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(dirty_region, bounds_cover_all_rects) {
+    DirtyRegion region;
+
+    region.add(SDL_Rect{10, 20, 30, 40});
+    region.add(SDL_Rect{100, 5, 10, 10});
+
+    EXPECT_FALSE(region.empty());
+    expect_rect({10, 5, 100, 55}, region.bounds(screen));
+}
+
+TEST(dirty_region, float_rects_are_extended_to_whole_pixels) {
+    DirtyRegion region;
+
+    region.add(SDL_FRect{10.5f, 20.25f, 5.f, 4.5f});
+
+    expect_rect({10, 20, 6, 5}, region.bounds(screen));
+}
+
+TEST(dirty_region, bounds_are_clipped_to_the_screen) {
+    DirtyRegion region;
+
+    region.add(SDL_Rect{600, -10, 100, 20});
+    expect_rect({600, 0, 40, 10}, region.bounds(screen));
+
+    region.clear();
+    region.add(SDL_Rect{700, 500, 10, 10});
+    EXPECT_FALSE(region.empty());
+    expect_rect({}, region.bounds(screen));
+}
+
+TEST(dirty_region, mark_all_covers_the_screen) {
+    DirtyRegion region;
+
+    region.add(SDL_Rect{10, 20, 30, 40});
+    region.markAll();
+    region.add(SDL_Rect{1000, 1000, 10, 10});
+
+    EXPECT_TRUE(region.isAll());
+    EXPECT_FALSE(region.empty());
+    expect_rect(screen, region.bounds(screen));
+
+    region.clear();
+
+    EXPECT_TRUE(region.empty());
+    EXPECT_FALSE(region.isAll());
+}
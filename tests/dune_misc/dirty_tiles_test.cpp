@@ -0,0 +1,118 @@
+#include <misc/DirtyTiles.h>
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+using dune::DirtyTiles;
+
+namespace {
+std::vector<std::pair<int, int>> dirty_tiles(const DirtyTiles& dirty) {
+    std::vector<std::pair<int, int>> tiles;
+    dirty.for_each([&](int x, int y) { tiles.emplace_back(x, y); });
+    return tiles;
+}
+
+std::vector<SDL_Rect> dirty_rects(const DirtyTiles& dirty) {
+    std::vector<SDL_Rect> rects;
+    dirty.for_each_rect([&](const SDL_Rect& rect) { rects.push_back(rect); });
+    return rects;
+}
+} // namespace
+
+TEST(dirty_tiles, initially_all_dirty) {
+    const DirtyTiles dirty{5, 3};
+
+    EXPECT_TRUE(dirty.isAll());
+    EXPECT_EQ(15, dirty.count());
+    EXPECT_EQ(15u, dirty_tiles(dirty).size());
+
+    const auto rects = dirty_rects(dirty);
+    ASSERT_EQ(1u, rects.size());
+    EXPECT_EQ(0, rects[0].x);
+    EXPECT_EQ(0, rects[0].y);
+    EXPECT_EQ(5, rects[0].w);
+    EXPECT_EQ(3, rects[0].h);
+}
+
+TEST(dirty_tiles, mark_records_each_tile_once) {
+    DirtyTiles dirty{64, 64};
+    dirty.clear();
+
+    EXPECT_TRUE(dirty.empty());
+
+    dirty.mark(3, 4);
+    dirty.mark(10, 2);
+    dirty.mark(3, 4);
+    dirty.mark(-1, 0);
+    dirty.mark(0, 64);
+
+    EXPECT_FALSE(dirty.empty());
+    EXPECT_EQ(2, dirty.count());
+
+    const auto tiles = dirty_tiles(dirty);
+    ASSERT_EQ(2u, tiles.size());
+    EXPECT_EQ(std::make_pair(3, 4), tiles[0]);
+    EXPECT_EQ(std::make_pair(10, 2), tiles[1]);
+
+    dirty.clear();
+    EXPECT_TRUE(dirty.empty());
+
+    dirty.mark(3, 4);
+    EXPECT_EQ(1, dirty.count());
+}
+
+TEST(dirty_tiles, one_bounding_rect_per_band) {
+    DirtyTiles dirty{64, 64};
+    dirty.clear();
+
+    dirty.mark(10, 1);
+    dirty.mark(2, 5);
+    dirty.mark(7, 3);
+    dirty.mark(40, 60);
+
+    const auto rects = dirty_rects(dirty);
+    ASSERT_EQ(2u, rects.size());
+
+    EXPECT_EQ(2, rects[0].x);
+    EXPECT_EQ(1, rects[0].y);
+    EXPECT_EQ(9, rects[0].w);
+    EXPECT_EQ(5, rects[0].h);
+
+    EXPECT_EQ(40, rects[1].x);
+    EXPECT_EQ(60, rects[1].y);
+    EXPECT_EQ(1, rects[1].w);
+    EXPECT_EQ(1, rects[1].h);
+
+    for (const auto& rect : rects) {
+        EXPECT_EQ(rect.y / DirtyTiles::band_height, (rect.y + rect.h - 1) / DirtyTiles::band_height);
+    }
+}
+
+TEST(dirty_tiles, mark_all_and_reset) {
+    DirtyTiles dirty{8, 8};
+    dirty.clear();
+
+    dirty.mark(1, 1);
+    dirty.markAll();
+    dirty.mark(2, 2);
+
+    EXPECT_TRUE(dirty.isAll());
+    EXPECT_EQ(64, dirty.count());
+
+    dirty.clear();
+    EXPECT_TRUE(dirty.empty());
+
+    dirty.mark(2, 2);
+    EXPECT_EQ(1, dirty.count());
+
+    dirty.reset(16, 4);
+    EXPECT_TRUE(dirty.isAll());
+    EXPECT_EQ(16, dirty.getSizeX());
+    EXPECT_EQ(4, dirty.getSizeY());
+
+    dirty.clear();
+    dirty.mark(15, 3);
+    EXPECT_EQ(std::make_pair(15, 3), dirty_tiles(dirty).at(0));
+}
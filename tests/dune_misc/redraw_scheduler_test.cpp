@@ -0,0 +1,41 @@
+#include <misc/RedrawScheduler.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using dune::dune_clock;
+using dune::RedrawScheduler;
+
+using namespace std::chrono_literals;
+
+TEST(redraw_scheduler, nothing_is_due_after_starting_a_frame) {
+    RedrawScheduler::startFrame();
+
+    EXPECT_FALSE(RedrawScheduler::due());
+    EXPECT_EQ(dune_clock::time_point::max(), RedrawScheduler::nextWake());
+}
+
+TEST(redraw_scheduler, invalidate_is_due_immediately) {
+    RedrawScheduler::startFrame();
+    RedrawScheduler::invalidate();
+
+    EXPECT_TRUE(RedrawScheduler::due());
+
+    RedrawScheduler::wakeAfter(1s);
+
+    EXPECT_TRUE(RedrawScheduler::due());
+}
+
+TEST(redraw_scheduler, the_earliest_wake_up_is_kept) {
+    const auto now = dune_clock::now();
+
+    RedrawScheduler::startFrame();
+    RedrawScheduler::wakeAt(now + 500ms);
+    RedrawScheduler::wakeAt(now + 200ms);
+    RedrawScheduler::wakeAt(now + 800ms);
+
+    EXPECT_EQ(now + 200ms, RedrawScheduler::nextWake());
+    EXPECT_FALSE(RedrawScheduler::due(now + 199ms));
+    EXPECT_TRUE(RedrawScheduler::due(now + 200ms));
+}
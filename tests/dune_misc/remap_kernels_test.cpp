@@ -0,0 +1,127 @@
+#include "misc/RemapKernels.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <random>
+#include <vector>
+
+namespace {
+
+using dune::remap::ColorMap;
+using dune::remap::InstructionSet;
+
+constexpr InstructionSet all_sets[] = {InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2,
+                                       InstructionSet::NEON};
+
+constexpr int width  = 75;
+constexpr int height = 9;
+constexpr int pitch  = 80;
+
+std::vector<uint8_t> make_image(uint32_t seed) {
+    std::vector<uint8_t> image(pitch * height);
+
+    std::mt19937 generator{seed};
+    for (auto& pixel : image)
+        pixel = static_cast<uint8_t>(generator());
+
+    return image;
+}
+
+/// The loop mapSurfaceColorRange() used before it got a lookup table
+std::vector<uint8_t> map_color_range(std::vector<uint8_t> image, int src_color, int dest_color) {
+    const auto offset = static_cast<uint8_t>(src_color - dest_color);
+
+    for (auto y = 0; y < height; ++y) {
+        for (auto x = 0; x < width; ++x) {
+            auto& p = image[y * pitch + x];
+            if (p >= src_color && p < src_color + 7)
+                p -= offset;
+        }
+    }
+
+    return image;
+}
+
+} // namespace
+
+TEST(remap_kernels, range_matches_mapSurfaceColorRange) {
+    const auto source = make_image(1);
+
+    for (const auto set : all_sets) {
+        if (!dune::scaler::is_supported(set))
+            continue;
+
+        for (const auto& [src_color, dest_color] : {std::pair{144, 160}, {144, 128}, {250, 3}, {232, 144}, {0, 9}}) {
+            auto actual = source;
+            dune::remap::remap(set, actual.data(), pitch, actual.data(), pitch, width, height,
+                               ColorMap::range(src_color, dest_color));
+
+            EXPECT_EQ(map_color_range(source, src_color, dest_color), actual)
+                << dune::scaler::instruction_set_name(set) << " " << src_color << " -> " << dest_color;
+        }
+    }
+}
+
+TEST(remap_kernels, dense_maps_match_scalar) {
+    const auto source = make_image(2);
+
+    std::mt19937 generator{3};
+    uint8_t table[256];
+    for (auto& entry : table)
+        entry = static_cast<uint8_t>(generator());
+
+    const ColorMap map{table};
+
+    size_t changed = 0;
+    for (auto i = 0; i < 256; ++i)
+        changed += table[i] != i ? 1 : 0;
+    EXPECT_EQ(changed, map.changed().size());
+
+    std::vector<uint8_t> expected(source.size());
+    dune::remap::remap(InstructionSet::Scalar, source.data(), pitch, expected.data(), pitch, width, height, map);
+
+    for (auto y = 0; y < height; ++y) {
+        for (auto x = 0; x < width; ++x)
+            ASSERT_EQ(table[source[y * pitch + x]], expected[y * pitch + x]);
+    }
+
+    for (const auto set : all_sets) {
+        if (!dune::scaler::is_supported(set))
+            continue;
+
+        std::vector<uint8_t> actual(source.size());
+        dune::remap::remap(set, source.data(), pitch, actual.data(), pitch, width, height, map);
+
+        EXPECT_EQ(expected, actual) << dune::scaler::instruction_set_name(set);
+    }
+}
+
+TEST(remap_kernels, batch_matches_single_maps) {
+    const auto source = make_image(4);
+
+    const ColorMap maps[] = {ColorMap::range(144, 160), ColorMap::range(144, 128), ColorMap{}.set(30, 0),
+                             ColorMap{}.set(170, 194).set(173, 195)};
+
+    for (const auto set : all_sets) {
+        if (!dune::scaler::is_supported(set))
+            continue;
+
+        std::vector<std::vector<uint8_t>> images(std::size(maps), std::vector<uint8_t>(source.size()));
+        std::vector<dune::remap::Target> targets;
+        for (auto i = 0u; i < std::size(maps); ++i)
+            targets.push_back({&maps[i], images[i].data(), pitch});
+
+        dune::remap::remap(set, source.data(), pitch, width, height, targets);
+
+        for (auto i = 0u; i < std::size(maps); ++i) {
+            std::vector<uint8_t> expected(source.size());
+            dune::remap::remap(InstructionSet::Scalar, source.data(), pitch, expected.data(), pitch, width, height,
+                               maps[i]);
+
+            EXPECT_EQ(expected, images[i]) << dune::scaler::instruction_set_name(set) << " map " << i;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include <Renderer/DuneRenderStats.h>
+
+#include <gtest/gtest.h>
+
+using dune::RenderLayer;
+using dune::RenderLayerScope;
+using dune::RenderStats;
+
+namespace {
+class render_stats : public ::testing::Test {
+protected:
+    void SetUp() override { RenderStats::enable(true); }
+    void TearDown() override { RenderStats::enable(false); }
+
+    static const dune::RenderLayerStats& last(RenderLayer layer) {
+        return RenderStats::lastFrame()[static_cast<size_t>(layer)];
+    }
+};
+
+auto* const texture1 = reinterpret_cast<SDL_Texture*>(0x10);
+auto* const texture2 = reinterpret_cast<SDL_Texture*>(0x20);
+} // namespace
+
+TEST_F(render_stats, counts_copies_switches_and_pixels) {
+    const SDL_FRect dest{0.f, 0.f, 10.f, 20.f};
+
+    RenderStats::countCopy(nullptr, texture1, &dest);
+    RenderStats::countCopy(nullptr, texture1, &dest);
+    RenderStats::countCopy(nullptr, texture2, &dest);
+    RenderStats::countStateChange();
+    RenderStats::endFrame();
+
+    const auto& gui = last(RenderLayer::GUI);
+    EXPECT_EQ(3, gui.copies);
+    EXPECT_EQ(3, gui.draw_calls);
+    EXPECT_EQ(2, gui.texture_switches);
+    EXPECT_EQ(1, gui.state_changes);
+    EXPECT_EQ(600, gui.pixels);
+}
+
+TEST_F(render_stats, batched_copies_are_one_draw_call) {
+    const SDL_FRect dest{0.f, 0.f, 4.f, 4.f};
+
+    for (auto i = 0; i < 5; ++i)
+        RenderStats::countCopy(nullptr, texture1, &dest, true);
+    RenderStats::countDrawCall();
+    RenderStats::endFrame();
+
+    EXPECT_EQ(5, last(RenderLayer::GUI).copies);
+    EXPECT_EQ(1, last(RenderLayer::GUI).draw_calls);
+    EXPECT_EQ(80, last(RenderLayer::GUI).pixels);
+}
+
+TEST_F(render_stats, layers_are_counted_separately) {
+    const SDL_FRect dest{0.f, 0.f, 1.f, 1.f};
+
+    {
+        RenderLayerScope layer{RenderLayer::Ground};
+        RenderStats::countCopy(nullptr, texture1, &dest);
+
+        layer.change(RenderLayer::Fog);
+        RenderStats::countCopy(nullptr, texture1, &dest);
+        RenderStats::countCopy(nullptr, texture2, &dest);
+    }
+
+    EXPECT_EQ(RenderLayer::GUI, RenderStats::layer());
+
+    RenderStats::countCopy(nullptr, texture2, &dest);
+    RenderStats::endFrame();
+
+    EXPECT_EQ(1, last(RenderLayer::Ground).copies);
+    EXPECT_EQ(1, last(RenderLayer::Ground).texture_switches);
+    EXPECT_EQ(2, last(RenderLayer::Fog).copies);
+    EXPECT_EQ(1, last(RenderLayer::Fog).texture_switches);
+    EXPECT_EQ(1, last(RenderLayer::GUI).copies);
+    EXPECT_EQ(0, last(RenderLayer::GUI).texture_switches);
+    EXPECT_EQ(0, last(RenderLayer::Units).copies);
+}
+
+TEST_F(render_stats, nothing_is_counted_while_disabled) {
+    const SDL_FRect dest{0.f, 0.f, 1.f, 1.f};
+
+    RenderStats::countCopy(nullptr, texture1, &dest);
+    RenderStats::endFrame();
+    EXPECT_EQ(1, last(RenderLayer::GUI).copies);
+
+    RenderStats::enable(false);
+
+    RenderStats::countCopy(nullptr, texture1, &dest);
+    RenderStats::countDrawCall(100);
+    RenderStats::endFrame();
+    EXPECT_EQ(0, last(RenderLayer::GUI).copies);
+    EXPECT_EQ(0, last(RenderLayer::GUI).pixels);
+}
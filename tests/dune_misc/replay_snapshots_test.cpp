@@ -0,0 +1,72 @@
+#include "ReplaySnapshots.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace {
+std::vector<uint8_t> make_savegame(uint32_t gameCycle) {
+    std::vector<uint8_t> savegame(4096);
+    std::iota(savegame.begin(), savegame.end(), static_cast<uint8_t>(gameCycle));
+    return savegame;
+}
+} // namespace
+
+TEST(replay_snapshots, find_nearest_earlier) {
+    ReplaySnapshots snapshots{100};
+
+    EXPECT_FALSE(snapshots.findSnapshot(0).has_value());
+
+    for (auto cycle = 0U; cycle <= 300U; cycle += 100U) {
+        ASSERT_TRUE(snapshots.isSnapshotDue(cycle));
+        snapshots.addSnapshot(cycle, make_savegame(cycle));
+        EXPECT_FALSE(snapshots.isSnapshotDue(cycle));
+    }
+
+    EXPECT_FALSE(snapshots.isSnapshotDue(150));
+
+    EXPECT_EQ(snapshots.findSnapshot(0), 0U);
+    EXPECT_EQ(snapshots.findSnapshot(99), 0U);
+    EXPECT_EQ(snapshots.findSnapshot(100), 100U);
+    EXPECT_EQ(snapshots.findSnapshot(250), 200U);
+    EXPECT_EQ(snapshots.findSnapshot(100000), 300U);
+}
+
+TEST(replay_snapshots, restore_point) {
+    ReplaySnapshots snapshots{100};
+
+    for (auto cycle = 0U; cycle <= 300U; cycle += 100U)
+        snapshots.addSnapshot(cycle, make_savegame(cycle));
+
+    // seeking forward restores a snapshot only if it is ahead of the current game cycle
+    EXPECT_EQ(snapshots.findRestorePoint(50, 250), 200U);
+    EXPECT_EQ(snapshots.findRestorePoint(150, 199), std::nullopt);
+    EXPECT_EQ(snapshots.findRestorePoint(200, 250), std::nullopt);
+    EXPECT_EQ(snapshots.findRestorePoint(250, 100000), 300U);
+
+    // seeking backwards always needs a snapshot
+    EXPECT_EQ(snapshots.findRestorePoint(250, 120), 100U);
+    EXPECT_EQ(snapshots.findRestorePoint(250, 0), 0U);
+}
+
+TEST(replay_snapshots, roundtrip) {
+    ReplaySnapshots snapshots{100};
+
+    snapshots.addSnapshot(200, make_savegame(200));
+
+    EXPECT_EQ(snapshots.getSnapshot(200), make_savegame(200));
+    EXPECT_THROW((void)snapshots.getSnapshot(100), std::invalid_argument);
+}
+
+TEST(replay_snapshots, memory_limit) {
+    ReplaySnapshots snapshots{10, 1};
+
+    for (auto cycle = 0U; cycle <= 100U; cycle += 10U) {
+        if (snapshots.isSnapshotDue(cycle))
+            snapshots.addSnapshot(cycle, make_savegame(cycle));
+    }
+
+    // only the first snapshot survives a limit that is too small for two snapshots
+    EXPECT_EQ(snapshots.findSnapshot(100), 0U);
+    EXPECT_EQ(snapshots.getSnapshot(0), make_savegame(0));
+}
@@ -0,0 +1,65 @@
+#include "SaveGameHeader.h"
+
+#include "misc/IMemoryStream.h"
+#include "misc/OMemoryStream.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+TEST(savegame_header, roundtrip) {
+    SaveGameHeader header;
+    header.mapName        = "2P - Island";
+    header.gameType       = GameType::CustomGame;
+    header.houseID        = HOUSETYPE::HOUSE_ORDOS;
+    header.gameCycleCount = 123456;
+
+    GameInitSettings::HouseInfo houseInfo{HOUSETYPE::HOUSE_ORDOS, 1};
+    houseInfo.addPlayerInfo(GameInitSettings::PlayerInfo{"Player", "HumanPlayer"});
+    header.houseInfoList.push_back(houseInfo);
+
+    header.thumbnailWidth  = 4;
+    header.thumbnailHeight = 2;
+    header.thumbnail.resize(4 * 2 * 3);
+    std::iota(header.thumbnail.begin(), header.thumbnail.end(), uint8_t{0});
+
+    OMemoryStream out;
+    out.open();
+    header.save(out);
+    out.writeUint32(0xDEADBEEF);
+
+    IMemoryStream in{out.getData(), out.getDataLength()};
+    const SaveGameHeader loaded{in};
+
+    EXPECT_EQ(loaded.mapName, header.mapName);
+    EXPECT_EQ(loaded.gameType, header.gameType);
+    EXPECT_EQ(loaded.houseID, header.houseID);
+    EXPECT_EQ(loaded.gameCycleCount, header.gameCycleCount);
+    ASSERT_EQ(loaded.houseInfoList.size(), 1U);
+    ASSERT_EQ(loaded.houseInfoList[0].playerInfoList.size(), 1U);
+    EXPECT_EQ(loaded.houseInfoList[0].playerInfoList[0].playerName, "Player");
+    EXPECT_EQ(loaded.thumbnailWidth, header.thumbnailWidth);
+    EXPECT_EQ(loaded.thumbnailHeight, header.thumbnailHeight);
+    EXPECT_EQ(loaded.thumbnail, header.thumbnail);
+
+    // the header does not read beyond its block
+    EXPECT_EQ(in.readUint32(), 0xDEADBEEF);
+}
+
+TEST(savegame_header, sections) {
+    std::vector<uint8_t> first(10000, 7);
+    std::vector<uint8_t> second(1000);
+    std::iota(second.begin(), second.end(), uint8_t{0});
+
+    OMemoryStream out;
+    out.open();
+    writeSaveGameSection(out, first);
+    writeSaveGameSection(out, {});
+    writeSaveGameSection(out, second);
+
+    IMemoryStream in{out.getData(), out.getDataLength()};
+    EXPECT_EQ(readSaveGameSection(in), first);
+    EXPECT_TRUE(readSaveGameSection(in).empty());
+    EXPECT_EQ(readSaveGameSection(in), second);
+    EXPECT_EQ(in.bytesLeft(), 0U);
+}
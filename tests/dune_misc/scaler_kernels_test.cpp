@@ -0,0 +1,116 @@
+#include "misc/ScalerKernels.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using dune::scaler::InstructionSet;
+
+constexpr InstructionSet vectorized_sets[] = {InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::NEON};
+
+/// An 8-bit image with some padding at the end of every row, like SDL surfaces have
+struct Image {
+    Image(int w, int h) : width{w}, height{h}, pitch{w + 13}, pixels(static_cast<size_t>(pitch) * h, 0xcd) { }
+
+    int width;
+    int height;
+    int pitch;
+    std::vector<uint8_t> pixels;
+};
+
+/// Sprite sheet like content: few colors, so many neighbors are equal and every branch of the scalers is taken
+Image make_sheet(int w, int h, int colors, uint32_t seed) {
+    Image image{w, h};
+
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<int> distribution{0, colors - 1};
+
+    for (auto y = 0; y < h; ++y) {
+        for (auto x = 0; x < w; ++x)
+            image.pixels[y * image.pitch + x] = static_cast<uint8_t>(distribution(generator) * 37);
+    }
+
+    return image;
+}
+
+struct Layout {
+    int tiles_x;
+    int tiles_y;
+    int tile_width;
+    int tile_height;
+};
+
+// Unit rows, structure animations, terrain rows, single pictures and a few odd shapes
+constexpr Layout layouts[] = {{8, 1, 16, 16}, {8, 2, 16, 16}, {4, 1, 32, 32}, {16, 1, 16, 16}, {1, 1, 48, 48},
+                              {1, 1, 17, 5},  {3, 2, 7, 9},   {1, 1, 1, 1},   {5, 1, 1, 3},    {2, 3, 33, 2},
+                              {1, 1, 100, 1}, {6, 25, 16, 16}};
+
+template<typename Scale>
+void expect_same_as_scalar(int factor, Scale&& scale) {
+    for (const auto set : vectorized_sets) {
+        if (!dune::scaler::is_supported(set))
+            continue;
+
+        for (const auto& layout : layouts) {
+            const auto w = layout.tiles_x * layout.tile_width;
+            const auto h = layout.tiles_y * layout.tile_height;
+
+            for (const auto colors : {1, 2, 3, 256}) {
+                const auto source = make_sheet(w, h, colors, static_cast<uint32_t>(w * 31 + h * 7 + colors));
+
+                Image expected{factor * w, factor * h};
+                Image actual{factor * w, factor * h};
+
+                scale(InstructionSet::Scalar, source, expected, layout);
+                scale(set, source, actual, layout);
+
+                EXPECT_EQ(expected.pixels, actual.pixels)
+                    << dune::scaler::instruction_set_name(set) << " " << layout.tiles_x << "x" << layout.tiles_y
+                    << " tiles of " << layout.tile_width << "x" << layout.tile_height << " with " << colors
+                    << " colors";
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(scaler_kernels, scale2x_known_result) {
+    const uint8_t source[] = {1, 2, 2, 1};
+    uint8_t result[16]{};
+
+    dune::scaler::scale2x(InstructionSet::Scalar, source, 2, result, 4, 2, 2, 2, 2);
+
+    const uint8_t expected[] = {1, 1, 2, 2, 1, 2, 1, 2, 2, 1, 2, 1, 2, 2, 1, 1};
+    EXPECT_TRUE(std::equal(std::begin(expected), std::end(expected), std::begin(result)));
+}
+
+TEST(scaler_kernels, scale2x_matches_scalar) {
+    expect_same_as_scalar(2, [](InstructionSet set, const Image& src, Image& dst, const Layout& layout) {
+        dune::scaler::scale2x(set, src.pixels.data(), src.pitch, dst.pixels.data(), dst.pitch, src.width, src.height,
+                              layout.tile_width, layout.tile_height);
+    });
+}
+
+TEST(scaler_kernels, scale3x_matches_scalar) {
+    expect_same_as_scalar(3, [](InstructionSet set, const Image& src, Image& dst, const Layout& layout) {
+        dune::scaler::scale3x(set, src.pixels.data(), src.pitch, dst.pixels.data(), dst.pitch, src.width, src.height,
+                              layout.tile_width, layout.tile_height);
+    });
+}
+
+TEST(scaler_kernels, nearest_neighbor_matches_scalar) {
+    expect_same_as_scalar(2, [](InstructionSet set, const Image& src, Image& dst, const Layout&) {
+        dune::scaler::double_nn(set, src.pixels.data(), src.pitch, dst.pixels.data(), dst.pitch, src.width,
+                                src.height);
+    });
+    expect_same_as_scalar(3, [](InstructionSet set, const Image& src, Image& dst, const Layout&) {
+        dune::scaler::triple_nn(set, src.pixels.data(), src.pitch, dst.pixels.data(), dst.pitch, src.width,
+                                src.height);
+    });
+}
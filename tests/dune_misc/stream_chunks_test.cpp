@@ -0,0 +1,101 @@
+#include <misc/StreamChunks.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// stands in for a map tile: the size of the record depends on the content, like the unit lists of a Tile
+struct Record {
+    uint32_t value = 0;
+    std::vector<uint32_t> extra;
+
+    bool operator==(const Record&) const = default;
+};
+
+std::vector<Record> make_records(size_t count) {
+    std::vector<Record> records(count);
+    for (size_t i = 0; i < count; i++) {
+        records[i].value = static_cast<uint32_t>(i * 7919U);
+        records[i].extra.resize(i % 3, static_cast<uint32_t>(i));
+    }
+    return records;
+}
+
+void save_record(OutputStream& stream, const Record& record) {
+    stream.writeUint32(record.value);
+    stream.writeUint32Vector(record.extra);
+}
+
+void load_record(InputStream& stream, Record& record) {
+    record.value = stream.readUint32();
+    record.extra = stream.readUint32Vector();
+}
+
+std::vector<Record> roundtrip(const std::vector<Record>& records, size_t itemsPerChunk) {
+    OMemoryStream out;
+    out.open();
+    dune::writeChunks(out, std::span<const Record>{records}, itemsPerChunk, save_record);
+    out.writeUint32(0xDEADBEEF);
+
+    IMemoryStream in{out.getData(), out.getDataLength()};
+    std::vector<Record> loaded(records.size());
+    dune::readChunks(in, std::span{loaded}, load_record);
+
+    EXPECT_EQ(in.readUint32(), 0xDEADBEEF);
+    EXPECT_EQ(in.bytesLeft(), 0U);
+
+    return loaded;
+}
+
+} // namespace
+
+TEST(stream_chunks, roundtrip_with_partial_last_chunk) {
+    // map sizes as Map::save() uses them: chunks of 8 columns
+    const std::vector<std::pair<int, int>> mapSizes{{1, 1}, {7, 5}, {9, 13}, {17, 3}, {64, 64}, {65, 31}};
+
+    for (const auto& [sizeX, sizeY] : mapSizes) {
+        const auto records = make_records(static_cast<size_t>(sizeX) * sizeY);
+
+        EXPECT_EQ(roundtrip(records, static_cast<size_t>(8) * sizeY), records) << sizeX << "x" << sizeY;
+    }
+}
+
+TEST(stream_chunks, roundtrip_with_more_items_per_chunk_than_items) {
+    const auto records = make_records(5);
+
+    EXPECT_EQ(roundtrip(records, 100), records);
+    EXPECT_TRUE(roundtrip({}, 8).empty());
+}
+
+TEST(stream_chunks, item_count_mismatch_throws) {
+    const auto records = make_records(20);
+
+    OMemoryStream out;
+    out.open();
+    dune::writeChunks(out, std::span<const Record>{records}, 8, save_record);
+
+    IMemoryStream in{out.getData(), out.getDataLength()};
+    std::vector<Record> loaded(30);
+    EXPECT_THROW(dune::readChunks(in, std::span{loaded}, load_record), std::runtime_error);
+}
+
+TEST(stream_chunks, unused_bytes_throw) {
+    const std::vector<uint32_t> values(20, 42);
+
+    OMemoryStream out;
+    out.open();
+    dune::writeChunks(out, std::span<const uint32_t>{values}, 8, [](OutputStream& stream, uint32_t value) {
+        stream.writeUint32(value);
+        stream.writeUint32(value);
+    });
+
+    IMemoryStream in{out.getData(), out.getDataLength()};
+    std::vector<uint32_t> loaded(values.size());
+    const auto load_first_value = [](InputStream& stream, uint32_t& value) { value = stream.readUint32(); };
+    EXPECT_THROW(dune::readChunks(in, std::span{loaded}, load_first_value), std::runtime_error);
+}
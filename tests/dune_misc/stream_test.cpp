@@ -0,0 +1,88 @@
+#include "misc/IFileStream.h"
+#include "misc/IMemoryStream.h"
+#include "misc/OFileStream.h"
+#include "misc/OMemoryStream.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <numeric>
+
+namespace {
+std::vector<uint32_t> make_values(size_t count) {
+    std::vector<uint32_t> values(count);
+    std::iota(values.begin(), values.end(), 0x12345678U);
+    return values;
+}
+} // namespace
+
+TEST(stream, bulk_write_matches_single_writes) {
+    const auto values = make_values(100);
+
+    OMemoryStream single;
+    single.open();
+    for (const auto x : values) {
+        single.writeUint32(x);
+    }
+
+    OMemoryStream bulk;
+    bulk.open();
+    bulk.writeUint32s(values);
+
+    ASSERT_EQ(single.getDataLength(), bulk.getDataLength());
+    EXPECT_TRUE(std::ranges::equal(single.getBytes(), bulk.getBytes()));
+
+    IMemoryStream in{bulk.getData(), bulk.getDataLength()};
+    std::vector<int32_t> loaded(values.size());
+    in.readSint32s(loaded);
+    EXPECT_EQ(static_cast<uint32_t>(loaded[99]), values[99]);
+    EXPECT_EQ(in.bytesLeft(), 0U);
+}
+
+TEST(stream, file_roundtrip_across_buffer) {
+    const auto filename = std::filesystem::temp_directory_path() / "dune_stream_test.bin";
+
+    // larger than the internal buffers of the file streams
+    const auto values = make_values(50000);
+    std::vector<uint8_t> bytes(200000);
+    std::iota(bytes.begin(), bytes.end(), uint8_t{0});
+
+    {
+        OFileStream out;
+        ASSERT_TRUE(out.open(filename));
+        out.writeUint8(7);
+        out.writeUint32Vector(values);
+        out.writeString("dune");
+        out.writeUint8Vector(bytes);
+        out.writeUint64(0x0123456789ABCDEFULL);
+        out.close();
+    }
+
+    IFileStream in;
+    ASSERT_TRUE(in.open(filename));
+    EXPECT_EQ(in.readUint8(), 7);
+    EXPECT_EQ(in.readUint32Vector(), values);
+    EXPECT_EQ(in.readString(), "dune");
+    EXPECT_EQ(in.readUint8Vector(), bytes);
+    EXPECT_EQ(in.readUint64(), 0x0123456789ABCDEFULL);
+    EXPECT_EQ(in.bytesLeft(), 0U);
+    EXPECT_THROW(in.readUint8(), InputStream::eof);
+    in.close();
+
+    std::filesystem::remove(filename);
+}
+
+TEST(stream, truncated_vector_throws) {
+    OMemoryStream out;
+    out.open();
+    out.writeUint32(1000);
+    out.writeUint32(1);
+
+    IMemoryStream in{out.getData(), out.getDataLength()};
+    EXPECT_THROW(in.readUint32Vector(), InputStream::eof);
+}
+
+TEST(stream, missing_file_does_not_open) {
+    IFileStream in;
+    EXPECT_FALSE(in.open(std::filesystem::temp_directory_path() / "dune_stream_test_missing.bin"));
+}
@@ -0,0 +1,47 @@
+#include "misc/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(thread_pool, submit_returns_results) {
+    ThreadPool pool{2};
+
+    auto a = pool.submit([] { return 6 * 7; });
+    auto b = pool.submit([] { return std::string{"dune"}; });
+
+    EXPECT_EQ(a.get(), 42);
+    EXPECT_EQ(b.get(), "dune");
+}
+
+TEST(thread_pool, parallel_for_visits_every_index_once) {
+    ThreadPool pool{3};
+
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for(visits.size(), [&](size_t i) { ++visits[i]; });
+
+    for (const auto& v : visits)
+        EXPECT_EQ(v.load(), 1);
+
+    pool.parallel_for(0, [](size_t) { FAIL(); });
+}
+
+TEST(thread_pool, exceptions_reach_the_caller) {
+    ThreadPool pool{2};
+
+    auto future = pool.submit([]() -> int { throw std::runtime_error{"task"}; });
+    EXPECT_THROW(future.get(), std::runtime_error);
+
+    EXPECT_THROW(pool.parallel_for(100,
+                                   [](size_t i) {
+                                       if (i == 50)
+                                           throw std::runtime_error{"index"};
+                                   }),
+                 std::runtime_error);
+
+    // the pool is still usable afterwards
+    EXPECT_EQ(pool.submit([] { return 1; }).get(), 1);
+}
@@ -0,0 +1,453 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LockstepHarness.h"
+
+#include <Command.h>
+#include <CommandManager.h>
+#include <GameInitSettings.h>
+
+#include <misc/exceptions.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/**
+    One player of the harness. This is the part of Game, CommandManager and HumanPlayer that takes part in the
+    lockstep protocol.
+*/
+struct LockstepPeer {
+    LockstepPeer(std::string name, uint8_t playerID)
+        : name(std::move(name)), playerID(playerID), networkManager(std::make_unique<NetworkManager>(0, "")) { }
+
+    std::string name;
+    uint8_t playerID;
+    std::unique_ptr<NetworkManager> networkManager;
+
+    std::map<std::string, uint32_t> nextExpectedCommandsCycle; ///< see HumanPlayer::nextExpectedCommandsCycle
+    std::vector<std::vector<Command>> timeslot;                ///< see CommandManager::timeslot
+    uint32_t networkCycleBuffer = 0;
+
+    uint32_t gameCycleCount  = 0;
+    uint32_t targetGameCycle = 0;
+    uint32_t frameCount      = 0;
+    uint32_t nextSerial      = 0;
+    dune::dune_clock::time_point lastTargetGameCycleTime{};
+    dune::dune_clock::time_point nextFrameTime{};
+
+    dune::dune_clock::time_point startWaitingTime{};
+    dune::dune_clock::duration stallTime{};
+
+    uint64_t commandHash      = 14695981039346656037ULL;
+    uint32_t executedCommands = 0;
+    uint32_t prematureCycles  = 0;
+
+    bool bCommandsChanged = true;
+    uint32_t lastSentCycle{};
+
+    void addCommand(const Command& command, uint32_t cycle) {
+        if (cycle >= timeslot.size()) {
+            timeslot.resize(cycle + 1);
+        }
+
+        bCommandsChanged = true;
+
+        timeslot[cycle].push_back(command);
+        std::ranges::stable_sort(timeslot[cycle], {}, &Command::getPlayerID);
+    }
+
+    void addCommandList(const std::string& playername, const CommandList& commandList) {
+        const auto iter = nextExpectedCommandsCycle.find(playername);
+        if (iter == nextExpectedCommandsCycle.end()) {
+            return;
+        }
+
+        for (const auto& commandListEntry : commandList.commandList) {
+            if (iter->second > commandListEntry.cycle) {
+                continue;
+            }
+
+            for (const auto& command : commandListEntry.commands) {
+                addCommand(command, commandListEntry.cycle);
+            }
+
+            iter->second = std::max(iter->second, commandListEntry.cycle + 1);
+        }
+    }
+
+    [[nodiscard]] bool isWaitingForNetwork(uint32_t cycle) const {
+        return std::ranges::any_of(nextExpectedCommandsCycle,
+                                   [cycle](const auto& expected) { return expected.second <= cycle; });
+    }
+
+    void sendCommandList() {
+        if (!bCommandsChanged && gameCycleCount == lastSentCycle && networkManager->resendCommandList()) {
+            return;
+        }
+
+        CommandList commandList;
+
+        for (uint32_t i = std::max(static_cast<int>(gameCycleCount) - MILLI2CYCLES(2500), 0);
+             i < gameCycleCount + networkCycleBuffer; i++) {
+
+            std::vector<Command> commands;
+
+            if (i < timeslot.size()) {
+                std::ranges::copy_if(timeslot[i], std::back_inserter(commands),
+                                     [this](const auto& command) { return command.getPlayerID() == playerID; });
+            }
+
+            commandList.commandList.emplace_back(i, std::move(commands));
+        }
+
+        networkManager->sendCommandList(commandList);
+
+        bCommandsChanged = false;
+        lastSentCycle    = gameCycleCount;
+    }
+};
+
+class LockstepHarness {
+public:
+    explicit LockstepHarness(const LockstepSettings& settings) : settings_(settings) { }
+
+    LockstepResult run() {
+        connectPlayers();
+
+        // the game phase runs on a simulated clock, so it neither depends on nor waits for the wall clock
+        now_ = dune::dune_clock::now();
+
+        auto conditions  = settings_.conditions;
+        conditions.clock = [this] { return now_; };
+
+        for (auto& peer : peers_) {
+            peer->networkManager->setSimulatedNetworkConditions(conditions);
+        }
+
+        return playGame();
+    }
+
+private:
+    void connectPlayers() {
+        const auto numPlayers = settings_.numClients + 1;
+
+        for (auto i = 0; i < numPlayers; i++) {
+            peers_.push_back(std::make_unique<LockstepPeer>(fmt::format("Player{}", i), static_cast<uint8_t>(i + 1)));
+        }
+
+        for (auto& peer : peers_) {
+            auto* const pPeer = peer.get();
+
+            for (const auto& other : peers_) {
+                if (other != peer) {
+                    pPeer->nextExpectedCommandsCycle[other->name] = 0;
+                }
+            }
+
+            pPeer->networkManager->setOnReceiveCommandList(
+                [pPeer](const auto& playername, const auto& commandList) {
+                    pPeer->addCommandList(playername, commandList);
+                });
+            pPeer->networkManager->setOnPeerDisconnected([pPeer](const auto& name, auto /*bHost*/, auto /*cause*/) {
+                THROW(std::runtime_error, "'{}' lost the connection to '{}'!", pPeer->name, name);
+            });
+        }
+
+        auto& host = *peers_.front()->networkManager;
+        host.setGetChangeEventListForNewPlayerCallback([](const auto& /*name*/) { return ChangeEventList{}; });
+        host.startServer(true, "Lockstep Harness", peers_.front()->name, &gameInitSettings_, 1, numPlayers);
+
+        // connect one client after the other as only one client at a time may be awaiting its connection
+        for (auto i = 1; i < numPlayers; i++) {
+            peers_[i]->networkManager->connect("127.0.0.1", host.getPort(), peers_[i]->name);
+
+            waitUntil([&] {
+                return std::ranges::all_of(peers_.begin(), peers_.begin() + i + 1, [i](const auto& peer) {
+                    return static_cast<int>(peer->networkManager->getConnectedPeers().size()) == i;
+                });
+            });
+        }
+    }
+
+    template<typename Predicate>
+    void waitUntil(Predicate&& predicate) {
+        const auto deadline = dune::dune_clock::now() + settings_.timeout;
+
+        while (!predicate()) {
+            if (dune::dune_clock::now() > deadline) {
+                THROW(std::runtime_error, "Timeout while connecting the players!");
+            }
+
+            for (auto& peer : peers_) {
+                peer->networkManager->update();
+            }
+
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    LockstepResult playGame() {
+        const auto gameStart = now_;
+        const auto deadline  = gameStart + settings_.timeout;
+
+        // ENet does not see the simulated latency in its round trip time, so we add it ourselves
+        const auto simulatedRoundTripTime =
+            dune::as_milliseconds<int>(2 * settings_.conditions.latency + settings_.conditions.jitter);
+
+        uint32_t sentBytesAtStart = 0;
+        for (auto& peer : peers_) {
+            const auto roundTripTime = peer->networkManager->getMaxPeerRoundTripTime() + simulatedRoundTripTime;
+
+            peer->networkCycleBuffer = settings_.networkCycleBuffer != 0
+                                         ? settings_.networkCycleBuffer
+                                         : CommandManager::calcNetworkCycleBuffer(roundTripTime);
+            peer->lastTargetGameCycleTime = gameStart;
+            peer->nextFrameTime           = gameStart;
+
+            sentBytesAtStart += peer->networkManager->getTotalSentBytes();
+        }
+
+        const auto isFinished = [this](const auto& peer) { return peer->gameCycleCount >= settings_.numCycles; };
+
+        while (!std::ranges::all_of(peers_, isFinished) && now_ < deadline) {
+            // the network delivers the delayed packets while the players are between two frames
+            for (auto& peer : peers_) {
+                peer->networkManager->update();
+            }
+
+            for (auto& peer : peers_) {
+                if (now_ >= peer->nextFrameTime) {
+                    runFrame(*peer);
+                    peer->nextFrameTime += settings_.frameTime;
+                }
+            }
+
+            now_ += 1ms;
+        }
+
+        LockstepResult result;
+        result.bCompleted = std::ranges::all_of(peers_, isFinished);
+        result.totalTime  = now_ - gameStart;
+        result.numPlayers = static_cast<uint32_t>(peers_.size());
+
+        result.networkCycleBuffer =
+            (*std::ranges::min_element(peers_, {}, [](const auto& peer) { return peer->networkCycleBuffer; }))
+                ->networkCycleBuffer;
+
+        uint32_t sentBytes = 0;
+        for (auto& peer : peers_) {
+            sentBytes += peer->networkManager->getTotalSentBytes();
+
+            if (peer->startWaitingTime != dune::dune_clock::time_point{}) {
+                peer->stallTime += now_ - peer->startWaitingTime;
+            }
+        }
+
+        result.bInSync = std::ranges::all_of(
+            peers_, [this](const auto& peer) { return peer->commandHash == peers_.front()->commandHash; });
+
+        result.issuedCommands = static_cast<uint32_t>(std::ranges::count_if(
+            issueTimes_, [this](const auto& issueTime) { return issueTime.second.cycle < settings_.numCycles; }));
+        result.executedCommands =
+            (*std::ranges::min_element(peers_, {}, [](const auto& peer) { return peer->executedCommands; }))
+                ->executedCommands;
+
+        for (const auto& peer : peers_) {
+            result.prematureCycles += peer->prematureCycles;
+            result.averageStallTime += peer->stallTime;
+            result.maxStallTime = std::max(result.maxStallTime, peer->stallTime);
+        }
+        result.averageStallTime /= peers_.size();
+
+        if (numInputDelays_ > 0) {
+            result.averageInputDelay = sumInputDelay_ / numInputDelays_;
+        }
+        result.maxInputDelay = maxInputDelay_;
+
+        if (numInputDelays_ > 0) {
+            result.minInputDelayCycles = minInputDelayCycles_;
+        }
+        result.maxInputDelayCycles = maxInputDelayCycles_;
+
+        const auto cycles =
+            (*std::ranges::max_element(peers_, {}, [](const auto& peer) { return peer->gameCycleCount; }))
+                ->gameCycleCount;
+        result.bytesPerCycle = cycles > 0 ? static_cast<double>(sentBytes - sentBytesAtStart) / cycles : 0.0;
+
+        return result;
+    }
+
+    /**
+        One iteration of Game::runMainLoop() without rendering and input handling.
+    */
+    void runFrame(LockstepPeer& peer) {
+        const auto frameStart = now_;
+
+        peer.networkManager->update();
+
+        const auto bFinished       = peer.gameCycleCount >= settings_.numCycles;
+        const auto bWaitForNetwork = !bFinished && peer.isWaitingForNetwork(peer.gameCycleCount);
+
+        if (bWaitForNetwork) {
+            if (peer.startWaitingTime == dune::dune_clock::time_point{}) {
+                peer.startWaitingTime = frameStart;
+            }
+        } else if (peer.startWaitingTime != dune::dune_clock::time_point{}) {
+            peer.stallTime += frameStart - peer.startWaitingTime;
+            peer.startWaitingTime = dune::dune_clock::time_point{};
+        }
+
+        // the "user input" of this frame
+        if (peer.frameCount++ % settings_.commandInterval == 0) {
+            const auto cycle  = peer.gameCycleCount + peer.networkCycleBuffer;
+            const auto serial = peer.nextSerial++;
+
+            peer.addCommand(Command(peer.playerID, CMDTYPE::CMD_TEST_SYNC, serial), cycle);
+            issueTimes_.emplace(issueKey(peer.playerID, serial), IssueTime{frameStart, peer.gameCycleCount, cycle});
+        }
+
+        peer.sendCommandList();
+
+        if (bWaitForNetwork || bFinished) {
+            return;
+        }
+
+        auto pendingTicks = frameStart - peer.lastTargetGameCycleTime;
+
+        if (pendingTicks > 2500ms) {
+            pendingTicks                 = 2 * settings_.gameSpeed;
+            peer.lastTargetGameCycleTime = frameStart - pendingTicks;
+        }
+
+        while (pendingTicks >= settings_.gameSpeed) {
+            pendingTicks -= settings_.gameSpeed;
+            peer.lastTargetGameCycleTime += settings_.gameSpeed;
+            ++peer.targetGameCycle;
+        }
+
+        // a frame takes no simulated time, so unlike Game::runMainLoop() it never stops early because it is behind
+        while (peer.gameCycleCount < peer.targetGameCycle && peer.gameCycleCount < settings_.numCycles) {
+            // the commands of the other players might only have arrived for the first cycles of this frame
+            if (peer.isWaitingForNetwork(peer.gameCycleCount)) {
+                break;
+            }
+
+            executeCycle(peer);
+        }
+    }
+
+    /**
+        The part of Game::updateGame() that executes the commands of the current cycle.
+    */
+    void executeCycle(LockstepPeer& peer) {
+        const auto now   = now_;
+        const auto cycle = peer.gameCycleCount;
+
+        // this would make the players diverge, as the missing commands are not executed in this cycle
+        if (peer.isWaitingForNetwork(cycle)) {
+            peer.prematureCycles++;
+        }
+
+        if (cycle < peer.timeslot.size()) {
+            for (const auto& command : peer.timeslot[cycle]) {
+                const auto serial = command.getParameters().at(0);
+
+                peer.commandHash = (peer.commandHash ^ cycle) * 1099511628211ULL;
+                peer.commandHash = (peer.commandHash ^ command.getPlayerID()) * 1099511628211ULL;
+                peer.commandHash = (peer.commandHash ^ serial) * 1099511628211ULL;
+                peer.executedCommands++;
+
+                const auto iter = issueTimes_.find(issueKey(command.getPlayerID(), serial));
+                if (iter != issueTimes_.end()) {
+                    const auto inputDelay = dune::as_milliseconds<double>(now - iter->second.time);
+
+                    sumInputDelay_ += inputDelay;
+                    maxInputDelay_ = std::max(maxInputDelay_, inputDelay);
+                    numInputDelays_++;
+
+                    const auto inputDelayCycles = cycle - iter->second.issuedInCycle;
+
+                    minInputDelayCycles_ = std::min(minInputDelayCycles_, inputDelayCycles);
+                    maxInputDelayCycles_ = std::max(maxInputDelayCycles_, inputDelayCycles);
+                }
+            }
+        }
+
+        peer.gameCycleCount++;
+    }
+
+    struct IssueTime {
+        dune::dune_clock::time_point time;
+        uint32_t issuedInCycle; ///< the game cycle of the issuing player when the command was issued
+        uint32_t cycle;         ///< the game cycle the command is scheduled for
+    };
+
+    static uint64_t issueKey(uint8_t playerID, uint32_t serial) {
+        return (static_cast<uint64_t>(playerID) << 32) | serial;
+    }
+
+    const LockstepSettings settings_;
+
+    dune::dune_clock::time_point now_{}; ///< the simulated time of the game phase
+
+    GameInitSettings gameInitSettings_{std::filesystem::path{"Lockstep Harness"}, std::string{"[BASIC]\n"},
+                                       std::string{"Lockstep Harness"}, false, SettingsClass::GameOptionsClass{}};
+
+    std::vector<std::unique_ptr<LockstepPeer>> peers_;
+
+    std::map<uint64_t, IssueTime> issueTimes_; ///< when and for which cycle a command was issued
+    double sumInputDelay_    = 0.0;
+    double maxInputDelay_    = 0.0;
+    uint64_t numInputDelays_ = 0;
+
+    uint32_t minInputDelayCycles_ = std::numeric_limits<uint32_t>::max();
+    uint32_t maxInputDelayCycles_ = 0;
+};
+
+} // namespace
+
+std::string LockstepResult::toString() const {
+    return fmt::format("players: {}, completed: {}, in sync: {}, commands: {}/{} executed, premature cycles: {}\n"
+                       "time: {:.0f} ms, stall time: {:.1f} ms avg / {:.1f} ms max\n"
+                       "input delay: {:.1f} ms avg / {:.1f} ms max ({} to {} cycles, scheduled {} cycles ahead)\n"
+                       "bandwidth: {:.1f} bytes per cycle\n",
+                       numPlayers, bCompleted, bInSync, executedCommands, issuedCommands, prematureCycles,
+                       dune::as_milliseconds<double>(totalTime), dune::as_milliseconds<double>(averageStallTime),
+                       dune::as_milliseconds<double>(maxStallTime), averageInputDelay, maxInputDelay,
+                       minInputDelayCycles, maxInputDelayCycles, networkCycleBuffer, bytesPerCycle);
+}
+
+LockstepResult runLockstepHarness(const LockstepSettings& settings) {
+    if (settings.numClients < 1 || settings.commandInterval < 1) {
+        THROW(std::invalid_argument, "Invalid lockstep harness settings!");
+    }
+
+    LockstepHarness harness{settings};
+
+    return harness.run();
+}
@@ -0,0 +1,82 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCKSTEPHARNESS_H
+#define LOCKSTEPHARNESS_H
+
+#include <Network/NetworkManager.h>
+
+#include <misc/dune_clock.h>
+
+#include <cstdint>
+#include <string>
+
+/**
+    Settings for one run of the lockstep harness.
+*/
+struct LockstepSettings {
+    int numClients              = 2;   ///< number of clients; the host is an additional player
+    uint32_t numCycles          = 250; ///< number of game cycles every player has to simulate
+    uint32_t commandInterval    = 4;   ///< every player issues one command every commandInterval frames
+    uint32_t networkCycleBuffer = 0;   ///< commands are scheduled this many cycles ahead; 0 = derive from RTT
+    dune::dune_clock::duration gameSpeed = dune::as_dune_clock_duration(GAMESPEED_DEFAULT); ///< time per game cycle
+    dune::dune_clock::duration frameTime = dune::as_dune_clock_duration(16);                ///< time per frame
+    dune::dune_clock::duration timeout   = dune::as_dune_clock_duration(60 * 1000); ///< give up after this time
+    SimulatedNetworkConditions conditions{}; ///< applied to the outgoing packets of every player once the game started
+};
+
+/**
+    The measurements of one run of the lockstep harness.
+*/
+struct LockstepResult {
+    bool bCompleted = false; ///< all players simulated all cycles before the timeout
+    bool bInSync    = false; ///< all players executed exactly the same commands in the same cycles
+
+    uint32_t numPlayers       = 0;
+    uint32_t issuedCommands   = 0; ///< commands issued by all players for cycles before numCycles
+    uint32_t executedCommands = 0; ///< minimum over all players of the number of executed commands
+    uint32_t prematureCycles  = 0; ///< cycles executed before the command lists of all players had arrived
+
+    uint32_t networkCycleBuffer = 0; ///< the smallest number of cycles any player scheduled its commands ahead
+
+    dune::dune_clock::duration totalTime{};       ///< simulated time of the game phase
+    dune::dune_clock::duration averageStallTime{}; ///< average time a player waited for other players
+    dune::dune_clock::duration maxStallTime{};     ///< maximum time a player waited for other players
+
+    double averageInputDelay = 0.0; ///< average time in ms from issuing a command until it is executed
+    double maxInputDelay     = 0.0; ///< maximum time in ms from issuing a command until it is executed
+
+    uint32_t minInputDelayCycles = 0; ///< minimum number of game cycles from issuing a command until it is executed
+    uint32_t maxInputDelayCycles = 0; ///< maximum number of game cycles from issuing a command until it is executed
+
+    double bytesPerCycle = 0.0; ///< bytes sent per game cycle by all players together
+
+    [[nodiscard]] std::string toString() const;
+};
+
+/**
+    Runs a host and several clients in this process, connects them with NetworkManager over 127.0.0.1 and plays
+    a lockstep "game" where every player only issues and executes CMD_TEST_SYNC commands. The frame loop mirrors
+    Game::runMainLoop(), Game::serviceNetwork() and CommandManager::update()/addCommandList(), so changes to the
+    network code can be benchmarked reproducibly on a single machine. The game runs on a simulated clock that
+    advances by one millisecond per step; only connecting the players waits for the wall clock.
+    \param  settings    the settings for this run
+    \return the measurements
+*/
+LockstepResult runLockstepHarness(const LockstepSettings& settings);
+
+#endif // LOCKSTEPHARNESS_H
@@ -0,0 +1,85 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Runs the lockstep harness with the given network conditions and prints stall time, input delay and bandwidth.
+
+#include "LockstepHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string_view>
+
+namespace {
+
+void printUsage() {
+    fprintf(stderr, "Usage:\n\tlockstep_bench [--clients=N] [--cycles=N] [--interval=N] [--buffer=N] "
+                    "[--latency=MS] [--jitter=MS] [--loss=PERCENT] [--seed=N] [--runs=N]\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LockstepSettings settings;
+    settings.numCycles = 1000;
+
+    auto runs = 1;
+
+    for (auto i = 1; i < argc; i++) {
+        const std::string_view parameter(argv[i]);
+
+        const auto value = [&](std::string_view prefix) { return atoi(argv[i] + prefix.size()); };
+
+        if (parameter.starts_with("--clients=")) {
+            settings.numClients = value("--clients=");
+        } else if (parameter.starts_with("--cycles=")) {
+            settings.numCycles = value("--cycles=");
+        } else if (parameter.starts_with("--interval=")) {
+            settings.commandInterval = value("--interval=");
+        } else if (parameter.starts_with("--buffer=")) {
+            settings.networkCycleBuffer = value("--buffer=");
+        } else if (parameter.starts_with("--latency=")) {
+            settings.conditions.latency = dune::as_dune_clock_duration(value("--latency="));
+        } else if (parameter.starts_with("--jitter=")) {
+            settings.conditions.jitter = dune::as_dune_clock_duration(value("--jitter="));
+        } else if (parameter.starts_with("--loss=")) {
+            settings.conditions.packetLoss = static_cast<float>(value("--loss=")) / 100.0f;
+        } else if (parameter.starts_with("--seed=")) {
+            settings.conditions.seed = value("--seed=");
+        } else if (parameter.starts_with("--runs=")) {
+            runs = value("--runs=");
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        for (auto run = 0; run < runs; run++) {
+            const auto result = runLockstepHarness(settings);
+
+            printf("Run %d:\n%s\n", run + 1, result.toString().c_str());
+
+            settings.conditions.seed++;
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "lockstep_bench: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
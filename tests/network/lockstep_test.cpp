@@ -0,0 +1,46 @@
+#include "LockstepHarness.h"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(lockstep, ideal_network) {
+    LockstepSettings settings;
+    settings.numClients = 2;
+    settings.numCycles  = 150;
+
+    const auto result = runLockstepHarness(settings);
+
+    EXPECT_TRUE(result.bCompleted);
+    EXPECT_TRUE(result.bInSync);
+    EXPECT_EQ(0, result.prematureCycles);
+    EXPECT_EQ(3, result.numPlayers);
+    EXPECT_GT(result.issuedCommands, 0);
+    EXPECT_EQ(result.issuedCommands, result.executedCommands);
+    EXPECT_GT(result.bytesPerCycle, 0.0);
+}
+
+TEST(lockstep, lossy_network) {
+    LockstepSettings settings;
+    settings.numClients            = 3;
+    settings.numCycles             = 150;
+    settings.conditions.latency    = 40ms;
+    settings.conditions.jitter     = 20ms;
+    settings.conditions.packetLoss = 0.1f;
+    settings.conditions.seed       = 1;
+
+    const auto result = runLockstepHarness(settings);
+
+    EXPECT_TRUE(result.bCompleted);
+
+    // no player may simulate a cycle before it has the commands of all other players for it
+    EXPECT_EQ(0, result.prematureCycles);
+    EXPECT_TRUE(result.bInSync);
+    EXPECT_EQ(result.issuedCommands, result.executedCommands);
+
+    // the scheduler has to give the commands at least one simulated round trip in advance ...
+    EXPECT_GE(result.networkCycleBuffer, MILLI2CYCLES(2 * 40U + 20U));
+
+    // ... and every command is executed exactly that many cycles after it was issued
+    EXPECT_EQ(result.networkCycleBuffer, result.minInputDelayCycles);
+}